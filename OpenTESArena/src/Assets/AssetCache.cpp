@@ -0,0 +1,288 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+
+#include "AssetCache.h"
+
+#include "components/debug/Debug.h"
+#include "components/utilities/Bytes.h"
+#include "components/utilities/Directory.h"
+#include "components/utilities/String.h"
+
+namespace
+{
+	constexpr char CacheMagic[4] = { 'O', 'T', 'A', 'C' };
+	constexpr uint32_t CacheFormatVersion = 2;
+	constexpr int CacheHeaderSize = 64; // Keeps the payload aligned when the file is memory-mapped.
+
+	struct CacheHeader
+	{
+		char magic[4];
+		uint32_t formatVersion;
+		uint32_t payloadVersion;
+		uint32_t reserved;
+		uint64_t sourceHash;
+		uint64_t payloadSize;
+		uint64_t payloadChecksum;
+		uint8_t padding[CacheHeaderSize - 40];
+	};
+
+	static_assert(sizeof(CacheHeader) == CacheHeaderSize);
+	static_assert(std::is_trivially_copyable_v<CacheHeader>);
+
+	std::string CacheFolderPath; // Empty if disabled.
+
+	uint64_t RotateLeft(uint64_t value, int bits)
+	{
+		return (value << bits) | (value >> (64 - bits));
+	}
+
+	// Consumes eight bytes per step with a multiply-rotate mix, then finishes with a MurmurHash3 avalanche.
+	// Not cryptographic; only needs to notice modified game data and corrupt entries.
+	uint64_t HashBytes(const uint8_t *bytes, size_t count)
+	{
+		constexpr uint64_t prime1 = 0x9E3779B185EBCA87ull;
+		constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+
+		uint64_t hash = prime1 ^ static_cast<uint64_t>(count);
+		const size_t wordCount = count / sizeof(uint64_t);
+		for (size_t i = 0; i < wordCount; i++)
+		{
+			uint64_t word;
+			std::memcpy(&word, bytes + (i * sizeof(uint64_t)), sizeof(word));
+			hash = RotateLeft(hash ^ (word * prime2), 31) * prime1;
+		}
+
+		const size_t tailCount = count - (wordCount * sizeof(uint64_t));
+		if (tailCount > 0)
+		{
+			uint64_t word = 0;
+			std::memcpy(&word, bytes + (wordCount * sizeof(uint64_t)), tailCount);
+			hash = RotateLeft(hash ^ (word * prime2), 31) * prime1;
+		}
+
+		hash ^= hash >> 33;
+		hash *= 0xFF51AFD7ED558CCDull;
+		hash ^= hash >> 33;
+		hash *= 0xC4CEB9FE1A85EC53ull;
+		hash ^= hash >> 33;
+		return hash;
+	}
+
+	// Source filenames can contain folders, so flatten them into one file per entry.
+	std::string MakeEntryPath(const char *sourceFilename)
+	{
+		std::string entryName(sourceFilename);
+		for (char &c : entryName)
+		{
+			const bool isSafeChar = (std::isalnum(static_cast<unsigned char>(c)) != 0) || (c == '.') || (c == '-');
+			c = isSafeChar ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : '_';
+		}
+
+		return CacheFolderPath + entryName + ".cache";
+	}
+
+	bool TryReadPayload(const char *sourceFilename, uint64_t sourceHash, uint32_t payloadVersion, Buffer<uint8_t> *outPayload)
+	{
+		const std::string entryPath = MakeEntryPath(sourceFilename);
+		std::ifstream stream(entryPath, std::ios::binary);
+		if (!stream.is_open())
+		{
+			return false;
+		}
+
+		CacheHeader header;
+		stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+		if (!stream.good() || (std::memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) != 0) ||
+			(header.formatVersion != CacheFormatVersion) || (header.payloadVersion != payloadVersion) ||
+			(header.sourceHash != sourceHash) || (header.payloadSize > static_cast<uint64_t>(INT32_MAX)))
+		{
+			return false;
+		}
+
+		outPayload->init(static_cast<int>(header.payloadSize));
+		stream.read(reinterpret_cast<char*>(outPayload->begin()), outPayload->getCount());
+		if (stream.gcount() != static_cast<std::streamsize>(outPayload->getCount()))
+		{
+			DebugLogWarning("Truncated asset cache entry \"" + entryPath + "\".");
+			return false;
+		}
+
+		if (HashBytes(outPayload->begin(), outPayload->getCount()) != header.payloadChecksum)
+		{
+			DebugLogWarning("Asset cache entry \"" + entryPath + "\" failed its checksum.");
+			return false;
+		}
+
+		return true;
+	}
+
+	void WritePayload(const char *sourceFilename, uint64_t sourceHash, uint32_t payloadVersion, BufferView<const uint8_t> payload)
+	{
+		CacheHeader header;
+		std::memset(&header, 0, sizeof(header));
+		std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+		header.formatVersion = CacheFormatVersion;
+		header.payloadVersion = payloadVersion;
+		header.sourceHash = sourceHash;
+		header.payloadSize = static_cast<uint64_t>(payload.getCount());
+		header.payloadChecksum = HashBytes(payload.begin(), payload.getCount());
+
+		// Write to a temp file first so an interrupted write never leaves a valid-looking entry behind.
+		const std::string entryPath = MakeEntryPath(sourceFilename);
+		const std::string tempPath = entryPath + ".tmp";
+		{
+			std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+			if (!stream.is_open())
+			{
+				DebugLogWarning("Couldn't open asset cache entry \"" + tempPath + "\" for writing.");
+				return;
+			}
+
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			stream.write(reinterpret_cast<const char*>(payload.begin()), payload.getCount());
+			if (!stream.good())
+			{
+				DebugLogWarning("Couldn't write asset cache entry \"" + tempPath + "\".");
+				return;
+			}
+		}
+
+		std::remove(entryPath.c_str());
+		if (std::rename(tempPath.c_str(), entryPath.c_str()) != 0)
+		{
+			DebugLogWarning("Couldn't replace asset cache entry \"" + entryPath + "\".");
+			std::remove(tempPath.c_str());
+		}
+	}
+}
+
+void AssetCache::init(const std::string &folderPath)
+{
+	CacheFolderPath = String::addTrailingSlashIfMissing(folderPath);
+	if (!Directory::exists(CacheFolderPath.c_str()))
+	{
+		Directory::createRecursively(CacheFolderPath.c_str());
+	}
+
+	DebugLog("Using asset cache \"" + CacheFolderPath + "\".");
+}
+
+void AssetCache::shutdown()
+{
+	CacheFolderPath.clear();
+}
+
+bool AssetCache::isEnabled()
+{
+	return !CacheFolderPath.empty();
+}
+
+uint64_t AssetCache::hashSource(BufferView<const std::byte> src)
+{
+	return HashBytes(reinterpret_cast<const uint8_t*>(src.begin()), src.getCount());
+}
+
+AssetCache::SourceEntry::SourceEntry(const char *sourceFilename, BufferView<const std::byte> src, uint32_t payloadVersion)
+{
+	this->sourceFilename = sourceFilename;
+	this->sourceHash = AssetCache::isEnabled() ? AssetCache::hashSource(src) : 0;
+	this->payloadVersion = payloadVersion;
+}
+
+bool AssetCache::SourceEntry::tryDecode(const PayloadDecoder &decoder) const
+{
+	if (!AssetCache::isEnabled())
+	{
+		return false;
+	}
+
+	Buffer<uint8_t> payload;
+	if (!TryReadPayload(this->sourceFilename, this->sourceHash, this->payloadVersion, &payload))
+	{
+		return false;
+	}
+
+	PayloadReader reader(payload);
+	if (!decoder(reader) || !reader.isFinished())
+	{
+		DebugLogWarning("Malformed asset cache payload for \"" + std::string(this->sourceFilename) + "\".");
+		return false;
+	}
+
+	return true;
+}
+
+void AssetCache::SourceEntry::encode(const PayloadEncoder &encoder) const
+{
+	if (!AssetCache::isEnabled())
+	{
+		return;
+	}
+
+	PayloadWriter writer;
+	encoder(writer);
+	WritePayload(this->sourceFilename, this->sourceHash, this->payloadVersion, writer.getPayload());
+}
+
+void AssetCache::PayloadWriter::writeU32(uint32_t value)
+{
+	for (int i = 0; i < 4; i++)
+	{
+		this->bytes.emplace_back(static_cast<uint8_t>((value >> (i * 8)) & 0xFF));
+	}
+}
+
+void AssetCache::PayloadWriter::writeBytes(BufferView<const uint8_t> values)
+{
+	this->bytes.insert(this->bytes.end(), values.begin(), values.end());
+}
+
+BufferView<const uint8_t> AssetCache::PayloadWriter::getPayload() const
+{
+	return BufferView<const uint8_t>(this->bytes.data(), static_cast<int>(this->bytes.size()));
+}
+
+AssetCache::PayloadReader::PayloadReader(BufferView<const uint8_t> payload)
+	: payload(payload)
+{
+	this->offset = 0;
+}
+
+bool AssetCache::PayloadReader::readU32(uint32_t *outValue)
+{
+	if ((this->offset + 4) > this->payload.getCount())
+	{
+		return false;
+	}
+
+	*outValue = Bytes::getLE32(this->payload.begin() + this->offset);
+	this->offset += 4;
+	return true;
+}
+
+bool AssetCache::PayloadReader::readBytes(BufferView<uint8_t> outValues)
+{
+	if ((this->offset + outValues.getCount()) > this->payload.getCount())
+	{
+		return false;
+	}
+
+	const uint8_t *ptr = this->payload.begin() + this->offset;
+	std::copy(ptr, ptr + outValues.getCount(), outValues.begin());
+	this->offset += outValues.getCount();
+	return true;
+}
+
+int AssetCache::PayloadReader::getRemainingCount() const
+{
+	return this->payload.getCount() - this->offset;
+}
+
+bool AssetCache::PayloadReader::isFinished() const
+{
+	return this->offset == this->payload.getCount();
+}
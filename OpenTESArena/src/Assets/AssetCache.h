@@ -0,0 +1,89 @@
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "components/utilities/Buffer.h"
+#include "components/utilities/BufferView.h"
+
+// Optional on-disk cache of decoded Arena assets so expensive decompression (PKLITE, RLE, etc.) only runs once.
+// Each entry is one file with a fixed 64-byte header followed by the raw payload, keyed by a hash of the source
+// file's bytes. Entries are ignored and regenerated when the source data, the cache format, or the loader's
+// payload version changes, or when the payload checksum doesn't match.
+
+namespace AssetCache
+{
+	class PayloadReader;
+	class PayloadWriter;
+
+	// Reads a loader's fields from a cached payload, returning false if it's malformed.
+	using PayloadDecoder = std::function<bool(PayloadReader &reader)>;
+
+	// Writes a loader's fields to a payload.
+	using PayloadEncoder = std::function<void(PayloadWriter &writer)>;
+
+	// Enables the cache in the given folder. The cache is disabled until this is called.
+	void init(const std::string &folderPath);
+
+	// Disables the cache again so every asset is decoded from its source file.
+	void shutdown();
+
+	bool isEnabled();
+
+	// Hashes the original file bytes eight at a time. Any change to the source data invalidates its entry.
+	uint64_t hashSource(BufferView<const std::byte> src);
+
+	// Cache entry for one source file. Loaders try to decode it before decoding the source file, and encode
+	// their output into it afterwards. The payload version is bumped by the loader whenever its decoded output
+	// or payload layout changes.
+	class SourceEntry
+	{
+	private:
+		const char *sourceFilename;
+		uint64_t sourceHash; // Only computed if the cache is enabled.
+		uint32_t payloadVersion;
+	public:
+		SourceEntry(const char *sourceFilename, BufferView<const std::byte> src, uint32_t payloadVersion);
+
+		// Decodes a still-valid cached payload. Fails if the decoder doesn't read the whole payload.
+		bool tryDecode(const PayloadDecoder &decoder) const;
+
+		// Stores a new payload, replacing any existing entry.
+		void encode(const PayloadEncoder &encoder) const;
+	};
+
+	// Little-endian payload serialization.
+	class PayloadWriter
+	{
+	private:
+		std::vector<uint8_t> bytes;
+	public:
+		void writeU32(uint32_t value);
+		void writeBytes(BufferView<const uint8_t> values);
+
+		BufferView<const uint8_t> getPayload() const;
+	};
+
+	class PayloadReader
+	{
+	private:
+		BufferView<const uint8_t> payload;
+		int offset;
+	public:
+		PayloadReader(BufferView<const uint8_t> payload);
+
+		bool readU32(uint32_t *outValue);
+		bool readBytes(BufferView<uint8_t> outValues);
+
+		int getRemainingCount() const;
+
+		// Whether every byte of the payload has been read.
+		bool isFinished() const;
+	};
+}
+
+#endif
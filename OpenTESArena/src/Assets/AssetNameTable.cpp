@@ -0,0 +1,83 @@
+#include <cctype>
+#include <mutex>
+
+#include "AssetNameTable.h"
+
+#include "components/debug/Debug.h"
+
+namespace
+{
+	char FoldCase(char c)
+	{
+		return static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+	}
+}
+
+size_t AssetNameTable::NameHash::operator()(std::string_view name) const
+{
+	// FNV-1a over the case-folded characters.
+	size_t hash = static_cast<size_t>(14695981039346656037ULL);
+	for (const char c : name)
+	{
+		hash ^= static_cast<unsigned char>(FoldCase(c));
+		hash *= static_cast<size_t>(1099511628211ULL);
+	}
+
+	return hash;
+}
+
+bool AssetNameTable::NameEqual::operator()(std::string_view a, std::string_view b) const
+{
+	if (a.size() != b.size())
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < a.size(); i++)
+	{
+		if (FoldCase(a[i]) != FoldCase(b[i]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+AssetNameTable::AssetNameTable()
+{
+	const AssetNameID emptyID = this->intern(std::string_view());
+	DebugAssert(emptyID == AssetNameTable::EMPTY_ID);
+}
+
+AssetNameID AssetNameTable::intern(std::string_view name)
+{
+	{
+		std::shared_lock<std::shared_mutex> lock(this->mutex);
+		const auto iter = this->ids.find(name);
+		if (iter != this->ids.end())
+		{
+			return iter->second;
+		}
+	}
+
+	std::unique_lock<std::shared_mutex> lock(this->mutex);
+	const auto iter = this->ids.find(name);
+	if (iter != this->ids.end())
+	{
+		// Another thread added it between locks.
+		return iter->second;
+	}
+
+	const AssetNameID id = static_cast<AssetNameID>(this->names.size());
+	this->names.emplace_back(name);
+	this->ids.emplace(std::string(name), id);
+	return id;
+}
+
+const std::string &AssetNameTable::getName(AssetNameID id) const
+{
+	std::shared_lock<std::shared_mutex> lock(this->mutex);
+	DebugAssertIndex(this->names, id);
+	return this->names[id];
+}
@@ -0,0 +1,51 @@
+#ifndef ASSET_NAME_TABLE_H
+#define ASSET_NAME_TABLE_H
+
+#include <cstddef>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "components/utilities/Singleton.h"
+
+// Handle to an interned asset name. Names that only differ by case get the same ID for the lifetime of
+// the program, so asset look-ups can compare and hash integers instead of strings.
+using AssetNameID = int;
+
+class AssetNameTable : public Singleton<AssetNameTable>
+{
+private:
+	// Case-insensitive hashing and comparison so look-ups don't have to build a case-folded copy.
+	struct NameHash
+	{
+		using is_transparent = void;
+
+		size_t operator()(std::string_view name) const;
+	};
+
+	struct NameEqual
+	{
+		using is_transparent = void;
+
+		bool operator()(std::string_view a, std::string_view b) const;
+	};
+
+	std::unordered_map<std::string, AssetNameID, NameHash, NameEqual> ids;
+	std::deque<std::string> names; // Spelling from when each name was first interned. Deque so references stay valid.
+	mutable std::shared_mutex mutex;
+public:
+	static constexpr AssetNameID EMPTY_ID = 0;
+
+	AssetNameTable();
+
+	// Gets the ID of the given name, adding it if it's new. Case-insensitive to match the VFS. Existing names
+	// only take a shared lock, but hot paths should still intern once and keep the ID.
+	AssetNameID intern(std::string_view name);
+
+	// Gets the name as it was first interned, suitable for opening files.
+	const std::string &getName(AssetNameID id) const;
+};
+
+#endif
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 
+#include "AssetCache.h"
 #include "CFAFile.h"
 #include "Compression.h"
 
@@ -10,6 +11,51 @@
 #include "components/utilities/Bytes.h"
 #include "components/vfs/manager.hpp"
 
+namespace
+{
+	constexpr uint32_t CfaCachePayloadVersion = 1;
+}
+
+bool CFAFile::tryDecodeCache(AssetCache::PayloadReader &reader)
+{
+	uint32_t width, height, xOffset, yOffset, imageCount;
+	if (!reader.readU32(&width) || !reader.readU32(&height) || !reader.readU32(&xOffset) ||
+		!reader.readU32(&yOffset) || !reader.readU32(&imageCount))
+	{
+		return false;
+	}
+
+	Buffer<Buffer2D<uint8_t>> images(static_cast<int>(imageCount));
+	for (Buffer2D<uint8_t> &image : images)
+	{
+		image.init(width, height);
+		if (!reader.readBytes(BufferView<uint8_t>(image.begin(), width * height)))
+		{
+			return false;
+		}
+	}
+
+	this->images = std::move(images);
+	this->width = width;
+	this->height = height;
+	this->xOffset = xOffset;
+	this->yOffset = yOffset;
+	return true;
+}
+
+void CFAFile::encodeCache(AssetCache::PayloadWriter &writer) const
+{
+	writer.writeU32(this->width);
+	writer.writeU32(this->height);
+	writer.writeU32(this->xOffset);
+	writer.writeU32(this->yOffset);
+	writer.writeU32(this->images.getCount());
+	for (const Buffer2D<uint8_t> &image : this->images)
+	{
+		writer.writeBytes(BufferView<const uint8_t>(image.begin(), image.getWidth() * image.getHeight()));
+	}
+}
+
 bool CFAFile::init(const char *filename)
 {
 	Buffer<std::byte> src;
@@ -19,6 +65,12 @@ bool CFAFile::init(const char *filename)
 		return false;
 	}
 
+	const AssetCache::SourceEntry cacheEntry(filename, src, CfaCachePayloadVersion);
+	if (cacheEntry.tryDecode([this](AssetCache::PayloadReader &reader) { return this->tryDecodeCache(reader); }))
+	{
+		return true;
+	}
+
 	const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.begin());
 
 	// Read CFA header. Fortunately, all CFAs have headers, unlike IMGs and CIFs.
@@ -147,6 +199,7 @@ bool CFAFile::init(const char *filename)
 	this->height = height;
 	this->xOffset = xOffset;
 	this->yOffset = yOffset;
+	cacheEntry.encode([this](AssetCache::PayloadWriter &writer) { this->encodeCache(writer); });
 	return true;
 }
 
@@ -3,6 +3,8 @@
 
 #include <cstdint>
 
+#include "AssetCache.h"
+
 #include "components/utilities/Buffer.h"
 #include "components/utilities/Buffer2D.h"
 
@@ -24,6 +26,10 @@ private:
 	static void demux5(const uint8_t *src, uint8_t *dst);
 	static void demux6(const uint8_t *src, uint8_t *dst);
 	static void demux7(const uint8_t *src, uint8_t *dst);
+
+	// Decoded frames are cached between runs.
+	bool tryDecodeCache(AssetCache::PayloadReader &reader);
+	void encodeCache(AssetCache::PayloadWriter &writer) const;
 public:
 	bool init(const char *filename);
 
@@ -2,6 +2,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "AssetCache.h"
 #include "CIFFile.h"
 #include "Compression.h"
 
@@ -12,6 +13,8 @@
 
 namespace
 {
+	constexpr uint32_t CifCachePayloadVersion = 1;
+
 	// These CIF files are headerless with a hardcoded frame count and pair
 	// of dimensions (they seem to all be tile-based).
 	const std::unordered_map<std::string, std::pair<int, Int2>> RawCifOverride =
@@ -25,6 +28,53 @@ namespace
 	};
 }
 
+bool CIFFile::tryDecodeCache(AssetCache::PayloadReader &reader)
+{
+	uint32_t imageCount;
+	if (!reader.readU32(&imageCount))
+	{
+		return false;
+	}
+
+	std::vector<Buffer2D<uint8_t>> images;
+	std::vector<Int2> offsets;
+	for (uint32_t i = 0; i < imageCount; i++)
+	{
+		uint32_t xOffset, yOffset, width, height;
+		if (!reader.readU32(&xOffset) || !reader.readU32(&yOffset) || !reader.readU32(&width) || !reader.readU32(&height))
+		{
+			return false;
+		}
+
+		Buffer2D<uint8_t> &image = images.emplace_back(Buffer2D<uint8_t>(width, height));
+		if (!reader.readBytes(BufferView<uint8_t>(image.begin(), width * height)))
+		{
+			return false;
+		}
+
+		offsets.emplace_back(Int2(xOffset, yOffset));
+	}
+
+	this->images = std::move(images);
+	this->offsets = std::move(offsets);
+	return true;
+}
+
+void CIFFile::encodeCache(AssetCache::PayloadWriter &writer) const
+{
+	writer.writeU32(static_cast<uint32_t>(this->images.size()));
+	for (size_t i = 0; i < this->images.size(); i++)
+	{
+		const Buffer2D<uint8_t> &image = this->images[i];
+		const Int2 &offset = this->offsets[i];
+		writer.writeU32(offset.x);
+		writer.writeU32(offset.y);
+		writer.writeU32(image.getWidth());
+		writer.writeU32(image.getHeight());
+		writer.writeBytes(BufferView<const uint8_t>(image.begin(), image.getWidth() * image.getHeight()));
+	}
+}
+
 bool CIFFile::init(const char *filename)
 {
 	// Some filenames (i.e., Arrows.cif) have different casing between the floppy version and
@@ -37,6 +87,12 @@ bool CIFFile::init(const char *filename)
 		return false;
 	}
 
+	const AssetCache::SourceEntry cacheEntry(filename, src, CifCachePayloadVersion);
+	if (cacheEntry.tryDecode([this](AssetCache::PayloadReader &reader) { return this->tryDecodeCache(reader); }))
+	{
+		return true;
+	}
+
 	const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.begin());
 	const uint8_t *srcEnd = reinterpret_cast<const uint8_t*>(src.end());
 
@@ -206,6 +262,7 @@ bool CIFFile::init(const char *filename)
 		return false;
 	}
 
+	cacheEntry.encode([this](AssetCache::PayloadWriter &writer) { this->encodeCache(writer); });
 	return true;
 }
 
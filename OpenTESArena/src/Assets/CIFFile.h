@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <vector>
 
+#include "AssetCache.h"
 #include "../Math/Vector2.h"
 
 #include "components/utilities/Buffer2D.h"
@@ -17,6 +18,10 @@ class CIFFile
 private:
 	std::vector<Buffer2D<uint8_t>> images;
 	std::vector<Int2> offsets;
+
+	// Decoded frames are cached between runs.
+	bool tryDecodeCache(AssetCache::PayloadReader &reader);
+	void encodeCache(AssetCache::PayloadWriter &writer) const;
 public:
 	bool init(const char *filename);
 
@@ -1,88 +1,566 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <vector>
+
 #include "Compression.h"
+#include "CompressionReference.h"
 
 #include "components/debug/Debug.h"
 #include "components/utilities/Bytes.h"
 
+namespace
+{
+	// The LZ history of types 4 and 8 is a 4 KiB ring buffer filled with spaces, where each written byte is also
+	// output, so a back-reference is just a distance into earlier output (or into the initial fill if it reaches
+	// before the start).
+	constexpr int LZHistorySize = 4096;
+	constexpr int LZHistoryMask = LZHistorySize - 1;
+	constexpr uint8_t LZHistoryFill = 0x20;
+
+	void CopyLZBackReference(uint8_t *dstBegin, uint8_t *dst, int distance, int count)
+	{
+		DebugAssert(distance >= 1);
+		DebugAssert(distance <= LZHistorySize);
+
+		const int dstIndex = static_cast<int>(dst - dstBegin);
+		const int fillCount = std::clamp(distance - dstIndex, 0, count);
+		std::fill(dst, dst + fillCount, LZHistoryFill);
+
+		if (distance >= count)
+		{
+			// No overlap between source and destination.
+			std::memcpy(dst + fillCount, dst + fillCount - distance, count - fillCount);
+		}
+		else
+		{
+			// Overlapping runs repeat the last few bytes, so they have to go one at a time.
+			for (int i = fillCount; i < count; i++)
+			{
+				dst[i] = dst[i - distance];
+			}
+		}
+	}
+
+	constexpr int Type04MaxReferenceCount = 18; // 4-bit count + 3.
+
+	// Distance from the current output position back to the given absolute history position.
+	int GetType04Distance(int dstIndex, int historyPos)
+	{
+		return ((dstIndex - historyPos - 1) & LZHistoryMask) + 1;
+	}
+
+	constexpr std::array<uint8_t, 256> Type08HighOffsetBits =
+	{
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+		0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+		0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+		0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+		0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+		0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09, 0x09,
+		0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0A, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B,
+		0x0C, 0x0C, 0x0C, 0x0C, 0x0D, 0x0D, 0x0D, 0x0D, 0x0E, 0x0E, 0x0E, 0x0E, 0x0F, 0x0F, 0x0F, 0x0F,
+		0x10, 0x10, 0x10, 0x10, 0x11, 0x11, 0x11, 0x11, 0x12, 0x12, 0x12, 0x12, 0x13, 0x13, 0x13, 0x13,
+		0x14, 0x14, 0x14, 0x14, 0x15, 0x15, 0x15, 0x15, 0x16, 0x16, 0x16, 0x16, 0x17, 0x17, 0x17, 0x17,
+		0x18, 0x18, 0x19, 0x19, 0x1A, 0x1A, 0x1B, 0x1B, 0x1C, 0x1C, 0x1D, 0x1D, 0x1E, 0x1E, 0x1F, 0x1F,
+		0x20, 0x20, 0x21, 0x21, 0x22, 0x22, 0x23, 0x23, 0x24, 0x24, 0x25, 0x25, 0x26, 0x26, 0x27, 0x27,
+		0x28, 0x28, 0x29, 0x29, 0x2A, 0x2A, 0x2B, 0x2B, 0x2C, 0x2C, 0x2D, 0x2D, 0x2E, 0x2E, 0x2F, 0x2F,
+		0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F
+		
+	};
+
+	constexpr std::array<uint8_t, 256> Type08LowOffsetBitCount =
+	{
+		0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+		0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+		0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+		0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+		0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+		0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+		0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+		0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+		0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05, 0x05,
+		0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+		0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+		0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+		0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+		0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+		0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+		0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08
+		
+	};
+
+	// Adaptive Huffman tree state. Leaves are nodes >= 627 (codeword + 627).
+	constexpr int Type08LeafCount = 314;
+	constexpr int Type08NodeCount = (Type08LeafCount * 2) - 1;
+	constexpr int Type08RootIndex = Type08NodeCount - 1;
+
+	struct Type08Tree
+	{
+		std::array<uint16_t, Type08NodeCount + Type08LeafCount> nodeIdxMap;
+		std::array<uint16_t, Type08NodeCount> nodeTree;
+		std::array<uint16_t, Type08NodeCount> nodeFreq;
+	};
+
+	// The starting tree is the same for every decode, so it's built once and copied.
+	const Type08Tree &GetType08InitialTree()
+	{
+		static const Type08Tree tree = []()
+		{
+			Type08Tree initialTree;
+			for (int i = 0; i < Type08NodeCount - 1; i++)
+			{
+				initialTree.nodeIdxMap[i] = static_cast<uint16_t>((i >> 1) + Type08LeafCount);
+			}
+
+			initialTree.nodeIdxMap[Type08NodeCount - 1] = 0;
+			for (int i = Type08NodeCount; i < static_cast<int>(initialTree.nodeIdxMap.size()); i++)
+			{
+				initialTree.nodeIdxMap[i] = static_cast<uint16_t>(i - Type08NodeCount);
+			}
+
+			for (int i = 0; i < Type08LeafCount; i++)
+			{
+				initialTree.nodeTree[i] = static_cast<uint16_t>(i + Type08NodeCount);
+				initialTree.nodeFreq[i] = 1;
+			}
+
+			for (int i = Type08LeafCount; i < Type08NodeCount; i++)
+			{
+				const int childIndex = (i - Type08LeafCount) * 2;
+				initialTree.nodeTree[i] = static_cast<uint16_t>(childIndex);
+				initialTree.nodeFreq[i] = initialTree.nodeFreq[childIndex] + initialTree.nodeFreq[childIndex + 1];
+			}
+
+			return initialTree;
+		}();
+
+		return tree;
+	}
+
+	// MSB-first bit reader that pads with zeros past the end of input.
+	class Type08BitReader
+	{
+	private:
+		const uint8_t *src;
+		const uint8_t *srcEnd;
+		uint64_t bits; // Unread bits, left-aligned.
+		int bitCount;
+
+		void refill()
+		{
+			const int byteCount = (64 - this->bitCount) / 8;
+			if ((this->srcEnd - this->src) >= byteCount)
+			{
+				for (int i = 0; i < byteCount; i++)
+				{
+					this->bits |= static_cast<uint64_t>(this->src[i]) << (56 - this->bitCount);
+					this->bitCount += 8;
+				}
+
+				this->src += byteCount;
+			}
+			else
+			{
+				for (int i = 0; i < byteCount; i++)
+				{
+					const uint8_t byte = (this->src != this->srcEnd) ? *(this->src++) : 0;
+					this->bits |= static_cast<uint64_t>(byte) << (56 - this->bitCount);
+					this->bitCount += 8;
+				}
+			}
+		}
+	public:
+		Type08BitReader(const uint8_t *src, const uint8_t *srcEnd)
+		{
+			this->src = src;
+			this->srcEnd = srcEnd;
+			this->bits = 0;
+			this->bitCount = 0;
+		}
+
+		int readBit()
+		{
+			if (this->bitCount == 0)
+			{
+				this->refill();
+			}
+
+			const int bit = static_cast<int>(this->bits >> 63);
+			this->bits <<= 1;
+			this->bitCount--;
+			return bit;
+		}
+
+		// Reads up to 16 bits at once.
+		uint32_t readBits(int count)
+		{
+			DebugAssert(count <= 16);
+			if (count == 0)
+			{
+				return 0;
+			}
+
+			if (this->bitCount < count)
+			{
+				this->refill();
+			}
+
+			const uint32_t value = static_cast<uint32_t>(this->bits >> (64 - count));
+			this->bits <<= count;
+			this->bitCount -= count;
+			return value;
+		}
+	};
+
+	std::atomic<bool> VerifyEnabled = false;
+	std::atomic<int> VerifiedDecodeCount = 0;
+	std::atomic<int> VerifyMismatchCount = 0;
+
+	// With verification enabled, snapshots the output before an optimized decode, then runs the reference decoder
+	// on the snapshot and compares the two. Does nothing otherwise.
+	template<typename ReferenceDecoder>
+	class DecodeVerifier
+	{
+	private:
+		const char *decoderName;
+		ReferenceDecoder referenceDecoder;
+		std::vector<uint8_t> referenceOut;
+		bool enabled;
+	public:
+		DecodeVerifier(const char *decoderName, BufferView<uint8_t> out, ReferenceDecoder &&referenceDecoder)
+			: referenceDecoder(std::move(referenceDecoder))
+		{
+			this->decoderName = decoderName;
+			this->enabled = VerifyEnabled.load(std::memory_order_relaxed);
+			if (this->enabled)
+			{
+				this->referenceOut.assign(out.begin(), out.end());
+			}
+		}
+
+		void finish(BufferView<uint8_t> out)
+		{
+			if (!this->enabled)
+			{
+				return;
+			}
+
+			this->referenceDecoder(BufferView<uint8_t>(this->referenceOut.data(), static_cast<int>(this->referenceOut.size())));
+			VerifiedDecodeCount++;
+
+			const auto mismatch = std::mismatch(out.begin(), out.end(), this->referenceOut.begin());
+			if (mismatch.first != out.end())
+			{
+				VerifyMismatchCount++;
+				DebugLogError(std::string(this->decoderName) + " output differs from the reference decoder at byte " +
+					std::to_string(mismatch.first - out.begin()) + " of " + std::to_string(out.getCount()) + ".");
+			}
+		}
+	};
+}
+
 void Compression::decodeRLE(const uint8_t *src, int stopCount, BufferView<uint8_t> dst)
 {
+	DecodeVerifier verifier("RLE", dst, [src, stopCount](BufferView<uint8_t> referenceOut)
+	{
+		CompressionReference::decodeRLE(src, stopCount, referenceOut);
+	});
+
 	// Adapted from WinArena.
-	int i = 0;
+	uint8_t *dstPtr = dst.begin();
 	int o = 0;
 
 	while (o < stopCount)
 	{
-		const uint8_t sample = src[i];
-		src++;
+		const uint8_t sample = *(src++);
 
 		// Is the selected byte part of a compressed packet?
 		if ((sample & 0x80) != 0)
 		{
-			const uint8_t value = src[i];
-			src++;
-
-			const uint32_t count = static_cast<uint32_t>(sample) - 0x7F;
+			const uint8_t value = *(src++);
+			const int count = static_cast<int>(sample) - 0x7F;
 
-			DebugAssert(o >= 0);
-			DebugAssert((o + static_cast<int>(count)) <= dst.getCount());
-			for (uint32_t j = 0; j < count; j++)
-			{
-				dst[o] = value;
-				o++;
-			}
+			DebugAssert((o + count) <= dst.getCount());
+			std::memset(dstPtr + o, value, count);
+			o += count;
 		}
 		else
 		{
-			const uint32_t count = static_cast<uint32_t>(sample) + 1;
+			const int count = static_cast<int>(sample) + 1;
 
-			DebugAssert(o >= 0);
-			DebugAssert((o + static_cast<int>(count)) <= dst.getCount());
-			for (uint32_t j = 0; j < count; j++)
-			{
-				dst[o] = src[i];
-				o++;
-				i++;
-			}
+			DebugAssert((o + count) <= dst.getCount());
+			std::memcpy(dstPtr + o, src, count);
+			src += count;
+			o += count;
 		}
 	}
+
+	verifier.finish(dst);
 }
 
 void Compression::decodeRLEWords(const uint8_t *src, int stopCount, BufferView<uint8_t> out)
 {
-	int i = 0;
+	DecodeVerifier verifier("RLE words", out, [src, stopCount](BufferView<uint8_t> referenceOut)
+	{
+		CompressionReference::decodeRLEWords(src, stopCount, referenceOut);
+	});
+
+	uint8_t *outPtr = out.begin();
 	int o = 0;
 
 	while (o < stopCount)
 	{
-		const int16_t sample = Bytes::getLE16(src + i);
-		i += 2;
+		const int16_t sample = Bytes::getLE16(src);
+		src += 2;
 
 		// If "sample" is positive, then "sample" literal words follow. Otherwise,
 		// repeat the next word "sample" times.
 		if (sample > 0)
 		{
-			for (int16_t j = 0; j < sample; j++)
+			// Output words are little-endian like the input, so literals are a straight copy.
+			const int byteCount = sample * 2;
+			DebugAssert(((o * 2) + byteCount) <= out.getCount());
+			std::memcpy(outPtr + (o * 2), src, byteCount);
+			src += byteCount;
+			o += sample;
+		}
+		else
+		{
+			const uint8_t lowByte = src[0];
+			const uint8_t highByte = src[1];
+			src += 2;
+
+			const uint16_t count = -sample;
+			DebugAssert(((o + count) * 2) <= out.getCount());
+
+			uint8_t *dstPtr = outPtr + (o * 2);
+			for (uint16_t j = 0; j < count; j++)
 			{
-				const uint16_t value = Bytes::getLE16(src + i);
-				i += 2;
+				dstPtr[j * 2] = lowByte;
+				dstPtr[(j * 2) + 1] = highByte;
+			}
+
+			o += count;
+		}
+	}
+
+	verifier.finish(out);
+}
 
-				out[o * 2] = value & 0x00FF;
-				out[(o * 2) + 1] = (value & 0xFF00) >> 8;
-				o++;
+void Compression::decodeType04(const uint8_t *src, const uint8_t *srcEnd, BufferView<uint8_t> out)
+{
+	DecodeVerifier verifier("Type 4", out, [src, srcEnd](BufferView<uint8_t> referenceOut)
+	{
+		CompressionReference::decodeType04(src, srcEnd, referenceOut);
+	});
+
+	uint8_t *dstBegin = out.begin();
+	uint8_t *dstEnd = out.end();
+	uint8_t *dst = dstBegin;
+
+	// This appears to be some form of LZ compression. It starts with a 1-byte-
+	// wide bitmask, where each bit declares if the next pixel comes directly
+	// from the input, or refers back to a previous run of output pixels that
+	// get duplicated. After each bit in the mask is used, another byte is read
+	// for another bitmask and the cycle repeats until the end of input.
+	auto decodeReference = [dstBegin](const uint8_t *src, uint8_t *dst, int maxCount)
+	{
+		const uint8_t byte1 = src[0];
+		const uint8_t byte2 = src[1];
+		const int tocopy = std::min((byte2 & 0x0F) + 3, maxCount);
+		const int copypos = (((byte2 & 0xF0) << 4) | byte1) + 18;
+		const int distance = GetType04Distance(static_cast<int>(dst - dstBegin), copypos);
+		CopyLZBackReference(dstBegin, dst, distance, tocopy);
+		return tocopy;
+	};
+
+	// Whole mask groups whose worst case fits in the remaining input and output don't need any checks.
+	constexpr int maxGroupSrcBytes = 1 + (8 * 2);
+	constexpr int maxGroupDstBytes = 8 * Type04MaxReferenceCount;
+	while (((srcEnd - src) >= maxGroupSrcBytes) && ((dstEnd - dst) >= maxGroupDstBytes))
+	{
+		int mask = *(src++);
+		for (int i = 0; i < 8; i++)
+		{
+			if ((mask & 1))
+			{
+				*(dst++) = *(src++);
+			}
+			else
+			{
+				dst += decodeReference(src, dst, Type04MaxReferenceCount);
+				src += 2;
 			}
+
+			mask >>= 1;
+		}
+	}
+
+	// Remaining tokens are checked individually.
+	int bitcount = 0;
+	int mask = 0;
+	while (src != srcEnd)
+	{
+		if (!bitcount)
+		{
+			bitcount = 8;
+			mask = *(src++);
 		}
 		else
 		{
-			const uint16_t value = Bytes::getLE16(src + i);
-			i += 2;
+			mask >>= 1;
+		}
 
-			const uint16_t count = -sample;
+		if ((mask & 1))
+		{
+			DebugAssertMsg(src != srcEnd, "Unexpected end of image.");
+			DebugAssertMsg(dst != dstEnd, "Decoded image overflow.");
+			if ((src == srcEnd) || (dst == dstEnd))
+			{
+				break;
+			}
 
-			for (uint16_t j = 0; j < count; j++)
+			*(dst++) = *(src++);
+		}
+		else
+		{
+			DebugAssertMsg((srcEnd - src) >= 2, "Unexpected end of image.");
+			if ((srcEnd - src) < 2)
+			{
+				break;
+			}
+
+			const int maxCount = static_cast<int>(dstEnd - dst);
+			DebugAssertMsg(maxCount >= ((src[1] & 0x0F) + 3), "Decoded image overflow.");
+			dst += decodeReference(src, dst, maxCount);
+			src += 2;
+		}
+
+		bitcount--;
+	}
+
+	std::fill(dst, dstEnd, 0);
+
+	verifier.finish(out);
+}
+
+void Compression::decodeType08(const uint8_t *src, const uint8_t *srcEnd, BufferView<uint8_t> out)
+{
+	DecodeVerifier verifier("Type 8", out, [src, srcEnd](BufferView<uint8_t> referenceOut)
+	{
+		CompressionReference::decodeType08(src, srcEnd, referenceOut);
+	});
+
+	Type08Tree tree = GetType08InitialTree();
+	std::array<uint16_t, Type08NodeCount + Type08LeafCount> &NodeIdxMap = tree.nodeIdxMap;
+	std::array<uint16_t, Type08NodeCount> &NodeTree = tree.nodeTree;
+	std::array<uint16_t, Type08NodeCount> &NodeFreq = tree.nodeFreq;
+
+	Type08BitReader bitReader(src, srcEnd);
+
+	// This feels like some form of adaptive Huffman coding, with a form of LZ
+	// compression. DEFLATE?
+	uint8_t *dstBegin = out.begin();
+	uint8_t *dstEnd = out.end();
+	uint8_t *dst = dstBegin;
+	while (dst != dstEnd)
+	{
+		// Starting with the root, append bits from the input while traversing
+		// the tree until a leaf node is found (indicated by being >= 627).
+		uint16_t node = NodeTree[Type08RootIndex];
+		while (node < Type08NodeCount)
+		{
+			node = NodeTree[node + bitReader.readBit()];
+		}
+
+		// Increment the use count (frequency) of this node, and ensure the
+		// tree remains sorted.
+		uint16_t freqidx = NodeIdxMap[node];
+		do {
+			NodeFreq[freqidx] += 1;
+			const uint16_t freq = NodeFreq[freqidx];
+			uint16_t nextidx = freqidx + 1;
+			if (nextidx < NodeFreq.size() && NodeFreq[nextidx] < freq)
 			{
-				out[o * 2] = value & 0x00FF;
-				out[(o * 2) + 1] = (value & 0xFF00) >> 8;
-				o++;
+				// Find the next frequency count that's not greater than the new frequency.
+				do {
+					nextidx++;
+				} while (nextidx < NodeFreq.size() && NodeFreq[nextidx] < freq);
+				nextidx--;
+
+				// Swap 'em, placing the new frequency just before the next
+				// greater one. Since the freq only incremented by 1, this
+				// won't put it out of order.
+				NodeFreq[freqidx] = NodeFreq[nextidx];
+				NodeFreq[nextidx] = freq;
+
+				std::swap(NodeTree[freqidx], NodeTree[nextidx]);
+
+				// Update the index mappings
+				uint16_t mapidx = NodeTree[nextidx];
+				NodeIdxMap[mapidx] = nextidx;
+				if (mapidx < Type08NodeCount)
+				{
+					NodeIdxMap[mapidx + 1] = nextidx;
+				}
+
+				mapidx = NodeTree[freqidx];
+				NodeIdxMap[mapidx] = freqidx;
+				if (mapidx < Type08NodeCount)
+				{
+					NodeIdxMap[mapidx + 1] = freqidx;
+				}
+
+				freqidx = nextidx;
 			}
+			// Recurse up the tree
+			freqidx = NodeIdxMap[freqidx];
+		} while (freqidx != 0);
+
+		// Get the value from the node. If it's less than 256, it's a direct pixel value.
+		const uint16_t codeword = node - Type08NodeCount;
+		if (codeword < 256)
+		{
+			*(dst++) = static_cast<uint8_t>(codeword);
+		}
+		else
+		{
+			// Otherwise, get the next 8 bits from input to construct the
+			// offset to previous pixels to repeat, with the count being
+			// derived from the node's value. The table gives how many more
+			// low offset bits follow, so they're read in one go.
+			const uint32_t tableidx = bitReader.readBits(8);
+			const int offsetHigh = Type08HighOffsetBits[tableidx] << 6;
+			const int bitcount = Type08LowOffsetBitCount[tableidx] - 2;
+			const uint32_t offsetLow = (tableidx << bitcount) | bitReader.readBits(bitcount);
+			const int distance = (offsetHigh | static_cast<int>(offsetLow & 0x003F)) + 1;
+
+			const int tocopy = codeword - 256 + 3;
+			const int copyCount = std::min(tocopy, static_cast<int>(dstEnd - dst));
+			CopyLZBackReference(dstBegin, dst, distance, copyCount);
+			dst += copyCount;
 		}
 	}
+
+	verifier.finish(out);
+}
+
+void Compression::setVerifyEnabled(bool enabled)
+{
+	VerifyEnabled = enabled;
+}
+
+int Compression::getVerifiedDecodeCount()
+{
+	return VerifiedDecodeCount;
+}
+
+int Compression::getVerifyMismatchCount()
+{
+	return VerifyMismatchCount;
 }
@@ -0,0 +1,20 @@
+#ifndef COMPRESSION_REFERENCE_H
+#define COMPRESSION_REFERENCE_H
+
+#include <cstdint>
+
+#include "components/utilities/BufferView.h"
+
+// The original, straightforward Arena decompressors. The optimized ones in Compression are checked against
+// these with OpenTESArenaBench --verify-decoders (game data) and --fuzz-decoders (generated streams), so they
+// should stay simple rather than fast.
+
+namespace CompressionReference
+{
+	void decodeRLE(const uint8_t *src, int stopCount, BufferView<uint8_t> dst);
+	void decodeRLEWords(const uint8_t *src, int stopCount, BufferView<uint8_t> out);
+	void decodeType04(const uint8_t *src, const uint8_t *srcend, BufferView<uint8_t> out);
+	void decodeType08(const uint8_t *src, const uint8_t *srcend, BufferView<uint8_t> out);
+}
+
+#endif
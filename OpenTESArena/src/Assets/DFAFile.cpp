@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <string>
 
+#include "AssetCache.h"
 #include "Compression.h"
 #include "DFAFile.h"
 
@@ -9,6 +10,46 @@
 #include "components/utilities/BufferView.h"
 #include "components/vfs/manager.hpp"
 
+namespace
+{
+	constexpr uint32_t DfaCachePayloadVersion = 1;
+}
+
+bool DFAFile::tryDecodeCache(AssetCache::PayloadReader &reader)
+{
+	uint32_t width, height, imageCount;
+	if (!reader.readU32(&width) || !reader.readU32(&height) || !reader.readU32(&imageCount))
+	{
+		return false;
+	}
+
+	Buffer<Buffer2D<uint8_t>> images(static_cast<int>(imageCount));
+	for (Buffer2D<uint8_t> &image : images)
+	{
+		image.init(width, height);
+		if (!reader.readBytes(BufferView<uint8_t>(image.begin(), width * height)))
+		{
+			return false;
+		}
+	}
+
+	this->images = std::move(images);
+	this->width = width;
+	this->height = height;
+	return true;
+}
+
+void DFAFile::encodeCache(AssetCache::PayloadWriter &writer) const
+{
+	writer.writeU32(this->width);
+	writer.writeU32(this->height);
+	writer.writeU32(this->images.getCount());
+	for (const Buffer2D<uint8_t> &image : this->images)
+	{
+		writer.writeBytes(BufferView<const uint8_t>(image.begin(), image.getWidth() * image.getHeight()));
+	}
+}
+
 bool DFAFile::init(const char *filename)
 {
 	Buffer<std::byte> src;
@@ -18,6 +59,12 @@ bool DFAFile::init(const char *filename)
 		return false;
 	}
 
+	const AssetCache::SourceEntry cacheEntry(filename, src, DfaCachePayloadVersion);
+	if (cacheEntry.tryDecode([this](AssetCache::PayloadReader &reader) { return this->tryDecodeCache(reader); }))
+	{
+		return true;
+	}
+
 	const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.begin());
 
 	// Read DFA header data.
@@ -84,6 +131,7 @@ bool DFAFile::init(const char *filename)
 
 	this->width = width;
 	this->height = height;
+	cacheEntry.encode([this](AssetCache::PayloadWriter &writer) { this->encodeCache(writer); });
 	return true;
 }
 
@@ -3,6 +3,8 @@
 
 #include <cstdint>
 
+#include "AssetCache.h"
+
 #include "components/utilities/Buffer.h"
 #include "components/utilities/Buffer2D.h"
 
@@ -14,6 +16,10 @@ class DFAFile
 private:
 	Buffer<Buffer2D<uint8_t>> images;
 	int width, height;
+
+	// Decoded frames are cached between runs.
+	bool tryDecodeCache(AssetCache::PayloadReader &reader);
+	void encodeCache(AssetCache::PayloadWriter &writer) const;
 public:
 	bool init(const char *filename);
 
@@ -3,6 +3,7 @@
 #include <memory>
 #include <string>
 
+#include "AssetCache.h"
 #include "ExeUnpacker.h"
 
 #include "components/debug/Debug.h"
@@ -12,6 +13,8 @@
 
 namespace
 {
+	constexpr uint32_t ExeCachePayloadVersion = 1;
+
 	// Performance optimization for bit reading (replaces the unnecessary heap 
 	// allocation of std::vector<bool>). Use BitVector::bitsUsed instead of 
 	// BitVector::bits.size().
@@ -205,6 +208,23 @@ namespace
 	};
 }
 
+bool ExeUnpacker::tryDecodeCache(AssetCache::PayloadReader &reader)
+{
+	Buffer<uint8_t> exeData(reader.getRemainingCount());
+	if (!reader.readBytes(exeData))
+	{
+		return false;
+	}
+
+	this->exeData = std::move(exeData);
+	return true;
+}
+
+void ExeUnpacker::encodeCache(AssetCache::PayloadWriter &writer) const
+{
+	writer.writeBytes(this->exeData);
+}
+
 bool ExeUnpacker::init(const char *filename)
 {
 	Buffer<std::byte> src;
@@ -214,6 +234,12 @@ bool ExeUnpacker::init(const char *filename)
 		return false;
 	}
 
+	const AssetCache::SourceEntry cacheEntry(filename, src, ExeCachePayloadVersion);
+	if (cacheEntry.tryDecode([this](AssetCache::PayloadReader &reader) { return this->tryDecodeCache(reader); }))
+	{
+		return true;
+	}
+
 	const uint8_t *srcPtr = reinterpret_cast<const uint8_t*>(src.begin());
 
 	// Generate the bit trees for "duplication mode". Since the Duplication1 table has 
@@ -439,6 +465,7 @@ bool ExeUnpacker::init(const char *filename)
 		}
 	}
 
+	cacheEntry.encode([this](AssetCache::PayloadWriter &writer) { this->encodeCache(writer); });
 	return true;
 }
 
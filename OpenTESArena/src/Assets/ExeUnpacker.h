@@ -3,6 +3,8 @@
 
 #include <cstdint>
 
+#include "AssetCache.h"
+
 #include "components/utilities/Buffer.h"
 #include "components/utilities/BufferView.h"
 
@@ -12,6 +14,10 @@ class ExeUnpacker
 {
 private:
 	Buffer<uint8_t> exeData;
+
+	// Decompression is slow enough to be worth caching between runs.
+	bool tryDecodeCache(AssetCache::PayloadReader &reader);
+	void encodeCache(AssetCache::PayloadWriter &writer) const;
 public:
 	// Reads in a compressed EXE file and decompresses it.
 	bool init(const char *filename);
@@ -1,19 +1,23 @@
 #include "TextureAsset.h"
 
 TextureAsset::TextureAsset(std::string &&filename, const std::optional<int> &index)
-	: filename(std::move(filename)), index(index) { }
+	: filename(std::move(filename)), index(index)
+{
+	this->filenameID = AssetNameTable::getInstance().intern(this->filename);
+}
 
 TextureAsset::TextureAsset(std::string &&filename)
-	: filename(std::move(filename)), index(std::nullopt) { }
+	: TextureAsset(std::move(filename), std::nullopt) { }
 
-TextureAsset::TextureAsset() { }
+TextureAsset::TextureAsset()
+	: filenameID(AssetNameTable::EMPTY_ID) { }
 
 bool TextureAsset::operator==(const TextureAsset &other) const
 {
-	return (this->filename == other.filename) && (this->index == other.index);
+	return (this->filenameID == other.filenameID) && (this->index == other.index);
 }
 
 bool TextureAsset::operator!=(const TextureAsset &other) const
 {
-	return (this->filename != other.filename) || (this->index != other.index);
+	return (this->filenameID != other.filenameID) || (this->index != other.index);
 }
@@ -4,12 +4,15 @@
 #include <optional>
 #include <string>
 
+#include "AssetNameTable.h"
+
 // General-purpose reference for a single texture. The index is set if the filename points to a
 // sequence of individual textures.
 
 struct TextureAsset
 {
 	std::string filename;
+	AssetNameID filenameID; // Interned filename for comparisons and look-ups.
 	std::optional<int> index; // Points into sequential texture file.
 
 	TextureAsset(std::string &&filename, const std::optional<int> &index);
@@ -20,4 +23,21 @@ struct TextureAsset
 	bool operator!=(const TextureAsset &other) const;
 };
 
+// Hash definition for unordered_map<TextureAsset, ...>.
+namespace std
+{
+	template <>
+	struct hash<TextureAsset>
+	{
+		size_t operator()(const TextureAsset &textureAsset) const
+		{
+			const size_t filenameHash = static_cast<size_t>(textureAsset.filenameID);
+			const size_t indexHash = static_cast<size_t>(textureAsset.index.value_or(-1));
+
+			// Multiply with a prime number before xor'ing.
+			return filenameHash ^ (indexHash * 41);
+		}
+	};
+}
+
 #endif
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "SDL.h"
 
 #include "TextureManager.h"
@@ -28,6 +30,47 @@ namespace
 	constexpr const char *EXTENSION_BMP = "BMP";
 }
 
+TextureManager::ResidencyStats::ResidencyStats()
+{
+	this->residentByteCount = 0;
+	this->hitCount = 0;
+	this->missCount = 0;
+	this->evictionCount = 0;
+}
+
+double TextureManager::ResidencyStats::getHitPercent() const
+{
+	const int64_t requestCount = this->hitCount + this->missCount;
+	if (requestCount == 0)
+	{
+		return 100.0;
+	}
+
+	return (static_cast<double>(this->hitCount) / static_cast<double>(requestCount)) * 100.0;
+}
+
+TextureManager::TextureBuilderFileEntry::TextureBuilderFileEntry()
+{
+	this->filenameID = AssetNameTable::EMPTY_ID;
+	this->byteCount = 0;
+	this->lastUsedFrame = -1;
+	this->resident = false;
+}
+
+void TextureManager::TextureBuilderFileEntry::init(AssetNameID filenameID, const TextureBuilderIdGroup &ids, int64_t byteCount, int64_t lastUsedFrame)
+{
+	this->filenameID = filenameID;
+	this->ids = ids;
+	this->byteCount = byteCount;
+	this->lastUsedFrame = lastUsedFrame;
+	this->resident = true;
+}
+
+TextureManager::TextureManager()
+{
+	this->currentFrame = 0;
+}
+
 bool TextureManager::matchesExtension(const char *filename, const char *extension)
 {
 	return StringView::caseInsensitiveEquals(StringView::getExtension(filename), extension);
@@ -419,13 +462,25 @@ std::optional<PaletteIdGroup> TextureManager::tryGetPaletteIDs(const char *filen
 		return std::nullopt;
 	}
 
-	std::string paletteName(filename);
-	auto iter = this->paletteIDs.find(paletteName);
+	const AssetNameID filenameID = AssetNameTable::getInstance().intern(filename);
+	return this->tryGetPaletteIDs(filenameID);
+}
+
+std::optional<PaletteIdGroup> TextureManager::tryGetPaletteIDs(AssetNameID filenameID)
+{
+	if (filenameID == AssetNameTable::EMPTY_ID)
+	{
+		DebugLogWarning("Missing palette filename.");
+		return std::nullopt;
+	}
+
+	auto iter = this->paletteIDs.find(filenameID);
 	if (iter == this->paletteIDs.end())
 	{
 		// Load palette(s) from file.
+		const std::string &paletteName = AssetNameTable::getInstance().getName(filenameID);
 		Buffer<Palette> palettes;
-		if (TextureManager::tryLoadPalettes(filename, &palettes))
+		if (TextureManager::tryLoadPalettes(paletteName.c_str(), &palettes))
 		{
 			const PaletteID id = static_cast<PaletteID>(this->palettes.size());
 			PaletteIdGroup ids(id, 1);
@@ -435,7 +490,7 @@ std::optional<PaletteIdGroup> TextureManager::tryGetPaletteIDs(const char *filen
 				this->palettes.emplace_back(std::move(palette));
 			}
 
-			iter = this->paletteIDs.emplace(std::move(paletteName), std::move(ids)).first;
+			iter = this->paletteIDs.emplace(filenameID, std::move(ids)).first;
 		}
 		else
 		{
@@ -462,7 +517,7 @@ std::optional<PaletteID> TextureManager::tryGetPaletteID(const char *filename)
 
 std::optional<PaletteID> TextureManager::tryGetPaletteID(const TextureAsset &textureAsset)
 {
-	const std::optional<PaletteIdGroup> ids = this->tryGetPaletteIDs(textureAsset.filename.c_str());
+	const std::optional<PaletteIdGroup> ids = this->tryGetPaletteIDs(textureAsset.filenameID);
 	if (ids.has_value())
 	{
 		const int index = textureAsset.index.has_value() ? *textureAsset.index : 0;
@@ -482,29 +537,83 @@ std::optional<TextureBuilderIdGroup> TextureManager::tryGetTextureBuilderIDs(con
 		return std::nullopt;
 	}
 
-	std::string filenameStr(filename);
-	auto iter = this->textureBuilderIDs.find(filenameStr);
-	if (iter == this->textureBuilderIDs.end())
+	const AssetNameID filenameID = AssetNameTable::getInstance().intern(filename);
+	return this->tryGetTextureBuilderIDs(filenameID);
+}
+
+std::optional<TextureBuilderIdGroup> TextureManager::tryGetTextureBuilderIDs(AssetNameID filenameID)
+{
+	if (filenameID == AssetNameTable::EMPTY_ID)
 	{
-		Buffer<TextureBuilder> textureBuilders;
-		if (!TextureManager::tryLoadTextureData(filename, &textureBuilders, nullptr))
+		DebugLogWarning("Missing texture builder filename.");
+		return std::nullopt;
+	}
+
+	auto iter = this->textureBuilderEntryIndices.find(filenameID);
+	if (iter != this->textureBuilderEntryIndices.end())
+	{
+		TextureBuilderFileEntry &entry = this->textureBuilderEntries[iter->second];
+		if (entry.resident)
 		{
-			DebugLogWarning("Couldn't load texture builders from \"" + filenameStr + "\".");
-			return std::nullopt;
+			entry.lastUsedFrame = this->currentFrame;
+			this->residencyStats.hitCount++;
+			return entry.ids;
 		}
+	}
+
+	this->residencyStats.missCount++;
+
+	const std::string &filename = AssetNameTable::getInstance().getName(filenameID);
+	Buffer<TextureBuilder> textureBuilders;
+	if (!TextureManager::tryLoadTextureData(filename.c_str(), &textureBuilders, nullptr))
+	{
+		DebugLogWarning("Couldn't load texture builders from \"" + filename + "\".");
+		return std::nullopt;
+	}
 
+	int64_t byteCount = 0;
+	for (const TextureBuilder &textureBuilder : textureBuilders)
+	{
+		byteCount += static_cast<int64_t>(textureBuilder.getWidth()) * textureBuilder.getHeight() * textureBuilder.getBytesPerTexel();
+	}
+
+	int entryIndex = -1;
+	if (iter != this->textureBuilderEntryIndices.end())
+	{
+		entryIndex = iter->second;
+	}
+	else
+	{
+		entryIndex = static_cast<int>(this->textureBuilderEntries.size());
+		this->textureBuilderEntries.emplace_back(TextureBuilderFileEntry());
+		this->textureBuilderEntryIndices.emplace(filenameID, entryIndex);
+	}
+
+	TextureBuilderFileEntry &entry = this->textureBuilderEntries[entryIndex];
+	TextureBuilderIdGroup ids = entry.ids;
+	if (ids.getCount() == textureBuilders.getCount())
+	{
+		// Reloading an evicted file into its reserved IDs.
+		for (int i = 0; i < textureBuilders.getCount(); i++)
+		{
+			this->textureBuilders[ids.getID(i)] = std::move(textureBuilders.get(i));
+		}
+	}
+	else
+	{
 		const TextureBuilderID startID = static_cast<TextureBuilderID>(this->textureBuilders.size());
-		TextureBuilderIdGroup ids(startID, textureBuilders.getCount());
+		ids = TextureBuilderIdGroup(startID, textureBuilders.getCount());
 
 		for (TextureBuilder &textureBuilder : textureBuilders)
 		{
 			this->textureBuilders.emplace_back(std::move(textureBuilder));
+			this->textureBuilderEntryIndicesByID.emplace_back(entryIndex);
 		}
-
-		iter = this->textureBuilderIDs.emplace(std::move(filenameStr), std::move(ids)).first;
 	}
 
-	return iter->second;
+	entry.init(filenameID, ids, byteCount, this->currentFrame);
+	this->residencyStats.residentByteCount += byteCount;
+	return ids;
 }
 
 std::optional<TextureBuilderID> TextureManager::tryGetTextureBuilderID(const char *filename)
@@ -522,7 +631,7 @@ std::optional<TextureBuilderID> TextureManager::tryGetTextureBuilderID(const cha
 
 std::optional<PaletteID> TextureManager::tryGetTextureBuilderID(const TextureAsset &textureAsset)
 {
-	const std::optional<TextureBuilderIdGroup> ids = this->tryGetTextureBuilderIDs(textureAsset.filename.c_str());
+	const std::optional<TextureBuilderIdGroup> ids = this->tryGetTextureBuilderIDs(textureAsset.filenameID);
 	if (ids.has_value())
 	{
 		const int index = textureAsset.index.has_value() ? *textureAsset.index : 0;
@@ -542,10 +651,11 @@ std::optional<TextureFileMetadataID> TextureManager::tryGetMetadataID(const char
 		return std::nullopt;
 	}
 
-	std::string filenameStr(filename);
-	auto iter = this->metadataIndices.find(filenameStr);
+	const AssetNameID filenameID = AssetNameTable::getInstance().intern(filename);
+	auto iter = this->metadataIndices.find(filenameID);
 	if (iter == this->metadataIndices.end())
 	{
+		const std::string filenameStr(filename);
 		TextureFileMetadata metadata;
 		if (!TextureManager::tryLoadTextureData(filename, nullptr, &metadata))
 		{
@@ -556,7 +666,7 @@ std::optional<TextureFileMetadataID> TextureManager::tryGetMetadataID(const char
 		const TextureFileMetadataID id = static_cast<TextureFileMetadataID>(this->metadatas.size());
 		this->metadatas.emplace_back(std::move(metadata));
 
-		iter = this->metadataIndices.emplace(std::move(filenameStr), id).first;
+		iter = this->metadataIndices.emplace(filenameID, id).first;
 	}
 
 	return static_cast<TextureFileMetadataID>(iter->second);
@@ -571,11 +681,102 @@ const Palette &TextureManager::getPaletteHandle(PaletteID id) const
 const TextureBuilder &TextureManager::getTextureBuilderHandle(TextureBuilderID id) const
 {
 	DebugAssertIndex(this->textureBuilders, id);
+	DebugAssertIndex(this->textureBuilderEntryIndicesByID, id);
+	const TextureBuilderFileEntry &entry = this->textureBuilderEntries[this->textureBuilderEntryIndicesByID[id]];
+	DebugAssertMsg(entry.resident, "Texture builder " + std::to_string(id) + " is evicted, use getOrReloadTextureBuilder().");
+	return this->textureBuilders[id];
+}
+
+const TextureBuilder &TextureManager::getOrReloadTextureBuilder(TextureBuilderID id)
+{
+	DebugAssertIndex(this->textureBuilders, id);
+	DebugAssertIndex(this->textureBuilderEntryIndicesByID, id);
+	TextureBuilderFileEntry &entry = this->textureBuilderEntries[this->textureBuilderEntryIndicesByID[id]];
+	if (!entry.resident)
+	{
+		this->reloadTextureBuilderEntry(entry);
+	}
+
+	entry.lastUsedFrame = this->currentFrame;
 	return this->textureBuilders[id];
 }
 
+void TextureManager::reloadTextureBuilderEntry(TextureBuilderFileEntry &entry)
+{
+	DebugAssert(!entry.resident);
+	this->residencyStats.missCount++;
+
+	const std::string &filename = AssetNameTable::getInstance().getName(entry.filenameID);
+	Buffer<TextureBuilder> textureBuilders;
+	if (!TextureManager::tryLoadTextureData(filename.c_str(), &textureBuilders, nullptr))
+	{
+		DebugCrash("Couldn't reload evicted texture builders from \"" + filename + "\".");
+	}
+
+	if (textureBuilders.getCount() != entry.ids.getCount())
+	{
+		DebugCrash("Reloaded texture builder count " + std::to_string(textureBuilders.getCount()) + " doesn't match " +
+			std::to_string(entry.ids.getCount()) + " in \"" + filename + "\".");
+	}
+
+	for (int i = 0; i < textureBuilders.getCount(); i++)
+	{
+		this->textureBuilders[entry.ids.getID(i)] = std::move(textureBuilders.get(i));
+	}
+
+	entry.resident = true;
+	this->residencyStats.residentByteCount += entry.byteCount;
+}
+
 const TextureFileMetadata &TextureManager::getMetadataHandle(TextureFileMetadataID id) const
 {
 	DebugAssertIndex(this->metadatas, id);
 	return this->metadatas[id];
 }
+
+const TextureManager::ResidencyStats &TextureManager::getResidencyStats() const
+{
+	return this->residencyStats;
+}
+
+void TextureManager::updateResidency(int64_t byteBudget)
+{
+	if ((byteBudget > 0) && (this->residencyStats.residentByteCount > byteBudget))
+	{
+		std::vector<int> evictableEntryIndices;
+		for (int i = 0; i < static_cast<int>(this->textureBuilderEntries.size()); i++)
+		{
+			const TextureBuilderFileEntry &entry = this->textureBuilderEntries[i];
+			if (entry.resident && (entry.lastUsedFrame < this->currentFrame))
+			{
+				evictableEntryIndices.emplace_back(i);
+			}
+		}
+
+		std::sort(evictableEntryIndices.begin(), evictableEntryIndices.end(),
+			[this](int a, int b)
+		{
+			return this->textureBuilderEntries[a].lastUsedFrame < this->textureBuilderEntries[b].lastUsedFrame;
+		});
+
+		for (const int entryIndex : evictableEntryIndices)
+		{
+			if (this->residencyStats.residentByteCount <= byteBudget)
+			{
+				break;
+			}
+
+			TextureBuilderFileEntry &entry = this->textureBuilderEntries[entryIndex];
+			for (int i = 0; i < entry.ids.getCount(); i++)
+			{
+				this->textureBuilders[entry.ids.getID(i)] = TextureBuilder();
+			}
+
+			entry.resident = false;
+			this->residencyStats.residentByteCount -= entry.byteCount;
+			this->residencyStats.evictionCount++;
+		}
+	}
+
+	this->currentFrame++;
+}
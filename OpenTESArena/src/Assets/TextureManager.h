@@ -8,6 +8,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "AssetNameTable.h"
 #include "TextureBuilder.h"
 #include "TextureFileMetadata.h"
 #include "TextureUtils.h"
@@ -20,18 +21,51 @@ struct TextureAsset;
 
 class TextureManager
 {
+public:
+	// Texture builder cache statistics for the profiler.
+	struct ResidencyStats
+	{
+		int64_t residentByteCount;
+		int64_t hitCount, missCount;
+		int64_t evictionCount;
+
+		ResidencyStats();
+
+		double getHitPercent() const;
+	};
 private:
-	// Mappings of texture filenames to indices/sequences of IDs.
-	std::unordered_map<std::string, PaletteIdGroup> paletteIDs;
-	std::unordered_map<std::string, TextureBuilderIdGroup> textureBuilderIDs;
-	std::unordered_map<std::string, int> metadataIndices;
+	// Residency of all texture builders loaded from one file. A file's IDs stay reserved after its texels
+	// are evicted so any IDs held by callers are still valid when it's reloaded.
+	struct TextureBuilderFileEntry
+	{
+		AssetNameID filenameID;
+		TextureBuilderIdGroup ids;
+		int64_t byteCount;
+		int64_t lastUsedFrame;
+		bool resident;
+
+		TextureBuilderFileEntry();
+
+		void init(AssetNameID filenameID, const TextureBuilderIdGroup &ids, int64_t byteCount, int64_t lastUsedFrame);
+	};
+
+	// Mappings of interned texture filenames to indices/sequences of IDs.
+	std::unordered_map<AssetNameID, PaletteIdGroup> paletteIDs;
+	std::unordered_map<AssetNameID, int> textureBuilderEntryIndices; // Points into texture builder entries.
+	std::unordered_map<AssetNameID, int> metadataIndices;
 
 	// Texture data/metadata for each type. Any groups of textures from the same filename are stored contiguously
 	// in the order they appear in the file.
 	std::vector<Palette> palettes;
-	std::vector<TextureBuilder> textureBuilders;
+	std::vector<TextureBuilder> textureBuilders; // Evicted files are reloaded by getOrReloadTextureBuilder().
 	std::vector<TextureFileMetadata> metadatas;
 
+	// Least-recently-used tracking for texture builders. ID and reloading look-ups count as uses.
+	std::vector<TextureBuilderFileEntry> textureBuilderEntries;
+	std::vector<int> textureBuilderEntryIndicesByID; // One per texture builder, points into texture builder entries.
+	int64_t currentFrame;
+	ResidencyStats residencyStats;
+
 	// Returns whether the given filename has the given extension.
 	static bool matchesExtension(const char *filename, const char *extension);
 
@@ -39,24 +73,43 @@ private:
 	static bool tryLoadPalettes(const char *filename, Buffer<Palette> *outPalettes);
 	static bool tryLoadTextureData(const char *filename, Buffer<TextureBuilder> *outTextures,
 		TextureFileMetadata *outMetadata);
+
+	// Loads an evicted file's texture builders back into its reserved IDs.
+	void reloadTextureBuilderEntry(TextureBuilderFileEntry &entry);
 public:
+	TextureManager();
+
 	// Texture ID retrieval functions, loading texture data if not loaded. All required palettes
 	// must be loaded by the caller in advance -- no palettes are loaded in non-palette loader
 	// functions. If the requested file has multiple images but the caller requested only one, the
 	// returned ID will be for the first image. Similarly, if the file has a single image but the
 	// caller expected several, the returned ID group will have only one ID.
 	std::optional<PaletteIdGroup> tryGetPaletteIDs(const char *filename);
+	std::optional<PaletteIdGroup> tryGetPaletteIDs(AssetNameID filenameID);
 	std::optional<PaletteID> tryGetPaletteID(const char *filename);
 	std::optional<PaletteID> tryGetPaletteID(const TextureAsset &textureAsset);
 	std::optional<TextureBuilderIdGroup> tryGetTextureBuilderIDs(const char *filename);
+	std::optional<TextureBuilderIdGroup> tryGetTextureBuilderIDs(AssetNameID filenameID);
 	std::optional<TextureBuilderID> tryGetTextureBuilderID(const char *filename);
 	std::optional<TextureBuilderID> tryGetTextureBuilderID(const TextureAsset &textureAsset);
 	std::optional<TextureFileMetadataID> tryGetMetadataID(const char *filename);
 
-	// Texture getter functions, fast look-up. These do not protect against dangling pointers.
+	// Texture getter functions, fast look-up. These do not protect against dangling pointers. The texture
+	// builder must be resident (i.e. its ID was retrieved or it was reloaded since the last residency update).
 	const Palette &getPaletteHandle(PaletteID id) const;
 	const TextureBuilder &getTextureBuilderHandle(TextureBuilderID id) const;
 	const TextureFileMetadata &getMetadataHandle(TextureFileMetadataID id) const;
+
+	// Gets a texture builder, reloading its file first if it was evicted, and marks it used this frame.
+	// Main thread only. The returned reference is only valid until the next look-up or residency update
+	// since a reload can replace the texture builder.
+	const TextureBuilder &getOrReloadTextureBuilder(TextureBuilderID id);
+
+	const ResidencyStats &getResidencyStats() const;
+
+	// Called once per frame. Evicts the least-recently-used texture builders that weren't used this frame
+	// until the resident texels fit in the budget. A budget of zero is unlimited.
+	void updateResidency(int64_t byteBudget);
 };
 
 #endif
@@ -107,7 +107,7 @@ Surface TextureUtils::generate(TextureUtils::PatternType type, int width, int he
 		// new surface from a texture builder is wasteful.
 		auto makeSurface = [&textureManager, tilesPaletteID](TextureBuilderID textureBuilderID)
 		{
-			const TextureBuilder &textureBuilder = textureManager.getTextureBuilderHandle(textureBuilderID);
+			const TextureBuilder &textureBuilder = textureManager.getOrReloadTextureBuilder(textureBuilderID);
 			Surface surface = Surface::createWithFormat(textureBuilder.getWidth(), textureBuilder.getHeight(),
 				Renderer::DEFAULT_BPP, Renderer::DEFAULT_PIXELFORMAT);
 
@@ -322,7 +322,7 @@ Surface TextureUtils::createTooltip(const std::string &text, const FontLibrary &
 	BufferView2D<uint32_t> surfacePixelsView(
 		static_cast<uint32_t*>(surface.getPixels()), surface.getWidth(), surface.getHeight());
 
-	Buffer<std::string_view> textLines = TextRenderUtils::getTextLines(text);
+	const BufferView<const std::string_view> textLines = TextRenderUtils::getTextLines(text);
 	constexpr TextAlignment alignment = TextAlignment::TopLeft;
 	TextRenderUtils::drawTextLines(textLines, fontDef, dstX, dstY, textColor, alignment, lineSpacing,
 		nullptr, nullptr, surfacePixelsView);
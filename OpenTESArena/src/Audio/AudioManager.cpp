@@ -448,8 +448,8 @@ void AudioManager::init(double musicVolume, double soundVolume, int maxChannels,
 	{
 		for (int i = 0; i < singleInstanceSoundsFile.getLineCount(); i++)
 		{
-			std::string soundFilename = singleInstanceSoundsFile.getLine(i);
-			mSingleInstanceSounds.emplace_back(std::move(soundFilename));
+			const std::string &soundFilename = singleInstanceSoundsFile.getLine(i);
+			mSingleInstanceSounds.emplace_back(AssetNameTable::getInstance().intern(soundFilename));
 		}
 	}
 	else
@@ -474,12 +474,18 @@ bool AudioManager::hasResamplerExtension() const
 }
 
 bool AudioManager::isPlayingSound(const std::string &filename) const
+{
+	const AssetNameID filenameID = AssetNameTable::getInstance().intern(filename);
+	return this->isPlayingSound(filenameID);
+}
+
+bool AudioManager::isPlayingSound(AssetNameID filenameID) const
 {
 	// Check through used sources' filenames.
 	const auto iter = std::find_if(mUsedSources.begin(), mUsedSources.end(),
-		[&filename](const std::pair<std::string, ALuint> &pair)
+		[filenameID](const std::pair<AssetNameID, ALuint> &pair)
 	{
-		return pair.first == filename;
+		return pair.first == filenameID;
 	});
 
 	return iter != mUsedSources.end();
@@ -561,22 +567,29 @@ void AudioManager::setListenerOrientation(const Double3 &direction)
 }
 
 void AudioManager::playSound(const std::string &filename, const std::optional<Double3> &position)
+{
+	const AssetNameID filenameID = AssetNameTable::getInstance().intern(filename);
+	this->playSound(filenameID, position);
+}
+
+void AudioManager::playSound(AssetNameID filenameID, const std::optional<Double3> &position)
 {
 	// Certain sounds should only have one live instance at a time. This is purely an arbitrary
 	// rule to avoid having long sounds overlap each other which would be very annoying and/or
 	// distracting for the player.
 	const bool isSingleInstance = std::find(mSingleInstanceSounds.begin(),
-		mSingleInstanceSounds.end(), filename) != mSingleInstanceSounds.end();
+		mSingleInstanceSounds.end(), filenameID) != mSingleInstanceSounds.end();
 	const bool allowedToPlay = !isSingleInstance ||
-		(isSingleInstance && !this->isPlayingSound(filename));
+		(isSingleInstance && !this->isPlayingSound(filenameID));
 
 	if (!mFreeSources.empty() && allowedToPlay)
 	{
-		auto vocIter = mSoundBuffers.find(filename);
+		auto vocIter = mSoundBuffers.find(filenameID);
 
 		if (vocIter == mSoundBuffers.end())
 		{
 			// Load the .VOC file and give its PCM data to a new OpenAL buffer.
+			const std::string &filename = AssetNameTable::getInstance().getName(filenameID);
 			VOCFile voc;
 			if (!voc.init(filename.c_str()))
 			{
@@ -602,7 +615,7 @@ void AudioManager::playSound(const std::string &filename, const std::optional<Do
 				static_cast<ALsizei>(audioData.getCount()),
 				static_cast<ALsizei>(voc.getSampleRate()));
 
-			vocIter = mSoundBuffers.emplace(filename, bufferID).first;
+			vocIter = mSoundBuffers.emplace(filenameID, bufferID).first;
 		}
 
 		// Set up the sound source.
@@ -635,7 +648,7 @@ void AudioManager::playSound(const std::string &filename, const std::optional<Do
 		// Play the sound.
 		alSourcePlay(source);
 
-		mUsedSources.push_front(std::make_pair(filename, source));
+		mUsedSources.push_front(std::make_pair(filenameID, source));
 		mFreeSources.pop_front();
 	}
 }
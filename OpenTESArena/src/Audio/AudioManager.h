@@ -11,6 +11,7 @@
 #include "al.h"
 
 #include "Midi.h"
+#include "../Assets/AssetNameTable.h"
 
 #include "../Math/Vector3.h"
 
@@ -49,23 +50,23 @@ private:
 	// Sounds which are allowed only one active instance at a time, otherwise they would
 	// sound a bit obnoxious. This functionality is added here because the original game
 	// can only play one sound at a time, so it doesn't have this problem.
-	std::vector<std::string> mSingleInstanceSounds;
+	std::vector<AssetNameID> mSingleInstanceSounds;
 
 	// Currently active song and playback stream.
 	MidiSongPtr mCurrentSong;
 	std::unique_ptr<OpenALStream> mSongStream;
 
 	// Loaded sound buffers from .VOC files.
-	std::unordered_map<std::string, ALuint> mSoundBuffers;
+	std::unordered_map<AssetNameID, ALuint> mSoundBuffers;
 
 	// A deque of available sources to play sounds and streams with.
 	std::deque<ALuint> mFreeSources;
 
 	// A deque of currently used sources for sounds (the music source is owned
-	// by OpenALStream). The string is the filename and the integer is the ID.
-	// The filename is required for some sounds that can only have one instance
+	// by OpenALStream). The first value is the interned filename and the second is the
+	// source ID. The filename is required for some sounds that can only have one instance
 	// active at a time.
-	std::deque<std::pair<std::string, ALuint>> mUsedSources;
+	std::deque<std::pair<AssetNameID, ALuint>> mUsedSources;
 
 	// Use this when resetting sound sources back to their default resampling. This uses
 	// whatever setting is the default within OpenAL.
@@ -101,6 +102,7 @@ public:
 
 	// Returns whether the given filename is playing in any sound handle.
 	bool isPlayingSound(const std::string &filename) const;
+	bool isPlayingSound(AssetNameID filenameID) const;
 
 	// Returns whether the given filename references an actual sound.
 	bool soundExists(const std::string &filename) const;
@@ -109,6 +111,7 @@ public:
 	// is played globally.
 	void playSound(const std::string &filename,
 		const std::optional<Double3> &position = std::nullopt);
+	void playSound(AssetNameID filenameID, const std::optional<Double3> &position = std::nullopt);
 
 	// Sets the music to the given music definition, with an optional music to play first as a
 	// lead-in to the actual music. If no music definition is given, the current music is stopped.
@@ -0,0 +1,1303 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "SDL.h"
+
+#include "Assets/AssetCache.h"
+#include "Assets/CFAFile.h"
+#include "Assets/CIFFile.h"
+#include "Assets/Compression.h"
+#include "Assets/CompressionReference.h"
+#include "Assets/DFAFile.h"
+#include "Assets/IMGFile.h"
+#include "Assets/MIFFile.h"
+#include "Assets/RMDFile.h"
+#include "Game/Game.h"
+#include "Interface/MainMenuUiController.h"
+#include "Interface/MainMenuUiModel.h"
+#include "Math/Constants.h"
+#include "Math/Random.h"
+#include "UI/Surface.h"
+#include "Utilities/Platform.h"
+#include "Voxels/VoxelUtils.h"
+
+#include "components/debug/Debug.h"
+#include "components/utilities/FPSCounter.h"
+#include "components/utilities/RecyclablePool.h"
+#include "components/utilities/String.h"
+#include "components/vfs/manager.hpp"
+
+// Headless benchmark: boots the engine with dummy SDL video/audio drivers and a null OpenAL device, loads a
+// test location, flies the camera on a fixed circle, and writes per-frame stage timings as CSV or JSON. With
+// --decoders, it instead times decoding every compressed asset in the game data, with --verify-decoders it
+// checks that the optimized decoders match the reference ones on every compressed asset, with --fuzz-decoders it
+// compares them on seeded random, truncated and corrupt streams without any game data, and with --pools it
+// compares RecyclablePool against its previous hash set free list implementation without booting the engine.
+
+namespace
+{
+	struct BenchLocation
+	{
+		const char *name;
+		int testType;
+		int testIndex;
+	};
+
+	constexpr BenchLocation BenchLocations[] =
+	{
+		{ "imperial", MainMenuUiModel::TestType_City, 0 },
+		{ "city", MainMenuUiModel::TestType_City, 1 },
+		{ "town", MainMenuUiModel::TestType_City, 2 },
+		{ "village", MainMenuUiModel::TestType_City, 3 },
+		{ "wilderness", MainMenuUiModel::TestType_Wilderness, 0 },
+		{ "interior", MainMenuUiModel::TestType_Interior, 0 },
+		{ "dungeon", MainMenuUiModel::TestType_Dungeon, 0 },
+		{ "wilddungeon", MainMenuUiModel::TestType_Dungeon, 1 },
+		{ "startdungeon", MainMenuUiModel::TestType_MainQuest, 0 }
+	};
+
+	struct BenchSettings
+	{
+		std::string locationName;
+		int warmupFrames;
+		int frameCount;
+		double dt; // Fixed simulation delta time so runs are comparable.
+		int seed;
+		double cameraRadius; // Radius of the camera's circle around the spawn point.
+		std::optional<double> resolutionScale;
+		bool json;
+		std::string outputPath; // Empty for stdout.
+		std::string dumpPath; // Empty for no frame dump.
+		int decoderIterations; // Non-zero to run the decoder benchmark instead.
+		int poolIterations; // Non-zero to run the pool benchmark instead.
+		bool verifyDecoders; // Compares optimized and reference decoders instead.
+		int fuzzDecoderCases; // Non-zero to fuzz the optimized decoders against the reference ones instead.
+
+		BenchSettings()
+		{
+			this->locationName = "imperial";
+			this->warmupFrames = 60;
+			this->frameCount = 600;
+			this->dt = 1.0 / 60.0;
+			this->seed = 0;
+			this->cameraRadius = 1.50;
+			this->json = false;
+			this->decoderIterations = 0;
+			this->poolIterations = 0;
+			this->verifyDecoders = false;
+			this->fuzzDecoderCases = 0;
+		}
+	};
+
+	struct BenchFrame
+	{
+		Game::FrameStageTimes stageTimes;
+		double render3DTime;
+		int drawCallCount;
+		int visTriangleCount;
+
+		BenchFrame()
+		{
+			this->render3DTime = 0.0;
+			this->drawCallCount = 0;
+			this->visTriangleCount = 0;
+		}
+
+		double getTotalTime() const
+		{
+			return this->stageTimes.input + this->stageTimes.tick + this->stageTimes.lateTick +
+				this->stageTimes.render + this->stageTimes.cleanUp;
+		}
+	};
+
+	void printUsage()
+	{
+		std::string locationNames;
+		for (const BenchLocation &location : BenchLocations)
+		{
+			if (!locationNames.empty())
+			{
+				locationNames += '|';
+			}
+
+			locationNames += location.name;
+		}
+
+		std::cerr << "Usage: OpenTESArenaBench [--location " << locationNames << "] [--frames N] [--warmup N]\n" <<
+			"  [--dt SECONDS] [--seed N] [--radius VOXELS] [--resolution-scale X] [--format csv|json]\n" <<
+			"  [--output PATH] [--dump PATH.bmp] [--decoders ITERATIONS] [--verify-decoders] [--fuzz-decoders CASES]\n" <<
+			"  [--pools ITERATIONS]\n";
+	}
+
+	bool tryParseArgs(int argc, char *argv[], BenchSettings *outSettings)
+	{
+		for (int i = 1; i < argc; i++)
+		{
+			const std::string arg = argv[i];
+			if (arg == "--verify-decoders")
+			{
+				outSettings->verifyDecoders = true;
+				continue;
+			}
+
+			if ((i + 1) >= argc)
+			{
+				std::cerr << "Missing value for \"" << arg << "\".\n";
+				return false;
+			}
+
+			const std::string value = argv[++i];
+			try
+			{
+				if (arg == "--location")
+				{
+					outSettings->locationName = String::toLowercase(value);
+				}
+				else if (arg == "--frames")
+				{
+					outSettings->frameCount = std::stoi(value);
+				}
+				else if (arg == "--warmup")
+				{
+					outSettings->warmupFrames = std::stoi(value);
+				}
+				else if (arg == "--dt")
+				{
+					outSettings->dt = std::stod(value);
+				}
+				else if (arg == "--seed")
+				{
+					outSettings->seed = std::stoi(value);
+				}
+				else if (arg == "--radius")
+				{
+					outSettings->cameraRadius = std::stod(value);
+				}
+				else if (arg == "--resolution-scale")
+				{
+					outSettings->resolutionScale = std::stod(value);
+				}
+				else if (arg == "--format")
+				{
+					if ((value != "csv") && (value != "json"))
+					{
+						std::cerr << "Unrecognized format \"" << value << "\".\n";
+						return false;
+					}
+
+					outSettings->json = value == "json";
+				}
+				else if (arg == "--output")
+				{
+					outSettings->outputPath = value;
+				}
+				else if (arg == "--dump")
+				{
+					outSettings->dumpPath = value;
+				}
+				else if (arg == "--decoders")
+				{
+					outSettings->decoderIterations = std::stoi(value);
+				}
+				else if (arg == "--fuzz-decoders")
+				{
+					outSettings->fuzzDecoderCases = std::stoi(value);
+				}
+				else if (arg == "--pools")
+				{
+					outSettings->poolIterations = std::stoi(value);
+				}
+				else
+				{
+					std::cerr << "Unrecognized argument \"" << arg << "\".\n";
+					return false;
+				}
+			}
+			catch (const std::exception&)
+			{
+				std::cerr << "Invalid value \"" << value << "\" for \"" << arg << "\".\n";
+				return false;
+			}
+		}
+
+		return (outSettings->frameCount > 0) && (outSettings->warmupFrames >= 0) && (outSettings->dt > 0.0) &&
+			(outSettings->decoderIterations >= 0) && (outSettings->fuzzDecoderCases >= 0) && (outSettings->poolIterations >= 0);
+	}
+
+	const BenchLocation *findLocation(const std::string &name)
+	{
+		const auto iter = std::find_if(std::begin(BenchLocations), std::end(BenchLocations),
+			[&name](const BenchLocation &location)
+		{
+			return name == location.name;
+		});
+
+		return (iter != std::end(BenchLocations)) ? &(*iter) : nullptr;
+	}
+
+	struct DecoderBenchResult
+	{
+		std::string pattern;
+		int fileCount;
+		double totalTime; // All iterations.
+	};
+
+	// Loads every file matching the pattern the given number of times.
+	template<typename FileType>
+	DecoderBenchResult runDecoderBench(const char *pattern, int iterations)
+	{
+		const std::vector<std::string> filenames = VFS::Manager::get().list(pattern);
+
+		DecoderBenchResult result;
+		result.pattern = pattern;
+		result.fileCount = static_cast<int>(filenames.size());
+
+		const auto startTime = std::chrono::steady_clock::now();
+		for (int i = 0; i < iterations; i++)
+		{
+			for (const std::string &filename : filenames)
+			{
+				FileType file;
+				file.init(filename.c_str());
+			}
+		}
+
+		const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - startTime;
+		result.totalTime = elapsedTime.count();
+		return result;
+	}
+
+	struct DecoderVerifyResult
+	{
+		std::string pattern;
+		int fileCount;
+		int decodeCount;
+		int mismatchCount;
+	};
+
+	// Loads every file matching the pattern once with decoder verification enabled.
+	template<typename FileType>
+	DecoderVerifyResult runDecoderVerify(const char *pattern)
+	{
+		const std::vector<std::string> filenames = VFS::Manager::get().list(pattern);
+		const int startDecodeCount = Compression::getVerifiedDecodeCount();
+		const int startMismatchCount = Compression::getVerifyMismatchCount();
+
+		for (const std::string &filename : filenames)
+		{
+			FileType file;
+			file.init(filename.c_str());
+		}
+
+		DecoderVerifyResult result;
+		result.pattern = pattern;
+		result.fileCount = static_cast<int>(filenames.size());
+		result.decodeCount = Compression::getVerifiedDecodeCount() - startDecodeCount;
+		result.mismatchCount = Compression::getVerifyMismatchCount() - startMismatchCount;
+		return result;
+	}
+
+	std::string makeDecoderVerifyReport(const std::vector<DecoderVerifyResult> &results, bool json)
+	{
+		std::stringstream ss;
+		if (json)
+		{
+			ss << "{\n";
+			ss << "  \"formats\": [\n";
+			for (int i = 0; i < static_cast<int>(results.size()); i++)
+			{
+				const DecoderVerifyResult &result = results[i];
+				ss << "    { \"pattern\": \"" << result.pattern << "\", \"files\": " << result.fileCount <<
+					", \"decodes\": " << result.decodeCount << ", \"mismatches\": " << result.mismatchCount << " }";
+				ss << (((i + 1) < static_cast<int>(results.size())) ? ",\n" : "\n");
+			}
+
+			ss << "  ]\n";
+			ss << "}\n";
+		}
+		else
+		{
+			ss << "pattern,files,decodes,mismatches\n";
+			for (const DecoderVerifyResult &result : results)
+			{
+				ss << result.pattern << ',' << result.fileCount << ',' << result.decodeCount << ',' << result.mismatchCount << '\n';
+			}
+		}
+
+		return ss.str();
+	}
+
+	std::string makeDecoderReport(const std::vector<DecoderBenchResult> &results, int iterations, bool json)
+	{
+		auto getAvgFileTime = [iterations](const DecoderBenchResult &result)
+		{
+			const int loadCount = result.fileCount * iterations;
+			return (loadCount > 0) ? (result.totalTime / static_cast<double>(loadCount)) : 0.0;
+		};
+
+		std::stringstream ss;
+		if (json)
+		{
+			ss << "{\n";
+			ss << "  \"iterations\": " << iterations << ",\n";
+			ss << "  \"formats\": [\n";
+			for (int i = 0; i < static_cast<int>(results.size()); i++)
+			{
+				const DecoderBenchResult &result = results[i];
+				ss << "    { \"pattern\": \"" << result.pattern << "\", \"files\": " << result.fileCount <<
+					", \"total_ms\": " << (result.totalTime * 1000.0) << ", \"avg_file_us\": " <<
+					(getAvgFileTime(result) * 1000000.0) << " }";
+				ss << (((i + 1) < static_cast<int>(results.size())) ? ",\n" : "\n");
+			}
+
+			ss << "  ]\n";
+			ss << "}\n";
+		}
+		else
+		{
+			ss << "pattern,files,iterations,total_ms,avg_file_us\n";
+			for (const DecoderBenchResult &result : results)
+			{
+				ss << result.pattern << ',' << result.fileCount << ',' << iterations << ',' <<
+					(result.totalTime * 1000.0) << ',' << (getAvgFileTime(result) * 1000000.0) << '\n';
+			}
+		}
+
+		return ss.str();
+	}
+
+	// Decoder fuzzing compares the optimized decoders with the reference ones on generated streams, so it needs no
+	// game data. Corrupt streams make both decoders assert or read/write out of bounds, so on POSIX every decode
+	// runs in a child process on guard-paged memory and the parent compares how it ended.
+	enum class DecoderFuzzOutcome
+	{
+		Success,
+		Assertion, // DebugAssert or DebugCrash.
+		Fault, // Out-of-bounds access (or another signal).
+		Timeout
+	};
+
+	using DecoderFuzzFunc = void(*)(const uint8_t *src, const uint8_t *srcEnd, int stopCount, BufferView<uint8_t> out);
+	using DecoderFuzzStreamFunc = void(*)(Random &random, int outSize, std::vector<uint8_t> &outStream);
+
+	struct DecoderFuzzFormat
+	{
+		const char *name;
+		DecoderFuzzFunc decode, referenceDecode;
+		DecoderFuzzStreamFunc makeStream; // Generates a well-formed stream for the output size.
+		int outSizeAlignment;
+		int outSizePerStopCount; // Output bytes per unit of the stop count, or 0 if the decoder has none.
+		bool referenceCanOverrun; // The reference type 8 decoder writes past its output if the last back-reference crosses the end.
+	};
+
+	struct DecoderFuzzResult
+	{
+		std::string name;
+		int caseCount;
+		int successCount; // Both decoders succeeded with identical output.
+		int failureCount; // Both decoders rejected the stream.
+		int referenceOverrunCount; // Reference overran its output and the optimized decoder clamped, with identical output.
+		int skippedCount; // Corrupt streams on platforms without process isolation.
+		int mismatchCount;
+	};
+
+	constexpr int DecoderFuzzMaxOutSize = 4096;
+	constexpr unsigned int DecoderFuzzTimeoutSeconds = 5;
+
+	void makeFuzzStreamRLE(Random &random, int outSize, std::vector<uint8_t> &outStream)
+	{
+		int o = 0;
+		while (o < outSize)
+		{
+			const int count = 1 + random.next(std::min(128, outSize - o));
+			if (random.next(2) == 0)
+			{
+				outStream.emplace_back(static_cast<uint8_t>(count + 0x7F));
+				outStream.emplace_back(static_cast<uint8_t>(random.next(256)));
+			}
+			else
+			{
+				outStream.emplace_back(static_cast<uint8_t>(count - 1));
+				for (int i = 0; i < count; i++)
+				{
+					outStream.emplace_back(static_cast<uint8_t>(random.next(256)));
+				}
+			}
+
+			o += count;
+		}
+	}
+
+	void makeFuzzStreamRLEWords(Random &random, int outSize, std::vector<uint8_t> &outStream)
+	{
+		const int wordCount = outSize / 2;
+		int o = 0;
+		while (o < wordCount)
+		{
+			const int count = 1 + random.next(std::min(64, wordCount - o));
+			const bool isLiteral = random.next(2) == 0;
+			const uint16_t sample = static_cast<uint16_t>(isLiteral ? count : -count);
+			outStream.emplace_back(static_cast<uint8_t>(sample & 0xFF));
+			outStream.emplace_back(static_cast<uint8_t>(sample >> 8));
+
+			const int byteCount = isLiteral ? (count * 2) : 2;
+			for (int i = 0; i < byteCount; i++)
+			{
+				outStream.emplace_back(static_cast<uint8_t>(random.next(256)));
+			}
+
+			o += count;
+		}
+	}
+
+	void makeFuzzStreamType04(Random &random, int outSize, std::vector<uint8_t> &outStream)
+	{
+		// The stream may end early; the rest of the output is zero-filled.
+		const int targetSize = (random.next(4) == 0) ? random.next(outSize + 1) : outSize;
+		int o = 0;
+		while (o < targetSize)
+		{
+			const int maskIndex = static_cast<int>(outStream.size());
+			outStream.emplace_back(0);
+			for (int bit = 0; (bit < 8) && (o < targetSize); bit++)
+			{
+				const int remaining = targetSize - o;
+				if ((remaining < 3) || (random.next(2) == 0))
+				{
+					outStream[maskIndex] |= static_cast<uint8_t>(1 << bit);
+					outStream.emplace_back(static_cast<uint8_t>(random.next(256)));
+					o++;
+				}
+				else
+				{
+					const int count = 3 + random.next(std::min(16, remaining - 2));
+					outStream.emplace_back(static_cast<uint8_t>(random.next(256)));
+					outStream.emplace_back(static_cast<uint8_t>((random.next(16) << 4) | (count - 3)));
+					o += count;
+				}
+			}
+		}
+	}
+
+	void makeFuzzStreamType08(Random &random, int outSize, std::vector<uint8_t> &outStream)
+	{
+		// Any bit string is a valid adaptive Huffman stream; input past the end reads as zeros.
+		const int byteCount = random.next(outSize + 1);
+		for (int i = 0; i < byteCount; i++)
+		{
+			outStream.emplace_back(static_cast<uint8_t>(random.next(256)));
+		}
+	}
+
+	const DecoderFuzzFormat DecoderFuzzFormats[] =
+	{
+		{
+			"rle",
+			[](const uint8_t *src, const uint8_t*, int stopCount, BufferView<uint8_t> out) { Compression::decodeRLE(src, stopCount, out); },
+			[](const uint8_t *src, const uint8_t*, int stopCount, BufferView<uint8_t> out) { CompressionReference::decodeRLE(src, stopCount, out); },
+			makeFuzzStreamRLE, 1, 1, false
+		},
+		{
+			"rle_words",
+			[](const uint8_t *src, const uint8_t*, int stopCount, BufferView<uint8_t> out) { Compression::decodeRLEWords(src, stopCount, out); },
+			[](const uint8_t *src, const uint8_t*, int stopCount, BufferView<uint8_t> out) { CompressionReference::decodeRLEWords(src, stopCount, out); },
+			makeFuzzStreamRLEWords, 2, 2, false
+		},
+		{
+			"type04",
+			[](const uint8_t *src, const uint8_t *srcEnd, int, BufferView<uint8_t> out) { Compression::decodeType04(src, srcEnd, out); },
+			[](const uint8_t *src, const uint8_t *srcEnd, int, BufferView<uint8_t> out) { CompressionReference::decodeType04(src, srcEnd, out); },
+			makeFuzzStreamType04, 1, 0, false
+		},
+		{
+			"type08",
+			[](const uint8_t *src, const uint8_t *srcEnd, int, BufferView<uint8_t> out) { Compression::decodeType08(src, srcEnd, out); },
+			[](const uint8_t *src, const uint8_t *srcEnd, int, BufferView<uint8_t> out) { CompressionReference::decodeType08(src, srcEnd, out); },
+			makeFuzzStreamType08, 1, 0, true
+		}
+	};
+
+	// Intact, truncated, bytes flipped, or entirely random.
+	void corruptFuzzStream(Random &random, int caseIndex, std::vector<uint8_t> &stream)
+	{
+		switch (caseIndex % 4)
+		{
+		case 1:
+			stream.resize(random.next(static_cast<int>(stream.size()) + 1));
+			break;
+		case 2:
+			if (!stream.empty())
+			{
+				const int flipCount = 1 + random.next(4);
+				for (int i = 0; i < flipCount; i++)
+				{
+					stream[random.next(static_cast<int>(stream.size()))] ^= static_cast<uint8_t>(1 + random.next(255));
+				}
+			}
+			break;
+		case 3:
+			stream.resize(random.next(DecoderFuzzMaxOutSize + 1));
+			for (uint8_t &byte : stream)
+			{
+				byte = static_cast<uint8_t>(random.next(256));
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+#if !defined(_WIN32)
+	// Shared memory whose last byte is followed by an inaccessible page, so a decoder reading or writing past it
+	// faults right away, and the parent process still sees what a child wrote before it ended.
+	class GuardedBytes
+	{
+	private:
+		uint8_t *mapping;
+		size_t mappingSize;
+		int count;
+	public:
+		GuardedBytes(int count)
+		{
+			const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+			const size_t dataSize = ((static_cast<size_t>(count) + pageSize - 1) / pageSize) * pageSize;
+			this->mappingSize = dataSize + pageSize;
+			void *mapping = mmap(nullptr, this->mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+			if (mapping == MAP_FAILED)
+			{
+				throw std::runtime_error("Couldn't map " + std::to_string(this->mappingSize) + " bytes for decoder fuzzing.");
+			}
+
+			this->mapping = static_cast<uint8_t*>(mapping);
+			mprotect(this->mapping + dataSize, pageSize, PROT_NONE);
+			this->count = count;
+		}
+
+		GuardedBytes(const GuardedBytes&) = delete;
+		GuardedBytes &operator=(const GuardedBytes&) = delete;
+
+		~GuardedBytes()
+		{
+			munmap(this->mapping, this->mappingSize);
+		}
+
+		uint8_t *begin()
+		{
+			return this->mapping + (this->mappingSize - static_cast<size_t>(sysconf(_SC_PAGESIZE))) - this->count;
+		}
+
+		uint8_t *end()
+		{
+			return this->begin() + this->count;
+		}
+	};
+
+	DecoderFuzzOutcome runFuzzDecode(DecoderFuzzFunc decode, GuardedBytes &src, int stopCount, GuardedBytes &out)
+	{
+		std::cout.flush();
+		std::cerr.flush();
+
+		const pid_t pid = fork();
+		if (pid < 0)
+		{
+			throw std::runtime_error("Couldn't fork for decoder fuzzing.");
+		}
+		else if (pid == 0)
+		{
+			// Assertion failures wait for a key press and write to stderr.
+			std::freopen("/dev/null", "r", stdin);
+			std::freopen("/dev/null", "w", stderr);
+			alarm(DecoderFuzzTimeoutSeconds);
+
+			decode(src.begin(), src.end(), stopCount, BufferView<uint8_t>(out.begin(), static_cast<int>(out.end() - out.begin())));
+			_exit(EXIT_SUCCESS);
+		}
+
+		int status = 0;
+		while (waitpid(pid, &status, 0) < 0) { }
+
+		if (WIFEXITED(status))
+		{
+			return (WEXITSTATUS(status) == EXIT_SUCCESS) ? DecoderFuzzOutcome::Success : DecoderFuzzOutcome::Assertion;
+		}
+		else if (WIFSIGNALED(status) && (WTERMSIG(status) == SIGALRM))
+		{
+			return DecoderFuzzOutcome::Timeout;
+		}
+
+		return DecoderFuzzOutcome::Fault;
+	}
+#endif
+
+	const char *getFuzzOutcomeName(DecoderFuzzOutcome outcome)
+	{
+		switch (outcome)
+		{
+		case DecoderFuzzOutcome::Success:
+			return "success";
+		case DecoderFuzzOutcome::Assertion:
+			return "assertion";
+		case DecoderFuzzOutcome::Fault:
+			return "fault";
+		default:
+			return "timeout";
+		}
+	}
+
+	// The reference decoders check bounds as they go while the optimized ones check a whole token up front, so a
+	// corrupt token can end in an assertion in one and an out-of-bounds access in the other. Either counts as
+	// rejecting the stream; a hang never does.
+	bool isFuzzFailure(DecoderFuzzOutcome outcome)
+	{
+		return (outcome == DecoderFuzzOutcome::Assertion) || (outcome == DecoderFuzzOutcome::Fault);
+	}
+
+	DecoderFuzzResult runDecoderFuzz(const DecoderFuzzFormat &format, int caseCount, int seed)
+	{
+		DecoderFuzzResult result;
+		result.name = format.name;
+		result.caseCount = caseCount;
+		result.successCount = 0;
+		result.failureCount = 0;
+		result.referenceOverrunCount = 0;
+		result.skippedCount = 0;
+		result.mismatchCount = 0;
+
+		Random random(seed);
+		std::vector<uint8_t> stream;
+		for (int caseIndex = 0; caseIndex < caseCount; caseIndex++)
+		{
+			const int outSize = std::max((1 + random.next(DecoderFuzzMaxOutSize)) & ~(format.outSizeAlignment - 1),
+				format.outSizeAlignment);
+			const int stopCount = (format.outSizePerStopCount > 0) ? (outSize / format.outSizePerStopCount) : 0;
+
+			stream.clear();
+			format.makeStream(random, outSize, stream);
+			corruptFuzzStream(random, caseIndex, stream);
+
+			// Bytes neither decoder writes still have to match.
+			const uint8_t outFill = static_cast<uint8_t>(random.next(256));
+
+			DecoderFuzzOutcome outcome, referenceOutcome;
+			std::vector<uint8_t> out(outSize, outFill);
+			std::vector<uint8_t> referenceOut(outSize, outFill);
+#if !defined(_WIN32)
+			{
+				GuardedBytes guardedSrc(static_cast<int>(stream.size()));
+				std::copy(stream.begin(), stream.end(), guardedSrc.begin());
+
+				GuardedBytes guardedOut(outSize);
+				std::fill(guardedOut.begin(), guardedOut.end(), outFill);
+				outcome = runFuzzDecode(format.decode, guardedSrc, stopCount, guardedOut);
+				std::copy(guardedOut.begin(), guardedOut.end(), out.begin());
+
+				std::fill(guardedOut.begin(), guardedOut.end(), outFill);
+				referenceOutcome = runFuzzDecode(format.referenceDecode, guardedSrc, stopCount, guardedOut);
+				std::copy(guardedOut.begin(), guardedOut.end(), referenceOut.begin());
+			}
+#else
+			// Without process isolation, only intact streams are safe to decode.
+			if ((caseIndex % 4) != 0)
+			{
+				result.skippedCount++;
+				continue;
+			}
+
+			format.decode(stream.data(), stream.data() + stream.size(), stopCount, BufferView<uint8_t>(out));
+			format.referenceDecode(stream.data(), stream.data() + stream.size(), stopCount, BufferView<uint8_t>(referenceOut));
+			outcome = DecoderFuzzOutcome::Success;
+			referenceOutcome = DecoderFuzzOutcome::Success;
+#endif
+
+			const bool sameOutput = out == referenceOut;
+			if ((outcome == DecoderFuzzOutcome::Success) && (referenceOutcome == DecoderFuzzOutcome::Success) && sameOutput)
+			{
+				result.successCount++;
+			}
+			else if (isFuzzFailure(outcome) && isFuzzFailure(referenceOutcome))
+			{
+				result.failureCount++;
+			}
+			else if (format.referenceCanOverrun && (outcome == DecoderFuzzOutcome::Success) &&
+				(referenceOutcome == DecoderFuzzOutcome::Fault) && sameOutput)
+			{
+				result.referenceOverrunCount++;
+			}
+			else
+			{
+				result.mismatchCount++;
+				std::cerr << "Decoder fuzz mismatch (" << format.name << ", seed " << seed << ", case " << caseIndex <<
+					", " << stream.size() << " -> " << outSize << " bytes): optimized " << getFuzzOutcomeName(outcome) <<
+					", reference " << getFuzzOutcomeName(referenceOutcome) << (sameOutput ? "" : ", outputs differ") << ".\n";
+			}
+		}
+
+		return result;
+	}
+
+	std::string makeDecoderFuzzReport(const std::vector<DecoderFuzzResult> &results, int seed, bool json)
+	{
+		std::stringstream ss;
+		if (json)
+		{
+			ss << "{\n";
+			ss << "  \"seed\": " << seed << ",\n";
+			ss << "  \"decoders\": [\n";
+			for (int i = 0; i < static_cast<int>(results.size()); i++)
+			{
+				const DecoderFuzzResult &result = results[i];
+				ss << "    { \"decoder\": \"" << result.name << "\", \"cases\": " << result.caseCount <<
+					", \"successes\": " << result.successCount << ", \"failures\": " << result.failureCount <<
+					", \"reference_overruns\": " << result.referenceOverrunCount << ", \"skipped\": " << result.skippedCount <<
+					", \"mismatches\": " << result.mismatchCount << " }";
+				ss << (((i + 1) < static_cast<int>(results.size())) ? ",\n" : "\n");
+			}
+
+			ss << "  ]\n";
+			ss << "}\n";
+		}
+		else
+		{
+			ss << "decoder,seed,cases,successes,failures,reference_overruns,skipped,mismatches\n";
+			for (const DecoderFuzzResult &result : results)
+			{
+				ss << result.name << ',' << seed << ',' << result.caseCount << ',' << result.successCount << ',' <<
+					result.failureCount << ',' << result.referenceOverrunCount << ',' << result.skippedCount << ',' <<
+					result.mismatchCount << '\n';
+			}
+		}
+
+		return ss.str();
+	}
+
+	// RecyclablePool before generational handles, kept as the baseline for --pools.
+	template<typename ElementT, typename IdT>
+	class HashSetRecyclablePool
+	{
+	private:
+		std::vector<ElementT> elements;
+		std::unordered_set<IdT> freedIDs;
+		IdT nextID;
+
+		bool isValidID(IdT id) const
+		{
+			return (id >= 0) && (id < this->nextID) && (this->freedIDs.find(id) == this->freedIDs.end());
+		}
+	public:
+		HashSetRecyclablePool()
+		{
+			this->nextID = 0;
+		}
+
+		int getTotalCount() const
+		{
+			return static_cast<int>(this->elements.size());
+		}
+
+		ElementT &get(IdT id)
+		{
+			DebugAssert(this->isValidID(id));
+			return this->elements[id];
+		}
+
+		const ElementT *tryGet(IdT id) const
+		{
+			return this->isValidID(id) ? &this->elements[id] : nullptr;
+		}
+
+		bool tryAlloc(IdT *outID)
+		{
+			if (!this->freedIDs.empty())
+			{
+				*outID = *this->freedIDs.begin();
+				this->freedIDs.erase(this->freedIDs.begin());
+			}
+			else
+			{
+				*outID = this->nextID;
+				this->nextID++;
+				this->elements.emplace_back(ElementT());
+			}
+
+			return true;
+		}
+
+		void free(IdT id)
+		{
+			DebugAssert(this->isValidID(id));
+			this->freedIDs.emplace(id);
+			this->elements[id] = ElementT();
+		}
+	};
+
+	struct PoolBenchElement
+	{
+		double x, y;
+		int value;
+
+		PoolBenchElement()
+		{
+			this->x = 0.0;
+			this->y = 0.0;
+			this->value = 0;
+		}
+	};
+
+	struct PoolBenchResult
+	{
+		std::string poolName;
+		double allocFreeTime, getTime, iterateTime; // All iterations.
+		int64_t checksum; // Keeps the work from being optimized out; should match between pools.
+	};
+
+	int64_t SumLiveElements(const HashSetRecyclablePool<PoolBenchElement, int> &pool)
+	{
+		int64_t sum = 0;
+		for (int i = 0; i < pool.getTotalCount(); i++)
+		{
+			const PoolBenchElement *element = pool.tryGet(i);
+			if (element != nullptr)
+			{
+				sum += element->value;
+			}
+		}
+
+		return sum;
+	}
+
+	int64_t SumLiveElements(const RecyclablePool<PoolBenchElement, int> &pool)
+	{
+		int64_t sum = 0;
+		pool.forEach([&sum](int id, const PoolBenchElement &element)
+		{
+			sum += element.value;
+		});
+
+		return sum;
+	}
+
+	// Churns a pool the way chunk streaming does: a steady population where a random part is freed and
+	// reallocated each iteration, followed by checked lookups and a pass over the live elements.
+	template<typename PoolType>
+	PoolBenchResult runPoolBench(const char *poolName, int iterations)
+	{
+		constexpr int elementCount = 16384;
+		constexpr int churnCount = elementCount / 4;
+
+		PoolBenchResult result;
+		result.poolName = poolName;
+		result.allocFreeTime = 0.0;
+		result.getTime = 0.0;
+		result.iterateTime = 0.0;
+		result.checksum = 0;
+
+		PoolType pool;
+		std::vector<int> ids(elementCount);
+		for (int i = 0; i < elementCount; i++)
+		{
+			pool.tryAlloc(&ids[i]);
+			pool.get(ids[i]).value = i;
+		}
+
+		Random random(12345);
+		for (int iteration = 0; iteration < iterations; iteration++)
+		{
+			auto startTime = std::chrono::steady_clock::now();
+			for (int i = 0; i < churnCount; i++)
+			{
+				const int index = random.next(elementCount);
+				pool.free(ids[index]);
+				pool.tryAlloc(&ids[index]);
+				pool.get(ids[index]).value = index;
+			}
+
+			auto endTime = std::chrono::steady_clock::now();
+			result.allocFreeTime += std::chrono::duration<double>(endTime - startTime).count();
+
+			startTime = endTime;
+			for (const int id : ids)
+			{
+				result.checksum += pool.get(id).value;
+			}
+
+			endTime = std::chrono::steady_clock::now();
+			result.getTime += std::chrono::duration<double>(endTime - startTime).count();
+
+			startTime = endTime;
+			result.checksum += SumLiveElements(pool);
+			endTime = std::chrono::steady_clock::now();
+			result.iterateTime += std::chrono::duration<double>(endTime - startTime).count();
+		}
+
+		return result;
+	}
+
+	std::string makePoolReport(const std::vector<PoolBenchResult> &results, int iterations, bool json)
+	{
+		std::stringstream ss;
+		if (json)
+		{
+			ss << "{\n";
+			ss << "  \"iterations\": " << iterations << ",\n";
+			ss << "  \"pools\": [\n";
+			for (int i = 0; i < static_cast<int>(results.size()); i++)
+			{
+				const PoolBenchResult &result = results[i];
+				ss << "    { \"pool\": \"" << result.poolName << "\", \"alloc_free_ms\": " << (result.allocFreeTime * 1000.0) <<
+					", \"get_ms\": " << (result.getTime * 1000.0) << ", \"iterate_ms\": " << (result.iterateTime * 1000.0) <<
+					", \"checksum\": " << result.checksum << " }";
+				ss << (((i + 1) < static_cast<int>(results.size())) ? ",\n" : "\n");
+			}
+
+			ss << "  ]\n";
+			ss << "}\n";
+		}
+		else
+		{
+			ss << "pool,iterations,alloc_free_ms,get_ms,iterate_ms,checksum\n";
+			for (const PoolBenchResult &result : results)
+			{
+				ss << result.poolName << ',' << iterations << ',' << (result.allocFreeTime * 1000.0) << ',' <<
+					(result.getTime * 1000.0) << ',' << (result.iterateTime * 1000.0) << ',' << result.checksum << '\n';
+			}
+		}
+
+		return ss.str();
+	}
+
+	// Writes to stdout if the path is empty.
+	bool writeReport(const std::string &report, const std::string &outputPath)
+	{
+		if (outputPath.empty())
+		{
+			std::cout << report;
+			return true;
+		}
+
+		std::ofstream stream(outputPath);
+		if (!stream.is_open())
+		{
+			std::cerr << "Couldn't open \"" << outputPath << "\" for writing.\n";
+			return false;
+		}
+
+		stream << report;
+		return true;
+	}
+
+	// Must be called before SDL and OpenAL are initialized.
+	void initHeadlessDrivers()
+	{
+		SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+		SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+		SDL_setenv("ALSOFT_DRIVERS", "null", 1);
+
+		// The dummy video driver only has the software renderer, which the engine wouldn't pick by default.
+		SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+	}
+
+	void loadLocation(Game &game, const BenchLocation &location)
+	{
+		constexpr int testIndex2 = 0;
+		constexpr int testWeather = 0;
+		const std::string mifName = MainMenuUiModel::getSelectedTestName(game, location.testType, location.testIndex, testIndex2);
+		const std::optional<ArenaTypes::InteriorType> optInteriorType =
+			MainMenuUiModel::getSelectedTestInteriorType(location.testType, location.testIndex);
+		const ArenaTypes::WeatherType weatherType = MainMenuUiModel::getSelectedTestWeatherType(testWeather);
+		const MapType mapType = MainMenuUiModel::getSelectedTestMapType(location.testType);
+		MainMenuUiController::onQuickStartButtonSelected(game, location.testType, location.testIndex, mifName, optInteriorType,
+			weatherType, mapType);
+
+		// Apply the game world panel now since there is no startup panel to process input events with.
+		game.handlePanelChanges();
+	}
+
+	// Places the camera on a circle around the spawn point, looking along the circle.
+	void updateCamera(Game &game, const WorldDouble3 &center, double radius, double percent)
+	{
+		const double angle = Constants::TwoPi * percent;
+		const double cosAngle = std::cos(angle);
+		const double sinAngle = std::sin(angle);
+		const WorldDouble3 position(center.x + (cosAngle * radius), center.y, center.z + (sinAngle * radius));
+		const WorldDouble3 lookAtPoint(position.x - sinAngle, position.y, position.z + cosAngle);
+
+		Player &player = game.getPlayer();
+		player.teleport(VoxelUtils::worldPointToCoord(position));
+		player.lookAt(VoxelUtils::worldPointToCoord(lookAtPoint));
+		player.setVelocityToZero();
+	}
+
+	std::string makeCsv(const std::vector<BenchFrame> &frames)
+	{
+		std::stringstream ss;
+		ss << "frame,total_ms,input_ms,tick_ms,late_tick_ms,render_ms,render_3d_ms,clean_up_ms,draw_calls,vis_triangles\n";
+		for (int i = 0; i < static_cast<int>(frames.size()); i++)
+		{
+			const BenchFrame &frame = frames[i];
+			const Game::FrameStageTimes &times = frame.stageTimes;
+			ss << i << ',' << (frame.getTotalTime() * 1000.0) << ',' << (times.input * 1000.0) << ',' <<
+				(times.tick * 1000.0) << ',' << (times.lateTick * 1000.0) << ',' << (times.render * 1000.0) << ',' <<
+				(frame.render3DTime * 1000.0) << ',' << (times.cleanUp * 1000.0) << ',' << frame.drawCallCount << ',' <<
+				frame.visTriangleCount << '\n';
+		}
+
+		return ss.str();
+	}
+
+	std::string makeJson(const BenchSettings &settings, const Int2 &renderDims, const std::vector<BenchFrame> &frames)
+	{
+		double totalTimeSum = 0.0;
+		double minTotalTime = 0.0;
+		double maxTotalTime = 0.0;
+		FPSCounter fpsCounter;
+		for (int i = 0; i < static_cast<int>(frames.size()); i++)
+		{
+			const double totalTime = frames[i].getTotalTime();
+			fpsCounter.updateFrameTime(totalTime);
+			totalTimeSum += totalTime;
+			minTotalTime = (i == 0) ? totalTime : std::min(minTotalTime, totalTime);
+			maxTotalTime = (i == 0) ? totalTime : std::max(maxTotalTime, totalTime);
+		}
+
+		const double avgTotalTime = frames.empty() ? 0.0 : (totalTimeSum / static_cast<double>(frames.size()));
+
+		std::stringstream ss;
+		ss << "{\n";
+		ss << "  \"location\": \"" << settings.locationName << "\",\n";
+		ss << "  \"seed\": " << settings.seed << ",\n";
+		ss << "  \"dt\": " << settings.dt << ",\n";
+		ss << "  \"render_width\": " << renderDims.x << ",\n";
+		ss << "  \"render_height\": " << renderDims.y << ",\n";
+		ss << "  \"avg_total_ms\": " << (avgTotalTime * 1000.0) << ",\n";
+		ss << "  \"min_total_ms\": " << (minTotalTime * 1000.0) << ",\n";
+		ss << "  \"max_total_ms\": " << (maxTotalTime * 1000.0) << ",\n";
+		ss << "  \"p99_total_ms\": " << (fpsCounter.getPercentileFrameTime(99.0) * 1000.0) << ",\n";
+		ss << "  \"low_1_percent_fps\": " << fpsCounter.getLowFPS(1.0) << ",\n";
+		ss << "  \"low_0_1_percent_fps\": " << fpsCounter.getLowFPS(0.1) << ",\n";
+		ss << "  \"frames\": [\n";
+		for (int i = 0; i < static_cast<int>(frames.size()); i++)
+		{
+			const BenchFrame &frame = frames[i];
+			const Game::FrameStageTimes &times = frame.stageTimes;
+			ss << "    { \"total_ms\": " << (frame.getTotalTime() * 1000.0) << ", \"input_ms\": " << (times.input * 1000.0) <<
+				", \"tick_ms\": " << (times.tick * 1000.0) << ", \"late_tick_ms\": " << (times.lateTick * 1000.0) <<
+				", \"render_ms\": " << (times.render * 1000.0) << ", \"render_3d_ms\": " << (frame.render3DTime * 1000.0) <<
+				", \"clean_up_ms\": " << (times.cleanUp * 1000.0) << ", \"draw_calls\": " << frame.drawCallCount <<
+				", \"vis_triangles\": " << frame.visTriangleCount << " }";
+			ss << (((i + 1) < static_cast<int>(frames.size())) ? ",\n" : "\n");
+		}
+
+		ss << "  ]\n";
+		ss << "}\n";
+		return ss.str();
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	BenchSettings settings;
+	if (!tryParseArgs(argc, argv, &settings))
+	{
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	const BenchLocation *location = findLocation(settings.locationName);
+	if (location == nullptr)
+	{
+		std::cerr << "Unrecognized location \"" << settings.locationName << "\".\n";
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	if (settings.fuzzDecoderCases > 0)
+	{
+		// Runs before logging is initialized so the forked decoder processes don't inherit the log writer thread.
+		std::vector<DecoderFuzzResult> fuzzResults;
+		int mismatchCount = 0;
+		try
+		{
+			for (const DecoderFuzzFormat &format : DecoderFuzzFormats)
+			{
+				fuzzResults.emplace_back(runDecoderFuzz(format, settings.fuzzDecoderCases, settings.seed));
+				mismatchCount += fuzzResults.back().mismatchCount;
+			}
+		}
+		catch (const std::exception &e)
+		{
+			std::cerr << "Decoder fuzzing failed: " << e.what() << '\n';
+			return EXIT_FAILURE;
+		}
+
+		const bool success = writeReport(makeDecoderFuzzReport(fuzzResults, settings.seed, settings.json), settings.outputPath);
+		return (success && (mismatchCount == 0)) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	const std::string logPath = Platform::getLogPath();
+	if (!Debug::init(logPath.c_str()))
+	{
+		std::cerr << "Couldn't init debug logging.\n";
+		return EXIT_FAILURE;
+	}
+
+	if (settings.poolIterations > 0)
+	{
+		// Pools don't need the engine.
+		std::vector<PoolBenchResult> poolResults;
+		poolResults.emplace_back(runPoolBench<HashSetRecyclablePool<PoolBenchElement, int>>("hashset", settings.poolIterations));
+		poolResults.emplace_back(runPoolBench<RecyclablePool<PoolBenchElement, int>>("generational", settings.poolIterations));
+
+		const bool success = writeReport(makePoolReport(poolResults, settings.poolIterations, settings.json), settings.outputPath);
+		Debug::shutdown();
+		return success ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	initHeadlessDrivers();
+
+	std::vector<BenchFrame> frames;
+	Int2 renderDims;
+	std::vector<DecoderBenchResult> decoderResults;
+	std::vector<DecoderVerifyResult> verifyResults;
+
+	try
+	{
+		// Allocated on the heap to avoid stack overflow warning.
+		std::unique_ptr<Game> game = std::make_unique<Game>();
+		if (!game->init())
+		{
+			DebugCrash("Couldn't init Game instance. Closing.");
+		}
+
+		if (settings.verifyDecoders)
+		{
+			// Cached files skip decoding entirely.
+			AssetCache::shutdown();
+			Compression::setVerifyEnabled(true);
+
+			// Every container that uses the LZ, RLE or RLE word decoders.
+			verifyResults.emplace_back(runDecoderVerify<MIFFile>("*.MIF"));
+			verifyResults.emplace_back(runDecoderVerify<IMGFile>("*.IMG"));
+			verifyResults.emplace_back(runDecoderVerify<CIFFile>("*.CIF"));
+			verifyResults.emplace_back(runDecoderVerify<CFAFile>("*.CFA"));
+			verifyResults.emplace_back(runDecoderVerify<DFAFile>("*.DFA"));
+			verifyResults.emplace_back(runDecoderVerify<RMDFile>("*.RMD"));
+
+			Compression::setVerifyEnabled(false);
+		}
+		else if (settings.decoderIterations > 0)
+		{
+			if (AssetCache::isEnabled())
+			{
+				DebugLogWarning("Asset cache is enabled; cached .CIF files won't be decoded.");
+			}
+
+			// Type 8 (.MIF, .IMG, .CIF), type 4 (.IMG, .CIF), RLE (.CIF) and RLE words (.RMD).
+			decoderResults.emplace_back(runDecoderBench<MIFFile>("*.MIF", settings.decoderIterations));
+			decoderResults.emplace_back(runDecoderBench<IMGFile>("*.IMG", settings.decoderIterations));
+			decoderResults.emplace_back(runDecoderBench<CIFFile>("*.CIF", settings.decoderIterations));
+			decoderResults.emplace_back(runDecoderBench<RMDFile>("*.RMD", settings.decoderIterations));
+		}
+		else
+		{
+			// Deterministic runs: fixed seed, no profiler overlay, and no option changes written back to disk.
+			game->getRandom().init(settings.seed);
+
+			Options &options = game->getOptions();
+			options.setMisc_ProfilerLevel(Options::MIN_PROFILER_LEVEL);
+			if (settings.resolutionScale.has_value())
+			{
+				// The renderer was sized during init so it has to be resized like the options menu does.
+				options.setGraphics_ResolutionScale(*settings.resolutionScale);
+
+				Renderer &renderer = game->getRenderer();
+				const Int2 windowDims = renderer.getWindowDimensions();
+				const bool fullGameWindow = options.getGraphics_ModernInterface();
+				renderer.resize(windowDims.x, windowDims.y, *settings.resolutionScale, fullGameWindow);
+			}
+
+			loadLocation(*game, *location);
+
+			// Warm-up frames let the scene change finish and chunks populate before measuring.
+			for (int i = 0; (i < settings.warmupFrames) && game->isRunning(); i++)
+			{
+				game->runFrame(settings.dt, settings.dt, nullptr);
+			}
+
+			const WorldDouble3 center = VoxelUtils::coordToWorldPoint(game->getPlayer().getPosition());
+			Renderer &renderer = game->getRenderer();
+
+			frames.reserve(settings.frameCount);
+			for (int i = 0; (i < settings.frameCount) && game->isRunning(); i++)
+			{
+				const double percent = static_cast<double>(i) / static_cast<double>(settings.frameCount);
+				updateCamera(*game, center, settings.cameraRadius, percent);
+
+				BenchFrame frame;
+				game->runFrame(settings.dt, settings.dt, &frame.stageTimes);
+
+				// A pipelined frame is still rasterizing here, so wait for it or the profiler data is one frame behind.
+				renderer.finishFrame();
+
+				const Renderer::ProfilerData &profilerData = renderer.getProfilerData();
+				frame.render3DTime = profilerData.frameTime;
+				frame.drawCallCount = profilerData.drawCallCount;
+				frame.visTriangleCount = profilerData.visTriangleCount;
+				renderDims = Int2(profilerData.width, profilerData.height);
+				frames.emplace_back(std::move(frame));
+			}
+
+			if (!settings.dumpPath.empty())
+			{
+				const Surface screenshot = renderer.getScreenshot();
+				if (SDL_SaveBMP(screenshot.get(), settings.dumpPath.c_str()) != 0)
+				{
+					DebugLogError("Couldn't dump frame to \"" + settings.dumpPath + "\": " + std::string(SDL_GetError()));
+				}
+			}
+		}
+	}
+	catch (const std::exception &e)
+	{
+		DebugCrash("Exception: " + std::string(e.what()));
+	}
+
+	std::string report;
+	bool verifyFailed = false;
+	if (settings.verifyDecoders)
+	{
+		report = makeDecoderVerifyReport(verifyResults, settings.json);
+		verifyFailed = Compression::getVerifyMismatchCount() > 0;
+	}
+	else if (settings.decoderIterations > 0)
+	{
+		report = makeDecoderReport(decoderResults, settings.decoderIterations, settings.json);
+	}
+	else
+	{
+		report = settings.json ? makeJson(settings, renderDims, frames) : makeCsv(frames);
+	}
+
+	const bool success = writeReport(report, settings.outputPath) && !verifyFailed;
+	Debug::shutdown();
+
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
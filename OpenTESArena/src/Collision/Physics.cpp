@@ -17,15 +17,21 @@
 #include "../World/MeshUtils.h"
 
 #include "components/debug/Debug.h"
+#include "components/utilities/FrameArena.h"
 
 namespace Physics
 {
+	// Only needed for the duration of a ray cast, so it lives in the frame arena.
+	using EntityVisStateList = FrameVector<EntityVisibilityState3D>;
+	using VoxelEntityMappings = std::unordered_map<VoxelInt3, EntityVisStateList, std::hash<VoxelInt3>, std::equal_to<VoxelInt3>,
+		FrameAllocator<std::pair<const VoxelInt3, EntityVisStateList>>>;
+
 	// Container of the voxels each entity is touching per chunk. Each chunk needs to look at adjacent chunk
 	// entities in case some of them overlap the chunk edge.
 	struct ChunkEntityMap
 	{
 		ChunkInt2 chunk;
-		std::unordered_map<VoxelInt3, std::vector<EntityVisibilityState3D>> mappings;
+		VoxelEntityMappings mappings;
 
 		void init(const ChunkInt2 &chunk)
 		{
@@ -37,10 +43,10 @@ namespace Physics
 			auto iter = this->mappings.find(voxel);
 			if (iter == this->mappings.end())
 			{
-				iter = this->mappings.emplace(voxel, std::vector<EntityVisibilityState3D>()).first;
+				iter = this->mappings.emplace(voxel, EntityVisStateList()).first;
 			}
 
-			std::vector<EntityVisibilityState3D> &visStateList = iter->second;
+			EntityVisStateList &visStateList = iter->second;
 			visStateList.emplace_back(visState);
 		}
 	};
@@ -76,7 +82,7 @@ namespace Physics
 			return count;
 		}();
 
-		Buffer<EntityInstanceID> entityInstIDs(totalNearbyEntities);
+		BufferView<EntityInstanceID> entityInstIDs = FrameArena::allocView<EntityInstanceID>(totalNearbyEntities);
 		entityInstIDs.fill(-1);
 
 		int entityInsertIndex = 0;
@@ -115,11 +121,12 @@ namespace Physics
 		ChunkEntityMap chunkEntityMap;
 		chunkEntityMap.init(chunk);
 
-		// Build mappings of voxels to entities.
+		// Build mappings of voxels to entities. Visibility states come from the entity manager's per-frame cache
+		// when the view is the player's.
+		const CoordDouble2 viewCoordXZ(viewCoord.chunk, VoxelDouble2(viewCoord.point.x, viewCoord.point.z));
 		for (const EntityInstanceID entityInstID : entityInstIDs)
 		{
 			const EntityInstance &entityInst = entityChunkManager.getEntity(entityInstID);
-			const CoordDouble2 viewCoordXZ(viewCoord.chunk, VoxelDouble2(viewCoord.point.x, viewCoord.point.z));
 			EntityVisibilityState3D visState;
 			entityChunkManager.getEntityVisibilityState3D(entityInstID, viewCoordXZ, ceilingScale, voxelChunkManager, visState);
 
@@ -162,7 +169,7 @@ namespace Physics
 	// The given chunk coordinate is known to be loaded.
 	const ChunkEntityMap &getOrAddChunkEntityMap(const ChunkInt2 &chunk, const CoordDouble3 &viewCoord,
 		double ceilingScale, const VoxelChunkManager &voxelChunkManager, const EntityChunkManager &entityChunkManager,
-		const EntityDefinitionLibrary &entityDefLibrary, std::vector<ChunkEntityMap> &chunkEntityMaps)
+		const EntityDefinitionLibrary &entityDefLibrary, FrameVector<ChunkEntityMap> &chunkEntityMaps)
 	{
 		for (const ChunkEntityMap &map : chunkEntityMaps)
 		{
@@ -446,7 +453,7 @@ namespace Physics
 		if (iter != entityMappings.end())
 		{
 			// Iterate over all the entities that cross this voxel and ray test them.
-			const std::vector<EntityVisibilityState3D> &entityVisStateList = iter->second;
+			const EntityVisStateList &entityVisStateList = iter->second;
 			for (const EntityVisibilityState3D &visState : entityVisStateList)
 			{
 				const EntityInstanceID entityInstID = visState.entityInstID;
@@ -491,7 +498,7 @@ namespace Physics
 	void rayCastInternal(const CoordDouble3 &rayCoord, const VoxelDouble3 &rayDirection, const VoxelDouble3 &cameraForward,
 		double ceilingScale, const VoxelChunkManager &voxelChunkManager, const EntityChunkManager &entityChunkManager,
 		const CollisionChunkManager &collisionChunkManager, bool includeEntities, const EntityDefinitionLibrary &entityDefLibrary,
-		const Renderer &renderer, std::vector<ChunkEntityMap> &chunkEntityMaps, Physics::Hit &hit)
+		const Renderer &renderer, FrameVector<ChunkEntityMap> &chunkEntityMaps, Physics::Hit &hit)
 	{
 		// Each flat shares the same axes. Their forward direction always faces opposite to the camera direction.
 		const VoxelDouble3 flatForward = VoxelDouble3(-cameraForward.x, 0.0, -cameraForward.z).normalized();
@@ -833,7 +840,7 @@ bool Physics::rayCast(const CoordDouble3 &rayStart, const VoxelDouble3 &rayDirec
 	hit.setT(Hit::MAX_T);
 
 	// Voxel->entity mappings for each chunk touched by the ray casting loop.
-	std::vector<ChunkEntityMap> chunkEntityMaps;
+	FrameVector<ChunkEntityMap> chunkEntityMaps;
 
 	// Ray cast through the voxel grid, populating the output hit data. Use the ray direction booleans for
 	// better code generation (at the expense of having a pile of if/else branches here).
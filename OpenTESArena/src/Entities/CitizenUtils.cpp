@@ -79,7 +79,7 @@ CitizenUtils::CitizenGenInfo CitizenUtils::makeCitizenGenInfo(int raceID, ArenaT
 		}
 		
 		// Idle animation by default.
-		const std::optional<int> stateIndex = animDef.tryGetStateIndex(EntityAnimationUtils::STATE_IDLE.c_str());
+		const std::optional<int> stateIndex = animDef.tryGetStateIndex(EntityAnimationUtils::getStateIdleID());
 		if (!stateIndex.has_value())
 		{
 			DebugLogError("Couldn't get idle state index for citizen.");
@@ -5,7 +5,6 @@
 
 #include "components/debug/Debug.h"
 #include "components/utilities/String.h"
-#include "components/utilities/StringView.h"
 
 bool EntityAnimationDefinitionState::operator==(const EntityAnimationDefinitionState &other) const
 {
@@ -181,11 +180,16 @@ std::optional<int> EntityAnimationDefinition::tryGetStateIndex(const char *name)
 		return std::nullopt;
 	}
 
-	const std::string_view nameView(name);
+	const AssetNameID nameID = AssetNameTable::getInstance().intern(name);
+	return this->tryGetStateIndex(nameID);
+}
+
+std::optional<int> EntityAnimationDefinition::tryGetStateIndex(AssetNameID nameID) const
+{
 	for (int i = 0; i < this->stateCount; i++)
 	{
 		const EntityAnimationDefinitionState &state = this->states[i];
-		if (StringView::caseInsensitiveEquals(state.name, nameView))
+		if (state.nameID == nameID)
 		{
 			return i;
 		}
@@ -264,6 +268,7 @@ int EntityAnimationDefinition::addState(const char *name, double seconds, bool i
 
 	EntityAnimationDefinitionState &state = this->states[this->stateCount];
 	std::snprintf(state.name, std::size(state.name), "%s", name);
+	state.nameID = AssetNameTable::getInstance().intern(state.name);
 	state.seconds = seconds;
 	state.keyframeListsIndex = this->keyframeListCount;
 	state.keyframeListCount = 0;
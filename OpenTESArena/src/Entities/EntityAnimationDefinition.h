@@ -4,11 +4,13 @@
 #include <optional>
 
 #include "EntityAnimationUtils.h"
+#include "../Assets/AssetNameTable.h"
 #include "../Assets/TextureAsset.h"
 
 struct EntityAnimationDefinitionState
 {
 	char name[EntityAnimationUtils::NAME_LENGTH];
+	AssetNameID nameID; // Interned name for look-ups.
 	double seconds;
 	int keyframeListsIndex;
 	int keyframeListCount;
@@ -58,6 +60,7 @@ struct EntityAnimationDefinition
 	bool operator!=(const EntityAnimationDefinition &other) const;
 
 	std::optional<int> tryGetStateIndex(const char *name) const;
+	std::optional<int> tryGetStateIndex(AssetNameID nameID) const;
 	int getLinearizedKeyframeIndex(int stateIndex, int keyframeListIndex, int keyframeIndex) const;
 
 	int addState(const char *name, double seconds, bool isLooping);
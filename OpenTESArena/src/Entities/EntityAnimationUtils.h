@@ -3,6 +3,8 @@
 
 #include <string>
 
+#include "../Assets/AssetNameTable.h"
+
 namespace EntityAnimationUtils
 {
 	const std::string STATE_IDLE = "Idle";
@@ -12,6 +14,25 @@ namespace EntityAnimationUtils
 	const std::string STATE_DEATH = "Death";
 	const std::string STATE_ACTIVATED = "Activated";
 
+	// Interned state names for per-frame look-ups, interned on first use.
+	inline AssetNameID getStateIdleID()
+	{
+		static const AssetNameID id = AssetNameTable::getInstance().intern(STATE_IDLE);
+		return id;
+	}
+
+	inline AssetNameID getStateWalkID()
+	{
+		static const AssetNameID id = AssetNameTable::getInstance().intern(STATE_WALK);
+		return id;
+	}
+
+	inline AssetNameID getStateActivatedID()
+	{
+		static const AssetNameID id = AssetNameTable::getInstance().intern(STATE_ACTIVATED);
+		return id;
+	}
+
 	// Max length of animation state name.
 	constexpr int NAME_LENGTH = 32;
 }
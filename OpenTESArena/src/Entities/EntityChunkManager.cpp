@@ -70,6 +70,13 @@ const EntityDefinition &EntityChunkManager::getEntityDef(EntityDefID defID) cons
 	}
 }
 
+EntityChunkManager::EntityChunkManager()
+	: visStateCacheEye2D(ChunkInt2::Zero, VoxelDouble2::Zero)
+{
+	this->visStateCacheCeilingScale = 0.0;
+	this->visStateCacheValid = false;
+}
+
 EntityDefID EntityChunkManager::addEntityDef(EntityDefinition &&def, const EntityDefinitionLibrary &defLibrary)
 {
 	const int libraryDefCount = defLibrary.getDefinitionCount();
@@ -406,6 +413,9 @@ void EntityChunkManager::populateChunk(EntityChunk &entityChunk, const VoxelChun
 void EntityChunkManager::updateCitizenStates(double dt, EntityChunk &entityChunk, const CoordDouble2 &playerCoordXZ,
 	bool isPlayerMoving, bool isPlayerWeaponSheathed, Random &random, const VoxelChunkManager &voxelChunkManager)
 {
+	const AssetNameID idleStateNameID = EntityAnimationUtils::getStateIdleID();
+	const AssetNameID walkStateNameID = EntityAnimationUtils::getStateWalkID();
+
 	for (int i = static_cast<int>(entityChunk.entityIDs.size()) - 1; i >= 0; i--)
 	{
 		const EntityInstanceID entityInstID = entityChunk.entityIDs[i];
@@ -423,13 +433,13 @@ void EntityChunkManager::updateCitizenStates(double dt, EntityChunk &entityChunk
 		const EntityDefinition &entityDef = this->getEntityDef(entityInst.defID);
 		const EntityAnimationDefinition &animDef = entityDef.getAnimDef();
 
-		const std::optional<int> idleStateIndex = animDef.tryGetStateIndex(EntityAnimationUtils::STATE_IDLE.c_str());
+		const std::optional<int> idleStateIndex = animDef.tryGetStateIndex(idleStateNameID);
 		if (!idleStateIndex.has_value())
 		{
 			DebugCrash("Couldn't get citizen idle state index.");
 		}
 
-		const std::optional<int> walkStateIndex = animDef.tryGetStateIndex(EntityAnimationUtils::STATE_WALK.c_str());
+		const std::optional<int> walkStateIndex = animDef.tryGetStateIndex(walkStateNameID);
 		if (!walkStateIndex.has_value())
 		{
 			DebugCrash("Couldn't get citizen walk state index.");
@@ -611,6 +621,8 @@ const VoxelDouble2 &EntityChunkManager::getEntityDirection(EntityDirectionID id)
 
 EntityAnimationInstance &EntityChunkManager::getEntityAnimationInstance(EntityAnimationInstanceID id)
 {
+	// The caller might change the animation state.
+	this->invalidateVisibilityStateCache();
 	return this->animInsts.get(id);
 }
 
@@ -703,7 +715,7 @@ BufferView<const EntityInstanceID> EntityChunkManager::getQueuedDestroyEntityIDs
 	return this->destroyedEntityIDs;
 }
 
-void EntityChunkManager::getEntityVisibilityState2D(EntityInstanceID id, const CoordDouble2 &eye2D, EntityVisibilityState2D &outVisState) const
+void EntityChunkManager::calculateEntityVisibilityState2D(EntityInstanceID id, const CoordDouble2 &eye2D, EntityVisibilityState2D &outVisState) const
 {
 	const EntityInstance &entityInst = this->entities.get(id);
 	const EntityDefinition &entityDef = this->getEntityDef(entityInst.defID);
@@ -780,11 +792,11 @@ void EntityChunkManager::getEntityVisibilityState2D(EntityInstanceID id, const C
 	outVisState.init(id, flatPosition, stateIndex, angleIndex, keyframeIndex);
 }
 
-void EntityChunkManager::getEntityVisibilityState3D(EntityInstanceID id, const CoordDouble2 &eye2D,
+void EntityChunkManager::calculateEntityVisibilityState3D(EntityInstanceID id, const CoordDouble2 &eye2D,
 	double ceilingScale, const VoxelChunkManager &voxelChunkManager, EntityVisibilityState3D &outVisState) const
 {
 	EntityVisibilityState2D visState2D;
-	this->getEntityVisibilityState2D(id, eye2D, visState2D);
+	this->calculateEntityVisibilityState2D(id, eye2D, visState2D);
 
 	const EntityInstance &entityInst = this->entities.get(id);
 	const EntityDefinition &entityDef = this->getEntityDef(entityInst.defID);
@@ -834,6 +846,92 @@ void EntityChunkManager::getEntityVisibilityState3D(EntityInstanceID id, const C
 	outVisState.init(id, flatPosition, visState2D.stateIndex, visState2D.angleIndex, visState2D.keyframeIndex);
 }
 
+const EntityVisibilityState3D *EntityChunkManager::tryGetCachedVisibilityState(EntityInstanceID id, const CoordDouble2 &eye2D) const
+{
+	if (!this->visStateCacheValid || (id < 0))
+	{
+		return nullptr;
+	}
+
+	const int slotIndex = EntityPool::getSlotIndex(id);
+	if (slotIndex >= static_cast<int>(this->visStateCache.size()))
+	{
+		return nullptr;
+	}
+
+	// Other eyes (i.e. a second camera) need their own calculation since angle indices depend on the eye.
+	const CoordDouble2 &cacheEye2D = this->visStateCacheEye2D;
+	if ((eye2D.chunk != cacheEye2D.chunk) || (eye2D.point.x != cacheEye2D.point.x) || (eye2D.point.y != cacheEye2D.point.y))
+	{
+		return nullptr;
+	}
+
+	const EntityVisibilityState3D &visState = this->visStateCache[slotIndex];
+	if (visState.entityInstID != id)
+	{
+		return nullptr;
+	}
+
+	return &visState;
+}
+
+void EntityChunkManager::getEntityVisibilityState2D(EntityInstanceID id, const CoordDouble2 &eye2D, EntityVisibilityState2D &outVisState) const
+{
+	const EntityVisibilityState3D *cachedVisState = this->tryGetCachedVisibilityState(id, eye2D);
+	if (cachedVisState != nullptr)
+	{
+		const CoordDouble3 &flatPosition = cachedVisState->flatPosition;
+		outVisState.init(id, CoordDouble2(flatPosition.chunk, VoxelDouble2(flatPosition.point.x, flatPosition.point.z)),
+			cachedVisState->stateIndex, cachedVisState->angleIndex, cachedVisState->keyframeIndex);
+		return;
+	}
+
+	this->calculateEntityVisibilityState2D(id, eye2D, outVisState);
+}
+
+void EntityChunkManager::getEntityVisibilityState3D(EntityInstanceID id, const CoordDouble2 &eye2D,
+	double ceilingScale, const VoxelChunkManager &voxelChunkManager, EntityVisibilityState3D &outVisState) const
+{
+	const EntityVisibilityState3D *cachedVisState = this->tryGetCachedVisibilityState(id, eye2D);
+	if ((cachedVisState != nullptr) && (ceilingScale == this->visStateCacheCeilingScale))
+	{
+		outVisState = *cachedVisState;
+		return;
+	}
+
+	this->calculateEntityVisibilityState3D(id, eye2D, ceilingScale, voxelChunkManager, outVisState);
+}
+
+void EntityChunkManager::updateVisibilityStateCache(const CoordDouble2 &eye2D, double ceilingScale,
+	const VoxelChunkManager &voxelChunkManager)
+{
+	// Indexed by pool slot so the cache doesn't need hashing.
+	this->visStateCache.resize(this->entities.getTotalCount());
+	for (EntityVisibilityState3D &visState : this->visStateCache)
+	{
+		visState.entityInstID = -1;
+	}
+
+	for (const ChunkPtr &chunkPtr : this->activeChunks)
+	{
+		for (const EntityInstanceID entityInstID : chunkPtr->entityIDs)
+		{
+			const int slotIndex = EntityPool::getSlotIndex(entityInstID);
+			DebugAssertIndex(this->visStateCache, slotIndex);
+			this->calculateEntityVisibilityState3D(entityInstID, eye2D, ceilingScale, voxelChunkManager, this->visStateCache[slotIndex]);
+		}
+	}
+
+	this->visStateCacheEye2D = eye2D;
+	this->visStateCacheCeilingScale = ceilingScale;
+	this->visStateCacheValid = true;
+}
+
+void EntityChunkManager::invalidateVisibilityStateCache()
+{
+	this->visStateCacheValid = false;
+}
+
 void EntityChunkManager::updateCreatureSounds(double dt, EntityChunk &entityChunk, const CoordDouble3 &playerCoord,
 	double ceilingScale, Random &random, AudioManager &audioManager)
 {
@@ -884,6 +982,8 @@ void EntityChunkManager::update(double dt, BufferView<const ChunkInt2> activeChu
 	const EntityDefinitionLibrary &entityDefLibrary = EntityDefinitionLibrary::getInstance();
 	const BinaryAssetLibrary &binaryAssetLibrary = BinaryAssetLibrary::getInstance();
 
+	this->invalidateVisibilityStateCache();
+
 	for (const ChunkInt2 &chunkPos : freedChunkPositions)
 	{
 		const int chunkIndex = this->getChunkIndex(chunkPos);
@@ -948,6 +1048,8 @@ void EntityChunkManager::update(double dt, BufferView<const ChunkInt2> activeChu
 
 		this->updateCreatureSounds(dt, entityChunk, playerCoord, ceilingScale, random, audioManager);
 	}
+
+	this->updateVisibilityStateCache(playerCoordXZ, ceilingScale, voxelChunkManager);
 }
 
 void EntityChunkManager::queueEntityDestroy(EntityInstanceID entityInstID)
@@ -961,6 +1063,11 @@ void EntityChunkManager::queueEntityDestroy(EntityInstanceID entityInstID)
 
 void EntityChunkManager::cleanUp()
 {
+	if (!this->destroyedEntityIDs.empty())
+	{
+		this->invalidateVisibilityStateCache();
+	}
+
 	for (const EntityInstanceID entityInstID : this->destroyedEntityIDs)
 	{
 		const EntityInstance &entityInst = this->entities.get(entityInstID);
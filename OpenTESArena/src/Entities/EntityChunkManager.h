@@ -8,6 +8,7 @@
 #include "EntityGeneration.h"
 #include "EntityInstance.h"
 #include "EntityUtils.h"
+#include "EntityVisibilityState.h"
 #include "../Math/BoundingBox.h"
 #include "../World/SpecializedChunkManager.h"
 
@@ -26,8 +27,6 @@ class TextureManager;
 class VoxelChunk;
 class VoxelChunkManager;
 
-struct EntityVisibilityState2D;
-struct EntityVisibilityState3D;
 struct MapSubDefinition;
 
 class EntityChunkManager final : public SpecializedChunkManager<EntityChunk>
@@ -64,6 +63,14 @@ private:
 	// was unloaded, or they were otherwise despawned. Cleared at end-of-frame.
 	std::vector<EntityInstanceID> destroyedEntityIDs;
 
+	// Visibility states of every active entity relative to the player, indexed by entity pool slot. Built once
+	// at the end of update() so rendering and ray casts don't each redo the angle and keyframe math per entity.
+	// Entries with an invalid entity instance ID weren't active when the cache was built.
+	std::vector<EntityVisibilityState3D> visStateCache;
+	CoordDouble2 visStateCacheEye2D;
+	double visStateCacheCeilingScale;
+	bool visStateCacheValid;
+
 	EntityDefID addEntityDef(EntityDefinition &&def, const EntityDefinitionLibrary &defLibrary);
 	EntityDefID getOrAddEntityDefID(const EntityDefinition &def, const EntityDefinitionLibrary &defLibrary);
 
@@ -86,7 +93,17 @@ private:
 	std::string getCreatureSoundFilename(const EntityDefID defID) const;
 	void updateCreatureSounds(double dt, EntityChunk &entityChunk, const CoordDouble3 &playerCoord,
 		double ceilingScale, Random &random, AudioManager &audioManager);
+
+	void calculateEntityVisibilityState2D(EntityInstanceID id, const CoordDouble2 &eye2D, EntityVisibilityState2D &outVisState) const;
+	void calculateEntityVisibilityState3D(EntityInstanceID id, const CoordDouble2 &eye2D, double ceilingScale,
+		const VoxelChunkManager &voxelChunkManager, EntityVisibilityState3D &outVisState) const;
+
+	const EntityVisibilityState3D *tryGetCachedVisibilityState(EntityInstanceID id, const CoordDouble2 &eye2D) const;
+	void updateVisibilityStateCache(const CoordDouble2 &eye2D, double ceilingScale, const VoxelChunkManager &voxelChunkManager);
+	void invalidateVisibilityStateCache();
 public:
+	EntityChunkManager();
+
 	const EntityDefinition &getEntityDef(EntityDefID defID) const;
 	const EntityInstance &getEntity(EntityInstanceID id) const;
 	const CoordDouble2 &getEntityPosition(EntityPositionID id) const;
@@ -106,7 +123,8 @@ public:
 	int getCountInChunkWithCreatureSound(const ChunkInt2 &chunkPos) const;
 	int getCountInChunkWithCitizenDirection(const ChunkInt2 &chunkPos) const;
 
-	// Gets the entity visibility data necessary for rendering and ray cast selection.
+	// Gets the entity visibility data necessary for rendering and ray cast selection. Reads from the per-frame
+	// cache when the eye is the player position it was built for.
 	void getEntityVisibilityState2D(EntityInstanceID id, const CoordDouble2 &eye2D, EntityVisibilityState2D &outVisState) const;
 	void getEntityVisibilityState3D(EntityInstanceID id, const CoordDouble2 &eye2D, double ceilingScale,
 		const VoxelChunkManager &voxelChunkManager, EntityVisibilityState3D &outVisState) const;
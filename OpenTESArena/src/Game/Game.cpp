@@ -5,7 +5,6 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
-#include <thread>
 
 #include "SDL.h"
 
@@ -13,6 +12,7 @@
 #include "Options.h"
 #include "PlayerInterface.h"
 #include "../Assets/ArenaLevelLibrary.h"
+#include "../Assets/AssetCache.h"
 #include "../Assets/BinaryAssetLibrary.h"
 #include "../Assets/CityDataFile.h"
 #include "../Assets/TextAssetLibrary.h"
@@ -34,11 +34,14 @@
 #include "../UI/FontLibrary.h"
 #include "../UI/GuiUtils.h"
 #include "../UI/Surface.h"
+#include "../UI/TextRenderCache.h"
 #include "../Utilities/Platform.h"
 
 #include "components/debug/Debug.h"
 #include "components/utilities/Directory.h"
 #include "components/utilities/File.h"
+#include "components/utilities/FrameArena.h"
+#include "components/utilities/FramePacer.h"
 #include "components/utilities/Path.h"
 #include "components/utilities/String.h"
 #include "components/utilities/TextLinesFile.h"
@@ -74,6 +77,15 @@ namespace
 	}
 }
 
+Game::FrameStageTimes::FrameStageTimes()
+{
+	this->input = 0.0;
+	this->tick = 0.0;
+	this->lateTick = 0.0;
+	this->render = 0.0;
+	this->cleanUp = 0.0;
+}
+
 Game::Game()
 {
 	// Keeps us from deleting a sub-panel the same frame it's in use. The pop is delayed until the
@@ -114,6 +126,8 @@ Game::~Game()
 
 	RenderWeatherManager &renderWeatherManager = this->sceneManager.renderWeatherManager;
 	renderWeatherManager.shutdown(this->renderer);
+
+	TextRenderCache::shutdown(this->renderer);
 }
 
 bool Game::init()
@@ -130,6 +144,16 @@ bool Game::init()
 	const std::string optionsPath = Platform::getOptionsPath();
 	this->initOptions(basePath, optionsPath);
 
+	Debug::setMinimumType(static_cast<DebugMessageType>(this->options.getMisc_LogLevel()));
+	const std::string &logDisabledCategories = this->options.getMisc_LogDisabledCategories();
+	if (!logDisabledCategories.empty())
+	{
+		for (const std::string &category : String::split(logDisabledCategories, ','))
+		{
+			Debug::setCategoryEnabled(String::trim(category), false);
+		}
+	}
+
 	const std::string &arenaPath = this->options.getMisc_ArenaPath();
 	DebugLog("Using ArenaPath \"" + arenaPath + "\".");
 
@@ -143,6 +167,12 @@ bool Game::init()
 	}
 
 	VFS::Manager::get().initialize(std::string(vfsFolderPath));
+	VFS::Manager::get().setWatchForChanges(this->options.getMisc_WatchDataFolders());
+
+	if (this->options.getMisc_AssetCache())
+	{
+		AssetCache::init(Platform::getAssetCachePath());
+	}
 
 	// Determine which game version the data path is pointing to.
 	std::string arenaExePath;
@@ -301,6 +331,26 @@ Panel *Game::getActivePanel() const
 	return (this->subPanels.size() > 0) ? this->subPanels.back().get() : this->panel.get();
 }
 
+bool Game::initRecording(const std::string &filename)
+{
+	// Reseed from the time-seeded generator so the seeds are known and can be saved.
+	const int randomSeed = this->random.next();
+	this->random.init(randomSeed);
+	return this->replaySession.initRecord(filename, randomSeed, this->arenaRandom.getSeed());
+}
+
+bool Game::initReplay(const std::string &filename)
+{
+	if (!this->replaySession.initReplay(filename))
+	{
+		return false;
+	}
+
+	this->random.init(this->replaySession.getRandomSeed());
+	this->arenaRandom.srand(this->replaySession.getArenaRandomSeed());
+	return true;
+}
+
 AudioManager &Game::getAudioManager()
 {
 	return this->audioManager;
@@ -435,6 +485,11 @@ void Game::setGameWorldRenderCallback(const GameWorldRenderCallback &callback)
 	this->gameWorldRenderCallback = callback;
 }
 
+bool Game::isRunning() const
+{
+	return this->running;
+}
+
 void Game::initOptions(const std::string &basePath, const std::string &optionsPath)
 {
 	// Load the default options first.
@@ -612,6 +667,13 @@ void Game::renderDebugInfo()
 		const std::string highestFrameTimeText = String::fixedPrecision(highestFrameTimeMS, 1);
 		debugText.append("FPS: " + averageFpsText + " (" + averageFrameTimeText + "ms " + lowestFrameTimeText +
 			"ms " + highestFrameTimeText + "ms)");
+
+		// Lows over a longer history show stutter that the average hides.
+		const std::string onePercentLowFpsText = String::fixedPrecision(this->fpsCounter.getLowFPS(1.0), 0);
+		const std::string pointOnePercentLowFpsText = String::fixedPrecision(this->fpsCounter.getLowFPS(0.1), 0);
+		const std::string p99FrameTimeText = String::fixedPrecision(this->fpsCounter.getPercentileFrameTime(99.0) * 1000.0, 1);
+		debugText.append("\nLows: " + onePercentLowFpsText + " (1%) " + pointOnePercentLowFpsText + " (0.1%), p99 " +
+			p99FrameTimeText + "ms");
 	}
 
 	const Int2 windowDims = this->renderer.getWindowDimensions();
@@ -635,13 +697,26 @@ void Game::renderDebugInfo()
 			const std::string renderTime = String::fixedPrecision(profilerData.frameTime * 1000.0, 2);
 			const std::string renderDrawCallCount = std::to_string(profilerData.drawCallCount);
 			const std::string objectTextureMbCount = String::fixedPrecision(static_cast<double>(profilerData.objectTextureByteCount) / (1024.0 * 1024.0), 2);
+			const std::string geometryMbCount = String::fixedPrecision(static_cast<double>(profilerData.geometryByteCount) / (1024.0 * 1024.0), 2);
+			const std::string geometryReservedMbCount = String::fixedPrecision(static_cast<double>(profilerData.geometryReservedByteCount) / (1024.0 * 1024.0), 2);
+			const TextureManager::ResidencyStats &residencyStats = this->textureManager.getResidencyStats();
+			const std::string textureCacheMbCount = String::fixedPrecision(static_cast<double>(residencyStats.residentByteCount) / (1024.0 * 1024.0), 2);
+			const std::string textureCacheHitPercent = String::fixedPrecision(residencyStats.getHitPercent(), 1);
 			debugText.append("\nRender: " + renderWidth + "x" + renderHeight + " (" + renderResScale + "), " +
 				renderThreadCount + " thread" + ((profilerData.threadCount > 1) ? "s" : "") + '\n' +
 				"3D render: " + renderTime + "ms" + '\n' +
 				"Textures: " + std::to_string(profilerData.objectTextureCount) + " (" + objectTextureMbCount + "MB)" + '\n' +
+				"Texture cache: " + textureCacheMbCount + "MB, " + textureCacheHitPercent + "% hits, " +
+				std::to_string(residencyStats.evictionCount) + " evictions" + '\n' +
+				"Geometry: " + geometryMbCount + "MB / " + geometryReservedMbCount + "MB in " +
+				std::to_string(profilerData.geometrySlabCount) + " slab" + ((profilerData.geometrySlabCount != 1) ? "s" : "") + '\n' +
 				"Draw calls: " + renderDrawCallCount + '\n' +
 				"Triangles: " + std::to_string(profilerData.visTriangleCount) + " / " + std::to_string(profilerData.sceneTriangleCount) + '\n' +
 				"Lights: " + std::to_string(profilerData.totalLightCount));
+
+			const std::string frameArenaKbCount = String::fixedPrecision(static_cast<double>(FrameArena::getLastFrameArenaByteCount()) / 1024.0, 1);
+			const std::string frameHeapKbCount = String::fixedPrecision(static_cast<double>(FrameArena::getLastFrameHeapByteCount()) / 1024.0, 1);
+			debugText.append("\nFrame arena: " + frameArenaKbCount + "KB, " + frameHeapKbCount + "KB heap overflow");
 		}
 		else
 		{
@@ -685,6 +760,228 @@ void Game::renderDebugInfo()
 	this->renderer.draw(&renderElement, 1, renderSpace);
 }
 
+void Game::updateInput(double dt, double clampedDt)
+{
+	try
+	{
+		const BufferView<const ButtonProxy> buttonProxies = this->getActivePanel()->getButtonProxies();
+		auto onFinishedProcessingEventFunc = [this]()
+		{
+			// See if the event requested any changes in active panels.
+			this->handlePanelChanges();
+		};
+
+		this->inputManager.update(*this, dt, buttonProxies, onFinishedProcessingEventFunc);
+
+		if (this->isSimulatingScene())
+		{
+			// Handle input for player motion.
+			const BufferView<const Rect> nativeCursorRegionsView(this->nativeCursorRegions);
+			const Double2 playerTurnDeltaXY = PlayerLogicController::makeTurningAngularValues(*this, clampedDt, nativeCursorRegionsView);
+			PlayerLogicController::turnPlayer(*this, playerTurnDeltaXY.x, playerTurnDeltaXY.y);
+			PlayerLogicController::handlePlayerMovement(*this, clampedDt, nativeCursorRegionsView);
+		}
+	}
+	catch (const std::exception &e)
+	{
+		DebugCrash("User input exception: " + std::string(e.what()));
+	}
+}
+
+void Game::tick(double clampedDt)
+{
+	try
+	{
+		// Animate the current UI panel by delta time.
+		this->getActivePanel()->tick(clampedDt);
+
+		// See if the panel tick requested any changes in active panels.
+		this->handlePanelChanges();
+
+		if (this->isSimulatingScene() && this->gameState.isActiveMapValid())
+		{
+			// Recalculate the active chunks.
+			const CoordDouble3 playerCoord = this->player.getPosition();
+			const int chunkDistance = this->options.getMisc_ChunkDistance();
+			ChunkManager &chunkManager = this->sceneManager.chunkManager;
+			chunkManager.update(playerCoord.chunk, chunkDistance);
+
+			// @todo: we should be able to get the voxel/entity/collision/etc. managers right here.
+			// It shouldn't be abstracted into a game state.
+			// - it should be like "do we need to clear the scene? yes/no. update the scene immediately? yes/no"
+
+			// Tick the various pieces of game world state.
+			this->gameState.tickGameClock(clampedDt, *this);
+			this->gameState.tickChasmAnimation(clampedDt);
+			this->gameState.tickSky(clampedDt, *this);
+			this->gameState.tickWeather(clampedDt, *this);
+			this->gameState.tickUiMessages(clampedDt);
+			this->gameState.tickPlayer(clampedDt, *this);
+			this->gameState.tickVoxels(clampedDt, *this);
+			this->gameState.tickEntities(clampedDt, *this);
+			this->gameState.tickCollision(clampedDt, *this);
+			this->gameState.tickRendering(*this);
+
+			// Update audio listener orientation.
+			const WorldDouble3 absolutePosition = VoxelUtils::coordToWorldPoint(playerCoord);
+			const WorldDouble3 &direction = this->player.getDirection();
+			const AudioManager::ListenerData listenerData(absolutePosition, direction);
+			this->audioManager.updateListener(listenerData);
+		}
+
+		this->audioManager.updateSources();
+	}
+	catch (const std::exception &e)
+	{
+		DebugCrash("Tick exception: " + std::string(e.what()));
+	}
+}
+
+void Game::lateTick(double clampedDt)
+{
+	// User input, ticking the active panel, and simulating the game state all have the potential
+	// to queue a scene change which needs to be fully processed before we render.
+	try
+	{
+		// Pick up data folder changes before a scene change can load from them.
+		VFS::Manager::get().pollChanges();
+
+		if (this->gameState.hasPendingSceneChange())
+		{
+			this->gameState.applyPendingSceneChange(*this, clampedDt);
+		}
+	}
+	catch (const std::exception &e)
+	{
+		DebugCrash("Late tick exception: " + std::string(e.what()));
+	}
+}
+
+void Game::render()
+{
+	try
+	{
+		// Get the draw calls from each UI panel/sub-panel and determine what to draw.
+		std::vector<const Panel*> panelsToRender;
+		panelsToRender.emplace_back(this->panel.get());
+		for (const auto &subPanel : this->subPanels)
+		{
+			panelsToRender.emplace_back(subPanel.get());
+		}
+
+		this->renderer.clear();
+
+		if (this->gameWorldRenderCallback)
+		{
+			if (!this->gameWorldRenderCallback(*this))
+			{
+				DebugLogError("Couldn't render game world.");
+			}
+		}
+
+		const Int2 windowDims = this->renderer.getWindowDimensions();
+
+		for (const Panel *currentPanel : panelsToRender)
+		{
+			const BufferView<const UiDrawCall> drawCallsView = currentPanel->getDrawCalls();
+			for (const UiDrawCall &drawCall : drawCallsView)
+			{
+				if (!drawCall.isActive())
+				{
+					continue;
+				}
+
+				const std::optional<Rect> &optClipRect = drawCall.getClipRect();
+				if (optClipRect.has_value())
+				{
+					const SDL_Rect clipRect = optClipRect->getSdlRect();
+					this->renderer.setClipRect(&clipRect);
+				}
+
+				const UiTextureID textureID = drawCall.getTextureID();
+				const Int2 position = drawCall.getPosition();
+				const Int2 size = drawCall.getSize();
+				const PivotType pivotType = drawCall.getPivotType();
+				const RenderSpace renderSpace = drawCall.getRenderSpace();
+
+				double xPercent, yPercent, wPercent, hPercent;
+				GuiUtils::makeRenderElementPercents(position.x, position.y, size.x, size.y, windowDims.x, windowDims.y,
+					renderSpace, pivotType, &xPercent, &yPercent, &wPercent, &hPercent);
+
+				const RendererSystem2D::RenderElement renderElement(textureID, xPercent, yPercent, wPercent, hPercent);
+				this->renderer.draw(&renderElement, 1, renderSpace);
+
+				if (optClipRect.has_value())
+				{
+					this->renderer.setClipRect(nullptr);
+				}
+			}
+		}
+
+		this->renderDebugInfo();
+		this->renderer.present();
+	}
+	catch (const std::exception &e)
+	{
+		DebugCrash("Render exception: " + std::string(e.what()));
+	}
+}
+
+void Game::cleanUpFrame()
+{
+	try
+	{
+		this->sceneManager.cleanUp();
+
+		const int64_t textureCacheBudget = static_cast<int64_t>(this->options.getGraphics_TextureCacheBudgetMB()) * 1024 * 1024;
+		this->textureManager.updateResidency(textureCacheBudget);
+	}
+	catch (const std::exception &e)
+	{
+		DebugCrash("Clean-up exception: " + std::string(e.what()));
+	}
+}
+
+void Game::runFrame(double dt, double clampedDt, FrameStageTimes *outStageTimes)
+{
+	using Clock = std::chrono::high_resolution_clock;
+	auto getSecondsSince = [](const Clock::time_point &startTime)
+	{
+		const std::chrono::duration<double> elapsed = Clock::now() - startTime;
+		return elapsed.count();
+	};
+
+	auto stageStartTime = Clock::now();
+	this->updateInput(dt, clampedDt);
+	const double inputTime = getSecondsSince(stageStartTime);
+
+	stageStartTime = Clock::now();
+	this->tick(clampedDt);
+	const double tickTime = getSecondsSince(stageStartTime);
+
+	stageStartTime = Clock::now();
+	this->lateTick(clampedDt);
+	const double lateTickTime = getSecondsSince(stageStartTime);
+
+	stageStartTime = Clock::now();
+	this->render();
+	const double renderTime = getSecondsSince(stageStartTime);
+
+	stageStartTime = Clock::now();
+	this->cleanUpFrame();
+	FrameArena::reset();
+	const double cleanUpTime = getSecondsSince(stageStartTime);
+
+	if (outStageTimes != nullptr)
+	{
+		outStageTimes->input = inputTime;
+		outStageTimes->tick = tickTime;
+		outStageTimes->lateTick = lateTickTime;
+		outStageTimes->render = renderTime;
+		outStageTimes->cleanUp = cleanUpTime;
+	}
+}
+
 void Game::loop()
 {
 	// Initialize panel and music to default (bootstrapping the first game frame).
@@ -711,224 +1008,66 @@ void Game::loop()
 
 	// Longest allowed frame time.
 	const std::chrono::duration<int64_t, std::nano> maxFrameTime(timeUnits / Options::MIN_FPS);
+	constexpr double timeUnitsReal = static_cast<double>(timeUnits);
+	const double maxFrameTimeReal = static_cast<double>(maxFrameTime.count()) / timeUnitsReal;
 
-	// On some platforms, thread sleeping takes longer than it should, so include a value to
-	// help compensate.
-	std::chrono::nanoseconds sleepBias(0);
-
-	auto thisTime = std::chrono::high_resolution_clock::now();
+	FramePacer framePacer;
 
 	// Primary game loop.
 	while (this->running)
 	{
-		const auto lastTime = thisTime;
-		thisTime = std::chrono::high_resolution_clock::now();
-
-		// Shortest allowed frame time.
-		const std::chrono::duration<int64_t, std::nano> minFrameTime(
-			timeUnits / this->options.getGraphics_TargetFPS());
-
-		// Time since the last frame started.
-		const auto frameTime = [minFrameTime, &sleepBias, &thisTime, lastTime]()
+		const ReplaySession::Mode replayMode = this->replaySession.getMode();
+		double dt, realDt;
+		if (replayMode == ReplaySession::Mode::Replay)
 		{
-			// Delay the current frame if the previous one was too fast.
-			auto diff = thisTime - lastTime;
-			if (diff < minFrameTime)
+			if (this->replaySession.isReplayFinished())
 			{
-				const auto sleepTime = minFrameTime - diff + sleepBias;
-				std::this_thread::sleep_for(sleepTime);
-
-				// Compensate for sleeping too long. Thread sleeping has questionable accuracy.
-				const auto tempTime = std::chrono::high_resolution_clock::now();
-				const auto unnecessarySleepTime = [thisTime, sleepTime, tempTime]()
-				{
-					const auto tempFrameTime = tempTime - thisTime;
-					return tempFrameTime - sleepTime;
-				}();
-
-				sleepBias = -unnecessarySleepTime;
-				thisTime = tempTime;
-				diff = thisTime - lastTime;
+				break;
 			}
 
-			return diff;
-		}();
-
-		// Two delta times: actual and clamped. Use the clamped delta time for game calculations
-		// so things don't break at low frame rates.
-		constexpr double timeUnitsReal = static_cast<double>(timeUnits);
-		const double dt = static_cast<double>(frameTime.count()) / timeUnitsReal;
-		const double clampedDt = std::fmin(frameTime.count(), maxFrameTime.count()) / timeUnitsReal;
-
-		// Update FPS counter.
-		this->fpsCounter.updateFrameTime(dt);
-
-		// User input.
-		try
-		{
-			const BufferView<const ButtonProxy> buttonProxies = this->getActivePanel()->getButtonProxies();
-			auto onFinishedProcessingEventFunc = [this]()
-			{
-				// See if the event requested any changes in active panels.
-				this->handlePanelChanges();
-			};
-
-			this->inputManager.update(*this, dt, buttonProxies, onFinishedProcessingEventFunc);
-
-			if (this->isSimulatingScene())
-			{
-				// Handle input for player motion.
-				const BufferView<const Rect> nativeCursorRegionsView(this->nativeCursorRegions);
-				const Double2 playerTurnDeltaXY = PlayerLogicController::makeTurningAngularValues(*this, clampedDt, nativeCursorRegionsView);
-				PlayerLogicController::turnPlayer(*this, playerTurnDeltaXY.x, playerTurnDeltaXY.y);
-				PlayerLogicController::handlePlayerMovement(*this, clampedDt, nativeCursorRegionsView);
-			}
+			// Replays run as fast as possible with the recorded delta times so every run reaches the same state.
+			realDt = framePacer.startFrameNow();
+			dt = this->replaySession.getReplayDeltaTime();
+			this->inputManager.setReplayFrame(this->replaySession.getReplayInput());
 		}
-		catch (const std::exception &e)
-		{
-			DebugCrash("User input exception: " + std::string(e.what()));
-		}
-
-		// Tick.
-		try
+		else
 		{
-			// Animate the current UI panel by delta time.
-			this->getActivePanel()->tick(clampedDt);
-
-			// See if the panel tick requested any changes in active panels.
-			this->handlePanelChanges();
-
-			if (this->isSimulatingScene() && this->gameState.isActiveMapValid())
+			// Shortest allowed frame time.
+			std::chrono::nanoseconds minFrameTime(timeUnits / this->options.getGraphics_TargetFPS());
+			if (this->options.getGraphics_AlignFramesToRefreshRate())
 			{
-				// Recalculate the active chunks.
-				const CoordDouble3 playerCoord = this->player.getPosition();
-				const int chunkDistance = this->options.getMisc_ChunkDistance();
-				ChunkManager &chunkManager = this->sceneManager.chunkManager;
-				chunkManager.update(playerCoord.chunk, chunkDistance);
-
-				// @todo: we should be able to get the voxel/entity/collision/etc. managers right here.
-				// It shouldn't be abstracted into a game state.
-				// - it should be like "do we need to clear the scene? yes/no. update the scene immediately? yes/no"
-
-				// Tick the various pieces of game world state.
-				this->gameState.tickGameClock(clampedDt, *this);
-				this->gameState.tickChasmAnimation(clampedDt);
-				this->gameState.tickSky(clampedDt, *this);
-				this->gameState.tickWeather(clampedDt, *this);
-				this->gameState.tickUiMessages(clampedDt);
-				this->gameState.tickPlayer(clampedDt, *this);
-				this->gameState.tickVoxels(clampedDt, *this);
-				this->gameState.tickEntities(clampedDt, *this);
-				this->gameState.tickCollision(clampedDt, *this);
-				this->gameState.tickRendering(*this);
-
-				// Update audio listener orientation.
-				const WorldDouble3 absolutePosition = VoxelUtils::coordToWorldPoint(playerCoord);
-				const WorldDouble3 &direction = this->player.getDirection();
-				const AudioManager::ListenerData listenerData(absolutePosition, direction);
-				this->audioManager.updateListener(listenerData);
+				const int refreshRate = this->renderer.getWindowRefreshRate();
+				minFrameTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+					FramePacer::makeRefreshAlignedPeriod(minFrameTime, refreshRate));
 			}
 
-			this->audioManager.updateSources();
-		}
-		catch (const std::exception &e)
-		{
-			DebugCrash("Tick exception: " + std::string(e.what()));
-		}
-
-		// Late tick. User input, ticking the active panel, and simulating the game state all have the potential
-		// to queue a scene change which needs to be fully processed before we render.
-		try
-		{
-			if (this->gameState.hasPendingSceneChange())
-			{
-				this->gameState.applyPendingSceneChange(*this, clampedDt);
-			}
-		}
-		catch (const std::exception &e)
-		{
-			DebugCrash("Late tick exception: " + std::string(e.what()));
+			dt = framePacer.waitForNextFrame(minFrameTime);
+			realDt = dt;
 		}
 
-		// Render.
-		try
-		{
-			// Get the draw calls from each UI panel/sub-panel and determine what to draw.
-			std::vector<const Panel*> panelsToRender;
-			panelsToRender.emplace_back(this->panel.get());
-			for (const auto &subPanel : this->subPanels)
-			{
-				panelsToRender.emplace_back(subPanel.get());
-			}
-
-			this->renderer.clear();
-
-			if (this->gameWorldRenderCallback)
-			{
-				if (!this->gameWorldRenderCallback(*this))
-				{
-					DebugLogError("Couldn't render game world.");
-				}
-			}
-
-			const Int2 windowDims = this->renderer.getWindowDimensions();
+		// Two delta times: actual and clamped. Use the clamped delta time for game calculations
+		// so things don't break at low frame rates.
+		const double clampedDt = std::fmin(dt, maxFrameTimeReal);
 
-			for (const Panel *currentPanel : panelsToRender)
-			{
-				const BufferView<const UiDrawCall> drawCallsView = currentPanel->getDrawCalls();
-				for (const UiDrawCall &drawCall : drawCallsView)
-				{
-					if (!drawCall.isActive())
-					{
-						continue;
-					}
-
-					const std::optional<Rect> &optClipRect = drawCall.getClipRect();
-					if (optClipRect.has_value())
-					{
-						const SDL_Rect clipRect = optClipRect->getSdlRect();
-						this->renderer.setClipRect(&clipRect);
-					}
-
-					const UiTextureID textureID = drawCall.getTextureID();
-					const Int2 position = drawCall.getPosition();
-					const Int2 size = drawCall.getSize();
-					const PivotType pivotType = drawCall.getPivotType();
-					const RenderSpace renderSpace = drawCall.getRenderSpace();
-
-					double xPercent, yPercent, wPercent, hPercent;
-					GuiUtils::makeRenderElementPercents(position.x, position.y, size.x, size.y, windowDims.x, windowDims.y,
-						renderSpace, pivotType, &xPercent, &yPercent, &wPercent, &hPercent);
-
-					const RendererSystem2D::RenderElement renderElement(textureID, xPercent, yPercent, wPercent, hPercent);
-					this->renderer.draw(&renderElement, 1, renderSpace);
-
-					if (optClipRect.has_value())
-					{
-						this->renderer.setClipRect(nullptr);
-					}
-				}
-			}
+		// Update FPS counter.
+		this->fpsCounter.updateFrameTime(realDt);
 
-			this->renderDebugInfo();
-			this->renderer.present();
-		}
-		catch (const std::exception &e)
-		{
-			DebugCrash("Render exception: " + std::string(e.what()));
-		}
+		this->runFrame(dt, clampedDt, nullptr);
 
-		// End-of-frame clean up.
-		try
+		if (replayMode == ReplaySession::Mode::Record)
 		{
-			this->sceneManager.cleanUp();
+			const uint32_t checksum = ReplaySession::makeStateChecksum(*this);
+			this->replaySession.recordFrame(dt, this->inputManager.getFrame(), checksum);
 		}
-		catch (const std::exception &e)
+		else if (replayMode == ReplaySession::Mode::Replay)
 		{
-			DebugCrash("Clean-up exception: " + std::string(e.what()));
+			const uint32_t checksum = ReplaySession::makeStateChecksum(*this);
+			this->replaySession.verifyReplayFrame(checksum);
 		}
 	}
 
+	this->replaySession.finish();
+
 	// At this point, the engine has received an exit signal and is now quitting peacefully.
 	this->options.saveChanges();
 }
@@ -11,6 +11,7 @@
 #include "CharacterCreationState.h"
 #include "GameState.h"
 #include "Options.h"
+#include "ReplaySession.h"
 #include "../Assets/TextureManager.h"
 #include "../Audio/AudioManager.h"
 #include "../Input/InputManager.h"
@@ -40,6 +41,14 @@ class Game
 {
 public:
 	using GameWorldRenderCallback = std::function<bool(Game&)>;
+
+	// Wall-clock seconds spent in each stage of one game loop iteration.
+	struct FrameStageTimes
+	{
+		double input, tick, lateTick, render, cleanUp;
+
+		FrameStageTimes();
+	};
 private:
 	AudioManager audioManager;
 
@@ -76,6 +85,9 @@ private:
 	Profiler profiler;
 	FPSCounter fpsCounter;
 
+	// Optional input recording or deterministic replay of a session.
+	ReplaySession replaySession;
+
 	SceneManager sceneManager;
 
 	// Active game session (needs to be positioned after Renderer member due to order of texture destruction).
@@ -100,15 +112,19 @@ private:
 	// available index.
 	void saveScreenshot(const Surface &surface);
 
-	// Handles any changes in panels after an SDL event or game tick.
-	void handlePanelChanges();
-
 	void handleApplicationExit();
 	void handleWindowResized(int width, int height);
 	void updateNativeCursorRegions(int windowWidth, int windowHeight);
 
 	// Optionally displays debug profiler info on-screen.
 	void renderDebugInfo();
+
+	// Game loop stages, run in this order each frame.
+	void updateInput(double dt, double clampedDt);
+	void tick(double clampedDt);
+	void lateTick(double clampedDt);
+	void render();
+	void cleanUpFrame();
 public:
 	Game();
 	Game(const Game&) = delete;
@@ -120,6 +136,12 @@ public:
 
 	bool init();
 
+	// Records this session's input, frame times, and RNG seeds to the given file. Must be called before loop().
+	bool initRecording(const std::string &filename);
+
+	// Replays a recorded session unpaced, checking for divergence each frame. Must be called before loop().
+	bool initReplay(const std::string &filename);
+
 	// Gets the audio manager for changing the current music and sound.
 	AudioManager &getAudioManager();
 
@@ -207,6 +229,10 @@ public:
 	// calculations, etc.).
 	void pushSubPanel(std::unique_ptr<Panel> nextSubPanel);
 
+	// Handles any changes in panels after an SDL event or game tick. Also used for applying the first panel
+	// when the game loop is driven externally.
+	void handlePanelChanges();
+
 	// Pops the current sub-panel off the stack after the current SDL event has been
 	// processed (to avoid popping a sub-panel while in use). This will normally be called 
 	// by a sub-panel to destroy itself. If a new sub-panel is pushed during the same event,
@@ -221,6 +247,13 @@ public:
 	// Sets the function to call for rendering the 3D scene.
 	void setGameWorldRenderCallback(const GameWorldRenderCallback &callback);
 
+	// Whether the application has not been asked to exit.
+	bool isRunning() const;
+
+	// Runs one iteration of the game loop without any frame pacing. Optionally writes how long each stage took.
+	// Used by the primary game loop and by the headless benchmark.
+	void runFrame(double dt, double clampedDt, FrameStageTimes *outStageTimes);
+
 	// Initial method for starting the game loop. This must only be called by main().
 	void loop();
 };
@@ -183,7 +183,7 @@ void GameState::queueMapDefChange(MapDefinition &&newMapDef, const std::optional
 	this->nextMapDefWeatherDef = weatherDef;
 }
 
-void GameState::queueMapDefPop()
+void GameState::queueMapDefPop(Random &random)
 {
 	if (this->hasPendingMapDefChange())
 	{
@@ -217,7 +217,6 @@ void GameState::queueMapDefPop()
 
 	// Calculate weather.
 	const ArenaTypes::WeatherType weatherType = this->getWeatherForLocation(this->provinceIndex, this->locationIndex);
-	Random random; // @todo: get from Game
 	this->nextMapDefWeatherDef = WeatherDefinition();
 	this->nextMapDefWeatherDef->initFromClassic(weatherType, this->date.getDay(), random);
 
@@ -648,7 +647,7 @@ void GameState::applyPendingSceneChange(Game &game, double dt)
 	const SkyInfoDefinition &activeSkyInfoDef = this->activeMapDef.getSkyInfoForSky(activeSkyIndex);
 
 	sceneManager.skyInstance.init(activeSkyDef, activeSkyInfoDef, this->date.getDay(), textureManager);
-	sceneManager.renderSkyManager.loadScene(activeSkyInfoDef, textureManager, renderer);
+	sceneManager.renderSkyManager.loadScene(sceneManager.skyInstance, activeSkyInfoDef, textureManager, renderer);
 	sceneManager.renderWeatherManager.loadScene();
 
 	const BinaryAssetLibrary &binaryAssetLibrary = BinaryAssetLibrary::getInstance();
@@ -846,6 +845,12 @@ void GameState::tickVoxels(double dt, Game &game)
 
 	const Player &player = game.getPlayer();
 
+	// Wild blocks are converted the first time one of their chunks becomes active.
+	if (this->getActiveMapType() == MapType::Wilderness)
+	{
+		this->activeMapDef.generateWildChunks(chunkManager.getNewChunkPositions(), game.getTextureManager());
+	}
+
 	const MapDefinition &mapDef = this->getActiveMapDef();
 	const int levelIndex = this->getActiveLevelIndex();
 	const BufferView<const LevelDefinition> levelDefs = mapDef.getLevels();
@@ -944,11 +949,11 @@ void GameState::tickRendering(Game &game)
 	RenderChunkManager &renderChunkManager = sceneManager.renderChunkManager;
 	renderChunkManager.updateActiveChunks(newChunkPositions, freedChunkPositions, voxelChunkManager, renderer);
 	renderChunkManager.updateLights(activeChunkPositions, newChunkPositions, playerCoord, ceilingScale, isFoggy, nightLightsAreActive,
-		options.getMisc_PlayerHasLight(), entityChunkManager, renderer);
-	renderChunkManager.updateVoxels(activeChunkPositions, newChunkPositions, ceilingScale, chasmAnimPercent,
-		voxelChunkManager, voxelVisChunkManager, textureManager, renderer);
+		options.getMisc_PlayerHasLight(), options.getGraphics_StaticLightmaps(), entityChunkManager, renderer);
+	renderChunkManager.updateVoxels(activeChunkPositions, newChunkPositions, playerCoordXZ, ceilingScale, chasmAnimPercent,
+		voxelChunkManager, voxelVisChunkManager, options.getGraphics_SortDrawCalls(), textureManager, renderer);
 	renderChunkManager.updateEntities(activeChunkPositions, newChunkPositions, playerCoordXZ, playerDirXZ, ceilingScale,
-		voxelChunkManager, entityChunkManager, textureManager, renderer);
+		voxelChunkManager, entityChunkManager, options.getGraphics_SortDrawCalls(), textureManager, renderer);
 
 	const bool isInterior = this->getActiveMapType() == MapType::Interior;
 	const WeatherType weatherType = this->weatherDef.type;
@@ -29,7 +29,15 @@ namespace
 		{ "CursorScale", OptionType::Double },
 		{ "ModernInterface", OptionType::Bool },
 		{ "TallPixelCorrection", OptionType::Bool },
-		{ "RenderThreadsMode", OptionType::Int }
+		{ "RenderThreadsMode", OptionType::Int },
+		{ "SortDrawCalls", OptionType::Bool },
+		{ "TextureCacheBudgetMB", OptionType::Int },
+		{ "PipelinedRendering", OptionType::Bool },
+		{ "DynamicResolution", OptionType::Bool },
+		{ "DynamicResolutionMinScale", OptionType::Double },
+		{ "AlignFramesToRefreshRate", OptionType::Bool },
+		{ "StaticLightmaps", OptionType::Bool },
+		{ "TextureMipmaps", OptionType::Bool }
 	};
 
 	const std::vector<std::pair<std::string, OptionType>> AudioMappings =
@@ -59,7 +67,11 @@ namespace
 		{ "ShowCompass", OptionType::Bool },
 		{ "ChunkDistance", OptionType::Int },
 		{ "StarDensity", OptionType::Int },
-		{ "PlayerHasLight", OptionType::Bool }
+		{ "PlayerHasLight", OptionType::Bool },
+		{ "AssetCache", OptionType::Bool },
+		{ "WatchDataFolders", OptionType::Bool },
+		{ "LogLevel", OptionType::Int },
+		{ "LogDisabledCategories", OptionType::String }
 	};
 }
 
@@ -508,6 +520,21 @@ void Options::checkGraphics_RenderThreadsMode(int value) const
 		std::to_string(Options::MAX_RENDER_THREADS_MODE) + ".");
 }
 
+void Options::checkGraphics_TextureCacheBudgetMB(int value) const
+{
+	DebugAssertMsg(value >= 0, "Texture cache budget cannot be negative.");
+}
+
+void Options::checkGraphics_DynamicResolutionMinScale(double value) const
+{
+	DebugAssertMsg(value >= Options::MIN_RESOLUTION_SCALE,
+		"Dynamic resolution min scale cannot be less than " +
+		String::fixedPrecision(Options::MIN_RESOLUTION_SCALE, 2) + ".");
+	DebugAssertMsg(value <= Options::MAX_RESOLUTION_SCALE,
+		"Dynamic resolution min scale cannot be greater than " +
+		String::fixedPrecision(Options::MAX_RESOLUTION_SCALE, 2) + ".");
+}
+
 void Options::checkAudio_MusicVolume(double value) const
 {
 	DebugAssertMsg(value >= Options::MIN_VOLUME, "Music volume cannot be negative.");
@@ -593,6 +620,16 @@ void Options::checkMisc_ProfilerLevel(int value) const
 		std::to_string(Options::MAX_PROFILER_LEVEL) + ".");
 }
 
+void Options::checkMisc_LogLevel(int value) const
+{
+	DebugAssertMsg(value >= Options::MIN_LOG_LEVEL,
+		"Log level cannot be less than " +
+		std::to_string(Options::MIN_LOG_LEVEL) + ".");
+	DebugAssertMsg(value <= Options::MAX_LOG_LEVEL,
+		"Log level cannot be greater than " +
+		std::to_string(Options::MAX_LOG_LEVEL) + ".");
+}
+
 void Options::loadDefaults(const std::string &filename)
 {
 	DebugLog("Reading defaults \"" + filename + "\".");
@@ -85,6 +85,8 @@ public:
 	static constexpr int MAX_STAR_DENSITY_MODE = 2;
 	static constexpr int MIN_PROFILER_LEVEL = 0;
 	static constexpr int MAX_PROFILER_LEVEL = 3;
+	static constexpr int MIN_LOG_LEVEL = 0;
+	static constexpr int MAX_LOG_LEVEL = 2;
 
 #define OPTION_BOOL(section, name) \
 bool get##section##_##name() const \
@@ -146,6 +148,14 @@ void set##section##_##name(const std::string &value) \
 	OPTION_BOOL(Graphics, ModernInterface)
 	OPTION_BOOL(Graphics, TallPixelCorrection)
 	OPTION_INT(Graphics, RenderThreadsMode)
+	OPTION_BOOL(Graphics, SortDrawCalls)
+	OPTION_INT(Graphics, TextureCacheBudgetMB)
+	OPTION_BOOL(Graphics, PipelinedRendering)
+	OPTION_BOOL(Graphics, DynamicResolution)
+	OPTION_DOUBLE(Graphics, DynamicResolutionMinScale)
+	OPTION_BOOL(Graphics, AlignFramesToRefreshRate)
+	OPTION_BOOL(Graphics, StaticLightmaps)
+	OPTION_BOOL(Graphics, TextureMipmaps)
 
 	OPTION_DOUBLE(Audio, MusicVolume)
 	OPTION_DOUBLE(Audio, SoundVolume)
@@ -167,6 +177,10 @@ void set##section##_##name(const std::string &value) \
 	OPTION_INT(Misc, ChunkDistance)
 	OPTION_INT(Misc, StarDensity)
 	OPTION_BOOL(Misc, PlayerHasLight)
+	OPTION_BOOL(Misc, AssetCache)
+	OPTION_BOOL(Misc, WatchDataFolders)
+	OPTION_INT(Misc, LogLevel)
+	OPTION_STRING(Misc, LogDisabledCategories)
 
 	// Reads all the key-values pairs from the given absolute path into the default members.
 	void loadDefaults(const std::string &filename);
@@ -0,0 +1,521 @@
+#include <cstring>
+#include <type_traits>
+
+#include "Game.h"
+#include "ReplaySession.h"
+#include "../Entities/EntityChunkManager.h"
+
+#include "components/debug/Debug.h"
+#include "components/utilities/String.h"
+
+namespace
+{
+	constexpr char ReplayMagic[4] = { 'O', 'T', 'R', 'P' };
+	constexpr uint32_t ReplayVersion = 2;
+
+	template<typename T>
+	void WriteValue(std::ofstream &stream, const T &value)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template<typename T>
+	bool TryReadValue(std::ifstream &stream, T *outValue)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		stream.read(reinterpret_cast<char*>(outValue), sizeof(T));
+		return stream.good();
+	}
+
+	// Only event types the input manager consumes are recorded, one field at a time, so the file doesn't depend
+	// on the SDL_Event layout or contain pointers.
+	bool IsRecordableEventType(uint32_t type)
+	{
+		switch (type)
+		{
+		case SDL_KEYDOWN:
+		case SDL_KEYUP:
+		case SDL_MOUSEBUTTONDOWN:
+		case SDL_MOUSEBUTTONUP:
+		case SDL_MOUSEWHEEL:
+		case SDL_MOUSEMOTION:
+		case SDL_QUIT:
+		case SDL_WINDOWEVENT:
+		case SDL_TEXTINPUT:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	void WriteEvent(std::ofstream &stream, const SDL_Event &e)
+	{
+		DebugAssert(IsRecordableEventType(e.type));
+		WriteValue(stream, static_cast<uint32_t>(e.type));
+
+		switch (e.type)
+		{
+		case SDL_KEYDOWN:
+		case SDL_KEYUP:
+			WriteValue(stream, static_cast<uint8_t>(e.key.repeat));
+			WriteValue(stream, static_cast<int32_t>(e.key.keysym.scancode));
+			WriteValue(stream, static_cast<int32_t>(e.key.keysym.sym));
+			WriteValue(stream, static_cast<uint16_t>(e.key.keysym.mod));
+			break;
+		case SDL_MOUSEBUTTONDOWN:
+		case SDL_MOUSEBUTTONUP:
+			WriteValue(stream, static_cast<uint8_t>(e.button.button));
+			WriteValue(stream, static_cast<uint8_t>(e.button.clicks));
+			WriteValue(stream, static_cast<int32_t>(e.button.x));
+			WriteValue(stream, static_cast<int32_t>(e.button.y));
+			break;
+		case SDL_MOUSEWHEEL:
+			WriteValue(stream, static_cast<int32_t>(e.wheel.x));
+			WriteValue(stream, static_cast<int32_t>(e.wheel.y));
+			break;
+		case SDL_MOUSEMOTION:
+			WriteValue(stream, static_cast<int32_t>(e.motion.x));
+			WriteValue(stream, static_cast<int32_t>(e.motion.y));
+			WriteValue(stream, static_cast<int32_t>(e.motion.xrel));
+			WriteValue(stream, static_cast<int32_t>(e.motion.yrel));
+			break;
+		case SDL_WINDOWEVENT:
+			WriteValue(stream, static_cast<uint8_t>(e.window.event));
+			WriteValue(stream, static_cast<int32_t>(e.window.data1));
+			WriteValue(stream, static_cast<int32_t>(e.window.data2));
+			break;
+		case SDL_TEXTINPUT:
+		{
+			const uint8_t textLength = static_cast<uint8_t>(std::strlen(e.text.text));
+			WriteValue(stream, textLength);
+			stream.write(e.text.text, textLength);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	bool TryReadEvent(std::ifstream &stream, SDL_Event *outEvent)
+	{
+		SDL_Event &e = *outEvent;
+		std::memset(&e, 0, sizeof(e));
+
+		uint32_t type;
+		if (!TryReadValue(stream, &type) || !IsRecordableEventType(type))
+		{
+			return false;
+		}
+
+		e.type = type;
+
+		bool success = true;
+		switch (type)
+		{
+		case SDL_KEYDOWN:
+		case SDL_KEYUP:
+		{
+			uint8_t repeat;
+			int32_t scancode, sym;
+			uint16_t mod;
+			success = TryReadValue(stream, &repeat) && TryReadValue(stream, &scancode) && TryReadValue(stream, &sym) &&
+				TryReadValue(stream, &mod);
+			e.key.state = (type == SDL_KEYDOWN) ? SDL_PRESSED : SDL_RELEASED;
+			e.key.repeat = repeat;
+			e.key.keysym.scancode = static_cast<SDL_Scancode>(scancode);
+			e.key.keysym.sym = static_cast<SDL_Keycode>(sym);
+			e.key.keysym.mod = mod;
+			break;
+		}
+		case SDL_MOUSEBUTTONDOWN:
+		case SDL_MOUSEBUTTONUP:
+		{
+			uint8_t button, clicks;
+			int32_t x, y;
+			success = TryReadValue(stream, &button) && TryReadValue(stream, &clicks) && TryReadValue(stream, &x) &&
+				TryReadValue(stream, &y);
+			e.button.state = (type == SDL_MOUSEBUTTONDOWN) ? SDL_PRESSED : SDL_RELEASED;
+			e.button.button = button;
+			e.button.clicks = clicks;
+			e.button.x = x;
+			e.button.y = y;
+			break;
+		}
+		case SDL_MOUSEWHEEL:
+		{
+			int32_t x, y;
+			success = TryReadValue(stream, &x) && TryReadValue(stream, &y);
+			e.wheel.x = x;
+			e.wheel.y = y;
+			break;
+		}
+		case SDL_MOUSEMOTION:
+		{
+			int32_t x, y, xrel, yrel;
+			success = TryReadValue(stream, &x) && TryReadValue(stream, &y) && TryReadValue(stream, &xrel) &&
+				TryReadValue(stream, &yrel);
+			e.motion.x = x;
+			e.motion.y = y;
+			e.motion.xrel = xrel;
+			e.motion.yrel = yrel;
+			break;
+		}
+		case SDL_WINDOWEVENT:
+		{
+			uint8_t windowEvent;
+			int32_t data1, data2;
+			success = TryReadValue(stream, &windowEvent) && TryReadValue(stream, &data1) && TryReadValue(stream, &data2);
+			e.window.event = windowEvent;
+			e.window.data1 = data1;
+			e.window.data2 = data2;
+			break;
+		}
+		case SDL_TEXTINPUT:
+		{
+			uint8_t textLength;
+			success = TryReadValue(stream, &textLength) && (textLength < sizeof(e.text.text));
+			if (success)
+			{
+				stream.read(e.text.text, textLength);
+				success = stream.good();
+			}
+
+			break;
+		}
+		default:
+			break;
+		}
+
+		return success;
+	}
+
+	// FNV-1a.
+	class ChecksumBuilder
+	{
+	private:
+		uint32_t value;
+	public:
+		ChecksumBuilder()
+		{
+			this->value = 2166136261u;
+		}
+
+		template<typename T>
+		void add(const T &data)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			uint8_t bytes[sizeof(T)];
+			std::memcpy(bytes, &data, sizeof(T));
+			for (const uint8_t byte : bytes)
+			{
+				this->value ^= byte;
+				this->value *= 16777619u;
+			}
+		}
+
+		uint32_t get() const
+		{
+			return this->value;
+		}
+	};
+}
+
+ReplaySession::Frame::Frame()
+{
+	this->dt = 0.0;
+	this->checksum = 0;
+}
+
+ReplaySession::ReplaySession()
+{
+	this->mode = Mode::None;
+	this->randomSeed = 0;
+	this->arenaRandomSeed = 0;
+	this->frameIndex = 0;
+	this->mismatchCount = 0;
+	this->firstMismatchFrameIndex = -1;
+}
+
+bool ReplaySession::initRecord(const std::string &filename, int randomSeed, uint32_t arenaRandomSeed)
+{
+	this->recordStream.open(filename, std::ios::binary | std::ios::trunc);
+	if (!this->recordStream.is_open())
+	{
+		DebugLogError("Couldn't open \"" + filename + "\" for recording.");
+		return false;
+	}
+
+	this->mode = Mode::Record;
+	this->filename = filename;
+	this->randomSeed = randomSeed;
+	this->arenaRandomSeed = arenaRandomSeed;
+	this->frameIndex = 0;
+
+	this->recordStream.write(ReplayMagic, sizeof(ReplayMagic));
+	WriteValue(this->recordStream, ReplayVersion);
+	WriteValue(this->recordStream, static_cast<int32_t>(randomSeed));
+	WriteValue(this->recordStream, arenaRandomSeed);
+
+	DebugLog("Recording replay to \"" + filename + "\".");
+	return true;
+}
+
+bool ReplaySession::initReplay(const std::string &filename)
+{
+	std::ifstream stream(filename, std::ios::binary);
+	if (!stream.is_open())
+	{
+		DebugLogError("Couldn't open replay \"" + filename + "\".");
+		return false;
+	}
+
+	char magic[sizeof(ReplayMagic)];
+	uint32_t version;
+	int32_t randomSeed;
+	uint32_t arenaRandomSeed;
+	stream.read(magic, sizeof(magic));
+	if (!stream.good() || (std::memcmp(magic, ReplayMagic, sizeof(magic)) != 0) || !TryReadValue(stream, &version) ||
+		(version != ReplayVersion) || !TryReadValue(stream, &randomSeed) || !TryReadValue(stream, &arenaRandomSeed))
+	{
+		DebugLogError("Invalid replay header in \"" + filename + "\".");
+		return false;
+	}
+
+	this->replayFrames.clear();
+	while (stream.peek() != std::ifstream::traits_type::eof())
+	{
+		Frame frame;
+		InputFrame &input = frame.input;
+		uint16_t keyboardStateSize, pressedKeyCount, eventCount;
+		bool success = TryReadValue(stream, &frame.dt) && TryReadValue(stream, &frame.checksum) &&
+			TryReadValue(stream, &input.keymod) && TryReadValue(stream, &input.mouseState) &&
+			TryReadValue(stream, &input.mousePosition.x) && TryReadValue(stream, &input.mousePosition.y) &&
+			TryReadValue(stream, &input.mouseDelta.x) && TryReadValue(stream, &input.mouseDelta.y) &&
+			TryReadValue(stream, &keyboardStateSize) && TryReadValue(stream, &pressedKeyCount);
+
+		if (success)
+		{
+			input.keyboardState.resize(keyboardStateSize, 0);
+			for (int i = 0; (i < pressedKeyCount) && success; i++)
+			{
+				uint16_t scancode;
+				success = TryReadValue(stream, &scancode) && (scancode < keyboardStateSize);
+				if (success)
+				{
+					input.keyboardState[scancode] = 1;
+				}
+			}
+		}
+
+		success = success && TryReadValue(stream, &eventCount);
+		if (success)
+		{
+			input.events.resize(eventCount);
+			for (int i = 0; (i < eventCount) && success; i++)
+			{
+				success = TryReadEvent(stream, &input.events[i]);
+			}
+		}
+
+		if (!success)
+		{
+			DebugLogWarning("Truncated replay frame " + std::to_string(this->replayFrames.size()) + " in \"" + filename + "\".");
+			break;
+		}
+
+		this->replayFrames.emplace_back(std::move(frame));
+	}
+
+	this->mode = Mode::Replay;
+	this->filename = filename;
+	this->randomSeed = randomSeed;
+	this->arenaRandomSeed = arenaRandomSeed;
+	this->frameIndex = 0;
+	this->mismatchCount = 0;
+	this->firstMismatchFrameIndex = -1;
+	this->replayStartTime = std::chrono::steady_clock::now();
+
+	DebugLog("Replaying " + std::to_string(this->replayFrames.size()) + " frames from \"" + filename + "\".");
+	return true;
+}
+
+ReplaySession::Mode ReplaySession::getMode() const
+{
+	return this->mode;
+}
+
+int ReplaySession::getRandomSeed() const
+{
+	return this->randomSeed;
+}
+
+uint32_t ReplaySession::getArenaRandomSeed() const
+{
+	return this->arenaRandomSeed;
+}
+
+bool ReplaySession::isReplayFinished() const
+{
+	DebugAssert(this->mode == Mode::Replay);
+	return this->frameIndex >= static_cast<int>(this->replayFrames.size());
+}
+
+double ReplaySession::getReplayDeltaTime() const
+{
+	DebugAssertIndex(this->replayFrames, this->frameIndex);
+	return this->replayFrames[this->frameIndex].dt;
+}
+
+const InputFrame &ReplaySession::getReplayInput() const
+{
+	DebugAssertIndex(this->replayFrames, this->frameIndex);
+	return this->replayFrames[this->frameIndex].input;
+}
+
+uint32_t ReplaySession::makeStateChecksum(Game &game)
+{
+	ChecksumBuilder checksum;
+
+	const Player &player = game.getPlayer();
+	const CoordDouble3 &playerPosition = player.getPosition();
+	checksum.add(playerPosition.chunk.x);
+	checksum.add(playerPosition.chunk.y);
+	checksum.add(playerPosition.point.x);
+	checksum.add(playerPosition.point.y);
+	checksum.add(playerPosition.point.z);
+
+	const Double3 &playerDirection = player.getDirection();
+	checksum.add(playerDirection.x);
+	checksum.add(playerDirection.y);
+	checksum.add(playerDirection.z);
+
+	const VoxelDouble3 &playerVelocity = player.getVelocity();
+	checksum.add(playerVelocity.x);
+	checksum.add(playerVelocity.y);
+	checksum.add(playerVelocity.z);
+
+	// Draw from copies so the checksum doesn't advance the game's RNGs.
+	Random randomCopy = game.getRandom();
+	checksum.add(randomCopy.next());
+	checksum.add(game.getArenaRandom().getSeed());
+
+	GameState &gameState = game.getGameState();
+	checksum.add(gameState.getDate().getDay());
+	checksum.add(gameState.getClock().getPreciseTotalSeconds());
+
+	const EntityChunkManager &entityChunkManager = game.getSceneManager().entityChunkManager;
+	for (int i = 0; i < entityChunkManager.getChunkCount(); i++)
+	{
+		const EntityChunk &entityChunk = entityChunkManager.getChunkAtIndex(i);
+		for (const EntityInstanceID entityInstID : entityChunk.entityIDs)
+		{
+			const EntityInstance &entityInst = entityChunkManager.getEntity(entityInstID);
+			const CoordDouble2 &entityPosition = entityChunkManager.getEntityPosition(entityInst.positionID);
+			checksum.add(entityInstID);
+			checksum.add(entityPosition.chunk.x);
+			checksum.add(entityPosition.chunk.y);
+			checksum.add(entityPosition.point.x);
+			checksum.add(entityPosition.point.y);
+		}
+	}
+
+	return checksum.get();
+}
+
+void ReplaySession::recordFrame(double dt, const InputFrame &input, uint32_t checksum)
+{
+	DebugAssert(this->mode == Mode::Record);
+
+	WriteValue(this->recordStream, dt);
+	WriteValue(this->recordStream, checksum);
+	WriteValue(this->recordStream, input.keymod);
+	WriteValue(this->recordStream, input.mouseState);
+	WriteValue(this->recordStream, input.mousePosition.x);
+	WriteValue(this->recordStream, input.mousePosition.y);
+	WriteValue(this->recordStream, input.mouseDelta.x);
+	WriteValue(this->recordStream, input.mouseDelta.y);
+
+	// Held keys are stored as a list of scancodes since nearly all of the keyboard state is zero.
+	const uint16_t keyboardStateSize = static_cast<uint16_t>(input.keyboardState.size());
+	uint16_t pressedKeyCount = 0;
+	for (const uint8_t keyState : input.keyboardState)
+	{
+		pressedKeyCount += (keyState != 0) ? 1 : 0;
+	}
+
+	WriteValue(this->recordStream, keyboardStateSize);
+	WriteValue(this->recordStream, pressedKeyCount);
+	for (int i = 0; i < keyboardStateSize; i++)
+	{
+		if (input.keyboardState[i] != 0)
+		{
+			WriteValue(this->recordStream, static_cast<uint16_t>(i));
+		}
+	}
+
+	uint16_t eventCount = 0;
+	for (const SDL_Event &e : input.events)
+	{
+		eventCount += IsRecordableEventType(e.type) ? 1 : 0;
+	}
+
+	WriteValue(this->recordStream, eventCount);
+	for (const SDL_Event &e : input.events)
+	{
+		if (IsRecordableEventType(e.type))
+		{
+			WriteEvent(this->recordStream, e);
+		}
+	}
+
+	this->frameIndex++;
+}
+
+void ReplaySession::verifyReplayFrame(uint32_t checksum)
+{
+	DebugAssertIndex(this->replayFrames, this->frameIndex);
+	const Frame &frame = this->replayFrames[this->frameIndex];
+	if (frame.checksum != checksum)
+	{
+		if (this->mismatchCount == 0)
+		{
+			this->firstMismatchFrameIndex = this->frameIndex;
+			DebugLogWarning("Replay diverged from the recording at frame " + std::to_string(this->frameIndex) + ".");
+		}
+
+		this->mismatchCount++;
+	}
+
+	this->frameIndex++;
+}
+
+void ReplaySession::finish()
+{
+	if (this->mode == Mode::Record)
+	{
+		this->recordStream.close();
+		DebugLog("Recorded " + std::to_string(this->frameIndex) + " frames to \"" + this->filename + "\".");
+	}
+	else if (this->mode == Mode::Replay)
+	{
+		const std::chrono::duration<double> elapsedTime = std::chrono::steady_clock::now() - this->replayStartTime;
+		const double elapsedSeconds = elapsedTime.count();
+		const double avgFrameTimeMS = (this->frameIndex > 0) ? ((elapsedSeconds * 1000.0) / static_cast<double>(this->frameIndex)) : 0.0;
+		DebugLog("Replay took " + String::fixedPrecision(elapsedSeconds, 3) + "s (" + String::fixedPrecision(avgFrameTimeMS, 3) +
+			"ms per frame).");
+
+		if (this->mismatchCount == 0)
+		{
+			DebugLog("Replayed " + std::to_string(this->frameIndex) + " frames from \"" + this->filename + "\" with no divergence.");
+		}
+		else
+		{
+			DebugLogWarning("Replayed " + std::to_string(this->frameIndex) + " frames from \"" + this->filename + "\" with " +
+				std::to_string(this->mismatchCount) + " mismatched frames (first at frame " +
+				std::to_string(this->firstMismatchFrameIndex) + ").");
+		}
+	}
+
+	this->mode = Mode::None;
+}
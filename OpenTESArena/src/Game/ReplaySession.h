@@ -0,0 +1,82 @@
+#ifndef REPLAY_SESSION_H
+#define REPLAY_SESSION_H
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../Input/InputFrame.h"
+
+// Records or replays everything that makes a game session non-deterministic: the SDL input of each frame,
+// each frame's delta time, and the RNG seeds. A replay runs unpaced with the recorded delta times and compares
+// per-frame game state checksums against the recording to detect divergence. There is no fixed timestep: the
+// simulation sees the same variable delta times the recording did, so a replay only reproduces its own recording
+// and says nothing about frame-rate independence of physics or animation.
+
+class Game;
+
+class ReplaySession
+{
+public:
+	enum class Mode
+	{
+		None,
+		Record,
+		Replay
+	};
+private:
+	struct Frame
+	{
+		double dt;
+		uint32_t checksum; // Game state after the frame.
+		InputFrame input;
+
+		Frame();
+	};
+
+	Mode mode;
+	std::string filename;
+	std::ofstream recordStream;
+	int randomSeed;
+	uint32_t arenaRandomSeed;
+	std::vector<Frame> replayFrames;
+	int frameIndex; // Frames recorded or replayed so far.
+	int mismatchCount;
+	int firstMismatchFrameIndex;
+	std::chrono::steady_clock::time_point replayStartTime;
+public:
+	ReplaySession();
+
+	// Starts writing a new recording to the given file.
+	bool initRecord(const std::string &filename, int randomSeed, uint32_t arenaRandomSeed);
+
+	// Loads a recording for playback.
+	bool initReplay(const std::string &filename);
+
+	Mode getMode() const;
+	int getRandomSeed() const;
+	uint32_t getArenaRandomSeed() const;
+
+	// Whether all recorded frames have been replayed.
+	bool isReplayFinished() const;
+
+	// The current replay frame's values.
+	double getReplayDeltaTime() const;
+	const InputFrame &getReplayInput() const;
+
+	// Hashes the simulated game state (player, clock, RNG, entities) for divergence checks.
+	static uint32_t makeStateChecksum(Game &game);
+
+	// Appends a frame to the recording.
+	void recordFrame(double dt, const InputFrame &input, uint32_t checksum);
+
+	// Compares the checksum of the replayed frame with the recorded one and advances to the next frame.
+	void verifyReplayFrame(uint32_t checksum);
+
+	// Closes the recording or logs the replay results.
+	void finish();
+};
+
+#endif
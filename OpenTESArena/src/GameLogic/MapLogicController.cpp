@@ -19,6 +19,7 @@ void MapLogicController::handleNightLightChange(Game &game, bool active)
 
 	// Turn streetlights on or off.
 	const std::string &newStreetlightAnimStateName = active ? EntityAnimationUtils::STATE_ACTIVATED : EntityAnimationUtils::STATE_IDLE;
+	const AssetNameID newStreetlightAnimStateNameID = active ? EntityAnimationUtils::getStateActivatedID() : EntityAnimationUtils::getStateIdleID();
 	EntityChunkManager &entityChunkManager = sceneManager.entityChunkManager;
 	for (int i = 0; i < entityChunkManager.getChunkCount(); i++)
 	{
@@ -30,7 +31,7 @@ void MapLogicController::handleNightLightChange(Game &game, bool active)
 			if (EntityUtils::isStreetlight(entityDef))
 			{
 				const EntityAnimationDefinition &entityAnimDef = entityDef.getAnimDef();
-				const std::optional<int> newAnimStateIndex = entityAnimDef.tryGetStateIndex(newStreetlightAnimStateName.c_str());
+				const std::optional<int> newAnimStateIndex = entityAnimDef.tryGetStateIndex(newStreetlightAnimStateNameID);
 				if (!newAnimStateIndex.has_value())
 				{
 					DebugLogError("Couldn't find \"" + newStreetlightAnimStateName + "\" animation state for streetlight entity \"" + std::to_string(entityInstID) + "\".");
@@ -195,7 +196,7 @@ void MapLogicController::handleMapTransition(Game &game, const Physics::Hit &hit
 		};
 
 		// Leave the interior and go to the saved exterior.
-		gameState.queueMapDefPop();
+		gameState.queueMapDefPop(game.getRandom());
 		gameState.queueMusicOnSceneChange(musicDefFunc, jingleMusicDefFunc);
 	}
 	else
@@ -0,0 +1,27 @@
+#include "InputFrame.h"
+
+InputFrame::InputFrame()
+{
+	this->keymod = 0;
+	this->mouseState = 0;
+}
+
+bool InputFrame::isKeyDown(int scancode) const
+{
+	if ((scancode < 0) || (scancode >= static_cast<int>(this->keyboardState.size())))
+	{
+		return false;
+	}
+
+	return this->keyboardState[scancode] != 0;
+}
+
+void InputFrame::clear()
+{
+	this->events.clear();
+	this->keyboardState.clear();
+	this->keymod = 0;
+	this->mouseState = 0;
+	this->mousePosition = Int2::Zero;
+	this->mouseDelta = Int2::Zero;
+}
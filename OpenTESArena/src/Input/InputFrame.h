@@ -0,0 +1,29 @@
+#ifndef INPUT_FRAME_H
+#define INPUT_FRAME_H
+
+#include <cstdint>
+#include <vector>
+
+#include "SDL_events.h"
+
+#include "../Math/Vector2.h"
+
+// All the SDL input state the input manager reads in one frame. Decoupled from SDL polling so a frame's
+// input can be recorded and replayed.
+struct InputFrame
+{
+	std::vector<SDL_Event> events; // Only event types the input manager handles.
+	std::vector<uint8_t> keyboardState; // Indexed by SDL_Scancode, non-zero if held.
+	uint16_t keymod;
+	uint32_t mouseState; // SDL_BUTTON() mask.
+	Int2 mousePosition;
+	Int2 mouseDelta; // Relative mouse motion since the previous frame.
+
+	InputFrame();
+
+	bool isKeyDown(int scancode) const;
+
+	void clear();
+};
+
+#endif
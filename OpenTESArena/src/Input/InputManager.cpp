@@ -159,8 +159,8 @@ void InputManager::TextInputListenerEntry::reset()
 }
 
 InputManager::InputManager()
-	: mouseDelta(0, 0)
 {
+	this->hasReplayFrame = false;
 	this->nextListenerID = 0;
 }
 
@@ -192,14 +192,12 @@ bool InputManager::keyReleased(const SDL_Event &e, SDL_Keycode keycode) const
 
 bool InputManager::keyIsDown(SDL_Scancode scancode) const
 {
-	const uint8_t *keys = SDL_GetKeyboardState(nullptr);
-	return keys[scancode] != 0;
+	return this->frame.isKeyDown(scancode);
 }
 
 bool InputManager::keyIsUp(SDL_Scancode scancode) const
 {
-	const uint8_t *keys = SDL_GetKeyboardState(nullptr);
-	return keys[scancode] == 0;
+	return !this->frame.isKeyDown(scancode);
 }
 
 bool InputManager::isMouseButtonEvent(const SDL_Event &e) const
@@ -229,14 +227,12 @@ bool InputManager::mouseButtonReleased(const SDL_Event &e, uint8_t button) const
 
 bool InputManager::mouseButtonIsDown(uint8_t button) const
 {
-	const uint32_t mouse = SDL_GetMouseState(nullptr, nullptr);
-	return (mouse & SDL_BUTTON(button)) != 0;
+	return (this->frame.mouseState & SDL_BUTTON(button)) != 0;
 }
 
 bool InputManager::mouseButtonIsUp(uint8_t button) const
 {
-	const uint32_t mouse = SDL_GetMouseState(nullptr, nullptr);
-	return (mouse & SDL_BUTTON(button)) == 0;
+	return (this->frame.mouseState & SDL_BUTTON(button)) == 0;
 }
 
 bool InputManager::mouseWheeledUp(const SDL_Event &e) const
@@ -259,6 +255,11 @@ bool InputManager::windowResized(const SDL_Event &e) const
 	return (e.type == SDL_WINDOWEVENT) && (e.window.event == SDL_WINDOWEVENT_RESIZED);
 }
 
+bool InputManager::renderTargetsReset(const SDL_Event &e) const
+{
+	return (e.type == SDL_RENDER_TARGETS_RESET) || (e.type == SDL_RENDER_DEVICE_RESET);
+}
+
 bool InputManager::isTextInput(const SDL_Event &e) const
 {
 	return e.type == SDL_TEXTINPUT;
@@ -283,14 +284,12 @@ InputManager::ListenerID InputManager::getNextListenerID()
 
 Int2 InputManager::getMousePosition() const
 {
-	int x, y;
-	SDL_GetMouseState(&x, &y);
-	return Int2(x, y);
+	return this->frame.mousePosition;
 }
 
 Int2 InputManager::getMouseDelta() const
 {
-	return this->mouseDelta;
+	return this->frame.mouseDelta;
 }
 
 bool InputManager::setInputActionMapActive(const std::string &name, bool active)
@@ -585,8 +584,7 @@ void InputManager::handleHeldInputs(Game &game, BufferView<const InputActionMap*
 		handleHeldMouseButton(buttonType);
 	}
 
-	const uint8_t *keyboardState = SDL_GetKeyboardState(nullptr);
-	const SDL_Keymod keyboardMod = SDL_GetModState();
+	const uint16_t keyboardMod = this->frame.keymod;
 
 	for (const InputActionMap *map : activeMaps)
 	{
@@ -605,7 +603,7 @@ void InputManager::handleHeldInputs(Game &game, BufferView<const InputActionMap*
 					{
 						const InputActionDefinition::KeyDefinition &keyDef = def.keyDef;
 						const SDL_Scancode scancode = SDL_GetScancodeFromKey(keyDef.keycode);
-						const bool isKeyHeld = (keyboardState[scancode] != 0) && (keyDef.keymod == keyboardMod);
+						const bool isKeyHeld = this->frame.isKeyDown(scancode) && (keyDef.keymod == keyboardMod);
 						if (isKeyHeld)
 						{
 							for (const InputActionListenerEntry *entry : enabledInputActionListeners)
@@ -624,11 +622,72 @@ void InputManager::handleHeldInputs(Game &game, BufferView<const InputActionMap*
 	}
 }
 
+const InputFrame &InputManager::getFrame() const
+{
+	return this->frame;
+}
+
+void InputManager::setReplayFrame(const InputFrame &frame)
+{
+	this->frame = frame;
+	this->hasReplayFrame = true;
+}
+
+void InputManager::pollFrame()
+{
+	this->frame.clear();
+
+	SDL_Event e;
+	while (SDL_PollEvent(&e) != 0)
+	{
+		const bool isHandledEvent = this->isKeyEvent(e) || this->isMouseButtonEvent(e) || this->isMouseWheelEvent(e) ||
+			this->isMouseMotionEvent(e) || this->applicationExit(e) || this->windowResized(e) || this->isTextInput(e) ||
+			this->renderTargetsReset(e);
+		if (isHandledEvent)
+		{
+			this->frame.events.emplace_back(e);
+		}
+	}
+
+	int keyCount;
+	const uint8_t *keys = SDL_GetKeyboardState(&keyCount);
+	this->frame.keyboardState.assign(keys, keys + keyCount);
+	this->frame.keymod = SDL_GetModState();
+	this->frame.mouseState = SDL_GetMouseState(&this->frame.mousePosition.x, &this->frame.mousePosition.y);
+	SDL_GetRelativeMouseState(&this->frame.mouseDelta.x, &this->frame.mouseDelta.y);
+}
+
 void InputManager::update(Game &game, double dt, BufferView<const ButtonProxy> buttonProxies,
 	const std::function<void()> &onFinishedProcessingEvent)
 {
-	// @todo: don't save mouse delta as member, just keep local variable here once we can.
-	SDL_GetRelativeMouseState(&this->mouseDelta.x, &this->mouseDelta.y);
+	if (!this->hasReplayFrame)
+	{
+		this->pollFrame();
+	}
+	else
+	{
+		// Live input is ignored while replaying, but closing or resizing the window and render resets still have
+		// to reach the game, so they're handled along with the replayed events.
+		SDL_PumpEvents();
+
+		auto takeLiveEvents = [this](uint32_t minType, uint32_t maxType)
+		{
+			SDL_Event e;
+			while (SDL_PeepEvents(&e, 1, SDL_GETEVENT, minType, maxType) > 0)
+			{
+				this->frame.events.emplace_back(e);
+			}
+		};
+
+		takeLiveEvents(SDL_QUIT, SDL_QUIT);
+		takeLiveEvents(SDL_WINDOWEVENT, SDL_WINDOWEVENT);
+		takeLiveEvents(SDL_RENDER_TARGETS_RESET, SDL_RENDER_DEVICE_RESET);
+
+		// Keyboard, text input, and mouse.
+		SDL_FlushEvents(SDL_KEYDOWN, SDL_MOUSEWHEEL);
+	}
+
+	this->hasReplayFrame = false;
 
 	// Cache active maps and listeners before looping over them since callbacks can change which ones are active.
 	std::vector<const InputActionMap*> activeMaps;
@@ -706,15 +765,14 @@ void InputManager::update(Game &game, double dt, BufferView<const ButtonProxy> b
 	// Handle held mouse buttons and keys.
 	const BufferView<const InputActionMap*> activeMapsView(activeMaps);
 	const BufferView<const InputActionListenerEntry*> enabledInputActionListenersView(enabledInputActionListeners);
-	Int2 mousePosition;
-	const uint32_t mouseState = SDL_GetMouseState(&mousePosition.x, &mousePosition.y);
+	const Int2 mousePosition = this->frame.mousePosition;
+	const uint32_t mouseState = this->frame.mouseState;
 	this->handleHeldInputs(game, activeMapsView, enabledInputActionListenersView, mouseState, mousePosition, dt);
 
 	// Handle SDL events.
 	// @todo: make sure to not fire duplicate callbacks for the same input action if it is registered to multiple
 	// keys/mouse buttons like Skip.
-	SDL_Event e;
-	while (SDL_PollEvent(&e) != 0)
+	for (const SDL_Event &e : this->frame.events)
 	{
 		if (this->isKeyEvent(e))
 		{
@@ -875,7 +933,7 @@ void InputManager::update(Game &game, double dt, BufferView<const ButtonProxy> b
 		{
 			for (const MouseMotionListenerEntry *entry : enabledMouseMotionListeners)
 			{
-				entry->callback(game, this->mouseDelta.x, this->mouseDelta.y);
+				entry->callback(game, this->frame.mouseDelta.x, this->frame.mouseDelta.y);
 			}
 		}
 		else if (this->applicationExit(e))
@@ -894,6 +952,19 @@ void InputManager::update(Game &game, double dt, BufferView<const ButtonProxy> b
 				entry->callback(width, height);
 			}
 		}
+		else if (this->renderTargetsReset(e))
+		{
+			// Not a listener event; text boxes and other render target owners check the renderer's counts.
+			Renderer &renderer = game.getRenderer();
+			if (e.type == SDL_RENDER_DEVICE_RESET)
+			{
+				renderer.handleRenderDeviceReset();
+			}
+			else
+			{
+				renderer.handleRenderTargetsReset();
+			}
+		}
 		else if (this->isTextInput(e))
 		{
 			const std::string_view text = e.text.text;
@@ -13,6 +13,7 @@
 #include "ApplicationEvents.h"
 #include "InputActionEvents.h"
 #include "InputActionMap.h"
+#include "InputFrame.h"
 #include "PointerEvents.h"
 #include "TextEvents.h"
 #include "../Math/Vector2.h"
@@ -150,7 +151,9 @@ private:
 	ListenerID nextListenerID;
 	std::vector<ListenerID> freedListenerIDs;
 
-	Int2 mouseDelta;
+	// Input state for the current frame, either polled from SDL or provided by a replay.
+	InputFrame frame;
+	bool hasReplayFrame;
 
 	ListenerID getNextListenerID();
 
@@ -160,6 +163,9 @@ private:
 	ListenerID addListenerInternal(CallbackType &&callback, ListenerType listenerType, std::vector<EntryType> &listeners,
 		std::vector<int> &freedListenerIndices);
 	
+	// Fills the current frame's input state from SDL.
+	void pollFrame();
+
 	void handleHeldInputs(Game &game, BufferView<const InputActionMap*> activeMaps,
 		BufferView<const InputActionListenerEntry*> enabledInputActionListeners, uint32_t mouseState,
 		const Int2 &mousePosition, double dt);
@@ -184,6 +190,7 @@ public:
 	bool mouseWheeledDown(const SDL_Event &e) const;
 	bool applicationExit(const SDL_Event &e) const;
 	bool windowResized(const SDL_Event &e) const;
+	bool renderTargetsReset(const SDL_Event &e) const;
 	bool isTextInput(const SDL_Event &e) const;
 	Int2 getMousePosition() const;
 	Int2 getMouseDelta() const;
@@ -210,6 +217,12 @@ public:
 	// Sets whether keyboard input is interpreted as text input or hotkeys.
 	void setTextInputMode(bool active);
 
+	// Gets the input state of the most recent update, for recording.
+	const InputFrame &getFrame() const;
+
+	// Uses the given input state for the next update instead of polling SDL.
+	void setReplayFrame(const InputFrame &frame);
+
 	// Handle input listener callbacks, etc..
 	void update(Game &game, double dt, BufferView<const ButtonProxy> buttonProxies,
 		const std::function<void()> &onFinishedProcessingEvent);
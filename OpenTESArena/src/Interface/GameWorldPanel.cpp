@@ -820,6 +820,7 @@ bool GameWorldPanel::gameWorldRenderCallback(Game &game)
 
 	const RenderSkyManager &renderSkyManager = sceneManager.renderSkyManager;
 	const BufferView<const RenderDrawCall> skyObjectDrawCalls = renderSkyManager.getObjectDrawCalls();
+	const BufferView<const RenderSkyPoint> skyPoints = renderSkyManager.getSkyPoints();
 	drawCalls.emplace_back(renderSkyManager.getBgDrawCall());
 	drawCalls.insert(drawCalls.end(), skyObjectDrawCalls.begin(), skyObjectDrawCalls.end());
 
@@ -872,7 +873,10 @@ bool GameWorldPanel::gameWorldRenderCallback(Game &game)
 		lightTableTextureID = sceneManager.normalLightTableNightTextureRef.get();
 	}
 
-	renderer.submitFrame(renderCamera, drawCalls, ambientPercent, paletteTextureID, lightTableTextureID, options.getGraphics_RenderThreadsMode());
+	const double targetFrameTime = 1.0 / static_cast<double>(options.getGraphics_TargetFPS());
+	renderer.setDynamicResolution(options.getGraphics_DynamicResolution(), options.getGraphics_DynamicResolutionMinScale(), targetFrameTime);
+	renderer.submitFrame(renderCamera, drawCalls, skyPoints, ambientPercent, paletteTextureID, lightTableTextureID,
+		options.getGraphics_RenderThreadsMode(), options.getGraphics_TextureMipmaps(), options.getGraphics_PipelinedRendering());
 
 	return true;
 }
@@ -188,7 +188,7 @@ void MainMenuUiController::onQuickStartButtonSelected(Game &game, int testType,
 				// Any province besides center province.
 				// @temp: mildly disorganized
 				provinceIndex = game.getRandom().next(worldMapDef.getProvinceCount() - 1);
-				locationIndex = MainMenuUiModel::getRandomCityLocationIndex(worldMapDef.getProvinceDef(provinceIndex));
+				locationIndex = MainMenuUiModel::getRandomCityLocationIndex(worldMapDef.getProvinceDef(provinceIndex), game.getRandom());
 			}
 
 			const ProvinceDefinition &provinceDef = worldMapDef.getProvinceDef(provinceIndex);
@@ -240,7 +240,7 @@ void MainMenuUiController::onQuickStartButtonSelected(Game &game, int testType,
 
 			if (mifName == MainMenuUiModel::RandomNamedDungeon)
 			{
-				const std::optional<int> locationIndex = MainMenuUiModel::getRandomDungeonLocationDefIndex(provinceDef);
+				const std::optional<int> locationIndex = MainMenuUiModel::getRandomDungeonLocationDefIndex(provinceDef, game.getRandom());
 				DebugAssertMsg(locationIndex.has_value(), "Couldn't find named dungeon in \"" + provinceDef.getName() + "\".");
 
 				const LocationDefinition &locationDef = provinceDef.getLocationDef(*locationIndex);
@@ -277,7 +277,7 @@ void MainMenuUiController::onQuickStartButtonSelected(Game &game, int testType,
 				const int wildBlockX = random.next(ArenaWildUtils::WILD_WIDTH);
 				const int wildBlockY = random.next(ArenaWildUtils::WILD_HEIGHT);
 
-				const int locationIndex = MainMenuUiModel::getRandomCityLocationIndex(provinceDef);
+				const int locationIndex = MainMenuUiModel::getRandomCityLocationIndex(provinceDef, random);
 				const LocationDefinition &locationDef = provinceDef.getLocationDef(locationIndex);
 				const LocationCityDefinition &cityDef = locationDef.getCityDefinition();
 
@@ -424,7 +424,7 @@ void MainMenuUiController::onQuickStartButtonSelected(Game &game, int testType,
 				}
 			}();
 
-			const std::optional<int> locationIndex = MainMenuUiModel::getRandomCityLocationDefIndexIfType(provinceDef, targetCityType);
+			const std::optional<int> locationIndex = MainMenuUiModel::getRandomCityLocationDefIndexIfType(provinceDef, targetCityType, game.getRandom());
 			DebugAssertMsg(locationIndex.has_value(), "Couldn't find city for \"" + mifName + "\".");
 
 			const LocationDefinition &locationDef = provinceDef.getLocationDef(*locationIndex);
@@ -490,7 +490,7 @@ void MainMenuUiController::onQuickStartButtonSelected(Game &game, int testType,
 		const int provinceIndex = game.getRandom().next(worldMapDef.getProvinceCount() - 1);
 		const ProvinceDefinition &provinceDef = worldMapDef.getProvinceDef(provinceIndex);
 
-		const int locationIndex = MainMenuUiModel::getRandomCityLocationIndex(provinceDef);
+		const int locationIndex = MainMenuUiModel::getRandomCityLocationIndex(provinceDef, game.getRandom());
 		const LocationDefinition &locationDef = provinceDef.getLocationDef(locationIndex);
 		const LocationCityDefinition &cityDef = locationDef.getCityDefinition();
 
@@ -184,19 +184,19 @@ void MainMenuUiModel::getMainQuestLocationFromIndex(int testIndex, const ExeData
 	}
 }
 
-std::vector<int> MainMenuUiModel::makeShuffledLocationIndices(const ProvinceDefinition &provinceDef)
+std::vector<int> MainMenuUiModel::makeShuffledLocationIndices(const ProvinceDefinition &provinceDef, Random &random)
 {
 	std::vector<int> indices(provinceDef.getLocationCount());
 	std::iota(indices.begin(), indices.end(), 0);
-	RandomUtils::shuffle<int>(indices);
+	RandomUtils::shuffle<int>(indices, random);
 	return indices;
 }
 
 std::optional<int> MainMenuUiModel::getRandomCityLocationDefIndexIfType(const ProvinceDefinition &provinceDef,
-	ArenaTypes::CityType cityType)
+	ArenaTypes::CityType cityType, Random &random)
 {
 	// Iterate over locations in the province in a random order.
-	const std::vector<int> randomLocationIndices = MainMenuUiModel::makeShuffledLocationIndices(provinceDef);
+	const std::vector<int> randomLocationIndices = MainMenuUiModel::makeShuffledLocationIndices(provinceDef, random);
 
 	for (const int locationIndex : randomLocationIndices)
 	{
@@ -214,10 +214,10 @@ std::optional<int> MainMenuUiModel::getRandomCityLocationDefIndexIfType(const Pr
 	return std::nullopt;
 }
 
-int MainMenuUiModel::getRandomCityLocationIndex(const ProvinceDefinition &provinceDef)
+int MainMenuUiModel::getRandomCityLocationIndex(const ProvinceDefinition &provinceDef, Random &random)
 {
 	// Iterate over locations in the province in a random order.
-	const std::vector<int> randomLocationIndices = MainMenuUiModel::makeShuffledLocationIndices(provinceDef);
+	const std::vector<int> randomLocationIndices = MainMenuUiModel::makeShuffledLocationIndices(provinceDef, random);
 
 	for (const int locationIndex : randomLocationIndices)
 	{
@@ -231,10 +231,10 @@ int MainMenuUiModel::getRandomCityLocationIndex(const ProvinceDefinition &provin
 	return -1;
 }
 
-std::optional<int> MainMenuUiModel::getRandomDungeonLocationDefIndex(const ProvinceDefinition &provinceDef)
+std::optional<int> MainMenuUiModel::getRandomDungeonLocationDefIndex(const ProvinceDefinition &provinceDef, Random &random)
 {
 	// Iterate over locations in the province in a random order.
-	const std::vector<int> randomLocationIndices = MainMenuUiModel::makeShuffledLocationIndices(provinceDef);
+	const std::vector<int> randomLocationIndices = MainMenuUiModel::makeShuffledLocationIndices(provinceDef, random);
 
 	for (const int locationIndex : randomLocationIndices)
 	{
@@ -12,8 +12,28 @@
 
 int main(int argc, char *argv[])
 {
-	static_cast<void>(argc);
-	static_cast<void>(argv);
+	// Optional "--record <file>" or "--replay <file>" for deterministic session playback.
+	std::string recordFilename, replayFilename;
+	for (int i = 1; i < argc; i += 2)
+	{
+		const std::string arg = argv[i];
+		const bool isKnownArg = (arg == "--record") || (arg == "--replay");
+		if (!isKnownArg || ((i + 1) >= argc))
+		{
+			std::cerr << (isKnownArg ? "Missing value for \"" : "Unrecognized argument \"") << arg << "\".\n";
+			std::cerr << "Usage: OpenTESArena [--record FILE | --replay FILE]\n";
+			return EXIT_FAILURE;
+		}
+
+		if (arg == "--record")
+		{
+			recordFilename = argv[i + 1];
+		}
+		else
+		{
+			replayFilename = argv[i + 1];
+		}
+	}
 
 	const std::string logPath = Platform::getLogPath();
 	if (!Debug::init(logPath.c_str()))
@@ -31,6 +51,21 @@ int main(int argc, char *argv[])
 			DebugCrash("Couldn't init Game instance. Closing.");
 		}
 
+		if (!replayFilename.empty())
+		{
+			if (!game->initReplay(replayFilename))
+			{
+				DebugCrash("Couldn't init replay \"" + replayFilename + "\".");
+			}
+		}
+		else if (!recordFilename.empty())
+		{
+			if (!game->initRecording(recordFilename))
+			{
+				DebugCrash("Couldn't init recording \"" + recordFilename + "\".");
+			}
+		}
+
 		game->loop();
 	}
 	catch (const std::exception &e)
@@ -1,23 +1,12 @@
 #ifndef RANDOM_UTILS_H
 #define RANDOM_UTILS_H
 
-#include <algorithm>
-#include <random>
-
 #include "Random.h"
 
 #include "components/utilities/BufferView.h"
 
 namespace RandomUtils
 {
-	// Shuffles the elements randomly with an unspecified RNG source.
-	template<typename T>
-	void shuffle(BufferView<T> buffer)
-	{
-		std::random_device randomDevice;
-		std::shuffle(buffer.begin(), buffer.end(), std::default_random_engine(randomDevice()));
-	}
-
 	// Shuffles the elements randomly with the given RNG source.
 	template<typename T>
 	void shuffle(BufferView<T> buffer, Random &random)
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <cmath>
+
+#include "DynamicResolutionController.h"
+
+#include "components/debug/Debug.h"
+
+namespace
+{
+	// Share of the target frame time the 3D renderer may use. The rest is left for simulation and UI.
+	constexpr double RenderBudgetPercent = 0.75;
+
+	// Exponential smoothing weight of the newest frame time.
+	constexpr double FrameTimeSmoothing = 0.15;
+
+	// Hysteresis band around the budget.
+	constexpr double OverBudgetRatio = 1.05;
+	constexpr double UnderBudgetRatio = 0.80;
+
+	// Dropping resolution reacts quickly so hitches are short, raising it waits until the scene is reliably cheap.
+	constexpr int FramesOverBudgetBeforeDecrease = 4;
+	constexpr int FramesUnderBudgetBeforeIncrease = 45;
+	constexpr int CooldownFramesAfterChange = 8;
+
+	// Limits on a single scale change.
+	constexpr double MinDecreaseMultiplier = 0.80;
+	constexpr double MaxDecreaseMultiplier = 0.97;
+	constexpr double MinIncreaseMultiplier = 1.02;
+	constexpr double MaxIncreaseMultiplier = 1.10;
+}
+
+DynamicResolutionController::DynamicResolutionController()
+{
+	this->reset(1.0);
+}
+
+void DynamicResolutionController::reset(double scale)
+{
+	this->scale = scale;
+	this->smoothedFrameTime = 0.0;
+	this->framesOverBudget = 0;
+	this->framesUnderBudget = 0;
+	this->cooldownFrames = 0;
+}
+
+double DynamicResolutionController::getScale() const
+{
+	return this->scale;
+}
+
+void DynamicResolutionController::update(double frameTime, double targetFrameTime, double minScale, double maxScale)
+{
+	DebugAssert(minScale <= maxScale);
+
+	// Bounds might have changed in the options.
+	const double clampedScale = std::clamp(this->scale, minScale, maxScale);
+	if (clampedScale != this->scale)
+	{
+		this->reset(clampedScale);
+		return;
+	}
+
+	if (this->cooldownFrames > 0)
+	{
+		this->cooldownFrames--;
+		return;
+	}
+
+	if (this->smoothedFrameTime <= 0.0)
+	{
+		this->smoothedFrameTime = frameTime;
+	}
+	else
+	{
+		this->smoothedFrameTime += (frameTime - this->smoothedFrameTime) * FrameTimeSmoothing;
+	}
+
+	const double budget = targetFrameTime * RenderBudgetPercent;
+	if ((budget <= 0.0) || (this->smoothedFrameTime <= 0.0))
+	{
+		return;
+	}
+
+	const double budgetRatio = this->smoothedFrameTime / budget;
+	if (budgetRatio > OverBudgetRatio)
+	{
+		this->framesOverBudget++;
+		this->framesUnderBudget = 0;
+	}
+	else if (budgetRatio < UnderBudgetRatio)
+	{
+		this->framesUnderBudget++;
+		this->framesOverBudget = 0;
+	}
+	else
+	{
+		this->framesOverBudget = 0;
+		this->framesUnderBudget = 0;
+	}
+
+	// Rasterization cost is roughly proportional to pixel count, which grows with the square of the scale.
+	const double idealMultiplier = std::sqrt(1.0 / budgetRatio);
+	double newScale = this->scale;
+	if (this->framesOverBudget >= FramesOverBudgetBeforeDecrease)
+	{
+		newScale = this->scale * std::clamp(idealMultiplier, MinDecreaseMultiplier, MaxDecreaseMultiplier);
+	}
+	else if (this->framesUnderBudget >= FramesUnderBudgetBeforeIncrease)
+	{
+		newScale = this->scale * std::clamp(idealMultiplier, MinIncreaseMultiplier, MaxIncreaseMultiplier);
+	}
+
+	newScale = std::clamp(newScale, minScale, maxScale);
+	if (newScale != this->scale)
+	{
+		this->reset(newScale);
+		this->cooldownFrames = CooldownFramesAfterChange;
+	}
+	else if ((this->framesOverBudget >= FramesOverBudgetBeforeDecrease) || (this->framesUnderBudget >= FramesUnderBudgetBeforeIncrease))
+	{
+		// Already at a bound.
+		this->framesOverBudget = 0;
+		this->framesUnderBudget = 0;
+	}
+}
@@ -0,0 +1,26 @@
+#ifndef DYNAMIC_RESOLUTION_CONTROLLER_H
+#define DYNAMIC_RESOLUTION_CONTROLLER_H
+
+// Adjusts the 3D render resolution scale to keep rasterization time within a frame-time budget. Uses a smoothed
+// frame time and requires several consecutive frames over or under budget before changing, so the scale doesn't
+// oscillate between two values.
+
+class DynamicResolutionController
+{
+private:
+	double scale;
+	double smoothedFrameTime; // Zero until the first frame at the current scale is measured.
+	int framesOverBudget, framesUnderBudget;
+	int cooldownFrames; // Frames to ignore after a scale change so the new scale's cost settles first.
+public:
+	DynamicResolutionController();
+
+	void reset(double scale);
+
+	double getScale() const;
+
+	// Feeds the most recent 3D frame time in seconds. The scale is kept between the given bounds.
+	void update(double frameTime, double targetFrameTime, double minScale, double maxScale);
+};
+
+#endif
@@ -1,9 +1,12 @@
 #include <algorithm>
 
 #include "RenderChunk.h"
+#include "Renderer.h"
 #include "RendererSystem3D.h"
 #include "../World/ChunkUtils.h"
 
+#include "components/debug/Debug.h"
+
 RenderVoxelLightIdList::RenderVoxelLightIdList()
 {
 	this->clear();
@@ -19,21 +22,59 @@ BufferView<const RenderLightID> RenderVoxelLightIdList::getLightIDs() const
 	return BufferView<const RenderLightID>(this->lightIDs, this->lightCount);
 }
 
-void RenderVoxelLightIdList::tryAddLight(RenderLightID id)
+BufferView<const RenderLightID> RenderVoxelLightIdList::getDynamicLightIDs() const
+{
+	return BufferView<const RenderLightID>(this->lightIDs, this->dynamicLightCount);
+}
+
+bool RenderVoxelLightIdList::hasStaticLights() const
+{
+	return this->lightCount > this->dynamicLightCount;
+}
+
+bool RenderVoxelLightIdList::trySetLightIDs(const RenderLightID *ids, int count, int dynamicCount)
 {
-	if (this->lightCount >= static_cast<int>(std::size(this->lightIDs)))
+	DebugAssert(count >= 0);
+	DebugAssert(count <= static_cast<int>(std::size(this->lightIDs)));
+	DebugAssert(dynamicCount >= 0);
+	DebugAssert(dynamicCount <= count);
+	if ((count == this->lightCount) && (dynamicCount == this->dynamicLightCount) && std::equal(ids, ids + count, this->lightIDs))
 	{
-		return;
+		return false;
 	}
 
-	this->lightIDs[this->lightCount] = id;
-	this->lightCount++;
+	std::copy(ids, ids + count, this->lightIDs);
+	std::fill(this->lightIDs + count, std::end(this->lightIDs), -1);
+	this->lightCount = count;
+	this->dynamicLightCount = dynamicCount;
+	return true;
 }
 
 void RenderVoxelLightIdList::clear()
 {
 	std::fill(std::begin(this->lightIDs), std::end(this->lightIDs), -1);
 	this->lightCount = 0;
+	this->dynamicLightCount = 0;
+}
+
+RenderChunkLight::RenderChunkLight()
+{
+	this->lightID = -1;
+	this->startRadius = 0.0;
+	this->endRadius = 0.0;
+	this->isStatic = false;
+}
+
+void RenderChunkLight::init(RenderLightID lightID, const WorldDouble3 &position, double startRadius, double endRadius,
+	const WorldInt3 &minVoxel, const WorldInt3 &maxVoxel, bool isStatic)
+{
+	this->lightID = lightID;
+	this->position = position;
+	this->startRadius = startRadius;
+	this->endRadius = endRadius;
+	this->minVoxel = minVoxel;
+	this->maxVoxel = maxVoxel;
+	this->isStatic = isStatic;
 }
 
 void RenderChunk::init(const ChunkInt2 &position, int height)
@@ -57,15 +98,69 @@ RenderVoxelMeshDefID RenderChunk::addMeshDefinition(RenderVoxelMeshDefinition &&
 
 void RenderChunk::addDirtyLightPosition(const VoxelInt3 &position)
 {
-	const auto iter = std::find(this->dirtyLightPositions.begin(), this->dirtyLightPositions.end(), position);
-	if (iter == this->dirtyLightPositions.end())
+	// Not deduplicated; draw call rebuilding only checks whether any voxel is dirty.
+	this->dirtyLightPositions.emplace_back(position);
+}
+
+void RenderChunk::addLight(const RenderChunkLight &light)
+{
+	DebugAssert(std::none_of(this->lights.begin(), this->lights.end(),
+		[&light](const RenderChunkLight &other) { return other.lightID == light.lightID; }));
+	this->lights.emplace_back(light);
+}
+
+void RenderChunk::removeLight(RenderLightID lightID)
+{
+	const auto iter = std::find_if(this->lights.begin(), this->lights.end(),
+		[lightID](const RenderChunkLight &light) { return light.lightID == lightID; });
+	if (iter != this->lights.end())
 	{
-		this->dirtyLightPositions.emplace_back(position);
+		*iter = this->lights.back();
+		this->lights.pop_back();
 	}
 }
 
+ObjectTextureID RenderChunk::getVoxelTextureID(VoxelChunk::VoxelTextureDefID textureDefID, int textureAssetIndex) const
+{
+	DebugAssert(textureAssetIndex >= 0);
+	DebugAssert(textureAssetIndex < VoxelTextureDefinition::MAX_TEXTURES);
+	const int index = (textureDefID * VoxelTextureDefinition::MAX_TEXTURES) + textureAssetIndex;
+	if ((index < 0) || (index >= static_cast<int>(this->voxelTextureIDs.size())))
+	{
+		return -1;
+	}
+
+	return this->voxelTextureIDs[index];
+}
+
+void RenderChunk::setVoxelTextureID(VoxelChunk::VoxelTextureDefID textureDefID, int textureAssetIndex, ObjectTextureID textureID)
+{
+	DebugAssert(textureDefID >= 0);
+	DebugAssert(textureAssetIndex >= 0);
+	DebugAssert(textureAssetIndex < VoxelTextureDefinition::MAX_TEXTURES);
+	const int index = (textureDefID * VoxelTextureDefinition::MAX_TEXTURES) + textureAssetIndex;
+	if (index >= static_cast<int>(this->voxelTextureIDs.size()))
+	{
+		this->voxelTextureIDs.resize((textureDefID + 1) * VoxelTextureDefinition::MAX_TEXTURES, -1);
+	}
+
+	this->voxelTextureIDs[index] = textureID;
+}
+
+void RenderChunk::freeLightmaps(Renderer &renderer)
+{
+	for (const auto &pair : this->lightmapIDs)
+	{
+		renderer.freeLightmap(pair.second);
+	}
+
+	this->lightmapIDs.clear();
+}
+
 void RenderChunk::freeBuffers(Renderer &renderer)
 {
+	this->freeLightmaps(renderer);
+
 	for (RenderVoxelMeshDefinition &meshDef : this->meshDefs)
 	{
 		meshDef.freeBuffers(renderer);
@@ -78,8 +173,11 @@ void RenderChunk::clear()
 	this->meshDefs.clear();
 	this->meshDefMappings.clear();
 	this->meshDefIDs.clear();
+	this->voxelTextureIDs.clear();
 	this->chasmWallIndexBufferIDsMap.clear();
 	this->voxelLightIdLists.clear();
+	this->lights.clear();
+	this->lightmapIDs.clear();
 	this->dirtyLightPositions.clear();
 	this->staticDrawCalls.clear();
 	this->doorDrawCalls.clear();
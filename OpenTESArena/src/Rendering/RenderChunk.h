@@ -24,15 +24,35 @@ struct RenderVoxelLightIdList
 {
 	RenderLightID lightIDs[RenderDrawCall::MAX_LIGHTS];
 	int lightCount;
+	int dynamicLightCount; // Dynamic lights are listed first.
 
 	RenderVoxelLightIdList();
 
 	BufferView<RenderLightID> getLightIDs();
 	BufferView<const RenderLightID> getLightIDs() const;
-	void tryAddLight(RenderLightID id);
+	BufferView<const RenderLightID> getDynamicLightIDs() const;
+	bool hasStaticLights() const;
+
+	// Replaces the list if the given lights differ. Returns whether anything changed.
+	bool trySetLightIDs(const RenderLightID *ids, int count, int dynamicCount);
 	void clear();
 };
 
+// A light whose range reaches into a chunk. Lets a voxel's light list be rebuilt without visiting every light in the scene.
+struct RenderChunkLight
+{
+	RenderLightID lightID;
+	WorldDouble3 position;
+	double startRadius, endRadius;
+	WorldInt3 minVoxel, maxVoxel; // Voxels touched by the light's end radius.
+	bool isStatic; // Static lights never move and can be baked into lightmaps.
+
+	RenderChunkLight();
+
+	void init(RenderLightID lightID, const WorldDouble3 &position, double startRadius, double endRadius,
+		const WorldInt3 &minVoxel, const WorldInt3 &maxVoxel, bool isStatic);
+};
+
 class RenderChunk final : public Chunk
 {
 public:
@@ -41,9 +61,12 @@ public:
 	std::vector<RenderVoxelMeshDefinition> meshDefs;
 	std::unordered_map<VoxelChunk::VoxelMeshDefID, RenderVoxelMeshDefID> meshDefMappings; // Note: this doesn't support VoxelIDs changing which def they point to (important if VoxelChunk::removeVoxelDef() is ever in use).
 	Buffer3D<RenderVoxelMeshDefID> meshDefIDs; // Points into mesh instances.
+	std::vector<ObjectTextureID> voxelTextureIDs; // Direct lookup by voxel texture def ID and texture asset index, -1 if not loaded. IDs are owned by the render chunk manager.
 	std::unordered_map<VoxelInt3, IndexBufferID> chasmWallIndexBufferIDsMap; // If an index buffer ID exists for a voxel, it adds a draw call for the chasm wall. IDs are owned by the render chunk manager.
-	Buffer3D<RenderVoxelLightIdList> voxelLightIdLists; // Lights touching each voxel. IDs are owned by RenderChunkManager.
-	std::vector<VoxelInt3> dirtyLightPositions; // Voxels that need relevant lights updated.
+	Buffer3D<RenderVoxelLightIdList> voxelLightIdLists; // Lights touching each voxel, nearest first. IDs are owned by RenderChunkManager.
+	std::vector<RenderChunkLight> lights; // Every enabled light touching at least one voxel in the chunk.
+	std::unordered_map<VoxelInt3, RenderLightmapID> lightmapIDs; // Baked static lights of voxels with draw calls, created on demand. IDs are owned by the render chunk.
+	std::vector<VoxelInt3> dirtyLightPositions; // Voxels whose light lists changed this frame.
 	std::vector<RenderDrawCall> staticDrawCalls; // Most voxel geometry (walls, floors, etc.).
 	std::vector<RenderDrawCall> doorDrawCalls; // All doors, open or closed.
 	std::vector<RenderDrawCall> chasmDrawCalls; // Chasm walls and floors, separate from static draw calls so their textures can animate.
@@ -59,6 +82,11 @@ public:
 	void init(const ChunkInt2 &position, int height);
 	RenderVoxelMeshDefID addMeshDefinition(RenderVoxelMeshDefinition &&meshDef);
 	void addDirtyLightPosition(const VoxelInt3 &position);
+	void addLight(const RenderChunkLight &light);
+	void removeLight(RenderLightID lightID);
+	ObjectTextureID getVoxelTextureID(VoxelChunk::VoxelTextureDefID textureDefID, int textureAssetIndex) const;
+	void setVoxelTextureID(VoxelChunk::VoxelTextureDefID textureDefID, int textureAssetIndex, ObjectTextureID textureID);
+	void freeLightmaps(Renderer &renderer);
 	void freeBuffers(Renderer &renderer);
 	void clear();
 };
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <numeric>
 #include <optional>
 
@@ -22,10 +23,12 @@
 #include "../Voxels/VoxelVisibilityChunkManager.h"
 #include "../World/ArenaMeshUtils.h"
 #include "../World/ChunkManager.h"
+#include "../World/ChunkUtils.h"
 #include "../World/MapDefinition.h"
 #include "../World/MapType.h"
 
 #include "components/debug/Debug.h"
+#include "components/utilities/FrameArena.h"
 
 namespace sgTexture
 {
@@ -93,18 +96,14 @@ namespace sgTexture
 
 	// Loads the given voxel definition's textures into the voxel textures list if they haven't been loaded yet.
 	void LoadVoxelDefTextures(const VoxelTextureDefinition &voxelTextureDef,
-		std::vector<RenderChunkManager::LoadedVoxelTexture> &voxelTextures, TextureManager &textureManager, Renderer &renderer)
+		std::vector<RenderChunkManager::LoadedVoxelTexture> &voxelTextures, std::unordered_map<TextureAsset, int> &voxelTextureIndices,
+		TextureManager &textureManager, Renderer &renderer)
 	{
 		for (int i = 0; i < voxelTextureDef.textureCount; i++)
 		{
 			const TextureAsset &textureAsset = voxelTextureDef.getTextureAsset(i);
-			const auto cacheIter = std::find_if(voxelTextures.begin(), voxelTextures.end(),
-				[&textureAsset](const RenderChunkManager::LoadedVoxelTexture &loadedTexture)
-			{
-				return loadedTexture.textureAsset == textureAsset;
-			});
-
-			if (cacheIter == voxelTextures.end())
+			const auto cacheIter = voxelTextureIndices.find(textureAsset);
+			if (cacheIter == voxelTextureIndices.end())
 			{
 				const std::optional<TextureBuilderID> textureBuilderID = textureManager.tryGetTextureBuilderID(textureAsset);
 				if (!textureBuilderID.has_value())
@@ -125,6 +124,7 @@ namespace sgTexture
 				RenderChunkManager::LoadedVoxelTexture newTexture;
 				newTexture.init(textureAsset, std::move(voxelTextureRef));
 				voxelTextures.emplace_back(std::move(newTexture));
+				voxelTextureIndices.emplace(textureAsset, static_cast<int>(voxelTextures.size()) - 1);
 			}
 		}
 	}
@@ -167,22 +167,18 @@ namespace sgTexture
 	}
 
 	void LoadChasmDefTextures(VoxelChunk::ChasmDefID chasmDefID, const VoxelChunk &voxelChunk,
-		BufferView<const RenderChunkManager::LoadedVoxelTexture> voxelTextures,
+		const std::unordered_map<TextureAsset, int> &voxelTextureIndices,
 		std::vector<RenderChunkManager::LoadedChasmFloorTextureList> &chasmFloorTextureLists,
 		std::vector<RenderChunkManager::LoadedChasmTextureKey> &chasmTextureKeys,
+		std::unordered_map<ChunkInt2, std::vector<int>> &chasmTextureKeyIndices,
 		TextureManager &textureManager, Renderer &renderer)
 	{
 		const ChunkInt2 chunkPos = voxelChunk.getPosition();
 		const ChasmDefinition &chasmDef = voxelChunk.getChasmDef(chasmDefID);
 
 		// Check if this chasm already has a mapping (i.e. have we seen this chunk before?).
-		const auto keyIter = std::find_if(chasmTextureKeys.begin(), chasmTextureKeys.end(),
-			[chasmDefID, &chunkPos](const RenderChunkManager::LoadedChasmTextureKey &loadedKey)
-		{
-			return (loadedKey.chasmDefID == chasmDefID) && (loadedKey.chunkPos == chunkPos);
-		});
-
-		if (keyIter != chasmTextureKeys.end())
+		std::vector<int> &chunkKeyIndices = chasmTextureKeyIndices[chunkPos];
+		if ((chasmDefID < static_cast<int>(chunkKeyIndices.size())) && (chunkKeyIndices[chasmDefID] >= 0))
 		{
 			return;
 		}
@@ -271,14 +267,9 @@ namespace sgTexture
 
 		// The chasm wall (if any) should already be loaded as a voxel texture during map gen.
 		// @todo: support chasm walls adding to the voxel textures list (i.e. for destroyed voxels; the list would have to be non-const)
-		const auto chasmWallIter = std::find_if(voxelTextures.begin(), voxelTextures.end(),
-			[&chasmDef](const RenderChunkManager::LoadedVoxelTexture &voxelTexture)
-		{
-			return voxelTexture.textureAsset == chasmDef.wallTextureAsset;
-		});
-
-		DebugAssert(chasmWallIter != voxelTextures.end());
-		const int chasmWallIndex = static_cast<int>(std::distance(voxelTextures.begin(), chasmWallIter));
+		const auto chasmWallIter = voxelTextureIndices.find(chasmDef.wallTextureAsset);
+		DebugAssert(chasmWallIter != voxelTextureIndices.end());
+		const int chasmWallIndex = chasmWallIter->second;
 
 		DebugAssert(chasmFloorListIndex >= 0);
 		DebugAssert(chasmWallIndex >= 0);
@@ -286,6 +277,13 @@ namespace sgTexture
 		RenderChunkManager::LoadedChasmTextureKey key;
 		key.init(chunkPos, chasmDefID, chasmFloorListIndex, chasmWallIndex);
 		chasmTextureKeys.emplace_back(std::move(key));
+
+		if (chasmDefID >= static_cast<int>(chunkKeyIndices.size()))
+		{
+			chunkKeyIndices.resize(chasmDefID + 1, -1);
+		}
+
+		chunkKeyIndices[chasmDefID] = static_cast<int>(chasmTextureKeys.size()) - 1;
 	}
 
 	// Creates a buffer of texture refs, intended to be accessed with linearized keyframe indices.
@@ -383,6 +381,130 @@ namespace sgTexture
 	}
 }
 
+namespace sgDrawOrder
+{
+	// Sort key layout from most to least significant bits. Draw calls are ordered by chunk, then by whole-voxel
+	// distance, then grouped by texture, then by the remaining distance. Translucent draw calls go last and are
+	// ordered back to front since they blend with what's behind them.
+	constexpr int FINE_DISTANCE_BITS = 20;
+	constexpr int TEXTURE_BITS = 20;
+	constexpr int DISTANCE_BITS = 16;
+	constexpr int CHUNK_RANK_BITS = 7;
+	constexpr int TEXTURE_SHIFT = FINE_DISTANCE_BITS;
+	constexpr int DISTANCE_SHIFT = TEXTURE_SHIFT + TEXTURE_BITS;
+	constexpr int CHUNK_RANK_SHIFT = DISTANCE_SHIFT + DISTANCE_BITS;
+	constexpr int TRANSLUCENT_SHIFT = CHUNK_RANK_SHIFT + CHUNK_RANK_BITS;
+	static_assert(TRANSLUCENT_SHIFT == 63);
+
+	constexpr int RADIX_BITS = 8;
+	constexpr int RADIX_BUCKET_COUNT = 1 << RADIX_BITS;
+	constexpr int RADIX_PASS_COUNT = 64 / RADIX_BITS;
+
+	constexpr uint64_t makeMask(int bitCount)
+	{
+		return (static_cast<uint64_t>(1) << bitCount) - 1;
+	}
+
+	bool isTranslucent(const RenderDrawCall &drawCall)
+	{
+		return drawCall.pixelShaderType == PixelShaderType::AlphaTestedWithLightLevelOpacity;
+	}
+
+	uint64_t makeKey(const RenderDrawCall &drawCall, int chunkRank, const WorldDouble2 &cameraPointXZ)
+	{
+		const WorldDouble2 drawCallPointXZ(drawCall.position.x, drawCall.position.z);
+		const double distance = (drawCallPointXZ - cameraPointXZ).length();
+		const double wholeDistance = std::floor(distance);
+
+		uint64_t distanceBits = std::min(static_cast<uint64_t>(wholeDistance), makeMask(DISTANCE_BITS));
+		uint64_t fineDistanceBits = std::min(static_cast<uint64_t>((distance - wholeDistance) * static_cast<double>(makeMask(FINE_DISTANCE_BITS) + 1)),
+			makeMask(FINE_DISTANCE_BITS));
+		uint64_t chunkRankBits = std::min(static_cast<uint64_t>(chunkRank), makeMask(CHUNK_RANK_BITS));
+
+		const bool translucent = sgDrawOrder::isTranslucent(drawCall);
+		if (translucent)
+		{
+			distanceBits = makeMask(DISTANCE_BITS) - distanceBits;
+			fineDistanceBits = makeMask(FINE_DISTANCE_BITS) - fineDistanceBits;
+			chunkRankBits = makeMask(CHUNK_RANK_BITS) - chunkRankBits;
+		}
+
+		const std::optional<ObjectTextureID> &textureID = drawCall.textureIDs[0];
+		const uint64_t textureBits = textureID.has_value() ? (static_cast<uint64_t>(*textureID) & makeMask(TEXTURE_BITS)) : 0;
+
+		return (static_cast<uint64_t>(translucent) << TRANSLUCENT_SHIFT) | (chunkRankBits << CHUNK_RANK_SHIFT) |
+			(distanceBits << DISTANCE_SHIFT) | (textureBits << TEXTURE_SHIFT) | fineDistanceBits;
+	}
+
+	// Least-significant-digit radix sort. Passes where every key has the same digit are skipped.
+	void radixSort(std::vector<RenderChunkManager::DrawCallSortEntry> &entries,
+		std::vector<RenderChunkManager::DrawCallSortEntry> &scratch)
+	{
+		scratch.resize(entries.size());
+
+		for (int pass = 0; pass < RADIX_PASS_COUNT; pass++)
+		{
+			const int shift = pass * RADIX_BITS;
+			std::array<int, RADIX_BUCKET_COUNT> bucketOffsets;
+			bucketOffsets.fill(0);
+
+			for (const RenderChunkManager::DrawCallSortEntry &entry : entries)
+			{
+				const int digit = static_cast<int>((entry.key >> shift) & makeMask(RADIX_BITS));
+				bucketOffsets[digit]++;
+			}
+
+			const int entryCount = static_cast<int>(entries.size());
+			const bool isSingleBucket = std::any_of(bucketOffsets.begin(), bucketOffsets.end(),
+				[entryCount](int count) { return count == entryCount; });
+			if (isSingleBucket)
+			{
+				continue;
+			}
+
+			int offset = 0;
+			for (int &bucketOffset : bucketOffsets)
+			{
+				const int count = bucketOffset;
+				bucketOffset = offset;
+				offset += count;
+			}
+
+			for (const RenderChunkManager::DrawCallSortEntry &entry : entries)
+			{
+				const int digit = static_cast<int>((entry.key >> shift) & makeMask(RADIX_BITS));
+				scratch[bucketOffsets[digit]] = entry;
+				bucketOffsets[digit]++;
+			}
+
+			std::swap(entries, scratch);
+		}
+	}
+}
+
+namespace sgLightmap
+{
+	// Samples along each axis of a voxel, including both faces. Spacing of a quarter voxel keeps the linear falloff
+	// of nearby lights close to per-pixel results.
+	constexpr int SAMPLES_PER_AXIS = 5;
+
+	// Same falloff as the software renderer's per-pixel lighting.
+	double GetLightIntensity(const RenderChunkLight &light, const WorldDouble3 &point)
+	{
+		const double distance = (light.position - point).length();
+		if (distance <= light.startRadius)
+		{
+			return 1.0;
+		}
+		else if (distance >= light.endRadius)
+		{
+			return 0.0;
+		}
+
+		return std::clamp(1.0 - ((distance - light.startRadius) / (light.endRadius - light.startRadius)), 0.0, 1.0);
+	}
+}
+
 void RenderChunkManager::LoadedVoxelTexture::init(const TextureAsset &textureAsset,
 	ScopedObjectTextureRef &&objectTextureRef)
 {
@@ -450,19 +572,50 @@ void RenderChunkManager::LoadedEntityAnimation::init(EntityDefID defID, Buffer<S
 RenderChunkManager::Light::Light()
 {
 	this->lightID = -1;
+	this->startRadius = 0.0;
+	this->endRadius = 0.0;
 	this->enabled = false;
+	this->isStatic = false;
+	this->isBinned = false;
 }
 
-void RenderChunkManager::Light::init(RenderLightID lightID, bool enabled)
+void RenderChunkManager::Light::init(RenderLightID lightID, const WorldDouble3 &position, double startRadius, double endRadius,
+	double ceilingScale, bool enabled, bool isStatic)
 {
 	this->lightID = lightID;
+	this->setVolume(position, startRadius, endRadius, ceilingScale);
 	this->enabled = enabled;
+	this->isStatic = isStatic;
+	this->isBinned = false;
+}
+
+void RenderChunkManager::Light::setVolume(const WorldDouble3 &position, double startRadius, double endRadius, double ceilingScale)
+{
+	this->position = position;
+	this->startRadius = startRadius;
+	this->endRadius = endRadius;
+
+	const WorldDouble3 radiusVector(endRadius, endRadius, endRadius);
+	this->minVoxel = VoxelUtils::pointToVoxel(position - radiusVector, ceilingScale);
+	this->maxVoxel = VoxelUtils::pointToVoxel(position + radiusVector, ceilingScale);
+}
+
+RenderChunkManager::DrawCallSortEntry::DrawCallSortEntry()
+{
+	this->key = 0;
+	this->drawCallIndex = -1;
+}
+
+void RenderChunkManager::DrawCallSortEntry::init(uint64_t key, int drawCallIndex)
+{
+	this->key = key;
+	this->drawCallIndex = drawCallIndex;
 }
 
 RenderChunkManager::RenderChunkManager()
 {
 	this->chasmWallIndexBufferIDs.fill(-1);
-	this->playerLightID = -1;
+	this->staticLightmapsEnabled = false;
 }
 
 void RenderChunkManager::init(Renderer &renderer)
@@ -553,28 +706,29 @@ void RenderChunkManager::init(Renderer &renderer)
 		return;
 	}
 
-	constexpr std::array<double, entityMeshVertexCount * positionComponentsPerVertex> entityVertices =
+	// Entity mesh data is uploaded as float since that's what the renderer stores.
+	constexpr std::array<float, entityMeshVertexCount * positionComponentsPerVertex> entityVertices =
 	{
-		0.0, 1.0, -0.50,
-		0.0, 0.0, -0.50,
-		0.0, 0.0, 0.50,
-		0.0, 1.0, 0.50
+		0.0f, 1.0f, -0.50f,
+		0.0f, 0.0f, -0.50f,
+		0.0f, 0.0f, 0.50f,
+		0.0f, 1.0f, 0.50f
 	};
 
-	constexpr std::array<double, entityMeshVertexCount * normalComponentsPerVertex> dummyEntityNormals =
+	constexpr std::array<float, entityMeshVertexCount * normalComponentsPerVertex> dummyEntityNormals =
 	{
-		0.0, 0.0, 0.0,
-		0.0, 0.0, 0.0,
-		0.0, 0.0, 0.0,
-		0.0, 0.0, 0.0
+		0.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 0.0f,
+		0.0f, 0.0f, 0.0f
 	};
 
-	constexpr std::array<double, entityMeshVertexCount * texCoordComponentsPerVertex> entityTexCoords =
+	constexpr std::array<float, entityMeshVertexCount * texCoordComponentsPerVertex> entityTexCoords =
 	{
-		0.0, 0.0,
-		0.0, 1.0,
-		1.0, 1.0,
-		1.0, 0.0
+		0.0f, 0.0f,
+		0.0f, 1.0f,
+		1.0f, 1.0f,
+		1.0f, 0.0f
 	};
 
 	constexpr std::array<int32_t, entityMeshIndexCount> entityIndices =
@@ -583,20 +737,22 @@ void RenderChunkManager::init(Renderer &renderer)
 		2, 3, 0
 	};
 
-	renderer.populateVertexBuffer(this->entityMeshDef.vertexBufferID, entityVertices);
-	renderer.populateAttributeBuffer(this->entityMeshDef.normalBufferID, dummyEntityNormals);
-	renderer.populateAttributeBuffer(this->entityMeshDef.texCoordBufferID, entityTexCoords);
+	renderer.populateVertexBufferFloat(this->entityMeshDef.vertexBufferID, entityVertices);
+	renderer.populateAttributeBufferFloat(this->entityMeshDef.normalBufferID, dummyEntityNormals);
+	renderer.populateAttributeBufferFloat(this->entityMeshDef.texCoordBufferID, entityTexCoords);
 	renderer.populateIndexBuffer(this->entityMeshDef.indexBufferID, entityIndices);
 
 	// Populate global lights.
-	if (!renderer.tryCreateLight(&this->playerLightID))
+	RenderLightID playerLightID;
+	if (!renderer.tryCreateLight(&playerLightID))
 	{
 		DebugLogError("Couldn't create render light ID for player.");
 		this->entityMeshDef.freeBuffers(renderer);
 		return;
 	}
 
-	renderer.setLightRadius(this->playerLightID, ArenaRenderUtils::PLAYER_LIGHT_START_RADIUS, ArenaRenderUtils::PLAYER_LIGHT_END_RADIUS);
+	this->playerLight.lightID = playerLightID;
+	renderer.setLightRadius(playerLightID, ArenaRenderUtils::PLAYER_LIGHT_START_RADIUS, ArenaRenderUtils::PLAYER_LIGHT_END_RADIUS);
 }
 
 void RenderChunkManager::shutdown(Renderer &renderer)
@@ -614,10 +770,10 @@ void RenderChunkManager::shutdown(Renderer &renderer)
 		indexBufferID = -1;
 	}
 
-	if (this->playerLightID >= 0)
+	if (this->playerLight.lightID >= 0)
 	{
-		renderer.freeLight(this->playerLightID);
-		this->playerLightID = -1;
+		renderer.freeLight(this->playerLight.lightID);
+		this->playerLight = Light();
 	}
 
 	for (auto &pair : this->entityLights)
@@ -632,9 +788,12 @@ void RenderChunkManager::shutdown(Renderer &renderer)
 
 	this->entityLights.clear();
 	this->voxelTextures.clear();
+	this->voxelTextureIndices.clear();
 	this->chasmFloorTextureLists.clear();
 	this->chasmTextureKeys.clear();
+	this->chasmTextureKeyIndices.clear();
 	this->entityAnims.clear();
+	this->entityAnimIndices.clear();
 	this->entityMeshDef.freeBuffers(renderer);
 	this->entityPaletteIndicesTextureRefs.clear();
 	this->voxelDrawCallsCache.clear();
@@ -643,30 +802,34 @@ void RenderChunkManager::shutdown(Renderer &renderer)
 
 ObjectTextureID RenderChunkManager::getVoxelTextureID(const TextureAsset &textureAsset) const
 {
-	const auto iter = std::find_if(this->voxelTextures.begin(), this->voxelTextures.end(),
-		[&textureAsset](const LoadedVoxelTexture &loadedTexture)
-	{
-		return loadedTexture.textureAsset == textureAsset;
-	});
-
-	DebugAssertMsg(iter != this->voxelTextures.end(), "No loaded voxel texture for \"" + textureAsset.filename + "\".");
-	const ScopedObjectTextureRef &objectTextureRef = iter->objectTextureRef;
+	const auto iter = this->voxelTextureIndices.find(textureAsset);
+	DebugAssertMsg(iter != this->voxelTextureIndices.end(), "No loaded voxel texture for \"" + textureAsset.filename + "\".");
+	const LoadedVoxelTexture &voxelTexture = this->voxelTextures[iter->second];
+	const ScopedObjectTextureRef &objectTextureRef = voxelTexture.objectTextureRef;
 	return objectTextureRef.get();
 }
 
-ObjectTextureID RenderChunkManager::getChasmFloorTextureID(const ChunkInt2 &chunkPos, VoxelChunk::ChasmDefID chasmDefID,
-	double chasmAnimPercent) const
+const RenderChunkManager::LoadedChasmTextureKey &RenderChunkManager::getChasmTextureKey(const ChunkInt2 &chunkPos,
+	VoxelChunk::ChasmDefID chasmDefID) const
 {
-	const auto keyIter = std::find_if(this->chasmTextureKeys.begin(), this->chasmTextureKeys.end(),
-		[&chunkPos, chasmDefID](const LoadedChasmTextureKey &key)
-	{
-		return (key.chunkPos == chunkPos) && (key.chasmDefID == chasmDefID);
-	});
+	const auto chunkIter = this->chasmTextureKeyIndices.find(chunkPos);
+	DebugAssertMsg(chunkIter != this->chasmTextureKeyIndices.end(), "No chasm texture keys in chunk (" + chunkPos.toString() + ").");
 
-	DebugAssertMsg(keyIter != this->chasmTextureKeys.end(), "No chasm texture key for chasm def ID \"" +
+	const std::vector<int> &chunkKeyIndices = chunkIter->second;
+	DebugAssertIndex(chunkKeyIndices, chasmDefID);
+	const int keyIndex = chunkKeyIndices[chasmDefID];
+	DebugAssertMsg(keyIndex >= 0, "No chasm texture key for chasm def ID \"" +
 		std::to_string(chasmDefID) + "\" in chunk (" + chunkPos.toString() + ").");
 
-	const int floorListIndex = keyIter->chasmFloorListIndex;
+	DebugAssertIndex(this->chasmTextureKeys, keyIndex);
+	return this->chasmTextureKeys[keyIndex];
+}
+
+ObjectTextureID RenderChunkManager::getChasmFloorTextureID(const ChunkInt2 &chunkPos, VoxelChunk::ChasmDefID chasmDefID,
+	double chasmAnimPercent) const
+{
+	const LoadedChasmTextureKey &key = this->getChasmTextureKey(chunkPos, chasmDefID);
+	const int floorListIndex = key.chasmFloorListIndex;
 	DebugAssertIndex(this->chasmFloorTextureLists, floorListIndex);
 	const LoadedChasmFloorTextureList &textureList = this->chasmFloorTextureLists[floorListIndex];
 	BufferView<const ScopedObjectTextureRef> objectTextureRefs = textureList.objectTextureRefs;
@@ -678,16 +841,8 @@ ObjectTextureID RenderChunkManager::getChasmFloorTextureID(const ChunkInt2 &chun
 
 ObjectTextureID RenderChunkManager::getChasmWallTextureID(const ChunkInt2 &chunkPos, VoxelChunk::ChasmDefID chasmDefID) const
 {
-	const auto keyIter = std::find_if(this->chasmTextureKeys.begin(), this->chasmTextureKeys.end(),
-		[&chunkPos, chasmDefID](const LoadedChasmTextureKey &key)
-	{
-		return (key.chunkPos == chunkPos) && (key.chasmDefID == chasmDefID);
-	});
-
-	DebugAssertMsg(keyIter != this->chasmTextureKeys.end(), "No chasm texture key for chasm def ID \"" +
-		std::to_string(chasmDefID) + "\" in chunk (" + chunkPos.toString() + ").");
-
-	const int wallIndex = keyIter->chasmWallIndex;
+	const LoadedChasmTextureKey &key = this->getChasmTextureKey(chunkPos, chasmDefID);
+	const int wallIndex = key.chasmWallIndex;
 	const LoadedVoxelTexture &voxelTexture = this->voxelTextures[wallIndex];
 	const ScopedObjectTextureRef &objectTextureRef = voxelTexture.objectTextureRef;
 	return objectTextureRef.get();
@@ -698,13 +853,9 @@ ObjectTextureID RenderChunkManager::getEntityTextureID(EntityInstanceID entityIn
 {
 	const EntityInstance &entityInst = entityChunkManager.getEntity(entityInstID);
 	const EntityDefID entityDefID = entityInst.defID;
-	const auto defIter = std::find_if(this->entityAnims.begin(), this->entityAnims.end(),
-		[entityDefID](const LoadedEntityAnimation &loadedAnim)
-	{
-		return loadedAnim.defID == entityDefID;
-	});
-
-	DebugAssertMsg(defIter != this->entityAnims.end(), "Expected loaded entity animation for def ID " + std::to_string(entityDefID) + ".");
+	const auto animIndexIter = this->entityAnimIndices.find(entityDefID);
+	DebugAssertMsg(animIndexIter != this->entityAnimIndices.end(), "Expected loaded entity animation for def ID " + std::to_string(entityDefID) + ".");
+	const LoadedEntityAnimation &loadedAnim = this->entityAnims[animIndexIter->second];
 
 	EntityVisibilityState2D visState;
 	entityChunkManager.getEntityVisibilityState2D(entityInstID, cameraCoordXZ, visState);
@@ -712,7 +863,7 @@ ObjectTextureID RenderChunkManager::getEntityTextureID(EntityInstanceID entityIn
 	const EntityDefinition &entityDef = entityChunkManager.getEntityDef(entityDefID);
 	const EntityAnimationDefinition &animDef = entityDef.getAnimDef();
 	const int linearizedKeyframeIndex = animDef.getLinearizedKeyframeIndex(visState.stateIndex, visState.angleIndex, visState.keyframeIndex);
-	const Buffer<ScopedObjectTextureRef> &textureRefs = defIter->textureRefs;
+	const Buffer<ScopedObjectTextureRef> &textureRefs = loadedAnim.textureRefs;
 	return textureRefs.get(linearizedKeyframeIndex).get();
 }
 
@@ -726,19 +877,46 @@ BufferView<const RenderDrawCall> RenderChunkManager::getEntityDrawCalls() const
 	return BufferView<const RenderDrawCall>(this->entityDrawCallsCache);
 }
 
-void RenderChunkManager::loadVoxelTextures(const VoxelChunk &voxelChunk, TextureManager &textureManager, Renderer &renderer)
+void RenderChunkManager::loadVoxelTextures(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, TextureManager &textureManager,
+	Renderer &renderer)
 {
 	for (int i = 0; i < voxelChunk.getTextureDefCount(); i++)
 	{
 		const VoxelTextureDefinition &voxelTextureDef = voxelChunk.getTextureDef(i);
-		sgTexture::LoadVoxelDefTextures(voxelTextureDef, this->voxelTextures, textureManager, renderer);
+		sgTexture::LoadVoxelDefTextures(voxelTextureDef, this->voxelTextures, this->voxelTextureIndices, textureManager, renderer);
 	}
 
 	for (int i = 0; i < voxelChunk.getChasmDefCount(); i++)
 	{
 		const VoxelChunk::ChasmDefID chasmDefID = static_cast<VoxelChunk::ChasmDefID>(i);
-		sgTexture::LoadChasmDefTextures(chasmDefID, voxelChunk, this->voxelTextures, this->chasmFloorTextureLists,
-			this->chasmTextureKeys, textureManager, renderer);
+		sgTexture::LoadChasmDefTextures(chasmDefID, voxelChunk, this->voxelTextureIndices, this->chasmFloorTextureLists,
+			this->chasmTextureKeys, this->chasmTextureKeyIndices, textureManager, renderer);
+	}
+
+	this->populateVoxelTextureIDs(renderChunk, voxelChunk);
+}
+
+void RenderChunkManager::populateVoxelTextureIDs(RenderChunk &renderChunk, const VoxelChunk &voxelChunk)
+{
+	const int mappedTextureDefCount = static_cast<int>(renderChunk.voxelTextureIDs.size()) / VoxelTextureDefinition::MAX_TEXTURES;
+	for (int i = mappedTextureDefCount; i < voxelChunk.getTextureDefCount(); i++)
+	{
+		const VoxelChunk::VoxelTextureDefID textureDefID = static_cast<VoxelChunk::VoxelTextureDefID>(i);
+		const VoxelTextureDefinition &voxelTextureDef = voxelChunk.getTextureDef(textureDefID);
+		for (int j = 0; j < VoxelTextureDefinition::MAX_TEXTURES; j++)
+		{
+			ObjectTextureID textureID = -1;
+			if (j < voxelTextureDef.textureCount)
+			{
+				const auto iter = this->voxelTextureIndices.find(voxelTextureDef.getTextureAsset(j));
+				if (iter != this->voxelTextureIndices.end())
+				{
+					textureID = this->voxelTextures[iter->second].objectTextureRef.get();
+				}
+			}
+
+			renderChunk.setVoxelTextureID(textureDefID, j, textureID);
+		}
 	}
 }
 
@@ -890,13 +1068,8 @@ void RenderChunkManager::loadEntityTextures(const EntityChunk &entityChunk, cons
 		const EntityInstance &entityInst = entityChunkManager.getEntity(entityInstID);
 		const EntityDefID entityDefID = entityInst.defID;
 
-		const auto animIter = std::find_if(this->entityAnims.begin(), this->entityAnims.end(),
-			[entityDefID](const LoadedEntityAnimation &loadedAnim)
-		{
-			return loadedAnim.defID == entityDefID;
-		});
-
-		if (animIter == this->entityAnims.end())
+		const auto animIndexIter = this->entityAnimIndices.find(entityDefID);
+		if (animIndexIter == this->entityAnimIndices.end())
 		{
 			const EntityDefinition &entityDef = entityChunkManager.getEntityDef(entityDefID);
 			const EntityAnimationDefinition &animDef = entityDef.getAnimDef();
@@ -905,6 +1078,7 @@ void RenderChunkManager::loadEntityTextures(const EntityChunk &entityChunk, cons
 			LoadedEntityAnimation loadedEntityAnim;
 			loadedEntityAnim.init(entityDefID, std::move(textureRefs));
 			this->entityAnims.emplace_back(std::move(loadedEntityAnim));
+			this->entityAnimIndices.emplace(entityDefID, static_cast<int>(this->entityAnims.size()) - 1);
 		}
 
 		if (entityInst.isCitizen())
@@ -925,8 +1099,8 @@ void RenderChunkManager::addVoxelDrawCall(const Double3 &position, const Double3
 	const Matrix4d &scaleMatrix, VertexBufferID vertexBufferID, AttributeBufferID normalBufferID, AttributeBufferID texCoordBufferID,
 	IndexBufferID indexBufferID, ObjectTextureID textureID0, const std::optional<ObjectTextureID> &textureID1,
 	TextureSamplingType textureSamplingType0, TextureSamplingType textureSamplingType1, RenderLightingType lightingType,
-	double meshLightPercent, BufferView<const RenderLightID> lightIDs, VertexShaderType vertexShaderType, PixelShaderType pixelShaderType,
-	double pixelShaderParam0, std::vector<RenderDrawCall> &drawCalls)
+	double meshLightPercent, BufferView<const RenderLightID> lightIDs, RenderLightmapID lightmapID, VertexShaderType vertexShaderType,
+	PixelShaderType pixelShaderType, double pixelShaderParam0, std::vector<RenderDrawCall> &drawCalls)
 {
 	RenderDrawCall drawCall;
 	drawCall.position = position;
@@ -947,6 +1121,7 @@ void RenderChunkManager::addVoxelDrawCall(const Double3 &position, const Double3
 	DebugAssert(std::size(drawCall.lightIDs) >= lightIDs.getCount());
 	std::copy(lightIDs.begin(), lightIDs.end(), std::begin(drawCall.lightIDs));
 	drawCall.lightIdCount = lightIDs.getCount();
+	drawCall.lightmapID = lightmapID;
 
 	drawCall.vertexShaderType = vertexShaderType;
 	drawCall.pixelShaderType = pixelShaderType;
@@ -956,7 +1131,7 @@ void RenderChunkManager::addVoxelDrawCall(const Double3 &position, const Double3
 }
 
 void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, double ceilingScale,
-	double chasmAnimPercent, bool updateStatics, bool updateAnimating)
+	double chasmAnimPercent, bool updateStatics, bool updateAnimating, Renderer &renderer)
 {
 	const ChunkInt2 &chunkPos = renderChunk.getPosition();
 
@@ -1012,10 +1187,21 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 					fadeAnimInst = &fadeAnimInsts[fadeAnimInstIndex];
 				}
 
-				const RenderVoxelLightIdList &voxelLightIdList = renderChunk.voxelLightIdLists.get(x, y, z);
-
 				const bool canAnimate = isDoor || isChasm || isFading;
-				if ((!canAnimate && updateStatics) || (canAnimate && updateAnimating))
+
+				const bool updateOpaqueDrawCalls = (!canAnimate && updateStatics) || (canAnimate && updateAnimating);
+				const bool updateAlphaTestedDrawCalls = updateStatics || (updateAnimating && isDoor);
+				const bool hasAlphaTestedDrawCalls = renderMeshDef.alphaTestedIndexBufferID >= 0;
+
+				// Only voxels getting draw calls this time need their lighting (and possibly a lightmap bake).
+				BufferView<const RenderLightID> voxelLightIDs;
+				RenderLightmapID voxelLightmapID = -1;
+				if (updateOpaqueDrawCalls || (hasAlphaTestedDrawCalls && updateAlphaTestedDrawCalls))
+				{
+					voxelLightmapID = this->getVoxelLighting(renderChunk, voxel, ceilingScale, renderer, &voxelLightIDs);
+				}
+
+				if (updateOpaqueDrawCalls)
 				{
 					for (int bufferIndex = 0; bufferIndex < renderMeshDef.opaqueIndexBufferIdCount; bufferIndex++)
 					{
@@ -1024,17 +1210,8 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 						if (!isChasm)
 						{
 							const int textureAssetIndex = sgTexture::GetVoxelOpaqueTextureAssetIndex(voxelType, bufferIndex);
-							const auto voxelTextureIter = std::find_if(this->voxelTextures.begin(), this->voxelTextures.end(),
-								[&voxelTextureDef, textureAssetIndex](const RenderChunkManager::LoadedVoxelTexture &loadedTexture)
-							{
-								return loadedTexture.textureAsset == voxelTextureDef.getTextureAsset(textureAssetIndex);
-							});
-
-							if (voxelTextureIter != this->voxelTextures.end())
-							{
-								textureID = voxelTextureIter->objectTextureRef.get();
-							}
-							else
+							textureID = renderChunk.getVoxelTextureID(voxelTextureDefID, textureAssetIndex);
+							if (textureID < 0)
 							{
 								DebugLogError("Couldn't find opaque texture asset \"" + voxelTextureDef.getTextureAsset(textureAssetIndex).filename + "\".");
 							}
@@ -1088,30 +1265,21 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 						const double pixelShaderParam0 = 0.0;
 						this->addVoxelDrawCall(worldPos, preScaleTranslation, rotationMatrix, scaleMatrix, renderMeshDef.vertexBufferID,
 							renderMeshDef.normalBufferID, renderMeshDef.texCoordBufferID, opaqueIndexBufferID, textureID, std::nullopt,
-							textureSamplingType, textureSamplingType, lightingType, meshLightPercent, voxelLightIdList.getLightIDs(),
+							textureSamplingType, textureSamplingType, lightingType, meshLightPercent, voxelLightIDs, voxelLightmapID,
 							VertexShaderType::Voxel, pixelShaderType, pixelShaderParam0, *drawCallsPtr);
 					}
 				}
 
-				if (renderMeshDef.alphaTestedIndexBufferID >= 0)
+				if (hasAlphaTestedDrawCalls)
 				{
-					if (updateStatics || (updateAnimating && isDoor))
+					if (updateAlphaTestedDrawCalls)
 					{
 						DebugAssert(!isChasm);
 						ObjectTextureID textureID = -1;
 
 						const int textureAssetIndex = sgTexture::GetVoxelAlphaTestedTextureAssetIndex(voxelType);
-						const auto voxelTextureIter = std::find_if(this->voxelTextures.begin(), this->voxelTextures.end(),
-							[&voxelTextureDef, textureAssetIndex](const RenderChunkManager::LoadedVoxelTexture &loadedTexture)
-						{
-							return loadedTexture.textureAsset == voxelTextureDef.getTextureAsset(textureAssetIndex);
-						});
-
-						if (voxelTextureIter != this->voxelTextures.end())
-						{
-							textureID = voxelTextureIter->objectTextureRef.get();
-						}
-						else
+						textureID = renderChunk.getVoxelTextureID(voxelTextureDefID, textureAssetIndex);
+						if (textureID < 0)
 						{
 							DebugLogError("Couldn't find alpha-tested texture asset \"" + voxelTextureDef.getTextureAsset(textureAssetIndex).filename + "\".");
 						}
@@ -1190,7 +1358,7 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 									this->addVoxelDrawCall(doorHingePosition, doorPreScaleTranslation, doorRotationMatrix, doorScaleMatrix,
 										renderMeshDef.vertexBufferID, renderMeshDef.normalBufferID, renderMeshDef.texCoordBufferID,
 										renderMeshDef.alphaTestedIndexBufferID, textureID, std::nullopt, textureSamplingType, textureSamplingType,
-										RenderLightingType::PerPixel, meshLightPercent, voxelLightIdList.getLightIDs(), VertexShaderType::SwingingDoor,
+										RenderLightingType::PerPixel, meshLightPercent, voxelLightIDs, voxelLightmapID, VertexShaderType::SwingingDoor,
 										PixelShaderType::AlphaTested, pixelShaderParam0, renderChunk.doorDrawCalls);
 								}
 
@@ -1220,7 +1388,7 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 									this->addVoxelDrawCall(doorHingePosition, doorPreScaleTranslation, doorRotationMatrix, doorScaleMatrix,
 										renderMeshDef.vertexBufferID, renderMeshDef.normalBufferID, renderMeshDef.texCoordBufferID,
 										renderMeshDef.alphaTestedIndexBufferID, textureID, std::nullopt, textureSamplingType, textureSamplingType,
-										RenderLightingType::PerPixel, meshLightPercent, voxelLightIdList.getLightIDs(), VertexShaderType::SlidingDoor,
+										RenderLightingType::PerPixel, meshLightPercent, voxelLightIDs, voxelLightmapID, VertexShaderType::SlidingDoor,
 										PixelShaderType::AlphaTestedWithVariableTexCoordUMin, pixelShaderParam0, renderChunk.doorDrawCalls);
 								}
 
@@ -1251,7 +1419,7 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 									this->addVoxelDrawCall(doorHingePosition, doorPreScaleTranslation, doorRotationMatrix, doorScaleMatrix,
 										renderMeshDef.vertexBufferID, renderMeshDef.normalBufferID, renderMeshDef.texCoordBufferID,
 										renderMeshDef.alphaTestedIndexBufferID, textureID, std::nullopt, textureSamplingType, textureSamplingType,
-										RenderLightingType::PerPixel, meshLightPercent, voxelLightIdList.getLightIDs(), VertexShaderType::RaisingDoor,
+										RenderLightingType::PerPixel, meshLightPercent, voxelLightIDs, voxelLightmapID, VertexShaderType::RaisingDoor,
 										PixelShaderType::AlphaTestedWithVariableTexCoordVMin, pixelShaderParam0, renderChunk.doorDrawCalls);
 								}
 
@@ -1286,7 +1454,7 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 							this->addVoxelDrawCall(worldPos, preScaleTranslation, rotationMatrix, scaleMatrix, renderMeshDef.vertexBufferID,
 								renderMeshDef.normalBufferID, renderMeshDef.texCoordBufferID, renderMeshDef.alphaTestedIndexBufferID,
 								textureID, std::nullopt, textureSamplingType, textureSamplingType, lightingType, meshLightPercent,
-								voxelLightIdList.getLightIDs(), VertexShaderType::Voxel, PixelShaderType::AlphaTested, pixelShaderParam0, *drawCallsPtr);
+								voxelLightIDs, voxelLightmapID, VertexShaderType::Voxel, PixelShaderType::AlphaTested, pixelShaderParam0, *drawCallsPtr);
 						}
 					}
 				}
@@ -1321,7 +1489,7 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 						constexpr double pixelShaderParam0 = 0.0;
 						this->addVoxelDrawCall(worldPos, preScaleTranslation, rotationMatrix, scaleMatrix, renderMeshDef.vertexBufferID,
 							renderMeshDef.normalBufferID, renderMeshDef.texCoordBufferID, chasmWallIndexBufferID, textureID0, textureID1,
-							textureSamplingType, textureSamplingType, lightingType, meshLightPercent, voxelLightIdList.getLightIDs(),
+							textureSamplingType, textureSamplingType, lightingType, meshLightPercent, voxelLightIDs, voxelLightmapID,
 							VertexShaderType::Voxel, PixelShaderType::OpaqueWithAlphaTestLayer, pixelShaderParam0, renderChunk.chasmDrawCalls);
 					}
 				}
@@ -1331,7 +1499,7 @@ void RenderChunkManager::loadVoxelDrawCalls(RenderChunk &renderChunk, const Voxe
 }
 
 void RenderChunkManager::rebuildVoxelChunkDrawCalls(RenderChunk &renderChunk, const VoxelChunk &voxelChunk,
-	double ceilingScale, double chasmAnimPercent, bool updateStatics, bool updateAnimating)
+	double ceilingScale, double chasmAnimPercent, bool updateStatics, bool updateAnimating, Renderer &renderer)
 {
 	if (updateStatics)
 	{
@@ -1345,25 +1513,31 @@ void RenderChunkManager::rebuildVoxelChunkDrawCalls(RenderChunk &renderChunk, co
 		renderChunk.fadingDrawCalls.clear();
 	}
 
-	this->loadVoxelDrawCalls(renderChunk, voxelChunk, ceilingScale, chasmAnimPercent, updateStatics, updateAnimating);
+	// Texture defs added since the chunk was loaded still need direct lookups.
+	this->populateVoxelTextureIDs(renderChunk, voxelChunk);
+
+	this->loadVoxelDrawCalls(renderChunk, voxelChunk, ceilingScale, chasmAnimPercent, updateStatics, updateAnimating, renderer);
 }
 
-void RenderChunkManager::rebuildVoxelDrawCallsList()
+void RenderChunkManager::rebuildVoxelDrawCallsList(const CoordDouble2 &cameraCoordXZ, bool sortDrawCalls)
 {
 	this->voxelDrawCallsCache.clear();
+	this->drawCallSortEntries.clear();
+	this->populateChunkDrawOrder(cameraCoordXZ, sortDrawCalls);
+
+	const WorldDouble2 cameraPointXZ = VoxelUtils::coordToWorldPoint(cameraCoordXZ);
+	for (int i = 0; i < static_cast<int>(this->chunkDrawOrder.size()); i++)
+	{
+		const ChunkPtr &chunkPtr = this->activeChunks[this->chunkDrawOrder[i]];
+		this->addDrawCallsToList(chunkPtr->staticDrawCalls, i, cameraPointXZ, sortDrawCalls, this->voxelDrawCallsCache);
+		this->addDrawCallsToList(chunkPtr->doorDrawCalls, i, cameraPointXZ, sortDrawCalls, this->voxelDrawCallsCache);
+		this->addDrawCallsToList(chunkPtr->chasmDrawCalls, i, cameraPointXZ, sortDrawCalls, this->voxelDrawCallsCache);
+		this->addDrawCallsToList(chunkPtr->fadingDrawCalls, i, cameraPointXZ, sortDrawCalls, this->voxelDrawCallsCache);
+	}
 
-	// @todo: eventually this should sort by distance from a CoordDouble2
-	for (size_t i = 0; i < this->activeChunks.size(); i++)
+	if (sortDrawCalls)
 	{
-		const ChunkPtr &chunkPtr = this->activeChunks[i];
-		BufferView<const RenderDrawCall> staticDrawCalls = chunkPtr->staticDrawCalls;
-		BufferView<const RenderDrawCall> doorDrawCalls = chunkPtr->doorDrawCalls;
-		BufferView<const RenderDrawCall> chasmDrawCalls = chunkPtr->chasmDrawCalls;
-		BufferView<const RenderDrawCall> fadingDrawCalls = chunkPtr->fadingDrawCalls;
-		this->voxelDrawCallsCache.insert(this->voxelDrawCallsCache.end(), staticDrawCalls.begin(), staticDrawCalls.end());
-		this->voxelDrawCallsCache.insert(this->voxelDrawCallsCache.end(), doorDrawCalls.begin(), doorDrawCalls.end());
-		this->voxelDrawCallsCache.insert(this->voxelDrawCallsCache.end(), chasmDrawCalls.begin(), chasmDrawCalls.end());
-		this->voxelDrawCallsCache.insert(this->voxelDrawCallsCache.end(), fadingDrawCalls.begin(), fadingDrawCalls.end());
+		this->sortDrawCallsList(this->voxelDrawCallsCache);
 	}
 }
 
@@ -1456,19 +1630,90 @@ void RenderChunkManager::rebuildEntityChunkDrawCalls(RenderChunk &renderChunk, c
 	}
 }
 
-void RenderChunkManager::rebuildEntityDrawCallsList()
+void RenderChunkManager::rebuildEntityDrawCallsList(const CoordDouble2 &cameraCoordXZ, bool sortDrawCalls)
 {
 	this->entityDrawCallsCache.clear();
+	this->drawCallSortEntries.clear();
+	this->populateChunkDrawOrder(cameraCoordXZ, sortDrawCalls);
 
-	// @todo: eventually this should sort by distance from a CoordDouble2
-	for (size_t i = 0; i < this->activeChunks.size(); i++)
+	const WorldDouble2 cameraPointXZ = VoxelUtils::coordToWorldPoint(cameraCoordXZ);
+	for (int i = 0; i < static_cast<int>(this->chunkDrawOrder.size()); i++)
 	{
-		const ChunkPtr &chunkPtr = this->activeChunks[i];
-		BufferView<const RenderDrawCall> entityDrawCalls = chunkPtr->entityDrawCalls;
-		this->entityDrawCallsCache.insert(this->entityDrawCallsCache.end(), entityDrawCalls.begin(), entityDrawCalls.end());
+		const ChunkPtr &chunkPtr = this->activeChunks[this->chunkDrawOrder[i]];
+		this->addDrawCallsToList(chunkPtr->entityDrawCalls, i, cameraPointXZ, sortDrawCalls, this->entityDrawCallsCache);
+	}
+
+	if (sortDrawCalls)
+	{
+		this->sortDrawCallsList(this->entityDrawCallsCache);
 	}
 }
 
+void RenderChunkManager::populateChunkDrawOrder(const CoordDouble2 &cameraCoordXZ, bool sortDrawCalls)
+{
+	this->chunkDrawOrder.resize(this->activeChunks.size());
+	std::iota(this->chunkDrawOrder.begin(), this->chunkDrawOrder.end(), 0);
+
+	if (!sortDrawCalls)
+	{
+		return;
+	}
+
+	// Distance from the camera to the closest point of each chunk, so the camera's own chunk is always first.
+	const WorldDouble2 cameraPointXZ = VoxelUtils::coordToWorldPoint(cameraCoordXZ);
+	auto getChunkDistanceSqr = [this, &cameraPointXZ](int activeChunkIndex)
+	{
+		const ChunkInt2 &chunkPos = this->activeChunks[activeChunkIndex]->getPosition();
+		const WorldDouble2 chunkMin = VoxelUtils::chunkPointToWorldPoint(chunkPos, VoxelDouble2::Zero);
+		const WorldDouble2 chunkMax = chunkMin + WorldDouble2(ChunkUtils::CHUNK_DIM, ChunkUtils::CHUNK_DIM);
+		const WorldDouble2 closestPoint(
+			std::clamp(cameraPointXZ.x, chunkMin.x, chunkMax.x),
+			std::clamp(cameraPointXZ.y, chunkMin.y, chunkMax.y));
+		return (closestPoint - cameraPointXZ).lengthSquared();
+	};
+
+	std::stable_sort(this->chunkDrawOrder.begin(), this->chunkDrawOrder.end(),
+		[&getChunkDistanceSqr](int a, int b)
+	{
+		return getChunkDistanceSqr(a) < getChunkDistanceSqr(b);
+	});
+}
+
+void RenderChunkManager::addDrawCallsToList(BufferView<const RenderDrawCall> drawCalls, int chunkRank,
+	const WorldDouble2 &cameraPointXZ, bool sortDrawCalls, std::vector<RenderDrawCall> &drawCallsList)
+{
+	if (sortDrawCalls)
+	{
+		for (const RenderDrawCall &drawCall : drawCalls)
+		{
+			const uint64_t key = sgDrawOrder::makeKey(drawCall, chunkRank, cameraPointXZ);
+			const int drawCallIndex = static_cast<int>(this->drawCallSortEntries.size()); // Parallel to the draw calls list.
+
+			DrawCallSortEntry entry;
+			entry.init(key, drawCallIndex);
+			this->drawCallSortEntries.emplace_back(std::move(entry));
+		}
+	}
+
+	drawCallsList.insert(drawCallsList.end(), drawCalls.begin(), drawCalls.end());
+}
+
+void RenderChunkManager::sortDrawCallsList(std::vector<RenderDrawCall> &drawCallsList)
+{
+	DebugAssert(this->drawCallSortEntries.size() == drawCallsList.size());
+	sgDrawOrder::radixSort(this->drawCallSortEntries, this->drawCallSortEntriesScratch);
+
+	this->drawCallSortScratch.resize(drawCallsList.size());
+	for (size_t i = 0; i < this->drawCallSortEntries.size(); i++)
+	{
+		const DrawCallSortEntry &entry = this->drawCallSortEntries[i];
+		DebugAssertIndex(drawCallsList, entry.drawCallIndex);
+		this->drawCallSortScratch[i] = drawCallsList[entry.drawCallIndex];
+	}
+
+	std::swap(drawCallsList, this->drawCallSortScratch);
+}
+
 void RenderChunkManager::updateActiveChunks(BufferView<const ChunkInt2> newChunkPositions, BufferView<const ChunkInt2> freedChunkPositions,
 	const VoxelChunkManager &voxelChunkManager, Renderer &renderer)
 {
@@ -1495,17 +1740,17 @@ void RenderChunkManager::updateActiveChunks(BufferView<const ChunkInt2> newChunk
 }
 
 void RenderChunkManager::updateVoxels(BufferView<const ChunkInt2> activeChunkPositions, BufferView<const ChunkInt2> newChunkPositions,
-	double ceilingScale, double chasmAnimPercent, const VoxelChunkManager &voxelChunkManager,
-	const VoxelVisibilityChunkManager &voxelVisChunkManager, TextureManager &textureManager, Renderer &renderer)
+	const CoordDouble2 &cameraCoordXZ, double ceilingScale, double chasmAnimPercent, const VoxelChunkManager &voxelChunkManager,
+	const VoxelVisibilityChunkManager &voxelVisChunkManager, bool sortDrawCalls, TextureManager &textureManager, Renderer &renderer)
 {
 	for (const ChunkInt2 &chunkPos : newChunkPositions)
 	{
 		RenderChunk &renderChunk = this->getChunkAtPosition(chunkPos);
 		const VoxelChunk &voxelChunk = voxelChunkManager.getChunkAtPosition(chunkPos);
-		this->loadVoxelTextures(voxelChunk, textureManager, renderer);
+		this->loadVoxelTextures(renderChunk, voxelChunk, textureManager, renderer);
 		this->loadVoxelMeshBuffers(renderChunk, voxelChunk, ceilingScale, renderer);
 		this->loadVoxelChasmWalls(renderChunk, voxelChunk);
-		this->rebuildVoxelChunkDrawCalls(renderChunk, voxelChunk, ceilingScale, chasmAnimPercent, true, false);
+		this->rebuildVoxelChunkDrawCalls(renderChunk, voxelChunk, ceilingScale, chasmAnimPercent, true, false, renderer);
 	}
 
 	for (const ChunkInt2 &chunkPos : activeChunkPositions)
@@ -1525,20 +1770,20 @@ void RenderChunkManager::updateVoxels(BufferView<const ChunkInt2> activeChunkPos
 		bool updateStatics = dirtyMeshDefPositions.getCount() > 0;
 		updateStatics |= dirtyFadeAnimInstPositions.getCount() > 0; // @temp fix for fading voxels being covered by their non-fading draw call
 		updateStatics |= dirtyLightPositions.getCount() > 0; // @temp fix for player light movement, eventually other moving lights too
-		this->rebuildVoxelChunkDrawCalls(renderChunk, voxelChunk, ceilingScale, chasmAnimPercent, updateStatics, true);
+		this->rebuildVoxelChunkDrawCalls(renderChunk, voxelChunk, ceilingScale, chasmAnimPercent, updateStatics, true, renderer);
 	}
 
 	// @todo: only rebuild if needed; currently we assume that all scenes in the game have some kind of animating chasms/etc., which is inefficient
 	//if ((freedChunkCount > 0) || (newChunkCount > 0))
 	{
-		this->rebuildVoxelDrawCallsList();
+		this->rebuildVoxelDrawCallsList(cameraCoordXZ, sortDrawCalls);
 	}
 }
 
 void RenderChunkManager::updateEntities(BufferView<const ChunkInt2> activeChunkPositions,
 	BufferView<const ChunkInt2> newChunkPositions, const CoordDouble2 &cameraCoordXZ, const VoxelDouble2 &cameraDirXZ,
 	double ceilingScale, const VoxelChunkManager &voxelChunkManager, const EntityChunkManager &entityChunkManager,
-	TextureManager &textureManager, Renderer &renderer)
+	bool sortDrawCalls, TextureManager &textureManager, Renderer &renderer)
 {
 	for (const EntityInstanceID entityInstID : entityChunkManager.getQueuedDestroyEntityIDs())
 	{
@@ -1571,37 +1816,411 @@ void RenderChunkManager::updateEntities(BufferView<const ChunkInt2> activeChunkP
 			voxelChunkManager, entityChunkManager);
 	}
 
-	this->rebuildEntityDrawCallsList();
+	this->rebuildEntityDrawCallsList(cameraCoordXZ, sortDrawCalls);
 
 	// Update normals buffer.
 	const VoxelDouble2 entityDir = -cameraDirXZ;
 	constexpr int entityMeshVertexCount = 4;
-	const std::array<double, entityMeshVertexCount * MeshUtils::NORMAL_COMPONENTS_PER_VERTEX> entityNormals =
-	{
-		entityDir.x, 0.0, entityDir.y,
-		entityDir.x, 0.0, entityDir.y,
-		entityDir.x, 0.0, entityDir.y,
-		entityDir.x, 0.0, entityDir.y
+	const float entityDirX = static_cast<float>(entityDir.x);
+	const float entityDirZ = static_cast<float>(entityDir.y);
+	const std::array<float, entityMeshVertexCount * MeshUtils::NORMAL_COMPONENTS_PER_VERTEX> entityNormals =
+	{
+		entityDirX, 0.0f, entityDirZ,
+		entityDirX, 0.0f, entityDirZ,
+		entityDirX, 0.0f, entityDirZ,
+		entityDirX, 0.0f, entityDirZ
 	};
 
-	renderer.populateAttributeBuffer(this->entityMeshDef.normalBufferID, entityNormals);
+	renderer.populateAttributeBufferFloat(this->entityMeshDef.normalBufferID, entityNormals);
+}
+
+void RenderChunkManager::binLight(Light &light)
+{
+	DebugAssert(!light.isBinned);
+	RenderChunkLight chunkLight;
+	chunkLight.init(light.lightID, light.position, light.startRadius, light.endRadius, light.minVoxel, light.maxVoxel, light.isStatic);
+
+	const ChunkInt2 minChunk = VoxelUtils::worldVoxelToChunk(WorldInt2(light.minVoxel.x, light.minVoxel.z));
+	const ChunkInt2 maxChunk = VoxelUtils::worldVoxelToChunk(WorldInt2(light.maxVoxel.x, light.maxVoxel.z));
+	for (int chunkY = minChunk.y; chunkY <= maxChunk.y; chunkY++)
+	{
+		for (int chunkX = minChunk.x; chunkX <= maxChunk.x; chunkX++)
+		{
+			RenderChunk *renderChunkPtr = this->tryGetChunkAtPosition(ChunkInt2(chunkX, chunkY));
+			if (renderChunkPtr != nullptr)
+			{
+				renderChunkPtr->addLight(chunkLight);
+			}
+		}
+	}
+
+	light.isBinned = true;
+}
+
+void RenderChunkManager::unbinLight(Light &light)
+{
+	DebugAssert(light.isBinned);
+	const ChunkInt2 minChunk = VoxelUtils::worldVoxelToChunk(WorldInt2(light.minVoxel.x, light.minVoxel.z));
+	const ChunkInt2 maxChunk = VoxelUtils::worldVoxelToChunk(WorldInt2(light.maxVoxel.x, light.maxVoxel.z));
+	for (int chunkY = minChunk.y; chunkY <= maxChunk.y; chunkY++)
+	{
+		for (int chunkX = minChunk.x; chunkX <= maxChunk.x; chunkX++)
+		{
+			RenderChunk *renderChunkPtr = this->tryGetChunkAtPosition(ChunkInt2(chunkX, chunkY));
+			if (renderChunkPtr != nullptr)
+			{
+				renderChunkPtr->removeLight(light.lightID);
+			}
+		}
+	}
+
+	light.isBinned = false;
+}
+
+void RenderChunkManager::rebuildChunkVoxelLightIdLists(RenderChunk &renderChunk, const WorldInt3 &minVoxel,
+	const WorldInt3 &maxVoxel, double ceilingScale, bool markDirty)
+{
+	const ChunkInt2 &chunkPos = renderChunk.getPosition();
+	const WorldInt3 chunkMinVoxel = VoxelUtils::chunkVoxelToWorldVoxel(chunkPos, VoxelInt3(0, 0, 0));
+	const WorldInt3 rangeMin(
+		std::max(minVoxel.x, chunkMinVoxel.x),
+		std::max(minVoxel.y, 0),
+		std::max(minVoxel.z, chunkMinVoxel.z));
+	const WorldInt3 rangeMax(
+		std::min(maxVoxel.x, chunkMinVoxel.x + ChunkUtils::CHUNK_DIM - 1),
+		std::min(maxVoxel.y, renderChunk.getHeight() - 1),
+		std::min(maxVoxel.z, chunkMinVoxel.z + ChunkUtils::CHUNK_DIM - 1));
+	if ((rangeMin.x > rangeMax.x) || (rangeMin.y > rangeMax.y) || (rangeMin.z > rangeMax.z))
+	{
+		return;
+	}
+
+	// Only lights overlapping the range can touch its voxels.
+	FrameVector<const RenderChunkLight*> candidateLights;
+	candidateLights.reserve(renderChunk.lights.size());
+	for (const RenderChunkLight &light : renderChunk.lights)
+	{
+		const bool overlaps =
+			(light.minVoxel.x <= rangeMax.x) && (light.maxVoxel.x >= rangeMin.x) &&
+			(light.minVoxel.y <= rangeMax.y) && (light.maxVoxel.y >= rangeMin.y) &&
+			(light.minVoxel.z <= rangeMax.z) && (light.maxVoxel.z >= rangeMin.z);
+		if (overlaps)
+		{
+			candidateLights.emplace_back(&light);
+		}
+	}
+
+	for (WEInt z = rangeMin.z; z <= rangeMax.z; z++)
+	{
+		for (int y = rangeMin.y; y <= rangeMax.y; y++)
+		{
+			for (SNInt x = rangeMin.x; x <= rangeMax.x; x++)
+			{
+				const WorldInt3 worldVoxel(x, y, z);
+				const WorldDouble3 voxelCenter = VoxelUtils::getVoxelCenter(worldVoxel, ceilingScale);
+
+				// Insertion sort with dynamic lights first since they can't be baked, then by distance. The farthest
+				// is dropped once full.
+				RenderLightID lightIDs[RenderDrawCall::MAX_LIGHTS];
+				double lightDistSqrs[RenderDrawCall::MAX_LIGHTS];
+				bool lightIsStatics[RenderDrawCall::MAX_LIGHTS];
+				int lightCount = 0;
+				int dynamicLightCount = 0;
+				for (const RenderChunkLight *lightPtr : candidateLights)
+				{
+					const RenderChunkLight &light = *lightPtr;
+					const bool isTouching =
+						(x >= light.minVoxel.x) && (x <= light.maxVoxel.x) &&
+						(y >= light.minVoxel.y) && (y <= light.maxVoxel.y) &&
+						(z >= light.minVoxel.z) && (z <= light.maxVoxel.z);
+					if (!isTouching)
+					{
+						continue;
+					}
+
+					const double distSqr = (light.position - voxelCenter).lengthSquared();
+					int insertIndex = lightCount;
+					while (insertIndex > 0)
+					{
+						const int prevIndex = insertIndex - 1;
+						const bool isBeforePrev = (lightIsStatics[prevIndex] && !light.isStatic) ||
+							((lightIsStatics[prevIndex] == light.isStatic) && (distSqr < lightDistSqrs[prevIndex]));
+						if (!isBeforePrev)
+						{
+							break;
+						}
+
+						insertIndex--;
+					}
+
+					if (insertIndex >= RenderDrawCall::MAX_LIGHTS)
+					{
+						continue;
+					}
+
+					const int lastIndex = std::min(lightCount, RenderDrawCall::MAX_LIGHTS - 1);
+					if ((lightCount == RenderDrawCall::MAX_LIGHTS) && !lightIsStatics[lastIndex])
+					{
+						dynamicLightCount--;
+					}
+
+					for (int i = lastIndex; i > insertIndex; i--)
+					{
+						lightIDs[i] = lightIDs[i - 1];
+						lightDistSqrs[i] = lightDistSqrs[i - 1];
+						lightIsStatics[i] = lightIsStatics[i - 1];
+					}
+
+					lightIDs[insertIndex] = light.lightID;
+					lightDistSqrs[insertIndex] = distSqr;
+					lightIsStatics[insertIndex] = light.isStatic;
+					lightCount = std::min(lightCount + 1, RenderDrawCall::MAX_LIGHTS);
+					if (!light.isStatic)
+					{
+						dynamicLightCount++;
+					}
+				}
+
+				const VoxelInt3 voxel(x - chunkMinVoxel.x, y, z - chunkMinVoxel.z);
+				RenderVoxelLightIdList &voxelLightIdList = renderChunk.voxelLightIdLists.get(voxel.x, voxel.y, voxel.z);
+				if (voxelLightIdList.trySetLightIDs(lightIDs, lightCount, dynamicLightCount) && markDirty)
+				{
+					renderChunk.addDirtyLightPosition(voxel);
+				}
+			}
+		}
+	}
+}
+
+void RenderChunkManager::rebuildVoxelLightIdLists(const WorldInt3 &minVoxel, const WorldInt3 &maxVoxel, double ceilingScale)
+{
+	const ChunkInt2 minChunk = VoxelUtils::worldVoxelToChunk(WorldInt2(minVoxel.x, minVoxel.z));
+	const ChunkInt2 maxChunk = VoxelUtils::worldVoxelToChunk(WorldInt2(maxVoxel.x, maxVoxel.z));
+	for (int chunkY = minChunk.y; chunkY <= maxChunk.y; chunkY++)
+	{
+		for (int chunkX = minChunk.x; chunkX <= maxChunk.x; chunkX++)
+		{
+			RenderChunk *renderChunkPtr = this->tryGetChunkAtPosition(ChunkInt2(chunkX, chunkY));
+			if (renderChunkPtr != nullptr)
+			{
+				constexpr bool markDirty = true;
+				this->rebuildChunkVoxelLightIdLists(*renderChunkPtr, minVoxel, maxVoxel, ceilingScale, markDirty);
+			}
+		}
+	}
+}
+
+void RenderChunkManager::invalidateLightmaps(const WorldInt3 &minVoxel, const WorldInt3 &maxVoxel, Renderer &renderer)
+{
+	const ChunkInt2 minChunk = VoxelUtils::worldVoxelToChunk(WorldInt2(minVoxel.x, minVoxel.z));
+	const ChunkInt2 maxChunk = VoxelUtils::worldVoxelToChunk(WorldInt2(maxVoxel.x, maxVoxel.z));
+	for (int chunkY = minChunk.y; chunkY <= maxChunk.y; chunkY++)
+	{
+		for (int chunkX = minChunk.x; chunkX <= maxChunk.x; chunkX++)
+		{
+			const ChunkInt2 chunkPos(chunkX, chunkY);
+			RenderChunk *renderChunkPtr = this->tryGetChunkAtPosition(chunkPos);
+			if (renderChunkPtr == nullptr)
+			{
+				continue;
+			}
+
+			RenderChunk &renderChunk = *renderChunkPtr;
+			for (auto iter = renderChunk.lightmapIDs.begin(); iter != renderChunk.lightmapIDs.end(); )
+			{
+				const VoxelInt3 &voxel = iter->first;
+				const WorldInt3 worldVoxel = VoxelUtils::chunkVoxelToWorldVoxel(chunkPos, voxel);
+				const bool isInRange =
+					(worldVoxel.x >= minVoxel.x) && (worldVoxel.x <= maxVoxel.x) &&
+					(worldVoxel.y >= minVoxel.y) && (worldVoxel.y <= maxVoxel.y) &&
+					(worldVoxel.z >= minVoxel.z) && (worldVoxel.z <= maxVoxel.z);
+				if (isInRange)
+				{
+					renderer.freeLightmap(iter->second);
+					renderChunk.addDirtyLightPosition(voxel);
+					iter = renderChunk.lightmapIDs.erase(iter);
+				}
+				else
+				{
+					++iter;
+				}
+			}
+		}
+	}
+}
+
+RenderLightmapID RenderChunkManager::getVoxelLighting(RenderChunk &renderChunk, const VoxelInt3 &voxel, double ceilingScale,
+	Renderer &renderer, BufferView<const RenderLightID> *outLightIDs)
+{
+	const RenderVoxelLightIdList &voxelLightIdList = renderChunk.voxelLightIdLists.get(voxel.x, voxel.y, voxel.z);
+	if (!this->staticLightmapsEnabled || !voxelLightIdList.hasStaticLights())
+	{
+		*outLightIDs = voxelLightIdList.getLightIDs();
+		return -1;
+	}
+
+	*outLightIDs = voxelLightIdList.getDynamicLightIDs();
+
+	const auto iter = renderChunk.lightmapIDs.find(voxel);
+	if (iter != renderChunk.lightmapIDs.end())
+	{
+		return iter->second;
+	}
+
+	// Bake every static light touching the voxel, not just the ones that fit in its light list.
+	const WorldInt3 worldVoxel = VoxelUtils::chunkVoxelToWorldVoxel(renderChunk.getPosition(), voxel);
+	FrameVector<const RenderChunkLight*> staticLights;
+	for (const RenderChunkLight &light : renderChunk.lights)
+	{
+		const bool isTouching =
+			(worldVoxel.x >= light.minVoxel.x) && (worldVoxel.x <= light.maxVoxel.x) &&
+			(worldVoxel.y >= light.minVoxel.y) && (worldVoxel.y <= light.maxVoxel.y) &&
+			(worldVoxel.z >= light.minVoxel.z) && (worldVoxel.z <= light.maxVoxel.z);
+		if (light.isStatic && isTouching)
+		{
+			staticLights.emplace_back(&light);
+		}
+	}
+
+	const WorldDouble3 minPoint(
+		static_cast<SNDouble>(worldVoxel.x),
+		static_cast<double>(worldVoxel.y) * ceilingScale,
+		static_cast<WEDouble>(worldVoxel.z));
+	const WorldDouble3 maxPoint = minPoint + WorldDouble3(1.0, ceilingScale, 1.0);
+
+	constexpr int sampleCount = sgLightmap::SAMPLES_PER_AXIS;
+	uint8_t intensities[sampleCount * sampleCount * sampleCount];
+	for (int z = 0; z < sampleCount; z++)
+	{
+		for (int y = 0; y < sampleCount; y++)
+		{
+			for (int x = 0; x < sampleCount; x++)
+			{
+				const Double3 samplePercent(
+					static_cast<double>(x) / static_cast<double>(sampleCount - 1),
+					static_cast<double>(y) / static_cast<double>(sampleCount - 1),
+					static_cast<double>(z) / static_cast<double>(sampleCount - 1));
+				const WorldDouble3 samplePoint(
+					minPoint.x + samplePercent.x,
+					minPoint.y + (samplePercent.y * ceilingScale),
+					minPoint.z + samplePercent.z);
+
+				double intensitySum = 0.0;
+				for (const RenderChunkLight *lightPtr : staticLights)
+				{
+					intensitySum += sgLightmap::GetLightIntensity(*lightPtr, samplePoint);
+				}
+
+				const int index = x + (y * sampleCount) + (z * sampleCount * sampleCount);
+				intensities[index] = static_cast<uint8_t>(std::round(std::clamp(intensitySum, 0.0, 1.0) * 255.0));
+			}
+		}
+	}
+
+	RenderLightmapID lightmapID;
+	if (!renderer.tryCreateLightmap(&lightmapID))
+	{
+		DebugLogError("Couldn't create lightmap for voxel (" + voxel.toString() + ") in chunk (" + renderChunk.getPosition().toString() + ").");
+		*outLightIDs = voxelLightIdList.getLightIDs();
+		return -1;
+	}
+
+	renderer.populateLightmap(lightmapID, minPoint, maxPoint, BufferView3D<const uint8_t>(intensities, sampleCount, sampleCount, sampleCount));
+	renderChunk.lightmapIDs.emplace(voxel, lightmapID);
+	return lightmapID;
 }
 
 void RenderChunkManager::updateLights(BufferView<const ChunkInt2> activeChunkPositions, BufferView<const ChunkInt2> newChunkPositions,
 	const CoordDouble3 &cameraCoord, double ceilingScale, bool isFogActive, bool nightLightsAreActive, bool playerHasLight,
-	const EntityChunkManager &entityChunkManager, Renderer &renderer)
+	bool useStaticLightmaps, const EntityChunkManager &entityChunkManager, Renderer &renderer)
 {
+	if (useStaticLightmaps != this->staticLightmapsEnabled)
+	{
+		// Every lit voxel switches between lightmaps and per-pixel static lights.
+		for (int i = 0; i < this->getChunkCount(); i++)
+		{
+			RenderChunk &renderChunk = this->getChunkAtIndex(i);
+			renderChunk.freeLightmaps(renderer);
+
+			const Buffer3D<RenderVoxelLightIdList> &voxelLightIdLists = renderChunk.voxelLightIdLists;
+			for (WEInt z = 0; z < voxelLightIdLists.getDepth(); z++)
+			{
+				for (int y = 0; y < voxelLightIdLists.getHeight(); y++)
+				{
+					for (SNInt x = 0; x < voxelLightIdLists.getWidth(); x++)
+					{
+						if (voxelLightIdLists.get(x, y, z).hasStaticLights())
+						{
+							renderChunk.addDirtyLightPosition(VoxelInt3(x, y, z));
+						}
+					}
+				}
+			}
+		}
+
+		this->staticLightmapsEnabled = useStaticLightmaps;
+	}
+
+	// Light ranges that changed this frame. Their voxels are rebuilt once every light is binned, and lightmaps
+	// touched by a changed static light are baked again.
+	struct DirtyRange
+	{
+		WorldInt3 minVoxel, maxVoxel;
+		bool isStatic;
+	};
+
+	FrameVector<DirtyRange> dirtyRanges;
+	auto addDirtyRange = [&dirtyRanges](const Light &light)
+	{
+		dirtyRanges.push_back({ light.minVoxel, light.maxVoxel, light.isStatic });
+	};
+
 	for (const EntityInstanceID entityInstID : entityChunkManager.getQueuedDestroyEntityIDs())
 	{
 		const auto iter = this->entityLights.find(entityInstID);
 		if (iter != this->entityLights.end())
 		{
-			const Light &light = iter->second;
+			Light &light = iter->second;
+			if (light.isBinned)
+			{
+				this->unbinLight(light);
+				addDirtyRange(light);
+			}
+
 			renderer.freeLight(light.lightID);
 			this->entityLights.erase(iter);
 		}
 	}
 
+	// Existing lights reaching into new chunks from their neighbors.
+	for (const ChunkInt2 &chunkPos : newChunkPositions)
+	{
+		RenderChunk &renderChunk = this->getChunkAtPosition(chunkPos);
+		auto tryAddToNewChunk = [&renderChunk, &chunkPos](const Light &light)
+		{
+			if (!light.isBinned)
+			{
+				return;
+			}
+
+			const ChunkInt2 minChunk = VoxelUtils::worldVoxelToChunk(WorldInt2(light.minVoxel.x, light.minVoxel.z));
+			const ChunkInt2 maxChunk = VoxelUtils::worldVoxelToChunk(WorldInt2(light.maxVoxel.x, light.maxVoxel.z));
+			if ((chunkPos.x >= minChunk.x) && (chunkPos.x <= maxChunk.x) && (chunkPos.y >= minChunk.y) && (chunkPos.y <= maxChunk.y))
+			{
+				RenderChunkLight chunkLight;
+				chunkLight.init(light.lightID, light.position, light.startRadius, light.endRadius, light.minVoxel,
+					light.maxVoxel, light.isStatic);
+				renderChunk.addLight(chunkLight);
+			}
+		};
+
+		tryAddToNewChunk(this->playerLight);
+		for (const auto &pair : this->entityLights)
+		{
+			tryAddToNewChunk(pair.second);
+		}
+	}
+
 	for (const ChunkInt2 &chunkPos : newChunkPositions)
 	{
 		const EntityChunk &entityChunk = entityChunkManager.getChunkAtPosition(chunkPos);
@@ -1622,10 +2241,6 @@ void RenderChunkManager::updateLights(BufferView<const ChunkInt2> activeChunkPos
 
 				const bool isLightEnabled = !EntityUtils::isStreetlight(entityDef) || nightLightsAreActive;
 
-				Light light;
-				light.init(lightID, isLightEnabled);
-				this->entityLights.emplace(entityInstID, std::move(light));
-
 				const CoordDouble2 &entityCoord = entityChunkManager.getEntityPosition(entityInst.positionID);
 				const WorldDouble2 entityPos = VoxelUtils::coordToWorldPoint(entityCoord);
 
@@ -1635,13 +2250,38 @@ void RenderChunkManager::updateLights(BufferView<const ChunkInt2> activeChunkPos
 				const WorldDouble3 entityPos3D(entityPos.x, entityPosY, entityPos.y);
 				renderer.setLightPosition(lightID, entityPos3D);
 				renderer.setLightRadius(lightID, ArenaRenderUtils::PLAYER_LIGHT_START_RADIUS, *entityLightRadius);
+
+				// Binned below with the other lights that changed state.
+				Light light;
+				constexpr bool isStaticLight = true;
+				light.init(lightID, entityPos3D, ArenaRenderUtils::PLAYER_LIGHT_START_RADIUS, *entityLightRadius, ceilingScale,
+					isLightEnabled, isStaticLight);
+				this->entityLights.emplace(entityInstID, std::move(light));
 			}
 		}
 	}
 
-	const WorldDouble3 prevPlayerLightPosition = renderer.getLightPosition(this->playerLightID);
+	// Entity lights are static, so only newly created and toggled ones (e.g. streetlights at dusk) need binning.
+	for (auto &pair : this->entityLights)
+	{
+		Light &light = pair.second;
+		if (light.enabled != light.isBinned)
+		{
+			if (light.enabled)
+			{
+				this->binLight(light);
+			}
+			else
+			{
+				this->unbinLight(light);
+			}
+
+			addDirtyRange(light);
+		}
+	}
+
 	const WorldDouble3 playerLightPosition = VoxelUtils::coordToWorldPoint(cameraCoord);
-	renderer.setLightPosition(this->playerLightID, playerLightPosition);
+	renderer.setLightPosition(this->playerLight.lightID, playerLightPosition);
 
 	double playerLightRadiusStart, playerLightRadiusEnd;
 	if (isFogActive)
@@ -1661,106 +2301,49 @@ void RenderChunkManager::updateLights(BufferView<const ChunkInt2> activeChunkPos
 		playerLightRadiusEnd = 0.0;
 	}
 
-	renderer.setLightRadius(this->playerLightID, playerLightRadiusStart, playerLightRadiusEnd);
+	renderer.setLightRadius(this->playerLight.lightID, playerLightRadiusStart, playerLightRadiusEnd);
 
-	// Clear all previous light references in voxels.
-	// @todo: track touched, newly-touched, and no-longer-touched voxels each frame for moving lights so we don't have to iterate all voxels
-	for (int i = 0; i < this->getChunkCount(); i++)
+	// When the player light moves, only its old and new ranges are rebuilt. Voxels in both are included since
+	// the distance ordering against other lights may have changed.
+	const bool isPlayerLightEnabled = playerHasLight && (this->playerLight.lightID >= 0);
+	const bool hasPlayerLightChanged = (this->playerLight.position != playerLightPosition) ||
+		(this->playerLight.startRadius != playerLightRadiusStart) || (this->playerLight.endRadius != playerLightRadiusEnd) || (this->playerLight.isBinned != isPlayerLightEnabled);
+	if (hasPlayerLightChanged)
 	{
-		RenderChunk &renderChunk = this->getChunkAtIndex(i);
-		for (RenderVoxelLightIdList &voxelLightIdList : renderChunk.voxelLightIdLists)
+		if (this->playerLight.isBinned)
 		{
-			voxelLightIdList.clear();
+			this->unbinLight(this->playerLight);
+			addDirtyRange(this->playerLight);
 		}
-	}
 
-	auto getLightMinAndMaxVoxels = [ceilingScale](const WorldDouble3 &lightPosition, double endRadius, WorldInt3 *outMin, WorldInt3 *outMax)
-	{
-		const WorldDouble3 lightPosMin = lightPosition - WorldDouble3(endRadius, endRadius, endRadius);
-		const WorldDouble3 lightPosMax = lightPosition + WorldDouble3(endRadius, endRadius, endRadius);
-		*outMin = VoxelUtils::pointToVoxel(lightPosMin, ceilingScale);
-		*outMax = VoxelUtils::pointToVoxel(lightPosMax, ceilingScale);
-	};
-
-	auto populateTouchedVoxelLightIdLists = [this, &renderer, ceilingScale](RenderLightID lightID, const WorldDouble3 &lightPosition,
-		const WorldInt3 &lightVoxelMin, const WorldInt3 &lightVoxelMax)
-	{
-		// Iterate over all voxels the light's bounding box touches.
-		for (WEInt z = lightVoxelMin.z; z <= lightVoxelMax.z; z++)
+		this->playerLight.setVolume(playerLightPosition, playerLightRadiusStart, playerLightRadiusEnd, ceilingScale);
+		this->playerLight.enabled = isPlayerLightEnabled;
+		if (this->playerLight.enabled)
 		{
-			for (int y = lightVoxelMin.y; y <= lightVoxelMax.y; y++)
-			{
-				for (SNInt x = lightVoxelMin.x; x <= lightVoxelMax.x; x++)
-				{
-					const CoordInt3 curLightCoord = VoxelUtils::worldVoxelToCoord(WorldInt3(x, y, z));
-					RenderChunk *renderChunkPtr = this->tryGetChunkAtPosition(curLightCoord.chunk);
-					if (renderChunkPtr != nullptr)
-					{
-						const VoxelInt3 &curLightVoxel = curLightCoord.voxel;
-						if (renderChunkPtr->isValidVoxel(curLightVoxel.x, curLightVoxel.y, curLightVoxel.z))
-						{
-							RenderVoxelLightIdList &voxelLightIdList = renderChunkPtr->voxelLightIdLists.get(curLightVoxel.x, curLightVoxel.y, curLightVoxel.z);
-							voxelLightIdList.tryAddLight(lightID);
-						}
-					}
-				}
-			}
+			this->binLight(this->playerLight);
+			addDirtyRange(this->playerLight);
 		}
-	};
-
-	WorldInt3 playerLightVoxelMin, playerLightVoxelMax;
-	getLightMinAndMaxVoxels(playerLightPosition, playerLightRadiusEnd, &playerLightVoxelMin, &playerLightVoxelMax);
-	populateTouchedVoxelLightIdLists(this->playerLightID, playerLightPosition, playerLightVoxelMin, playerLightVoxelMax);
+	}
 
-	// Populate each voxel's light ID list based on which lights touch them, preferring the nearest lights.
-	// - @todo: this method doesn't implicitly allow sorting by distance because it doesn't check lights per voxel, it checks voxels per light.
-	//   If sorting is desired then do it after this loop. It should also sort by intensity at the voxel center, not just distance to the light.
-	for (const auto &pair : this->entityLights)
+	// New chunks get all their draw calls built anyway so they don't need dirty voxels.
+	for (const ChunkInt2 &chunkPos : newChunkPositions)
 	{
-		const Light &light = pair.second;
-		if (light.enabled)
+		RenderChunk &renderChunk = this->getChunkAtPosition(chunkPos);
+		for (int i = 0; i < static_cast<int>(renderChunk.lights.size()); i++)
 		{
-			const RenderLightID lightID = light.lightID;
-			const WorldDouble3 &lightPosition = renderer.getLightPosition(lightID);
-
-			double dummyLightStartRadius, lightEndRadius;
-			renderer.getLightRadii(lightID, &dummyLightStartRadius, &lightEndRadius);
-
-			WorldInt3 lightVoxelMin, lightVoxelMax;
-			getLightMinAndMaxVoxels(lightPosition, lightEndRadius, &lightVoxelMin, &lightVoxelMax);
-			populateTouchedVoxelLightIdLists(lightID, lightPosition, lightVoxelMin, lightVoxelMax);
+			const RenderChunkLight light = renderChunk.lights[i];
+			constexpr bool markDirty = false;
+			this->rebuildChunkVoxelLightIdLists(renderChunk, light.minVoxel, light.maxVoxel, ceilingScale, markDirty);
 		}
 	}
 
-	WorldInt3 prevPlayerLightVoxelMin, prevPlayerLightVoxelMax;
-	getLightMinAndMaxVoxels(prevPlayerLightPosition, playerLightRadiusEnd, &prevPlayerLightVoxelMin, &prevPlayerLightVoxelMax);
-
-	// See which voxels affected by the player's light are getting their light references updated.
-	// This is for dirty voxel draw calls mainly, not about setting light references (might change later).
-	if ((prevPlayerLightVoxelMin != playerLightVoxelMin) || (prevPlayerLightVoxelMax != playerLightVoxelMax))
+	for (const DirtyRange &dirtyRange : dirtyRanges)
 	{
-		for (WEInt z = playerLightVoxelMin.z; z <= playerLightVoxelMax.z; z++)
+		this->rebuildVoxelLightIdLists(dirtyRange.minVoxel, dirtyRange.maxVoxel, ceilingScale);
+
+		if (dirtyRange.isStatic)
 		{
-			for (int y = playerLightVoxelMin.y; y <= playerLightVoxelMax.y; y++)
-			{
-				for (SNInt x = playerLightVoxelMin.x; x <= playerLightVoxelMax.x; x++)
-				{
-					const bool isInPrevRange =
-						(x >= prevPlayerLightVoxelMin.x) && (x <= prevPlayerLightVoxelMax.x) &&
-						(y >= prevPlayerLightVoxelMin.y) && (y <= prevPlayerLightVoxelMax.y) &&
-						(z >= prevPlayerLightVoxelMin.z) && (z <= prevPlayerLightVoxelMax.z);
-					
-					if (!isInPrevRange)
-					{
-						const CoordInt3 curLightCoord = VoxelUtils::worldVoxelToCoord(WorldInt3(x, y, z));
-						RenderChunk *renderChunkPtr = this->tryGetChunkAtPosition(curLightCoord.chunk);
-						if (renderChunkPtr != nullptr)
-						{
-							renderChunkPtr->addDirtyLightPosition(curLightCoord.voxel);
-						}
-					}
-				}
-			}
+			this->invalidateLightmaps(dirtyRange.minVoxel, dirtyRange.maxVoxel, renderer);
 		}
 	}
 }
@@ -1799,9 +2382,12 @@ void RenderChunkManager::cleanUp()
 void RenderChunkManager::unloadScene(Renderer &renderer)
 {
 	this->voxelTextures.clear();
+	this->voxelTextureIndices.clear();
 	this->chasmFloorTextureLists.clear();
 	this->chasmTextureKeys.clear();
+	this->chasmTextureKeyIndices.clear();
 	this->entityAnims.clear();
+	this->entityAnimIndices.clear();
 	this->entityPaletteIndicesTextureRefs.clear();
 
 	// Free vertex/attribute/index buffer IDs.
@@ -1812,6 +2398,9 @@ void RenderChunkManager::unloadScene(Renderer &renderer)
 		this->recycleChunk(i);
 	}
 
+	// The player light is kept across scenes but no chunks list it anymore.
+	this->playerLight.isBinned = false;
+
 	for (auto &pair : this->entityLights)
 	{
 		Light &light = pair.second;
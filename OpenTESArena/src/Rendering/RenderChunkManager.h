@@ -2,7 +2,9 @@
 #define RENDER_CHUNK_MANAGER_H
 
 #include <array>
+#include <cstdint>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
 #include "RenderChunk.h"
@@ -78,37 +80,68 @@ public:
 	struct Light
 	{
 		RenderLightID lightID;
+		WorldDouble3 position;
+		double startRadius, endRadius;
+		WorldInt3 minVoxel, maxVoxel; // Voxels touched by the end radius.
 		bool enabled;
+		bool isStatic; // Never moves once created.
+		bool isBinned; // Whether chunks currently list this light.
 
 		Light();
 
-		void init(RenderLightID lightID, bool enabled);
+		void init(RenderLightID lightID, const WorldDouble3 &position, double startRadius, double endRadius, double ceilingScale,
+			bool enabled, bool isStatic);
+		void setVolume(const WorldDouble3 &position, double startRadius, double endRadius, double ceilingScale);
+	};
+
+	// Draw call index paired with a radix sort key for front-to-back ordering.
+	struct DrawCallSortEntry
+	{
+		uint64_t key;
+		int drawCallIndex;
+
+		DrawCallSortEntry();
+
+		void init(uint64_t key, int drawCallIndex);
 	};
 private:
 	// Chasm wall support - one index buffer for each face combination.
 	std::array<IndexBufferID, ArenaMeshUtils::CHASM_WALL_COMBINATION_COUNT> chasmWallIndexBufferIDs;
 
 	std::vector<LoadedVoxelTexture> voxelTextures; // Includes chasm walls.
+	std::unordered_map<TextureAsset, int> voxelTextureIndices; // Points into voxel textures.
 	std::vector<LoadedChasmFloorTextureList> chasmFloorTextureLists;
 	std::vector<LoadedChasmTextureKey> chasmTextureKeys; // Points into floor lists and wall textures.
+	std::unordered_map<ChunkInt2, std::vector<int>> chasmTextureKeyIndices; // Chasm def ID -> index into chasm texture keys, -1 if none.
 
 	std::vector<LoadedEntityAnimation> entityAnims;
+	std::unordered_map<EntityDefID, int> entityAnimIndices; // Points into entity animations.
 	RenderEntityMeshDefinition entityMeshDef; // Shared by all entities.
 	std::unordered_map<EntityPaletteIndicesInstanceID, ScopedObjectTextureRef> entityPaletteIndicesTextureRefs;
 
-	RenderLightID playerLightID;
+	Light playerLight;
 	std::unordered_map<EntityInstanceID, Light> entityLights; // All lights have an associated entity.
+	bool staticLightmapsEnabled; // Whether voxel draw calls sample baked static lights instead of evaluating them per pixel.
 
 	// All accumulated draw calls from scene components each frame. This is sent to the renderer.
 	std::vector<RenderDrawCall> voxelDrawCallsCache, entityDrawCallsCache;
 
+	// Scratch buffers for sorting draw calls by distance each frame.
+	std::vector<int> chunkDrawOrder; // Indices into active chunks, nearest first.
+	std::vector<DrawCallSortEntry> drawCallSortEntries, drawCallSortEntriesScratch;
+	std::vector<RenderDrawCall> drawCallSortScratch;
+
 	ObjectTextureID getVoxelTextureID(const TextureAsset &textureAsset) const;
+	const LoadedChasmTextureKey &getChasmTextureKey(const ChunkInt2 &chunkPos, VoxelChunk::ChasmDefID chasmDefID) const;
 	ObjectTextureID getChasmFloorTextureID(const ChunkInt2 &chunkPos, VoxelChunk::ChasmDefID chasmDefID, double chasmAnimPercent) const;
 	ObjectTextureID getChasmWallTextureID(const ChunkInt2 &chunkPos, VoxelChunk::ChasmDefID chasmDefID) const;
 	ObjectTextureID getEntityTextureID(EntityInstanceID entityInstID, const CoordDouble2 &cameraCoordXZ,
 		const EntityChunkManager &entityChunkManager) const;
 
-	void loadVoxelTextures(const VoxelChunk &voxelChunk, TextureManager &textureManager, Renderer &renderer);
+	void loadVoxelTextures(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, TextureManager &textureManager, Renderer &renderer);
+
+	// Fills the render chunk's direct voxel texture lookup table for any texture defs it hasn't mapped yet.
+	void populateVoxelTextureIDs(RenderChunk &renderChunk, const VoxelChunk &voxelChunk);
 	void loadVoxelMeshBuffers(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, double ceilingScale, Renderer &renderer);
 	void loadVoxelChasmWall(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, SNInt x, int y, WEInt z);
 	void loadVoxelChasmWalls(RenderChunk &renderChunk, const VoxelChunk &voxelChunk);
@@ -120,16 +153,21 @@ private:
 		const Matrix4d &scaleMatrix, VertexBufferID vertexBufferID, AttributeBufferID normalBufferID, AttributeBufferID texCoordBufferID,
 		IndexBufferID indexBufferID, ObjectTextureID textureID0, const std::optional<ObjectTextureID> &textureID1,
 		TextureSamplingType textureSamplingType0, TextureSamplingType textureSamplingType1, RenderLightingType lightingType,
-		double meshLightPercent, BufferView<const RenderLightID> lightIDs, VertexShaderType vertexShaderType, PixelShaderType pixelShaderType,
-		double pixelShaderParam0, std::vector<RenderDrawCall> &drawCalls);
+		double meshLightPercent, BufferView<const RenderLightID> lightIDs, RenderLightmapID lightmapID, VertexShaderType vertexShaderType,
+		PixelShaderType pixelShaderType, double pixelShaderParam0, std::vector<RenderDrawCall> &drawCalls);
 	void loadVoxelDrawCalls(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, double ceilingScale,
-		double chasmAnimPercent, bool updateStatics, bool updateAnimating);
+		double chasmAnimPercent, bool updateStatics, bool updateAnimating, Renderer &renderer);
+
+	// Gets the lights for a voxel's per-pixel lit draw calls. With lightmaps, static lights are baked into the
+	// returned lightmap and only dynamic lights are listed.
+	RenderLightmapID getVoxelLighting(RenderChunk &renderChunk, const VoxelInt3 &voxel, double ceilingScale, Renderer &renderer,
+		BufferView<const RenderLightID> *outLightIDs);
 
 	// Call once per frame per chunk after all voxel chunk changes have been applied to this manager.
 	// All context-sensitive data (like for chasm walls) should be available in the voxel chunk.
 	void rebuildVoxelChunkDrawCalls(RenderChunk &renderChunk, const VoxelChunk &voxelChunk, double ceilingScale,
-		double chasmAnimPercent, bool updateStatics, bool updateAnimating);
-	void rebuildVoxelDrawCallsList();
+		double chasmAnimPercent, bool updateStatics, bool updateAnimating, Renderer &renderer);
+	void rebuildVoxelDrawCallsList(const CoordDouble2 &cameraCoordXZ, bool sortDrawCalls);
 
 	void addEntityDrawCall(const Double3 &position, const Matrix4d &rotationMatrix, const Matrix4d &scaleMatrix,
 		ObjectTextureID textureID0, const std::optional<ObjectTextureID> &textureID1, BufferView<const RenderLightID> lightIDs,
@@ -137,7 +175,30 @@ private:
 	void rebuildEntityChunkDrawCalls(RenderChunk &renderChunk, const EntityChunk &entityChunk, const CoordDouble2 &cameraCoordXZ,
 		const Matrix4d &rotationMatrix, double ceilingScale, const VoxelChunkManager &voxelChunkManager,
 		const EntityChunkManager &entityChunkManager);
-	void rebuildEntityDrawCallsList();
+	void rebuildEntityDrawCallsList(const CoordDouble2 &cameraCoordXZ, bool sortDrawCalls);
+
+	// Orders active chunks nearest first if sorting, otherwise keeps their existing order.
+	void populateChunkDrawOrder(const CoordDouble2 &cameraCoordXZ, bool sortDrawCalls);
+
+	// Appends the draw calls to the given list, adding sort entries for them if sorting.
+	void addDrawCallsToList(BufferView<const RenderDrawCall> drawCalls, int chunkRank, const WorldDouble2 &cameraPointXZ,
+		bool sortDrawCalls, std::vector<RenderDrawCall> &drawCallsList);
+
+	// Reorders the draw calls list by its sort entries. Sorting is stable so ties keep submission order.
+	void sortDrawCallsList(std::vector<RenderDrawCall> &drawCallsList);
+
+	// Adds or removes the light in every active chunk its range touches. Voxel light lists are rebuilt afterwards.
+	void binLight(Light &light);
+	void unbinLight(Light &light);
+
+	// Recomputes the nearest lights of voxels in the given range from each chunk's light list, optionally marking
+	// voxels whose lists changed so their draw calls are rebuilt.
+	void rebuildChunkVoxelLightIdLists(RenderChunk &renderChunk, const WorldInt3 &minVoxel, const WorldInt3 &maxVoxel,
+		double ceilingScale, bool markDirty);
+	void rebuildVoxelLightIdLists(const WorldInt3 &minVoxel, const WorldInt3 &maxVoxel, double ceilingScale);
+
+	// Frees lightmaps in the range so they're baked again with the current static lights.
+	void invalidateLightmaps(const WorldInt3 &minVoxel, const WorldInt3 &maxVoxel, Renderer &renderer);
 public:
 	RenderChunkManager();
 
@@ -152,14 +213,14 @@ public:
 		const VoxelChunkManager &voxelChunkManager, Renderer &renderer);
 
 	void updateVoxels(BufferView<const ChunkInt2> activeChunkPositions, BufferView<const ChunkInt2> newChunkPositions,
-		double ceilingScale, double chasmAnimPercent, const VoxelChunkManager &voxelChunkManager,
-		const VoxelVisibilityChunkManager &voxelVisChunkManager, TextureManager &textureManager, Renderer &renderer);
+		const CoordDouble2 &cameraCoordXZ, double ceilingScale, double chasmAnimPercent, const VoxelChunkManager &voxelChunkManager,
+		const VoxelVisibilityChunkManager &voxelVisChunkManager, bool sortDrawCalls, TextureManager &textureManager, Renderer &renderer);
 	void updateEntities(BufferView<const ChunkInt2> activeChunkPositions, BufferView<const ChunkInt2> newChunkPositions,
 		const CoordDouble2 &cameraCoordXZ, const VoxelDouble2 &cameraDirXZ, double ceilingScale, const VoxelChunkManager &voxelChunkManager,
-		const EntityChunkManager &entityChunkManager, TextureManager &textureManager, Renderer &renderer);
+		const EntityChunkManager &entityChunkManager, bool sortDrawCalls, TextureManager &textureManager, Renderer &renderer);
 	void updateLights(BufferView<const ChunkInt2> activeChunkPositions, BufferView<const ChunkInt2> newChunkPositions,
 		const CoordDouble3 &cameraCoord, double ceilingScale, bool isFogActive, bool nightLightsAreActive, bool playerHasLight,
-		const EntityChunkManager &entityChunkManager, Renderer &renderer);
+		bool useStaticLightmaps, const EntityChunkManager &entityChunkManager, Renderer &renderer);
 
 	void setNightLightsActive(bool enabled, const EntityChunkManager &entityChunkManager);
 
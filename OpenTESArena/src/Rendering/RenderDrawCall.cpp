@@ -16,6 +16,7 @@ RenderDrawCall::RenderDrawCall()
 	}
 
 	this->lightIdCount = 0;
+	this->lightmapID = -1;
 	this->lightPercent = 0.0;
 	this->vertexShaderType = static_cast<VertexShaderType>(-1);
 	this->pixelShaderType = static_cast<PixelShaderType>(-1);
@@ -48,6 +49,7 @@ void RenderDrawCall::clear()
 	}
 
 	this->lightIdCount = 0;
+	this->lightmapID = -1;
 	this->lightPercent = 0.0;
 	this->vertexShaderType = static_cast<VertexShaderType>(-1);
 	this->pixelShaderType = static_cast<PixelShaderType>(-1);
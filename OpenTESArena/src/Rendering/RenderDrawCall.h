@@ -27,6 +27,7 @@ struct RenderDrawCall
 	double lightPercent; // For per-mesh lighting.
 	RenderLightID lightIDs[MAX_LIGHTS]; // For per-pixel lighting.
 	int lightIdCount;
+	RenderLightmapID lightmapID; // For per-pixel lighting, holds static lights not in the light IDs. -1 if none.
 
 	VertexShaderType vertexShaderType;
 	PixelShaderType pixelShaderType;
@@ -1,7 +1,7 @@
 #include "RenderFrameSettings.h"
 
 void RenderFrameSettings::init(double ambientPercent, ObjectTextureID paletteTextureID, ObjectTextureID lightTableTextureID,
-	int renderWidth, int renderHeight, int renderThreadsMode)
+	int renderWidth, int renderHeight, int renderThreadsMode, bool useMipmaps)
 {
 	this->ambientPercent = ambientPercent;
 	this->paletteTextureID = paletteTextureID;
@@ -9,4 +9,5 @@ void RenderFrameSettings::init(double ambientPercent, ObjectTextureID paletteTex
 	this->renderWidth = renderWidth;
 	this->renderHeight = renderHeight;
 	this->renderThreadsMode = renderThreadsMode;
+	this->useMipmaps = useMipmaps;
 }
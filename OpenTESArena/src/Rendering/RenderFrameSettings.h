@@ -12,9 +12,10 @@ struct RenderFrameSettings
 	double ambientPercent;
 	ObjectTextureID paletteTextureID, lightTableTextureID;
 	int renderWidth, renderHeight, renderThreadsMode;
+	bool useMipmaps; // Whether distant surfaces sample smaller versions of their textures.
 
 	void init(double ambientPercent, ObjectTextureID paletteTextureID, ObjectTextureID lightTableTextureID,
-		int renderWidth, int renderHeight, int renderThreadsMode);
+		int renderWidth, int renderHeight, int renderThreadsMode, bool useMipmaps);
 };
 
 #endif
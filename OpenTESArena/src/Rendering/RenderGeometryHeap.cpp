@@ -0,0 +1,294 @@
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "RenderGeometryHeap.h"
+
+namespace
+{
+	constexpr int UnitByteCount = 16; // Allocation granularity; keeps every allocation aligned for SIMD loads.
+	constexpr int DefaultSlabUnitCount = (4 * 1024 * 1024) / UnitByteCount;
+
+	// A slab is compacted once this fraction of its used range is holes.
+	constexpr double CompactionHoleRatio = 0.5;
+
+	// Empty slabs kept around for reuse instead of being released.
+	constexpr int MaxSpareSlabCount = 1;
+
+	int GetUnitCount(int byteCount)
+	{
+		return (byteCount + UnitByteCount - 1) / UnitByteCount;
+	}
+}
+
+RenderGeometryHeap::Stats::Stats()
+{
+	this->slabCount = 0;
+	this->allocationCount = 0;
+	this->reservedByteCount = 0;
+	this->usedByteCount = 0;
+	this->compactionCount = 0;
+	this->compactedByteCount = 0;
+}
+
+RenderGeometryHeap::Slab::Slab()
+{
+	this->unitCount = 0;
+	this->usedUnitCount = 0;
+	this->needsCompaction = false;
+}
+
+void RenderGeometryHeap::Slab::init(int unitCount)
+{
+	DebugAssert(unitCount > 0);
+	this->bytes.init(unitCount * UnitByteCount);
+	this->heap = VirtualHeap();
+	this->unitCount = unitCount;
+	this->usedUnitCount = 0;
+	this->needsCompaction = false;
+}
+
+void RenderGeometryHeap::Slab::release()
+{
+	DebugAssert(this->usedUnitCount == 0);
+	this->bytes.clear();
+	this->heap = VirtualHeap();
+	this->unitCount = 0;
+	this->needsCompaction = false;
+}
+
+RenderGeometryHeap::Allocation::Allocation()
+{
+	this->slabIndex = -1;
+	this->handle = VirtualHeap::INVALID_HANDLE;
+	this->unitOffset = 0;
+	this->unitCount = 0;
+	this->byteCount = 0;
+}
+
+RenderGeometryHeap::RenderGeometryHeap()
+{
+	this->compactionCount = 0;
+	this->compactedByteCount = 0;
+}
+
+std::byte *RenderGeometryHeap::getBytes(RenderGeometryAllocationID id)
+{
+	const Allocation &allocation = this->allocations.get(id);
+	Slab &slab = this->slabs[allocation.slabIndex];
+	return slab.bytes.begin() + (allocation.unitOffset * UnitByteCount);
+}
+
+const std::byte *RenderGeometryHeap::getBytes(RenderGeometryAllocationID id) const
+{
+	const Allocation &allocation = this->allocations.get(id);
+	const Slab &slab = this->slabs[allocation.slabIndex];
+	return slab.bytes.begin() + (allocation.unitOffset * UnitByteCount);
+}
+
+bool RenderGeometryHeap::tryAllocInSlab(int slabIndex, int unitCount, Allocation *outAllocation)
+{
+	Slab &slab = this->slabs[slabIndex];
+	if ((slab.unitCount - slab.usedUnitCount) < unitCount)
+	{
+		return false;
+	}
+
+	// The virtual heap is unbounded, so a placement past the end of the slab means it doesn't fit.
+	const VirtualHeap::Handle handle = slab.heap.alloc(unitCount);
+	const VirtualHeap::Block *block;
+	if (!slab.heap.tryGetBlock(handle, &block))
+	{
+		return false;
+	}
+
+	if ((block->offset + block->size) > static_cast<VirtualHeap::Block::Offset>(slab.unitCount))
+	{
+		slab.heap.free(handle);
+		return false;
+	}
+
+	slab.usedUnitCount += unitCount;
+	outAllocation->slabIndex = slabIndex;
+	outAllocation->handle = handle;
+	outAllocation->unitOffset = static_cast<int>(block->offset);
+	outAllocation->unitCount = unitCount;
+	return true;
+}
+
+bool RenderGeometryHeap::tryAlloc(int byteCount, RenderGeometryAllocationID *outID)
+{
+	DebugAssert(byteCount > 0);
+	const int unitCount = GetUnitCount(byteCount);
+
+	Allocation allocation;
+	bool success = false;
+	for (int i = 0; i < static_cast<int>(this->slabs.size()); i++)
+	{
+		if (this->tryAllocInSlab(i, unitCount, &allocation))
+		{
+			success = true;
+			break;
+		}
+	}
+
+	if (!success)
+	{
+		// Reuse a released slab entry if there is one. Oversized meshes get a slab to themselves.
+		const auto releasedIter = std::find_if(this->slabs.begin(), this->slabs.end(),
+			[](const Slab &slab) { return slab.unitCount == 0; });
+		const int slabIndex = (releasedIter != this->slabs.end()) ?
+			static_cast<int>(std::distance(this->slabs.begin(), releasedIter)) : static_cast<int>(this->slabs.size());
+		if (slabIndex == static_cast<int>(this->slabs.size()))
+		{
+			this->slabs.emplace_back(Slab());
+		}
+
+		this->slabs[slabIndex].init(std::max(unitCount, DefaultSlabUnitCount));
+		success = this->tryAllocInSlab(slabIndex, unitCount, &allocation);
+		DebugAssert(success);
+	}
+
+	if (!this->allocations.tryAlloc(outID))
+	{
+		DebugLogError("Couldn't allocate render geometry ID.");
+		Slab &slab = this->slabs[allocation.slabIndex];
+		slab.heap.free(allocation.handle);
+		slab.usedUnitCount -= allocation.unitCount;
+		return false;
+	}
+
+	allocation.byteCount = byteCount;
+	this->allocations.get(*outID) = allocation;
+	return true;
+}
+
+void RenderGeometryHeap::free(RenderGeometryAllocationID id)
+{
+	const Allocation &allocation = this->allocations.get(id);
+	Slab &slab = this->slabs[allocation.slabIndex];
+	slab.heap.free(allocation.handle);
+	slab.usedUnitCount -= allocation.unitCount;
+
+	if (slab.usedUnitCount == 0)
+	{
+		// Nothing to pack; start over from the beginning of the slab.
+		slab.heap = VirtualHeap();
+		slab.needsCompaction = false;
+	}
+	else
+	{
+		slab.needsCompaction = true;
+	}
+
+	this->allocations.free(id);
+}
+
+void RenderGeometryHeap::compactSlab(int slabIndex)
+{
+	Slab &slab = this->slabs[slabIndex];
+	slab.needsCompaction = false;
+
+	struct LiveAllocation
+	{
+		int unitOffset;
+		RenderGeometryAllocationID id;
+	};
+
+	std::vector<LiveAllocation> liveAllocations;
+	int usedEndUnit = 0;
+	this->allocations.forEach([slabIndex, &liveAllocations, &usedEndUnit](RenderGeometryAllocationID id, const Allocation &allocation)
+	{
+		if (allocation.slabIndex == slabIndex)
+		{
+			liveAllocations.push_back({ allocation.unitOffset, id });
+			usedEndUnit = std::max(usedEndUnit, allocation.unitOffset + allocation.unitCount);
+		}
+	});
+
+	const int holeUnitCount = usedEndUnit - slab.usedUnitCount;
+	if (holeUnitCount <= static_cast<int>(static_cast<double>(usedEndUnit) * CompactionHoleRatio))
+	{
+		return;
+	}
+
+	// Moving in offset order only ever shifts data toward the start, so nothing is overwritten before it's moved.
+	std::sort(liveAllocations.begin(), liveAllocations.end(),
+		[](const LiveAllocation &a, const LiveAllocation &b) { return a.unitOffset < b.unitOffset; });
+
+	slab.heap = VirtualHeap();
+	std::byte *slabBytes = slab.bytes.begin();
+	for (const LiveAllocation &liveAllocation : liveAllocations)
+	{
+		Allocation &allocation = this->allocations.get(liveAllocation.id);
+		allocation.handle = slab.heap.alloc(allocation.unitCount);
+
+		const VirtualHeap::Block *block;
+		const bool success = slab.heap.tryGetBlock(allocation.handle, &block);
+		DebugAssert(success);
+
+		const int newUnitOffset = static_cast<int>(block->offset);
+		if (newUnitOffset != allocation.unitOffset)
+		{
+			std::memmove(slabBytes + (newUnitOffset * UnitByteCount), slabBytes + (allocation.unitOffset * UnitByteCount),
+				allocation.byteCount);
+			allocation.unitOffset = newUnitOffset;
+			this->compactedByteCount += allocation.byteCount;
+		}
+	}
+
+	this->compactionCount++;
+}
+
+void RenderGeometryHeap::compact()
+{
+	int spareSlabCount = 0;
+	for (int i = 0; i < static_cast<int>(this->slabs.size()); i++)
+	{
+		Slab &slab = this->slabs[i];
+		if (slab.unitCount == 0)
+		{
+			continue;
+		}
+
+		if (slab.usedUnitCount == 0)
+		{
+			spareSlabCount++;
+			if (spareSlabCount > MaxSpareSlabCount)
+			{
+				slab.release();
+			}
+		}
+		else if (slab.needsCompaction)
+		{
+			this->compactSlab(i);
+		}
+	}
+}
+
+RenderGeometryHeap::Stats RenderGeometryHeap::getStats() const
+{
+	Stats stats;
+	for (const Slab &slab : this->slabs)
+	{
+		if (slab.unitCount > 0)
+		{
+			stats.slabCount++;
+			stats.reservedByteCount += static_cast<int64_t>(slab.unitCount) * UnitByteCount;
+			stats.usedByteCount += static_cast<int64_t>(slab.usedUnitCount) * UnitByteCount;
+		}
+	}
+
+	stats.allocationCount = this->allocations.getUsedCount();
+	stats.compactionCount = this->compactionCount;
+	stats.compactedByteCount = this->compactedByteCount;
+	return stats;
+}
+
+void RenderGeometryHeap::clear()
+{
+	this->slabs.clear();
+	this->allocations.clear();
+	this->compactionCount = 0;
+	this->compactedByteCount = 0;
+}
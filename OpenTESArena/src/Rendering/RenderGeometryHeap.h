@@ -0,0 +1,106 @@
+#ifndef RENDER_GEOMETRY_HEAP_H
+#define RENDER_GEOMETRY_HEAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "components/debug/Debug.h"
+#include "components/utilities/Buffer.h"
+#include "components/utilities/BufferView.h"
+#include "components/utilities/RecyclablePool.h"
+#include "components/utilities/VirtualHeap.h"
+
+using RenderGeometryAllocationID = int;
+
+// Suballocates mesh vertices, attributes, and indices out of a few large slabs instead of one heap allocation
+// per buffer, so geometry for nearby chunks ends up close together in memory. Placement within a slab is
+// tracked by a virtual heap. Slabs left fragmented by frees are compacted later by compact(), which moves
+// allocations, so pointers into the heap are only valid until then.
+class RenderGeometryHeap
+{
+public:
+	struct Stats
+	{
+		int slabCount;
+		int allocationCount;
+		int64_t reservedByteCount; // Sum of slab sizes.
+		int64_t usedByteCount; // Including alignment padding.
+		int compactionCount; // Total slab compactions so far.
+		int64_t compactedByteCount; // Total bytes moved by compactions so far.
+
+		Stats();
+	};
+private:
+	struct Slab
+	{
+		Buffer<std::byte> bytes; // Empty if released.
+		VirtualHeap heap; // In allocation units.
+		int unitCount;
+		int usedUnitCount;
+		bool needsCompaction; // Whether something was freed since the last compaction.
+
+		Slab();
+
+		void init(int unitCount);
+		void release();
+	};
+
+	struct Allocation
+	{
+		int slabIndex;
+		VirtualHeap::Handle handle;
+		int unitOffset, unitCount;
+		int byteCount;
+
+		Allocation();
+	};
+
+	using AllocationPool = RecyclablePool<Allocation, RenderGeometryAllocationID>;
+
+	std::vector<Slab> slabs;
+	AllocationPool allocations;
+	int compactionCount;
+	int64_t compactedByteCount;
+
+	std::byte *getBytes(RenderGeometryAllocationID id);
+	const std::byte *getBytes(RenderGeometryAllocationID id) const;
+
+	bool tryAllocInSlab(int slabIndex, int unitCount, Allocation *outAllocation);
+	void compactSlab(int slabIndex);
+public:
+	RenderGeometryHeap();
+
+	bool tryAlloc(int byteCount, RenderGeometryAllocationID *outID);
+	void free(RenderGeometryAllocationID id);
+
+	// Gets the allocation as a list of elements, valid until the next compact() or free().
+	template<typename T>
+	BufferView<T> get(RenderGeometryAllocationID id)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		const Allocation &allocation = this->allocations.get(id);
+		DebugAssert((allocation.byteCount % sizeof(T)) == 0);
+		return BufferView<T>(reinterpret_cast<T*>(this->getBytes(id)), allocation.byteCount / static_cast<int>(sizeof(T)));
+	}
+
+	template<typename T>
+	BufferView<const T> get(RenderGeometryAllocationID id) const
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		const Allocation &allocation = this->allocations.get(id);
+		DebugAssert((allocation.byteCount % sizeof(T)) == 0);
+		return BufferView<const T>(reinterpret_cast<const T*>(this->getBytes(id)), allocation.byteCount / static_cast<int>(sizeof(T)));
+	}
+
+	// Packs the live allocations of badly fragmented slabs together and releases surplus empty slabs.
+	// Cheap when nothing was freed since the last call.
+	void compact();
+
+	Stats getStats() const;
+
+	void clear();
+};
+
+#endif
@@ -33,6 +33,9 @@ enum class TextureSamplingType
 // Unique ID for a light allocated in the renderer's internal format.
 using RenderLightID = int;
 
+// Unique ID for baked static light intensities over a region, sampled in place of evaluating those lights per pixel.
+using RenderLightmapID = int;
+
 enum class RenderLightingType
 {
 	PerMesh, // Mesh is uniformly shaded by a single draw call value.
@@ -3,6 +3,7 @@
 
 #include "ArenaRenderUtils.h"
 #include "Renderer.h"
+#include "RendererUtils.h"
 #include "RenderSkyManager.h"
 #include "../Assets/ArenaPaletteName.h"
 #include "../Assets/ArenaTextureName.h"
@@ -24,10 +25,26 @@ void RenderSkyManager::LoadedGeneralSkyObjectTextureEntry::init(const TextureAss
 	this->objectTextureRef = std::move(objectTextureRef);
 }
 
-void RenderSkyManager::LoadedSmallStarTextureEntry::init(uint8_t paletteIndex, ScopedObjectTextureRef &&objectTextureRef)
+RenderSkyManager::SkyObjectDrawCallState::SkyObjectDrawCallState()
 {
-	this->paletteIndex = paletteIndex;
-	this->objectTextureRef = std::move(objectTextureRef);
+	this->skyObjectIndex = -1;
+	this->distance = 0.0;
+	this->textureIdStartIndex = -1;
+	this->textureIdCount = 0;
+	this->textureIdIndex = -1;
+	this->isDistantAmbientLit = false;
+}
+
+void RenderSkyManager::SkyObjectDrawCallState::init(int skyObjectIndex, double distance, int textureIdStartIndex,
+	int textureIdCount, bool isDistantAmbientLit)
+{
+	this->skyObjectIndex = skyObjectIndex;
+	this->distance = distance;
+	this->textureIdStartIndex = textureIdStartIndex;
+	this->textureIdCount = textureIdCount;
+	this->textureIdIndex = -1;
+	this->isDistantAmbientLit = isDistantAmbientLit;
+	this->direction = Double3::Zero;
 }
 
 RenderSkyManager::RenderSkyManager()
@@ -41,6 +58,9 @@ RenderSkyManager::RenderSkyManager()
 	this->objectNormalBufferID = -1;
 	this->objectTexCoordBufferID = -1;
 	this->objectIndexBufferID = -1;
+	this->lightningDrawCallStartIndex = 0;
+	this->visibleObjectDrawCallCount = 0;
+	this->skyPointsVisible = false;
 }
 
 void RenderSkyManager::init(const ExeData &exeData, TextureManager &textureManager, Renderer &renderer)
@@ -351,6 +371,13 @@ void RenderSkyManager::shutdown(Renderer &renderer)
 
 	this->freeObjectBuffers(renderer);
 	this->objectDrawCalls.clear();
+	this->objectDrawCallStates.clear();
+	this->skyObjectTextureIDs.clear();
+	this->lightningDrawCallStartIndex = 0;
+	this->visibleObjectDrawCallCount = 0;
+	this->skyPoints.clear();
+	this->skyPointSkyObjectIndices.clear();
+	this->skyPointsVisible = false;
 }
 
 ObjectTextureID RenderSkyManager::getGeneralSkyObjectTextureID(const TextureAsset &textureAsset) const
@@ -370,23 +397,6 @@ ObjectTextureID RenderSkyManager::getGeneralSkyObjectTextureID(const TextureAsse
 	return iter->objectTextureRef.get();
 }
 
-ObjectTextureID RenderSkyManager::getSmallStarTextureID(uint8_t paletteIndex) const
-{
-	const auto iter = std::find_if(this->smallStarTextures.begin(), this->smallStarTextures.end(),
-		[paletteIndex](const LoadedSmallStarTextureEntry &loadedTexture)
-	{
-		return loadedTexture.paletteIndex == paletteIndex;
-	});
-
-	if (iter == this->smallStarTextures.end())
-	{
-		DebugLogError("Couldn't find loaded small star texture with palette index \"" + std::to_string(paletteIndex) + "\".");
-		return -1;
-	}
-
-	return iter->objectTextureRef.get();
-}
-
 void RenderSkyManager::freeBgBuffers(Renderer &renderer)
 {
 	if (this->bgVertexBufferID >= 0)
@@ -441,7 +451,6 @@ void RenderSkyManager::freeObjectBuffers(Renderer &renderer)
 	}
 
 	this->generalSkyObjectTextures.clear();
-	this->smallStarTextures.clear();
 }
 
 const RenderDrawCall &RenderSkyManager::getBgDrawCall() const
@@ -451,10 +460,82 @@ const RenderDrawCall &RenderSkyManager::getBgDrawCall() const
 
 BufferView<const RenderDrawCall> RenderSkyManager::getObjectDrawCalls() const
 {
-	return this->objectDrawCalls;
+	return BufferView<const RenderDrawCall>(this->objectDrawCalls.data(), this->visibleObjectDrawCallCount);
+}
+
+BufferView<const RenderSkyPoint> RenderSkyManager::getSkyPoints() const
+{
+	if (!this->skyPointsVisible)
+	{
+		return BufferView<const RenderSkyPoint>();
+	}
+
+	return this->skyPoints;
 }
 
-void RenderSkyManager::loadScene(const SkyInfoDefinition &skyInfoDef, TextureManager &textureManager, Renderer &renderer)
+void RenderSkyManager::addObjectDrawCall(const SkyInstance &skyInst, int skyObjectIndex, double distance,
+	bool isAnimated, bool isDistantAmbientLit, PixelShaderType pixelShaderType)
+{
+	const SkyObjectInstance &skyObjectInst = skyInst.getSkyObjectInst(skyObjectIndex);
+	DebugAssert(skyObjectInst.textureType == SkyObjectTextureType::TextureAsset);
+
+	// Resolve texture IDs for every animation frame now so updates only need to index into them.
+	const SkyObjectTextureAssetEntry &textureAssetEntry = skyInst.getTextureAssetEntry(skyObjectInst.textureAssetEntryID);
+	const BufferView<const TextureAsset> textureAssets = textureAssetEntry.textureAssets;
+	const int textureIdStartIndex = static_cast<int>(this->skyObjectTextureIDs.size());
+	const int textureIdCount = isAnimated ? textureAssets.getCount() : 1;
+	for (int i = 0; i < textureIdCount; i++)
+	{
+		const TextureAsset &textureAsset = textureAssets.get(i);
+		this->skyObjectTextureIDs.emplace_back(this->getGeneralSkyObjectTextureID(textureAsset));
+	}
+
+	SkyObjectDrawCallState state;
+	state.init(skyObjectIndex, distance, textureIdStartIndex, textureIdCount, isDistantAmbientLit);
+
+	RenderDrawCall drawCall;
+	drawCall.position = Double3::Zero;
+	drawCall.preScaleTranslation = Double3::Zero;
+	drawCall.rotation = Matrix4d::identity();
+	drawCall.scale = Matrix4d::identity();
+	drawCall.vertexBufferID = this->objectVertexBufferID;
+	drawCall.normalBufferID = this->objectNormalBufferID;
+	drawCall.texCoordBufferID = this->objectTexCoordBufferID;
+	drawCall.indexBufferID = this->objectIndexBufferID;
+	drawCall.textureIDs[0] = this->skyObjectTextureIDs[textureIdStartIndex];
+	drawCall.textureIDs[1] = std::nullopt;
+	drawCall.textureSamplingType0 = TextureSamplingType::Default;
+	drawCall.textureSamplingType1 = TextureSamplingType::Default;
+	drawCall.lightingType = RenderLightingType::PerMesh;
+	drawCall.lightPercent = 1.0;
+	drawCall.lightIdCount = 0;
+	drawCall.vertexShaderType = VertexShaderType::SlidingDoor; // @todo: make a sky object vertex shader
+	drawCall.pixelShaderType = pixelShaderType;
+	drawCall.pixelShaderParam0 = 0.0;
+
+	this->objectDrawCalls.emplace_back(std::move(drawCall));
+	this->objectDrawCallStates.emplace_back(std::move(state));
+}
+
+void RenderSkyManager::updateObjectDrawCallTransform(RenderDrawCall &drawCall, SkyObjectDrawCallState &state,
+	const SkyObjectInstance &skyObjectInst)
+{
+	const Double3 &direction = skyObjectInst.transformedDirection;
+	const Radians pitchRadians = direction.getYAngleRadians();
+	const Radians yawRadians = MathUtils::fullAtan2(Double2(direction.z, direction.x).normalized()) + Constants::Pi;
+	const Matrix4d pitchRotation = Matrix4d::zRotation(pitchRadians);
+	const Matrix4d yawRotation = Matrix4d::yRotation(yawRadians);
+	drawCall.rotation = yawRotation * pitchRotation;
+
+	const double scaledWidth = skyObjectInst.width * state.distance;
+	const double scaledHeight = skyObjectInst.height * state.distance;
+	drawCall.scale = Matrix4d::scale(1.0, scaledHeight, scaledWidth);
+
+	state.direction = direction;
+}
+
+void RenderSkyManager::loadScene(const SkyInstance &skyInst, const SkyInfoDefinition &skyInfoDef, TextureManager &textureManager,
+	Renderer &renderer)
 {
 	auto tryLoadTextureAsset = [this, &textureManager, &renderer](const TextureAsset &textureAsset)
 	{
@@ -487,44 +568,6 @@ void RenderSkyManager::loadScene(const SkyInfoDefinition &skyInfoDef, TextureMan
 		}
 	};
 
-	auto tryLoadPaletteColor = [this, &renderer](uint8_t paletteIndex)
-	{
-		const auto iter = std::find_if(this->smallStarTextures.begin(), this->smallStarTextures.end(),
-			[paletteIndex](const LoadedSmallStarTextureEntry &loadedTexture)
-		{
-			return loadedTexture.paletteIndex == paletteIndex;
-		});
-
-		if (iter == this->smallStarTextures.end())
-		{
-			constexpr int textureWidth = 1;
-			constexpr int textureHeight = textureWidth;
-			constexpr int bytesPerTexel = 1;
-			ObjectTextureID textureID;
-			if (!renderer.tryCreateObjectTexture(textureWidth, textureHeight, bytesPerTexel, &textureID))
-			{
-				DebugLogError("Couldn't create object texture for sky object texture palette index \"" + std::to_string(paletteIndex) + "\".");
-				return;
-			}
-
-			LockedTexture lockedTexture = renderer.lockObjectTexture(textureID);
-			if (!lockedTexture.isValid())
-			{
-				DebugLogError("Couldn't lock sky object texture for writing palette index \"" + std::to_string(paletteIndex) + "\".");
-				return;
-			}
-
-			DebugAssert(lockedTexture.bytesPerTexel == 1);
-			uint8_t *dstTexels = static_cast<uint8_t*>(lockedTexture.texels);
-			*dstTexels = paletteIndex;
-			renderer.unlockObjectTexture(textureID);
-
-			LoadedSmallStarTextureEntry loadedEntry;
-			loadedEntry.init(paletteIndex, ScopedObjectTextureRef(textureID, renderer));
-			this->smallStarTextures.emplace_back(std::move(loadedEntry));
-		}		
-	};
-
 	for (int i = 0; i < skyInfoDef.getLandCount(); i++)
 	{
 		const SkyLandDefinition &landDef = skyInfoDef.getLand(i);
@@ -546,11 +589,8 @@ void RenderSkyManager::loadScene(const SkyInfoDefinition &skyInfoDef, TextureMan
 		switch (starDef.type)
 		{
 		case SkyStarType::Small:
-		{
-			const SkySmallStarDefinition &smallStarDef = starDef.smallStar;
-			tryLoadPaletteColor(smallStarDef.paletteIndex);
+			// Drawn as sky points; no texture needed.
 			break;
-		}
 		case SkyStarType::Large:
 		{
 			const SkyLargeStarDefinition &largeStarDef = starDef.largeStar;
@@ -587,7 +627,67 @@ void RenderSkyManager::loadScene(const SkyInfoDefinition &skyInfoDef, TextureMan
 		}
 	}
 
-	// @todo: load draw calls for all the sky objects (ideally here, but can be in update() for now if convenient)
+	// @temp fix for Z ordering. Later I think we should just not do depth testing in the sky?
+	constexpr double landDistance = 500.0;
+	constexpr double airDistance = landDistance + 400.0;
+	constexpr double moonDistance = airDistance + 400.0;
+	constexpr double sunDistance = moonDistance + 400.0;
+	constexpr double starDistance = RendererUtils::SKY_STAR_DISTANCE; // Shared with small stars drawn as sky points.
+	static_assert(starDistance > sunDistance);
+
+	// Create persistent draw calls for all sky objects, ordered back to front. Small stars become sky points.
+	for (int i = skyInst.starEnd - 1; i >= skyInst.starStart; i--)
+	{
+		const SkyObjectInstance &skyObjectInst = skyInst.getSkyObjectInst(i);
+		const SkyObjectTextureType textureType = skyObjectInst.textureType;
+		if (textureType == SkyObjectTextureType::TextureAsset)
+		{
+			this->addObjectDrawCall(skyInst, i, starDistance, false, false, PixelShaderType::AlphaTestedWithPreviousBrightnessLimit);
+		}
+		else if (textureType == SkyObjectTextureType::PaletteIndex)
+		{
+			const SkyObjectPaletteIndexEntry &paletteIndexEntry = skyInst.getPaletteIndexEntry(skyObjectInst.paletteIndexEntryID);
+
+			RenderSkyPoint skyPoint;
+			skyPoint.init(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, paletteIndexEntry.paletteIndex);
+			this->skyPoints.emplace_back(std::move(skyPoint));
+			this->skyPointSkyObjectIndices.emplace_back(i);
+		}
+		else
+		{
+			DebugNotImplementedMsg(std::to_string(static_cast<int>(textureType)));
+		}
+	}
+
+	for (int i = skyInst.sunStart; i < skyInst.sunEnd; i++)
+	{
+		this->addObjectDrawCall(skyInst, i, sunDistance, false, false, PixelShaderType::AlphaTested);
+	}
+
+	for (int i = skyInst.moonStart; i < skyInst.moonEnd; i++)
+	{
+		this->addObjectDrawCall(skyInst, i, moonDistance, false, false, PixelShaderType::AlphaTestedWithLightLevelColor);
+	}
+
+	for (int i = skyInst.airStart; i < skyInst.airEnd; i++)
+	{
+		this->addObjectDrawCall(skyInst, i, airDistance, false, true, PixelShaderType::AlphaTestedWithLightLevelColor);
+	}
+
+	for (int i = skyInst.landStart; i < skyInst.landEnd; i++)
+	{
+		const SkyObjectInstance &skyObjectInst = skyInst.getSkyObjectInst(i);
+		this->addObjectDrawCall(skyInst, i, landDistance, true, !skyObjectInst.emissive, PixelShaderType::AlphaTested);
+	}
+
+	this->lightningDrawCallStartIndex = static_cast<int>(this->objectDrawCalls.size());
+	for (int i = skyInst.lightningStart; i < skyInst.lightningEnd; i++)
+	{
+		this->addObjectDrawCall(skyInst, i, landDistance, true, false, PixelShaderType::AlphaTested);
+	}
+
+	this->visibleObjectDrawCallCount = 0;
+	this->skyPointsVisible = false;
 }
 
 void RenderSkyManager::update(const SkyInstance &skyInst, const WeatherInstance &weatherInst,
@@ -635,192 +735,84 @@ void RenderSkyManager::update(const SkyInstance &skyInst, const WeatherInstance
 		this->bgDrawCall.textureIDs[0] = this->skyGradientPMTextureRef.get();
 	}
 
-	// @temp fix for Z ordering. Later I think we should just not do depth testing in the sky?
-	constexpr double landDistance = 500.0;
-	constexpr double airDistance = landDistance + 400.0;
-	constexpr double moonDistance = airDistance + 400.0;
-	constexpr double sunDistance = moonDistance + 400.0;
-	constexpr double starDistance = sunDistance + 400.0;
-
-	constexpr double fullBrightLightPercent = 1.0;
-
-	auto addDrawCall = [this, &renderer, &cameraPos](const Double3 &direction, double width, double height, ObjectTextureID textureID,
-		double arbitraryDistance, double meshLightPercent, PixelShaderType pixelShaderType)
-	{
-		RenderDrawCall drawCall;
-		drawCall.position = cameraPos + (direction * arbitraryDistance);
-		drawCall.preScaleTranslation = Double3::Zero;
-		
-		const Radians pitchRadians = direction.getYAngleRadians();
-		const Radians yawRadians = MathUtils::fullAtan2(Double2(direction.z, direction.x).normalized()) + Constants::Pi;
-		const Matrix4d pitchRotation = Matrix4d::zRotation(pitchRadians);
-		const Matrix4d yawRotation = Matrix4d::yRotation(yawRadians);
-		drawCall.rotation = yawRotation * pitchRotation;
-
-		const double scaledWidth = width * arbitraryDistance;
-		const double scaledHeight = height * arbitraryDistance;
-		drawCall.scale = Matrix4d::scale(1.0, scaledHeight, scaledWidth);
-
-		drawCall.vertexBufferID = this->objectVertexBufferID;
-		drawCall.normalBufferID = this->objectNormalBufferID;
-		drawCall.texCoordBufferID = this->objectTexCoordBufferID;
-		drawCall.indexBufferID = this->objectIndexBufferID;
-		drawCall.textureIDs[0] = textureID;
-		drawCall.textureIDs[1] = std::nullopt;
-		drawCall.textureSamplingType0 = TextureSamplingType::Default;
-		drawCall.textureSamplingType1 = TextureSamplingType::Default;
-		drawCall.lightingType = RenderLightingType::PerMesh;
-		drawCall.lightPercent = meshLightPercent;
-		drawCall.lightIdCount = 0;
-		drawCall.vertexShaderType = VertexShaderType::SlidingDoor; // @todo: make a sky object vertex shader
-		drawCall.pixelShaderType = pixelShaderType;
-		drawCall.pixelShaderParam0 = 0.0;
-		this->objectDrawCalls.emplace_back(std::move(drawCall));
-	};
-
-	// @todo: create draw calls in loadScene() as an optimization
-	// @todo: update sky object draw call transforms if they are affected by planet rotation
-
-	this->objectDrawCalls.clear(); // @todo: don't clear every frame, just change their transforms/animation texture ID
-
 	// No sky objects during fog.
 	if (isFoggy)
 	{
+		this->visibleObjectDrawCallCount = 0;
+		this->skyPointsVisible = false;
 		return;
 	}
 
-	// Order draw calls back to front.
-	for (int i = skyInst.starEnd - 1; i >= skyInst.starStart; i--)
+	// Small stars only need their direction kept in sync with planet rotation.
+	for (int i = 0; i < static_cast<int>(this->skyPoints.size()); i++)
 	{
-		const SkyObjectInstance &skyObjectInst = skyInst.getSkyObjectInst(i);
-		const SkyObjectTextureType textureType = skyObjectInst.textureType;
-
-		ObjectTextureID textureID = -1;
-		if (textureType == SkyObjectTextureType::TextureAsset)
-		{
-			const SkyObjectTextureAssetEntry &textureAssetEntry = skyInst.getTextureAssetEntry(skyObjectInst.textureAssetEntryID);
-			const TextureAsset &textureAsset = textureAssetEntry.textureAssets.get(0);
-			textureID = this->getGeneralSkyObjectTextureID(textureAsset);
-		}
-		else if (textureType == SkyObjectTextureType::PaletteIndex)
-		{
-			const SkyObjectPaletteIndexEntry &paletteIndexEntry = skyInst.getPaletteIndexEntry(skyObjectInst.paletteIndexEntryID);
-			const uint8_t paletteIndex = paletteIndexEntry.paletteIndex;
-			textureID = this->getSmallStarTextureID(paletteIndex);
-		}
-		else
-		{
-			DebugNotImplementedMsg(std::to_string(static_cast<int>(textureType)));
-		}
-
-		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, starDistance,
-			fullBrightLightPercent, PixelShaderType::AlphaTestedWithPreviousBrightnessLimit);
+		const SkyObjectInstance &skyObjectInst = skyInst.getSkyObjectInst(this->skyPointSkyObjectIndices[i]);
+		this->skyPoints[i].direction = skyObjectInst.transformedDirection;
 	}
 
-	for (int i = skyInst.sunStart; i < skyInst.sunEnd; i++)
-	{
-		const SkyObjectInstance &skyObjectInst = skyInst.getSkyObjectInst(i);
-		const SkyObjectTextureType textureType = skyObjectInst.textureType;
-		DebugAssertMsg(textureType == SkyObjectTextureType::TextureAsset, "Expected all sky sun objects to use TextureAsset texture type.");
-
-		const SkyObjectTextureAssetEntry &textureAssetEntry = skyInst.getTextureAssetEntry(skyObjectInst.textureAssetEntryID);
-		const TextureAsset &textureAsset = textureAssetEntry.textureAssets.get(0);
-		const ObjectTextureID textureID = this->getGeneralSkyObjectTextureID(textureAsset);
+	this->skyPointsVisible = true;
 
-		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, sunDistance,
-			fullBrightLightPercent, PixelShaderType::AlphaTested);
-	}
-
-	for (int i = skyInst.moonStart; i < skyInst.moonEnd; i++)
+	// Keep visible lightning bolts at the front of the lightning range so the visible draw calls are contiguous.
+	const int drawCallCount = static_cast<int>(this->objectDrawCalls.size());
+	int visibleDrawCallCount = this->lightningDrawCallStartIndex;
+	for (int i = this->lightningDrawCallStartIndex; i < drawCallCount; i++)
 	{
-		const SkyObjectInstance &skyObjectInst = skyInst.getSkyObjectInst(i);
-		const SkyObjectTextureType textureType = skyObjectInst.textureType;
-		DebugAssertMsg(textureType == SkyObjectTextureType::TextureAsset, "Expected all sky moon objects to use TextureAsset texture type.");
-
-		const SkyObjectTextureAssetEntry &textureAssetEntry = skyInst.getTextureAssetEntry(skyObjectInst.textureAssetEntryID);
-		const TextureAsset &textureAsset = textureAssetEntry.textureAssets.get(0);
-		const ObjectTextureID textureID = this->getGeneralSkyObjectTextureID(textureAsset);
+		if (skyInst.isLightningVisible(this->objectDrawCallStates[i].skyObjectIndex))
+		{
+			if (i != visibleDrawCallCount)
+			{
+				std::swap(this->objectDrawCalls[i], this->objectDrawCalls[visibleDrawCallCount]);
+				std::swap(this->objectDrawCallStates[i], this->objectDrawCallStates[visibleDrawCallCount]);
+			}
 
-		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, moonDistance,
-			fullBrightLightPercent, PixelShaderType::AlphaTestedWithLightLevelColor);
+			visibleDrawCallCount++;
+		}
 	}
 
-	for (int i = skyInst.airStart; i < skyInst.airEnd; i++)
-	{
-		const SkyObjectInstance &skyObjectInst = skyInst.getSkyObjectInst(i);
-		const SkyObjectTextureType textureType = skyObjectInst.textureType;
-		DebugAssertMsg(textureType == SkyObjectTextureType::TextureAsset, "Expected all sky air objects to use TextureAsset texture type.");
-
-		const SkyObjectTextureAssetEntry &textureAssetEntry = skyInst.getTextureAssetEntry(skyObjectInst.textureAssetEntryID);
-		const TextureAsset &textureAsset = textureAssetEntry.textureAssets.get(0);
-		const ObjectTextureID textureID = this->getGeneralSkyObjectTextureID(textureAsset);
+	this->visibleObjectDrawCallCount = visibleDrawCallCount;
 
-		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, airDistance,
-			distantAmbientPercent, PixelShaderType::AlphaTestedWithLightLevelColor);
-	}
-
-	for (int i = skyInst.landStart; i < skyInst.landEnd; i++)
+	for (int i = 0; i < visibleDrawCallCount; i++)
 	{
-		const SkyObjectInstance &skyObjectInst = skyInst.getSkyObjectInst(i);
-		const SkyObjectTextureType textureType = skyObjectInst.textureType;
-		DebugAssertMsg(textureType == SkyObjectTextureType::TextureAsset, "Expected all sky land objects to use TextureAsset texture type.");
+		RenderDrawCall &drawCall = this->objectDrawCalls[i];
+		SkyObjectDrawCallState &state = this->objectDrawCallStates[i];
+		const SkyObjectInstance &skyObjectInst = skyInst.getSkyObjectInst(state.skyObjectIndex);
+		drawCall.position = cameraPos + (skyObjectInst.transformedDirection * state.distance);
 
-		const SkyObjectTextureAssetEntry &textureAssetEntry = skyInst.getTextureAssetEntry(skyObjectInst.textureAssetEntryID);
-		const BufferView<const TextureAsset> textureAssets = textureAssetEntry.textureAssets;
-		const int textureCount = textureAssets.getCount();
+		if (skyObjectInst.transformedDirection != state.direction)
+		{
+			this->updateObjectDrawCallTransform(drawCall, state, skyObjectInst);
+		}
 
-		int textureAssetIndex = 0;
+		int textureIdIndex = 0;
 		const int animIndex = skyObjectInst.animIndex;
-		const bool hasAnimation = animIndex >= 0;
-		if (hasAnimation)
+		if ((animIndex >= 0) && (state.textureIdCount > 1))
 		{
 			const SkyObjectAnimationInstance &animInst = skyInst.getAnimInst(animIndex);
-			const double animPercent = animInst.percentDone;
-			textureAssetIndex = std::clamp(static_cast<int>(static_cast<double>(textureCount) * animPercent), 0, textureCount - 1);
+			textureIdIndex = std::clamp(static_cast<int>(static_cast<double>(state.textureIdCount) * animInst.percentDone), 0, state.textureIdCount - 1);
 		}
 
-		const TextureAsset &textureAsset = textureAssets.get(textureAssetIndex);
-		const ObjectTextureID textureID = this->getGeneralSkyObjectTextureID(textureAsset);
-		const double meshLightPercent = skyObjectInst.emissive ? fullBrightLightPercent : distantAmbientPercent;
-		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, landDistance,
-			meshLightPercent, PixelShaderType::AlphaTested);
-	}
-
-	for (int i = skyInst.lightningStart; i < skyInst.lightningEnd; i++)
-	{
-		if (!skyInst.isLightningVisible(i))
+		if (textureIdIndex != state.textureIdIndex)
 		{
-			continue;
+			drawCall.textureIDs[0] = this->skyObjectTextureIDs[state.textureIdStartIndex + textureIdIndex];
+			state.textureIdIndex = textureIdIndex;
 		}
 
-		const SkyObjectInstance &skyObjectInst = skyInst.getSkyObjectInst(i);
-		const SkyObjectTextureType textureType = skyObjectInst.textureType;
-		DebugAssertMsg(textureType == SkyObjectTextureType::TextureAsset, "Expected all sky lightning objects to use TextureAsset texture type.");
-
-		const SkyObjectTextureAssetEntry &textureAssetEntry = skyInst.getTextureAssetEntry(skyObjectInst.textureAssetEntryID);
-		const BufferView<const TextureAsset> textureAssets = textureAssetEntry.textureAssets;
-		const int textureCount = textureAssets.getCount();
-
-		int textureAssetIndex = 0;
-		const int animIndex = skyObjectInst.animIndex;
-		double meshLightPercent = fullBrightLightPercent;
-		const bool hasAnimation = animIndex >= 0;
-		DebugAssert(hasAnimation);
-
-		const SkyObjectAnimationInstance &animInst = skyInst.getAnimInst(animIndex);
-		const double animPercent = animInst.percentDone;
-		textureAssetIndex = std::clamp(static_cast<int>(static_cast<double>(textureCount) * animPercent), 0, textureCount - 1);
-
-		const TextureAsset &textureAsset = textureAssets.get(textureAssetIndex);
-		const ObjectTextureID textureID = this->getGeneralSkyObjectTextureID(textureAsset);
-		addDrawCall(skyObjectInst.transformedDirection, skyObjectInst.width, skyObjectInst.height, textureID, landDistance,
-			meshLightPercent, PixelShaderType::AlphaTested);
+		if (state.isDistantAmbientLit)
+		{
+			drawCall.lightPercent = distantAmbientPercent;
+		}
 	}
 }
 
 void RenderSkyManager::unloadScene(Renderer &renderer)
 {
 	this->generalSkyObjectTextures.clear();
-	this->smallStarTextures.clear();
 	this->objectDrawCalls.clear();
+	this->objectDrawCallStates.clear();
+	this->skyObjectTextureIDs.clear();
+	this->lightningDrawCallStartIndex = 0;
+	this->visibleObjectDrawCallCount = 0;
+	this->skyPoints.clear();
+	this->skyPointSkyObjectIndices.clear();
+	this->skyPointsVisible = false;
 }
@@ -1,8 +1,11 @@
 #ifndef RENDER_SKY_MANAGER_H
 #define RENDER_SKY_MANAGER_H
 
+#include <vector>
+
 #include "RenderDrawCall.h"
 #include "RenderGeometryUtils.h"
+#include "RenderSkyPoint.h"
 #include "RenderTextureUtils.h"
 #include "../Assets/TextureAsset.h"
 
@@ -13,6 +16,8 @@ class SkyInstance;
 class TextureManager;
 class WeatherInstance;
 
+struct SkyObjectInstance;
+
 enum class WeatherType;
 
 class RenderSkyManager
@@ -26,12 +31,20 @@ private:
 		void init(const TextureAsset &textureAsset, ScopedObjectTextureRef &&objectTextureRef);
 	};
 
-	struct LoadedSmallStarTextureEntry
+	// Ties a sky object instance to its persistent draw call so the draw call is only touched when the
+	// object's transform or animation frame changes.
+	struct SkyObjectDrawCallState
 	{
-		uint8_t paletteIndex;
-		ScopedObjectTextureRef objectTextureRef;
+		int skyObjectIndex;
+		double distance; // Arbitrary distance from the camera for Z ordering.
+		int textureIdStartIndex, textureIdCount; // Range in skyObjectTextureIDs, one per animation frame or one if not animated.
+		int textureIdIndex; // Currently selected animation frame.
+		bool isDistantAmbientLit; // Whether the draw call's light percent follows the distant ambient light.
+		Double3 direction; // Direction the draw call's rotation and scale were last calculated from.
+
+		SkyObjectDrawCallState();
 
-		void init(uint8_t paletteIndex, ScopedObjectTextureRef &&objectTextureRef);
+		void init(int skyObjectIndex, double distance, int textureIdStartIndex, int textureIdCount, bool isDistantAmbientLit);
 	};
 
 	// All the possible sky color textures to choose from, dependent on the active weather. These are used by
@@ -54,11 +67,26 @@ private:
 	AttributeBufferID objectTexCoordBufferID;
 	IndexBufferID objectIndexBufferID;
 	std::vector<LoadedGeneralSkyObjectTextureEntry> generalSkyObjectTextures;
-	std::vector<LoadedSmallStarTextureEntry> smallStarTextures;
-	std::vector<RenderDrawCall> objectDrawCalls; // Order matters: stars, sun, planets, clouds, mountains.
+
+	// Persistent sky object draw calls created on scene load. Order matters: large stars, sun, planets, clouds,
+	// mountains, then lightning bolts (visible bolts are kept at the front of the lightning range).
+	std::vector<RenderDrawCall> objectDrawCalls;
+	std::vector<SkyObjectDrawCallState> objectDrawCallStates; // One per draw call.
+	std::vector<ObjectTextureID> skyObjectTextureIDs; // Resolved texture IDs for each animation frame of each sky object.
+	int lightningDrawCallStartIndex;
+	int visibleObjectDrawCallCount;
+
+	// Small stars are drawn by the renderer as point sprites instead of as draw calls.
+	std::vector<RenderSkyPoint> skyPoints;
+	std::vector<int> skyPointSkyObjectIndices; // One per sky point.
+	bool skyPointsVisible;
 
 	ObjectTextureID getGeneralSkyObjectTextureID(const TextureAsset &textureAsset) const;
-	ObjectTextureID getSmallStarTextureID(uint8_t paletteIndex) const;
+
+	// Only land and lightning objects cycle through their textures; the rest always use their first texture.
+	void addObjectDrawCall(const SkyInstance &skyInst, int skyObjectIndex, double distance, bool isAnimated,
+		bool isDistantAmbientLit, PixelShaderType pixelShaderType);
+	void updateObjectDrawCallTransform(RenderDrawCall &drawCall, SkyObjectDrawCallState &state, const SkyObjectInstance &skyObjectInst);
 
 	void freeBgBuffers(Renderer &renderer);
 	void freeObjectBuffers(Renderer &renderer);
@@ -70,8 +98,9 @@ public:
 
 	const RenderDrawCall &getBgDrawCall() const;
 	BufferView<const RenderDrawCall> getObjectDrawCalls() const;
+	BufferView<const RenderSkyPoint> getSkyPoints() const;
 
-	void loadScene(const SkyInfoDefinition &skyInfoDef, TextureManager &textureManager, Renderer &renderer);
+	void loadScene(const SkyInstance &skyInst, const SkyInfoDefinition &skyInfoDef, TextureManager &textureManager, Renderer &renderer);
 	void update(const SkyInstance &skyInst, const WeatherInstance &weatherInst, const CoordDouble3 &cameraCoord, bool isInterior,
 		double daytimePercent, bool isFoggy, double distantAmbientPercent, Renderer &renderer);
 	void unloadScene(Renderer &renderer);
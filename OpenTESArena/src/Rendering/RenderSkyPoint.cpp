@@ -0,0 +1,16 @@
+#include "RenderSkyPoint.h"
+
+RenderSkyPoint::RenderSkyPoint()
+{
+	this->width = 0.0;
+	this->height = 0.0;
+	this->paletteIndex = 0;
+}
+
+void RenderSkyPoint::init(const Double3 &direction, double width, double height, uint8_t paletteIndex)
+{
+	this->direction = direction;
+	this->width = width;
+	this->height = height;
+	this->paletteIndex = paletteIndex;
+}
@@ -0,0 +1,21 @@
+#ifndef RENDER_SKY_POINT_H
+#define RENDER_SKY_POINT_H
+
+#include <cstdint>
+
+#include "../Math/Vector3.h"
+
+// A distant point of light in the sky (i.e. a small star). These are drawn by the renderer as projected point
+// sprites behind all geometry instead of going through the triangle pipeline as full draw calls.
+struct RenderSkyPoint
+{
+	Double3 direction; // Normalized direction from the camera, independent of camera position.
+	double width, height; // Size in the sky relative to the point's distance.
+	uint8_t paletteIndex;
+
+	RenderSkyPoint();
+
+	void init(const Double3 &direction, double width, double height, uint8_t paletteIndex);
+};
+
+#endif
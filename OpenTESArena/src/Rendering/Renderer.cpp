@@ -109,12 +109,16 @@ Renderer::ProfilerData::ProfilerData()
 	this->visTriangleCount = -1;
 	this->objectTextureCount = -1;
 	this->objectTextureByteCount = -1;
+	this->geometrySlabCount = -1;
+	this->geometryByteCount = -1;
+	this->geometryReservedByteCount = -1;
 	this->totalLightCount = -1;
 	this->frameTime = 0.0;
 }
 
 void Renderer::ProfilerData::init(int width, int height, int threadCount, int drawCallCount, int sceneTriangleCount,
-	int visTriangleCount, int objectTextureCount, int64_t objectTextureByteCount, int totalLightCount, double frameTime)
+	int visTriangleCount, int objectTextureCount, int64_t objectTextureByteCount, int geometrySlabCount, int64_t geometryByteCount,
+	int64_t geometryReservedByteCount, int totalLightCount, double frameTime)
 {
 	this->width = width;
 	this->height = height;
@@ -124,10 +128,19 @@ void Renderer::ProfilerData::init(int width, int height, int threadCount, int dr
 	this->visTriangleCount = visTriangleCount;
 	this->objectTextureCount = objectTextureCount;
 	this->objectTextureByteCount = objectTextureByteCount;
+	this->geometrySlabCount = geometrySlabCount;
+	this->geometryByteCount = geometryByteCount;
+	this->geometryReservedByteCount = geometryReservedByteCount;
 	this->totalLightCount = totalLightCount;
 	this->frameTime = frameTime;
 }
 
+Renderer::PipelinedFrame::PipelinedFrame()
+{
+	this->outputBuffer = nullptr;
+	this->frameTime = 0.0;
+}
+
 Renderer::Renderer()
 {
 	DebugAssert(this->nativeTexture.get() == nullptr);
@@ -136,12 +149,33 @@ Renderer::Renderer()
 	this->renderer = nullptr;
 	this->letterboxMode = 0;
 	this->fullGameWindow = false;
+	this->renderTargetsResetCount = 0;
+	this->renderDeviceResetCount = 0;
+	this->dynamicResolutionEnabled = false;
+	this->dynamicResolutionMinScale = 1.0;
+	this->dynamicResolutionTargetFrameTime = 0.0;
+	this->pipelineFrameQueued = false;
+	this->pipelineStopRequested = false;
+	this->pipelineFrameInFlight = false;
+	this->hasPipelinedFrameImage = false;
 }
 
 Renderer::~Renderer()
 {
 	DebugLog("Closing.");
 
+	this->waitForPipelinedFrame();
+	if (this->pipelineThread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->pipelineMutex);
+			this->pipelineStopRequested = true;
+		}
+
+		this->pipelineCondition.notify_all();
+		this->pipelineThread.join();
+	}
+
 	if (this->renderer2D)
 	{
 		this->renderer2D->shutdown();
@@ -160,6 +194,121 @@ Renderer::~Renderer()
 	SDL_Quit();
 }
 
+void Renderer::runPipelineThread()
+{
+	while (true)
+	{
+		std::unique_lock<std::mutex> lock(this->pipelineMutex);
+		this->pipelineCondition.wait(lock, [this]()
+		{
+			return this->pipelineFrameQueued || this->pipelineStopRequested;
+		});
+
+		if (this->pipelineStopRequested)
+		{
+			return;
+		}
+
+		lock.unlock();
+
+		// The main thread doesn't touch the snapshot or 3D renderer state until the frame is marked done.
+		PipelinedFrame &frame = this->pipelinedFrame;
+		const auto startTime = std::chrono::high_resolution_clock::now();
+		this->renderer3D->submitFrame(frame.camera, frame.drawCalls, frame.skyPoints, frame.frameSettings, frame.outputBuffer);
+		const auto endTime = std::chrono::high_resolution_clock::now();
+		frame.frameTime = static_cast<double>((endTime - startTime).count()) / static_cast<double>(std::nano::den);
+
+		lock.lock();
+		this->pipelineFrameQueued = false;
+		lock.unlock();
+		this->pipelineCondition.notify_all();
+	}
+}
+
+void Renderer::waitForPipelinedFrame()
+{
+	if (!this->pipelineFrameInFlight)
+	{
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(this->pipelineMutex);
+		this->pipelineCondition.wait(lock, [this]()
+		{
+			return !this->pipelineFrameQueued;
+		});
+	}
+
+	this->pipelineFrameInFlight = false;
+
+	const PipelinedFrame &frame = this->pipelinedFrame;
+	this->updateProfilerData(frame.frameTime);
+	this->updateDynamicResolution(frame.frameTime);
+
+	this->uploadGameWorldImage(frame.frameSettings.renderWidth, frame.frameSettings.renderHeight);
+	this->hasPipelinedFrameImage = true;
+}
+
+void Renderer::updateProfilerData(double frameTime)
+{
+	const RendererSystem3D::ProfilerData swProfilerData = this->renderer3D->getProfilerData();
+	this->profilerData.init(swProfilerData.width, swProfilerData.height, swProfilerData.threadCount,
+		swProfilerData.drawCallCount, swProfilerData.sceneTriangleCount, swProfilerData.visTriangleCount,
+		swProfilerData.textureCount, swProfilerData.textureByteCount, swProfilerData.geometrySlabCount,
+		swProfilerData.geometryByteCount, swProfilerData.geometryReservedByteCount, swProfilerData.totalLightCount, frameTime);
+}
+
+void Renderer::updateDynamicResolution(double frameTime)
+{
+	if (!this->dynamicResolutionEnabled)
+	{
+		return;
+	}
+
+	const double maxScale = this->resolutionScaleFunc();
+	const double minScale = std::min(this->dynamicResolutionMinScale, maxScale);
+	this->dynamicResolution.update(frameTime, this->dynamicResolutionTargetFrameTime, minScale, maxScale);
+}
+
+void Renderer::uploadGameWorldImage(int width, int height)
+{
+	DebugAssert(width <= this->gameWorldTexture.getWidth());
+	DebugAssert(height <= this->gameWorldTexture.getHeight());
+
+	SDL_Rect rect;
+	rect.x = 0;
+	rect.y = 0;
+	rect.w = width;
+	rect.h = height;
+
+	const int pitch = width * static_cast<int>(sizeof(uint32_t));
+	const int status = SDL_UpdateTexture(this->gameWorldTexture.get(), &rect, this->gameWorldPixels.begin(), pitch);
+	DebugAssertMsg(status == 0, "Couldn't update game world texture (" + std::string(SDL_GetError()) + ").");
+
+	this->gameWorldImageDims = Int2(width, height);
+}
+
+void Renderer::drawGameWorldImage()
+{
+	SDL_SetRenderTarget(this->renderer, this->nativeTexture.get());
+
+	SDL_Rect srcRect;
+	srcRect.x = 0;
+	srcRect.y = 0;
+	srcRect.w = this->gameWorldImageDims.x;
+	srcRect.h = this->gameWorldImageDims.y;
+
+	const Int2 viewDims = this->getViewDimensions();
+	SDL_Rect dstRect;
+	dstRect.x = 0;
+	dstRect.y = 0;
+	dstRect.w = viewDims.x;
+	dstRect.h = viewDims.y;
+
+	SDL_RenderCopy(this->renderer, this->gameWorldTexture.get(), &srcRect, &dstRect);
+}
+
 SDL_Renderer *Renderer::createRenderer(SDL_Window *window)
 {
 	// Automatically choose the best driver.
@@ -265,6 +414,17 @@ Int2 Renderer::getWindowDimensions() const
 	return Int2(windowWidth, windowHeight);
 }
 
+int Renderer::getWindowRefreshRate() const
+{
+	SDL_DisplayMode displayMode;
+	if (SDL_GetWindowDisplayMode(this->window, &displayMode) != 0)
+	{
+		return 0;
+	}
+
+	return displayMode.refresh_rate;
+}
+
 double Renderer::getWindowAspect() const
 {
 	const Int2 dims = this->getWindowDimensions();
@@ -596,6 +756,10 @@ bool Renderer::init(int width, int height, WindowMode windowMode, int letterboxM
 	DebugAssertMsg(this->gameWorldTexture.get() != nullptr,
 		"Couldn't create game world texture (" + std::string(SDL_GetError()) + ").");
 
+	this->gameWorldPixels.init(renderWidth * renderHeight);
+	this->gameWorldImageDims = Int2(renderWidth, renderHeight);
+	this->dynamicResolution.reset(resolutionScale);
+
 	RenderInitSettings initSettings;
 	initSettings.init(renderWidth, renderHeight, renderThreadsMode);
 	this->renderer3D->init(initSettings);
@@ -605,6 +769,9 @@ bool Renderer::init(int width, int height, WindowMode windowMode, int letterboxM
 
 void Renderer::resize(int width, int height, double resolutionScale, bool fullGameWindow)
 {
+	this->waitForPipelinedFrame();
+	this->hasPipelinedFrameImage = false;
+
 	// The window's dimensions are resized automatically by SDL. The renderer's are not.
 	const Int2 windowDims = this->getWindowDimensions();
 	DebugAssertMsg(windowDims.x == width, "Mismatched resize widths.");
@@ -629,10 +796,27 @@ void Renderer::resize(int width, int height, double resolutionScale, bool fullGa
 		this->gameWorldTexture = this->createTexture(Renderer::DEFAULT_PIXELFORMAT, SDL_TEXTUREACCESS_STREAMING, renderWidth, renderHeight);
 		DebugAssertMsg(this->gameWorldTexture.get() != nullptr, "Couldn't recreate game world texture (" + std::string(SDL_GetError()) + ").");
 
+		this->gameWorldPixels.init(renderWidth * renderHeight);
+		this->gameWorldImageDims = Int2(renderWidth, renderHeight);
+		this->dynamicResolution.reset(resolutionScale);
+
 		this->renderer3D->resize(renderWidth, renderHeight);
 	}
 }
 
+void Renderer::setDynamicResolution(bool enabled, double minScale, double targetFrameTime)
+{
+	if (enabled && !this->dynamicResolutionEnabled)
+	{
+		// Start from full quality.
+		this->dynamicResolution.reset(this->resolutionScaleFunc());
+	}
+
+	this->dynamicResolutionEnabled = enabled;
+	this->dynamicResolutionMinScale = minScale;
+	this->dynamicResolutionTargetFrameTime = targetFrameTime;
+}
+
 void Renderer::setLetterboxMode(int letterboxMode)
 {
 	this->letterboxMode = letterboxMode;
@@ -718,66 +902,91 @@ void Renderer::setRenderThreadsMode(int mode)
 bool Renderer::tryCreateVertexBuffer(int vertexCount, int componentsPerVertex, VertexBufferID *outID)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	return this->renderer3D->tryCreateVertexBuffer(vertexCount, componentsPerVertex, outID);
 }
 
 bool Renderer::tryCreateAttributeBuffer(int vertexCount, int componentsPerVertex, AttributeBufferID *outID)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	return this->renderer3D->tryCreateAttributeBuffer(vertexCount, componentsPerVertex, outID);
 }
 
 bool Renderer::tryCreateIndexBuffer(int indexCount, IndexBufferID *outID)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	return this->renderer3D->tryCreateIndexBuffer(indexCount, outID);
 }
 
 void Renderer::populateVertexBuffer(VertexBufferID id, BufferView<const double> vertices)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	this->renderer3D->populateVertexBuffer(id, vertices);
 }
 
+void Renderer::populateVertexBufferFloat(VertexBufferID id, BufferView<const float> vertices)
+{
+	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
+	this->renderer3D->populateVertexBufferFloat(id, vertices);
+}
+
 void Renderer::populateAttributeBuffer(AttributeBufferID id, BufferView<const double> attributes)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	this->renderer3D->populateAttributeBuffer(id, attributes);
 }
 
+void Renderer::populateAttributeBufferFloat(AttributeBufferID id, BufferView<const float> attributes)
+{
+	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
+	this->renderer3D->populateAttributeBufferFloat(id, attributes);
+}
+
 void Renderer::populateIndexBuffer(IndexBufferID id, BufferView<const int32_t> indices)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	this->renderer3D->populateIndexBuffer(id, indices);
 }
 
 void Renderer::freeVertexBuffer(VertexBufferID id)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	this->renderer3D->freeVertexBuffer(id);
 }
 
 void Renderer::freeAttributeBuffer(AttributeBufferID id)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	this->renderer3D->freeAttributeBuffer(id);
 }
 
 void Renderer::freeIndexBuffer(IndexBufferID id)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	this->renderer3D->freeIndexBuffer(id);
 }
 
 bool Renderer::tryCreateObjectTexture(int width, int height, int bytesPerTexel, ObjectTextureID *outID)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	return this->renderer3D->tryCreateObjectTexture(width, height, bytesPerTexel, outID);
 }
 
 bool Renderer::tryCreateObjectTexture(const TextureBuilder &textureBuilder, ObjectTextureID *outID)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	return this->renderer3D->tryCreateObjectTexture(textureBuilder, outID);
 }
 
@@ -797,13 +1006,49 @@ bool Renderer::tryCreateUiTexture(BufferView2D<const uint8_t> texels, const Pale
 }
 
 bool Renderer::tryCreateUiTexture(TextureBuilderID textureBuilderID, PaletteID paletteID,
-	const TextureManager &textureManager, UiTextureID *outID)
+	TextureManager &textureManager, UiTextureID *outID)
 {
 	return this->renderer2D->tryCreateUiTexture(textureBuilderID, paletteID, textureManager, outID);
 }
 
+bool Renderer::tryCreateUiRenderTarget(int width, int height, UiTextureID *outID)
+{
+	return this->renderer2D->tryCreateUiRenderTarget(width, height, outID);
+}
+
+void Renderer::drawUiTextureQuads(UiTextureID srcTextureID, const RendererSystem2D::TextureQuad *quads, int count,
+	UiTextureID dstTextureID)
+{
+	this->renderer2D->drawQuadsToUiTexture(srcTextureID, quads, count, dstTextureID);
+}
+
+int Renderer::getRenderTargetsResetCount() const
+{
+	return this->renderTargetsResetCount;
+}
+
+int Renderer::getRenderDeviceResetCount() const
+{
+	return this->renderDeviceResetCount;
+}
+
+void Renderer::handleRenderTargetsReset()
+{
+	DebugLogWarning("Render targets were reset; redrawing them.");
+	this->renderTargetsResetCount++;
+}
+
+void Renderer::handleRenderDeviceReset()
+{
+	DebugLogWarning("Render device was reset; recreating textures that support it.");
+	this->renderTargetsResetCount++;
+	this->renderDeviceResetCount++;
+}
+
 std::optional<Int2> Renderer::tryGetObjectTextureDims(ObjectTextureID id) const
 {
+	// No pipelined frame wait: textures are only created, freed or resized on this thread after waiting, and
+	// the pipeline thread only reads them, so reading the dimensions concurrently is safe.
 	DebugAssert(this->renderer3D->isInited());
 	return this->renderer3D->tryGetObjectTextureDims(id);
 }
@@ -816,6 +1061,7 @@ std::optional<Int2> Renderer::tryGetUiTextureDims(UiTextureID id) const
 LockedTexture Renderer::lockObjectTexture(ObjectTextureID id)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	return this->renderer3D->lockObjectTexture(id);
 }
 
@@ -827,6 +1073,7 @@ uint32_t *Renderer::lockUiTexture(UiTextureID textureID)
 void Renderer::unlockObjectTexture(ObjectTextureID id)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	this->renderer3D->unlockObjectTexture(id);
 }
 
@@ -838,6 +1085,7 @@ void Renderer::unlockUiTexture(UiTextureID textureID)
 void Renderer::freeObjectTexture(ObjectTextureID id)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	this->renderer3D->freeObjectTexture(id);
 }
 
@@ -849,39 +1097,66 @@ void Renderer::freeUiTexture(UiTextureID id)
 bool Renderer::tryCreateLight(RenderLightID *outID)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	return this->renderer3D->tryCreateLight(outID);
 }
 
 const Double3 &Renderer::getLightPosition(RenderLightID id)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	return this->renderer3D->getLightPosition(id);
 }
 
 void Renderer::getLightRadii(RenderLightID id, double *outStartRadius, double *outEndRadius)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	this->renderer3D->getLightRadii(id, outStartRadius, outEndRadius);
 }
 
 void Renderer::setLightPosition(RenderLightID id, const Double3 &worldPoint)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	this->renderer3D->setLightPosition(id, worldPoint);
 }
 
 void Renderer::setLightRadius(RenderLightID id, double startRadius, double endRadius)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	this->renderer3D->setLightRadius(id, startRadius, endRadius);
 }
 
 void Renderer::freeLight(RenderLightID id)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 	this->renderer3D->freeLight(id);
 }
 
+bool Renderer::tryCreateLightmap(RenderLightmapID *outID)
+{
+	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
+	return this->renderer3D->tryCreateLightmap(outID);
+}
+
+void Renderer::populateLightmap(RenderLightmapID id, const Double3 &minPoint, const Double3 &maxPoint, BufferView3D<const uint8_t> intensities)
+{
+	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
+	this->renderer3D->populateLightmap(id, minPoint, maxPoint, intensities);
+}
+
+void Renderer::freeLightmap(RenderLightmapID id)
+{
+	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
+	this->renderer3D->freeLightmap(id);
+}
+
 void Renderer::clear(const Color &color)
 {
 	SDL_SetRenderTarget(this->renderer, this->nativeTexture.get());
@@ -961,38 +1236,81 @@ void Renderer::fillOriginalRect(const Color &color, int x, int y, int w, int h)
 }
 
 void Renderer::submitFrame(const RenderCamera &camera, BufferView<const RenderDrawCall> voxelDrawCalls,
-	double ambientPercent, ObjectTextureID paletteTextureID, ObjectTextureID lightTableTextureID, int renderThreadsMode)
+	BufferView<const RenderSkyPoint> skyPoints, double ambientPercent, ObjectTextureID paletteTextureID, ObjectTextureID lightTableTextureID,
+	int renderThreadsMode, bool useMipmaps, bool pipelined)
 {
 	DebugAssert(this->renderer3D->isInited());
+	this->waitForPipelinedFrame();
 
-	const Int2 renderDims(this->gameWorldTexture.getWidth(), this->gameWorldTexture.getHeight());
+	// The game world texture and pixel buffer are sized for the max scale so dynamic resolution changes
+	// don't reallocate anything.
+	const Int2 maxRenderDims(this->gameWorldTexture.getWidth(), this->gameWorldTexture.getHeight());
+	Int2 renderDims = maxRenderDims;
+	if (this->dynamicResolutionEnabled)
+	{
+		const Int2 viewDims = this->getViewDimensions();
+		const double scale = this->dynamicResolution.getScale();
+		renderDims.x = std::min(Renderer::makeRendererDimension(viewDims.x, scale), maxRenderDims.x);
+		renderDims.y = std::min(Renderer::makeRendererDimension(viewDims.y, scale), maxRenderDims.y);
+	}
 
 	RenderFrameSettings renderFrameSettings;
-	renderFrameSettings.init(ambientPercent, paletteTextureID, lightTableTextureID, renderDims.x, renderDims.y, renderThreadsMode);
+	renderFrameSettings.init(ambientPercent, paletteTextureID, lightTableTextureID, renderDims.x, renderDims.y, renderThreadsMode,
+		useMipmaps);
 
-	uint32_t *outputBuffer;
-	int gameWorldPitch;
-	int status = SDL_LockTexture(this->gameWorldTexture.get(), nullptr,
-		reinterpret_cast<void**>(&outputBuffer), &gameWorldPitch);
-	DebugAssertMsg(status == 0, "Couldn't lock game world texture for scene rendering (" + std::string(SDL_GetError()) + ").");
+	uint32_t *outputBuffer = this->gameWorldPixels.begin();
+
+	if (pipelined)
+	{
+		// Draw the previous frame's world while this one is rasterized.
+		if (this->hasPipelinedFrameImage)
+		{
+			this->drawGameWorldImage();
+		}
+
+		if (!this->pipelineThread.joinable())
+		{
+			this->pipelineThread = std::thread(&Renderer::runPipelineThread, this);
+		}
+
+		// Copy everything the frame needs since draw call lists are rebuilt during the next tick.
+		PipelinedFrame &frame = this->pipelinedFrame;
+		frame.camera = camera;
+		frame.drawCalls.assign(voxelDrawCalls.begin(), voxelDrawCalls.end());
+		frame.skyPoints.assign(skyPoints.begin(), skyPoints.end());
+		frame.frameSettings = renderFrameSettings;
+		frame.outputBuffer = outputBuffer;
+
+		{
+			std::lock_guard<std::mutex> lock(this->pipelineMutex);
+			this->pipelineFrameQueued = true;
+		}
+
+		this->pipelineCondition.notify_all();
+		this->pipelineFrameInFlight = true;
+		return;
+	}
+
+	this->hasPipelinedFrameImage = false;
 
 	// Render the game world (no UI).
 	const auto startTime = std::chrono::high_resolution_clock::now();
-	this->renderer3D->submitFrame(camera, voxelDrawCalls, renderFrameSettings, outputBuffer);
+	this->renderer3D->submitFrame(camera, voxelDrawCalls, skyPoints, renderFrameSettings, outputBuffer);
 	const auto endTime = std::chrono::high_resolution_clock::now();
 	const double frameTime = static_cast<double>((endTime - startTime).count()) / static_cast<double>(std::nano::den);
 
 	// Update profiler stats.
-	const RendererSystem3D::ProfilerData swProfilerData = this->renderer3D->getProfilerData();
-	this->profilerData.init(swProfilerData.width, swProfilerData.height, swProfilerData.threadCount,
-		swProfilerData.drawCallCount, swProfilerData.sceneTriangleCount, swProfilerData.visTriangleCount,
-		swProfilerData.textureCount, swProfilerData.textureByteCount, swProfilerData.totalLightCount, frameTime);
+	this->updateProfilerData(frameTime);
+	this->updateDynamicResolution(frameTime);
 
 	// Update the game world texture with the new pixels and copy to the native frame buffer (stretching if needed).
-	SDL_UnlockTexture(this->gameWorldTexture.get());
+	this->uploadGameWorldImage(renderDims.x, renderDims.y);
+	this->drawGameWorldImage();
+}
 
-	const Int2 viewDims = this->getViewDimensions();
-	this->draw(this->gameWorldTexture, 0, 0, viewDims.x, viewDims.y);
+void Renderer::finishFrame()
+{
+	this->waitForPipelinedFrame();
 }
 
 void Renderer::draw(const Texture &texture, int x, int y, int w, int h)
@@ -1018,6 +1336,9 @@ void Renderer::draw(const RendererSystem2D::RenderElement *renderElements, int c
 
 void Renderer::present()
 {
+	// Intentionally doesn't wait for a pipelined frame; this presents the previous frame's world image while
+	// the next one rasterizes. It only touches SDL textures owned by this thread, and the pipeline thread's
+	// output buffer isn't uploaded until waitForPipelinedFrame().
 	this->renderer3D->present(); // @todo: maybe this call will do the below at some point? Not sure
 
 	SDL_SetRenderTarget(this->renderer, nullptr);
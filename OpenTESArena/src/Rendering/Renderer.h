@@ -1,21 +1,31 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
 #include <vector>
 
 #include "SDL.h"
 
+#include "DynamicResolutionController.h"
+#include "RenderCamera.h"
+#include "RenderDrawCall.h"
+#include "RenderFrameSettings.h"
+#include "RenderSkyPoint.h"
 #include "RendererSystem2D.h"
 #include "RendererSystem3D.h"
 #include "RendererSystemType.h"
 #include "../Assets/TextureUtils.h"
 #include "../UI/Texture.h"
 
+#include "components/utilities/Buffer.h"
 #include "components/utilities/BufferView.h"
+#include "components/utilities/BufferView3D.h"
 
 class Color;
 class Rect;
@@ -63,6 +73,10 @@ public:
 		// Textures.
 		int objectTextureCount;
 		int64_t objectTextureByteCount;
+
+		// Geometry heap.
+		int geometrySlabCount;
+		int64_t geometryByteCount, geometryReservedByteCount;
 		
 		// Lights.
 		int totalLightCount;
@@ -72,21 +86,69 @@ public:
 		ProfilerData();
 
 		void init(int width, int height, int threadCount, int drawCallCount, int sceneTriangleCount, int visTriangleCount,
-			int objectTextureCount, int64_t objectTextureByteCount, int totalLightCount, double frameTime);
+			int objectTextureCount, int64_t objectTextureByteCount, int geometrySlabCount, int64_t geometryByteCount,
+			int64_t geometryReservedByteCount, int totalLightCount, double frameTime);
 	};
 
 	using ResolutionScaleFunc = std::function<double()>;
 private:
+	// Snapshot of a 3D frame rasterized on the pipeline thread while the next frame is simulated.
+	struct PipelinedFrame
+	{
+		RenderCamera camera;
+		std::vector<RenderDrawCall> drawCalls;
+		std::vector<RenderSkyPoint> skyPoints;
+		RenderFrameSettings frameSettings;
+		uint32_t *outputBuffer; // Game world pixels.
+		double frameTime;
+
+		PipelinedFrame();
+	};
+
 	std::unique_ptr<RendererSystem2D> renderer2D;
 	std::unique_ptr<RendererSystem3D> renderer3D;
 	std::vector<DisplayMode> displayModes;	
 	SDL_Window *window;
 	SDL_Renderer *renderer;
 	Texture nativeTexture, gameWorldTexture; // Frame buffers.
+	Buffer<uint32_t> gameWorldPixels; // 3D renderer output, sized for the max resolution scale.
+	Int2 gameWorldImageDims; // Dimensions of the image last uploaded to the game world texture.
 	ProfilerData profilerData;
 	ResolutionScaleFunc resolutionScaleFunc; // Gets an up-to-date resolution scale value from the game options.
 	int letterboxMode; // Determines aspect ratio of the original UI (16:10, 4:3, etc.).
 	bool fullGameWindow; // Determines height of 3D frame buffer.
+	int renderTargetsResetCount; // Times the driver discarded render target contents.
+	int renderDeviceResetCount; // Times the driver discarded all textures.
+
+	// Lowers the render dimensions below the resolution scale option when 3D frames take too long.
+	DynamicResolutionController dynamicResolution;
+	bool dynamicResolutionEnabled;
+	double dynamicResolutionMinScale;
+	double dynamicResolutionTargetFrameTime;
+
+	// At most one 3D frame is in flight. Any call touching 3D renderer state waits for it first, so the
+	// simulation only overlaps rasterization until it needs to change render resources.
+	PipelinedFrame pipelinedFrame;
+	std::thread pipelineThread;
+	std::mutex pipelineMutex;
+	std::condition_variable pipelineCondition;
+	bool pipelineFrameQueued; // Guarded by the mutex; true until the pipeline thread finishes the frame.
+	bool pipelineStopRequested; // Guarded by the mutex.
+	bool pipelineFrameInFlight; // Main thread only.
+	bool hasPipelinedFrameImage; // Whether the game world texture holds a finished pipelined frame.
+
+	void runPipelineThread();
+
+	// Blocks until the in-flight 3D frame is done and makes its image available to draw.
+	void waitForPipelinedFrame();
+
+	void updateProfilerData(double frameTime);
+	void updateDynamicResolution(double frameTime);
+
+	// Copies the 3D renderer output into the top-left of the game world texture, then stretches that part
+	// over the game world view.
+	void uploadGameWorldImage(int width, int height);
+	void drawGameWorldImage();
 
 	// Helper method for making a renderer context.
 	static SDL_Renderer *createRenderer(SDL_Window *window);
@@ -110,6 +172,9 @@ public:
 	// Gets the width and height of the active window.
 	Int2 getWindowDimensions() const;
 
+	// Gets the refresh rate in Hz of the display the window is on, or 0 if unknown.
+	int getWindowRefreshRate() const;
+
 	// Gets the aspect ratio of the active window.
 	double getWindowAspect() const;
 
@@ -158,6 +223,10 @@ public:
 	// Resizes the renderer dimensions.
 	void resize(int width, int height, double resolutionScale, bool fullGameWindow);
 
+	// Sets the dynamic resolution bounds and the frame time it tries to hold. The resolution scale option is
+	// the upper bound.
+	void setDynamicResolution(bool enabled, double minScale, double targetFrameTime);
+
 	// Sets the letterbox mode.
 	void setLetterboxMode(int letterboxMode);
 
@@ -185,7 +254,9 @@ public:
 	bool tryCreateAttributeBuffer(int vertexCount, int componentsPerVertex, AttributeBufferID *outID);
 	bool tryCreateIndexBuffer(int indexCount, IndexBufferID *outID);
 	void populateVertexBuffer(VertexBufferID id, BufferView<const double> vertices);
+	void populateVertexBufferFloat(VertexBufferID id, BufferView<const float> vertices);
 	void populateAttributeBuffer(AttributeBufferID id, BufferView<const double> attributes);
+	void populateAttributeBufferFloat(AttributeBufferID id, BufferView<const float> attributes);
 	void populateIndexBuffer(IndexBufferID id, BufferView<const int32_t> indices);
 	void freeVertexBuffer(VertexBufferID id);
 	void freeAttributeBuffer(AttributeBufferID id);
@@ -198,11 +269,23 @@ public:
 	bool tryCreateUiTexture(BufferView2D<const uint32_t> texels, UiTextureID *outID);
 	bool tryCreateUiTexture(BufferView2D<const uint8_t> texels, const Palette &palette, UiTextureID *outID);
 	bool tryCreateUiTexture(TextureBuilderID textureBuilderID, PaletteID paletteID,
-		const TextureManager &textureManager, UiTextureID *outID);
+		TextureManager &textureManager, UiTextureID *outID);
 
 	std::optional<Int2> tryGetObjectTextureDims(ObjectTextureID id) const;
 	std::optional<Int2> tryGetUiTextureDims(UiTextureID id) const;
 
+	// Render target UI textures can only be updated by drawing quads into them.
+	bool tryCreateUiRenderTarget(int width, int height, UiTextureID *outID);
+	void drawUiTextureQuads(UiTextureID srcTextureID, const RendererSystem2D::TextureQuad *quads, int count,
+		UiTextureID dstTextureID);
+
+	// Render target contents are lost when this changes (i.e. on SDL_RENDER_TARGETS_RESET) and must be redrawn.
+	// A device reset (SDL_RENDER_DEVICE_RESET) also loses every other texture and counts as both.
+	int getRenderTargetsResetCount() const;
+	int getRenderDeviceResetCount() const;
+	void handleRenderTargetsReset();
+	void handleRenderDeviceReset();
+
 	// Allows for updating all texels in the given texture. Must be unlocked to flush the changes.
 	LockedTexture lockObjectTexture(ObjectTextureID id);
 	uint32_t *lockUiTexture(UiTextureID id);
@@ -220,6 +303,9 @@ public:
 	void setLightPosition(RenderLightID id, const Double3 &worldPoint);
 	void setLightRadius(RenderLightID id, double startRadius, double endRadius);
 	void freeLight(RenderLightID id);
+	bool tryCreateLightmap(RenderLightmapID *outID);
+	void populateLightmap(RenderLightmapID id, const Double3 &minPoint, const Double3 &maxPoint, BufferView3D<const uint8_t> intensities);
+	void freeLightmap(RenderLightmapID id);
 
 	// Fills the native frame buffer with the draw color, or default black/transparent.
 	void clear(const Color &color);
@@ -236,10 +322,15 @@ public:
 	void fillRect(const Color &color, int x, int y, int w, int h);
 	void fillOriginalRect(const Color &color, int x, int y, int w, int h);
 
-	// Runs the 3D renderer which draws the world onto the native frame buffer.
+	// Runs the 3D renderer which draws the world onto the native frame buffer. If pipelined, the world is
+	// rasterized on a separate thread and the previous frame's image is drawn instead (one frame of latency).
 	void submitFrame(const RenderCamera &camera, BufferView<const RenderDrawCall> voxelDrawCalls,
-		double ambientPercent, ObjectTextureID paletteTextureID, ObjectTextureID lightTableTextureID,
-		int renderThreadsMode);
+		BufferView<const RenderSkyPoint> skyPoints, double ambientPercent, ObjectTextureID paletteTextureID, ObjectTextureID lightTableTextureID,
+		int renderThreadsMode, bool useMipmaps, bool pipelined);
+
+	// Blocks until any pipelined frame is rasterized so the profiler data and game world image are for the
+	// last submitted frame. Does nothing if the last frame wasn't pipelined.
+	void finishFrame();
 
 	// Draw methods for the native and original frame buffers.
 	void draw(const Texture &texture, int x, int y, int w, int h);
@@ -11,6 +11,21 @@ RendererSystem2D::RenderElement::RenderElement(UiTextureID id, double x, double
 	this->height = height;
 }
 
+RendererSystem2D::TextureQuad::TextureQuad(int srcX, int srcY, int width, int height, int dstX, int dstY,
+	const Color &color)
+	: color(color)
+{
+	this->srcX = srcX;
+	this->srcY = srcY;
+	this->width = width;
+	this->height = height;
+	this->dstX = dstX;
+	this->dstY = dstY;
+}
+
+RendererSystem2D::TextureQuad::TextureQuad()
+	: TextureQuad(0, 0, 0, 0, 0, 0, Color::White) { }
+
 RendererSystem2D::~RendererSystem2D()
 {
 	// Do nothing.
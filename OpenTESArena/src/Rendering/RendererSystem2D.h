@@ -7,6 +7,7 @@
 #include "RenderTextureUtils.h"
 #include "../Assets/TextureUtils.h"
 #include "../Math/Vector2.h"
+#include "../Utilities/Color.h"
 #include "../Utilities/Palette.h"
 
 #include "components/utilities/BufferView2D.h"
@@ -43,6 +44,17 @@ public:
 		RenderElement(UiTextureID id, double x, double y, double width, double height);
 	};
 
+	// A region of one UI texture copied at 1:1 scale into another, tinted by a color.
+	struct TextureQuad
+	{
+		int srcX, srcY, width, height;
+		int dstX, dstY;
+		Color color;
+
+		TextureQuad(int srcX, int srcY, int width, int height, int dstX, int dstY, const Color &color);
+		TextureQuad();
+	};
+
 	virtual ~RendererSystem2D();
 
 	virtual bool init(SDL_Window *window) = 0;
@@ -53,7 +65,11 @@ public:
 	virtual bool tryCreateUiTexture(BufferView2D<const uint32_t> texels, UiTextureID *outID) = 0;
 	virtual bool tryCreateUiTexture(BufferView2D<const uint8_t> texels, const Palette &palette, UiTextureID *outID) = 0;
 	virtual bool tryCreateUiTexture(TextureBuilderID textureBuilderID, PaletteID paletteID,
-		const TextureManager &textureManager, UiTextureID *outID) = 0;
+		TextureManager &textureManager, UiTextureID *outID) = 0;
+
+	// Creates a texture that can be drawn into with drawQuadsToUiTexture() but can't be locked. Fails if the
+	// backend doesn't support render targets.
+	virtual bool tryCreateUiRenderTarget(int width, int height, UiTextureID *outID) = 0;
 
 	virtual uint32_t *lockUiTexture(UiTextureID textureID) = 0;
 	virtual void unlockUiTexture(UiTextureID textureID) = 0;
@@ -67,6 +83,9 @@ public:
 	// Drawing method for UI elements. Positions and sizes are in 0->1 vector space so that the caller's
 	// data is resolution-independent.
 	virtual void draw(const RenderElement *elements, int count, RenderSpace renderSpace, const Rect &letterboxRect) = 0;
+
+	// Clears the render target texture then draws the quads from the source texture into it in order.
+	virtual void drawQuadsToUiTexture(UiTextureID srcTextureID, const TextureQuad *quads, int count, UiTextureID dstTextureID) = 0;
 };
 
 #endif
@@ -1,7 +1,8 @@
 #include "RendererSystem3D.h"
 
 RendererSystem3D::ProfilerData::ProfilerData(int width, int height, int threadCount, int drawCallCount, int sceneTriangleCount,
-	int visTriangleCount, int textureCount, int64_t textureByteCount, int totalLightCount)
+	int visTriangleCount, int textureCount, int64_t textureByteCount, int geometrySlabCount,
+	int64_t geometryByteCount, int64_t geometryReservedByteCount, int totalLightCount)
 {
 	this->width = width;
 	this->height = height;
@@ -11,6 +12,9 @@ RendererSystem3D::ProfilerData::ProfilerData(int width, int height, int threadCo
 	this->visTriangleCount = visTriangleCount;
 	this->textureCount = textureCount;
 	this->textureByteCount = textureByteCount;
+	this->geometrySlabCount = geometrySlabCount;
+	this->geometryByteCount = geometryByteCount;
+	this->geometryReservedByteCount = geometryReservedByteCount;
 	this->totalLightCount = totalLightCount;
 }
 
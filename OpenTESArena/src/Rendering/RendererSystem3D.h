@@ -11,6 +11,7 @@
 #include "../Utilities/Palette.h"
 
 #include "components/utilities/BufferView.h"
+#include "components/utilities/BufferView3D.h"
 
 // Abstract base class for 3D renderer.
 
@@ -21,6 +22,7 @@ struct RenderCamera;
 struct RenderDrawCall;
 struct RenderFrameSettings;
 struct RenderInitSettings;
+struct RenderSkyPoint;
 
 class RendererSystem3D
 {
@@ -34,10 +36,13 @@ public:
 		int sceneTriangleCount, visTriangleCount;
 		int textureCount;
 		int64_t textureByteCount;
+		int geometrySlabCount;
+		int64_t geometryByteCount, geometryReservedByteCount;
 		int totalLightCount;
 
 		ProfilerData(int width, int height, int threadCount, int drawCallCount, int sceneTriangleCount,
-			int visTriangleCount, int textureCount, int64_t textureByteCount, int totalLightCount);
+			int visTriangleCount, int textureCount, int64_t textureByteCount, int geometrySlabCount,
+			int64_t geometryByteCount, int64_t geometryReservedByteCount, int totalLightCount);
 	};
 
 	virtual ~RendererSystem3D();
@@ -54,7 +59,9 @@ public:
 	virtual bool tryCreateAttributeBuffer(int vertexCount, int componentsPerVertex, AttributeBufferID *outID) = 0;
 	virtual bool tryCreateIndexBuffer(int indexCount, IndexBufferID *outID) = 0;
 	virtual void populateVertexBuffer(VertexBufferID id, BufferView<const double> vertices) = 0;
+	virtual void populateVertexBufferFloat(VertexBufferID id, BufferView<const float> vertices) = 0;
 	virtual void populateAttributeBuffer(AttributeBufferID id, BufferView<const double> attributes) = 0;
+	virtual void populateAttributeBufferFloat(AttributeBufferID id, BufferView<const float> attributes) = 0;
 	virtual void populateIndexBuffer(IndexBufferID id, BufferView<const int32_t> indices) = 0;
 	virtual void freeVertexBuffer(VertexBufferID id) = 0;
 	virtual void freeAttributeBuffer(AttributeBufferID id) = 0;
@@ -74,20 +81,26 @@ public:
 	virtual void setLightPosition(RenderLightID id, const Double3 &worldPoint) = 0;
 	virtual void setLightRadius(RenderLightID id, double startRadius, double endRadius) = 0;
 	virtual void freeLight(RenderLightID id) = 0;
+	virtual bool tryCreateLightmap(RenderLightmapID *outID) = 0;
+	virtual void populateLightmap(RenderLightmapID id, const Double3 &minPoint, const Double3 &maxPoint,
+		BufferView3D<const uint8_t> intensities) = 0;
+	virtual void freeLightmap(RenderLightmapID id) = 0;
 
-	// Returns the texture's dimensions, if it exists.
+	// Returns the texture's dimensions, if it exists. May be called while a pipelined frame is being rasterized,
+	// so it must only read.
 	virtual std::optional<Int2> tryGetObjectTextureDims(ObjectTextureID id) const = 0;
 
 	// Gets various profiler information about internal renderer state.
 	virtual ProfilerData getProfilerData() const = 0;
 	
 	// Begins rendering a frame. Currently this is a blocking call and it should be safe to present the frame
-	// upon returning from this.
+	// upon returning from this. Sky points are drawn after all draw calls, behind any geometry.
 	virtual void submitFrame(const RenderCamera &camera, BufferView<const RenderDrawCall> drawCalls,
-		const RenderFrameSettings &settings, uint32_t *outputBuffer) = 0;
+		BufferView<const RenderSkyPoint> skyPoints, const RenderFrameSettings &settings, uint32_t *outputBuffer) = 0;
 
 	// Presents the finished frame to the screen. This may just be a copy to the screen frame buffer that
-	// is then taken care of by the top-level rendering manager, since UI must be drawn afterwards.
+	// is then taken care of by the top-level rendering manager, since UI must be drawn afterwards. Called while
+	// a pipelined frame may still be rasterizing, so it must not touch any frame state.
 	virtual void present() = 0;
 };
 
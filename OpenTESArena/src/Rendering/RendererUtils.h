@@ -16,6 +16,9 @@ namespace RendererUtils
 	constexpr double NEAR_PLANE = 0.001;
 	constexpr double FAR_PLANE = 1000.0;
 
+	// Arbitrary distance of stars from the camera so they sort behind other sky objects.
+	constexpr double SKY_STAR_DISTANCE = 2100.0;
+
 	RenderCamera makeCamera(const ChunkInt2 &chunk, const Double3 &point, const Double3 &direction,
 		Degrees fovY, double aspectRatio, bool tallPixelCorrection);
 
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cmath>
+#include <optional>
 #include <type_traits>
 
 #include "SDL_render.h"
@@ -119,9 +120,9 @@ bool SdlUiRenderer::tryCreateUiTexture(BufferView2D<const uint8_t> texels, const
 }
 
 bool SdlUiRenderer::tryCreateUiTexture(TextureBuilderID textureBuilderID, PaletteID paletteID,
-	const TextureManager &textureManager, UiTextureID *outID)
+	TextureManager &textureManager, UiTextureID *outID)
 {
-	const TextureBuilder &textureBuilder = textureManager.getTextureBuilderHandle(textureBuilderID);
+	const TextureBuilder &textureBuilder = textureManager.getOrReloadTextureBuilder(textureBuilderID);
 	const TextureBuilderType type = textureBuilder.getType();
 	if (type == TextureBuilderType::Paletted)
 	{
@@ -144,6 +145,35 @@ bool SdlUiRenderer::tryCreateUiTexture(TextureBuilderID textureBuilderID, Palett
 	}
 }
 
+bool SdlUiRenderer::tryCreateUiRenderTarget(int width, int height, UiTextureID *outID)
+{
+	if (SDL_RenderTargetSupported(this->renderer) == SDL_FALSE)
+	{
+		return false;
+	}
+
+	SDL_Texture *texture = SDL_CreateTexture(this->renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, width, height);
+	if (texture == nullptr)
+	{
+		DebugLogError("Couldn't allocate SDL_Texture render target (dims: " + std::to_string(width) + "x" +
+			std::to_string(height) + ", " + std::string(SDL_GetError()) + ").");
+		return false;
+	}
+
+	if (SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND) != 0)
+	{
+		DebugLogError("Couldn't set SDL_Texture render target blend mode to blend (dims: " + std::to_string(width) + "x" +
+			std::to_string(height) + ", " + std::string(SDL_GetError()) + ").");
+		SDL_DestroyTexture(texture);
+		return false;
+	}
+
+	*outID = this->nextID;
+	this->nextID++;
+	this->textures.emplace(*outID, texture);
+	return true;
+}
+
 uint32_t *SdlUiRenderer::lockUiTexture(UiTextureID textureID)
 {
 	const auto iter = this->textures.find(textureID);
@@ -296,3 +326,58 @@ void SdlUiRenderer::draw(const RenderElement *elements, int count, RenderSpace r
 		SDL_RenderCopy(this->renderer, texture, nullptr, &nativeRect);
 	}
 }
+
+void SdlUiRenderer::drawQuadsToUiTexture(UiTextureID srcTextureID, const TextureQuad *quads, int count, UiTextureID dstTextureID)
+{
+	const auto srcIter = this->textures.find(srcTextureID);
+	const auto dstIter = this->textures.find(dstTextureID);
+	DebugAssert(srcIter != this->textures.end());
+	DebugAssert(dstIter != this->textures.end());
+	SDL_Texture *srcTexture = srcIter->second;
+	SDL_Texture *dstTexture = dstIter->second;
+
+	SDL_Texture *prevTarget = SDL_GetRenderTarget(this->renderer);
+	if (SDL_SetRenderTarget(this->renderer, dstTexture) != 0)
+	{
+		DebugLogError("Couldn't set UI texture " + std::to_string(dstTextureID) + " as render target (" +
+			std::string(SDL_GetError()) + ").");
+		return;
+	}
+
+	uint8_t prevR, prevG, prevB, prevA;
+	SDL_GetRenderDrawColor(this->renderer, &prevR, &prevG, &prevB, &prevA);
+	SDL_SetRenderDrawColor(this->renderer, 0, 0, 0, 0);
+	SDL_RenderClear(this->renderer);
+	SDL_SetRenderDrawColor(this->renderer, prevR, prevG, prevB, prevA);
+
+	// Consecutive quads usually share a color, so the tint only changes between runs.
+	std::optional<Color> currentColor;
+	for (int i = 0; i < count; i++)
+	{
+		const TextureQuad &quad = quads[i];
+		if (!currentColor.has_value() || (*currentColor != quad.color))
+		{
+			SDL_SetTextureColorMod(srcTexture, quad.color.r, quad.color.g, quad.color.b);
+			SDL_SetTextureAlphaMod(srcTexture, quad.color.a);
+			currentColor = quad.color;
+		}
+
+		SDL_Rect srcRect;
+		srcRect.x = quad.srcX;
+		srcRect.y = quad.srcY;
+		srcRect.w = quad.width;
+		srcRect.h = quad.height;
+
+		SDL_Rect dstRect;
+		dstRect.x = quad.dstX;
+		dstRect.y = quad.dstY;
+		dstRect.w = quad.width;
+		dstRect.h = quad.height;
+
+		SDL_RenderCopy(this->renderer, srcTexture, &srcRect, &dstRect);
+	}
+
+	SDL_SetTextureColorMod(srcTexture, 255, 255, 255);
+	SDL_SetTextureAlphaMod(srcTexture, 255);
+	SDL_SetRenderTarget(this->renderer, prevTarget);
+}
@@ -32,7 +32,9 @@ public:
 	bool tryCreateUiTexture(BufferView2D<const uint32_t> texels, UiTextureID *outID) override;
 	bool tryCreateUiTexture(BufferView2D<const uint8_t> texels, const Palette &palette, UiTextureID *outID) override;
 	bool tryCreateUiTexture(TextureBuilderID textureBuilderID, PaletteID paletteID,
-		const TextureManager &textureManager, UiTextureID *outID) override;
+		TextureManager &textureManager, UiTextureID *outID) override;
+
+	bool tryCreateUiRenderTarget(int width, int height, UiTextureID *outID) override;
 
 	uint32_t *lockUiTexture(UiTextureID textureID) override;
 	void unlockUiTexture(UiTextureID textureID) override;
@@ -42,6 +44,7 @@ public:
 	std::optional<Int2> tryGetTextureDims(UiTextureID id) const override;
 
 	void draw(const RenderElement *elements, int count, RenderSpace renderSpace, const Rect &letterboxRect) override;
+	void drawQuadsToUiTexture(UiTextureID srcTextureID, const TextureQuad *quads, int count, UiTextureID dstTextureID) override;
 };
 
 #endif
@@ -11,6 +11,7 @@
 #include "RendererUtils.h"
 #include "RenderFrameSettings.h"
 #include "RenderInitSettings.h"
+#include "RenderSkyPoint.h"
 #include "SoftwareRenderer.h"
 #include "../Assets/TextureBuilder.h"
 #include "../Math/Constants.h"
@@ -22,6 +23,75 @@
 
 #include "components/debug/Debug.h"
 
+// Internal texture layout types/functions.
+namespace swTexture
+{
+	// Mip levels with both dimensions a multiple of this are stored as square tiles, one 64-byte cache line each,
+	// so sampling a rotated or grazing-angle surface doesn't touch a new cache line for every row.
+	constexpr bool USE_TILED_LAYOUT = true;
+	constexpr int TILE_DIM = 8;
+	constexpr int TILE_DIM_BITS = 3;
+	constexpr int TILE_DIM_MASK = TILE_DIM - 1;
+
+	bool CanTile(int width, int height)
+	{
+		return USE_TILED_LAYOUT && ((width % TILE_DIM) == 0) && ((height % TILE_DIM) == 0);
+	}
+
+	int GetTexelIndex(int x, int y, int width, bool isTiled)
+	{
+		if (!isTiled)
+		{
+			return x + (y * width);
+		}
+
+		const int tileIndex = (x >> TILE_DIM_BITS) + ((y >> TILE_DIM_BITS) * (width >> TILE_DIM_BITS));
+		return (tileIndex << (TILE_DIM_BITS * 2)) + ((y & TILE_DIM_MASK) << TILE_DIM_BITS) + (x & TILE_DIM_MASK);
+	}
+
+	int GetMipDimension(int dimension, int level)
+	{
+		return std::max(dimension >> level, 1);
+	}
+
+	// Palette indices can't be averaged, so a 2x2 block becomes its most common texel. A block with at least
+	// half its texels opaque stays opaque so alpha-tested sprites don't thin out in the distance.
+	uint8_t DownsampleTexels(const uint8_t (&texels)[4])
+	{
+		int opaqueCount = 0;
+		for (const uint8_t texel : texels)
+		{
+			opaqueCount += (texel != 0) ? 1 : 0;
+		}
+
+		const bool isOpaque = opaqueCount >= 2;
+		uint8_t bestTexel = 0;
+		int bestCount = 0;
+		for (int i = 0; i < 4; i++)
+		{
+			const uint8_t texel = texels[i];
+			if ((texel != 0) != isOpaque)
+			{
+				continue;
+			}
+
+			int count = 0;
+			for (int j = i; j < 4; j++)
+			{
+				count += (texels[j] == texel) ? 1 : 0;
+			}
+
+			if (count > bestCount)
+			{
+				bestTexel = texel;
+				bestCount = count;
+			}
+		}
+
+		return bestTexel;
+	}
+}
+
 // Internal geometry types/functions.
 namespace swGeometry
 {
@@ -328,20 +398,184 @@ namespace swGeometry
 	std::array<Double3, MAX_CLIP_LIST_SIZE> g_visibleClipListNormal0s, g_visibleClipListNormal1s, g_visibleClipListNormal2s;
 	std::array<Double2, MAX_CLIP_LIST_SIZE> g_visibleClipListUV0s, g_visibleClipListUV1s, g_visibleClipListUV2s;
 	std::array<ObjectTextureID, MAX_CLIP_LIST_SIZE> g_visibleClipListTextureID0s, g_visibleClipListTextureID1s;
+
+	// Vertex stage batch for the mesh being processed, one component per array. Positions are relative to the
+	// camera so float keeps its precision near the viewer wherever the mesh is in the world.
+	std::vector<float> g_vertexXs, g_vertexYs, g_vertexZs;
+	std::vector<float> g_normalXs, g_normalYs, g_normalZs;
+	std::vector<uint8_t> g_vertexOutsideMasks; // Bit per clipping plane the vertex is definitely outside of.
+	std::vector<uint8_t> g_vertexStraddleMasks; // Bit per clipping plane the vertex isn't definitely inside of.
+	constexpr float CLIP_OUTCODE_MARGIN = 1.0e-4f; // Vertices this close to a plane are left to the double-precision clipper.
+
 	int g_visibleTriangleCount = 0; // Note this includes new triangles from clipping.
 	int g_totalTriangleCount = 0;
 	int g_totalDrawCallCount = 0;
 
-	// Processes the given world space triangles in the following ways, and returns a view to a geometry cache
+	// Model space to camera-relative world space for one draw call, with the vertex shader folded into a single
+	// affine transform.
+	struct VertexTransform
+	{
+		float linear[3][3]; // Row-major.
+		float translation[3];
+		float normalLinear[3][3];
+	};
+
+	VertexTransform MakeVertexTransform(VertexShaderType vertexShaderType, const Double3 &modelPosition,
+		const Double3 &preScaleTranslation, const Matrix4d &rotation, const Matrix4d &scale, const Double3 &eye)
+	{
+		Matrix4d positionMatrix = Matrix4d::identity();
+		Matrix4d normalMatrix = Matrix4d::identity();
+		Double4 offset(modelPosition, 0.0);
+		switch (vertexShaderType)
+		{
+		case VertexShaderType::Voxel:
+			break;
+		case VertexShaderType::SwingingDoor:
+			positionMatrix = rotation;
+			normalMatrix = rotation;
+			break;
+		case VertexShaderType::SlidingDoor:
+			positionMatrix = rotation * scale;
+			normalMatrix = rotation;
+			break;
+		case VertexShaderType::RaisingDoor:
+		{
+			// Same as pushing + popping a translation around the scale so it scales towards the ceiling.
+			const Double4 preScaleTranslationXYZW(preScaleTranslation, 1.0);
+			positionMatrix = rotation * scale;
+			normalMatrix = rotation;
+			offset = offset + (rotation * ((scale * preScaleTranslationXYZW) - preScaleTranslationXYZW));
+			break;
+		}
+		case VertexShaderType::SplittingDoor:
+			DebugNotImplemented();
+			break;
+		case VertexShaderType::Entity:
+			positionMatrix = rotation * scale;
+			break;
+		default:
+			DebugNotImplementedMsg(std::to_string(static_cast<int>(vertexShaderType)));
+			break;
+		}
+
+		const Double3 translation(
+			positionMatrix.w.x + offset.x - eye.x,
+			positionMatrix.w.y + offset.y - eye.y,
+			positionMatrix.w.z + offset.z - eye.z);
+
+		const Double4 *positionColumns[3] = { &positionMatrix.x, &positionMatrix.y, &positionMatrix.z };
+		const Double4 *normalColumns[3] = { &normalMatrix.x, &normalMatrix.y, &normalMatrix.z };
+
+		VertexTransform transform;
+		for (int column = 0; column < 3; column++)
+		{
+			transform.linear[0][column] = static_cast<float>(positionColumns[column]->x);
+			transform.linear[1][column] = static_cast<float>(positionColumns[column]->y);
+			transform.linear[2][column] = static_cast<float>(positionColumns[column]->z);
+			transform.normalLinear[0][column] = static_cast<float>(normalColumns[column]->x);
+			transform.normalLinear[1][column] = static_cast<float>(normalColumns[column]->y);
+			transform.normalLinear[2][column] = static_cast<float>(normalColumns[column]->z);
+		}
+
+		transform.translation[0] = static_cast<float>(translation.x);
+		transform.translation[1] = static_cast<float>(translation.y);
+		transform.translation[2] = static_cast<float>(translation.z);
+		return transform;
+	}
+
+	// Applies a 3x3 matrix plus translation to planar components. Simple enough for the compiler to vectorize.
+	void TransformComponents(const float (&matrix)[3][3], float translationX, float translationY, float translationZ,
+		const float *srcXs, const float *srcYs, const float *srcZs, int count, float *dstXs, float *dstYs, float *dstZs)
+	{
+		const float m00 = matrix[0][0], m01 = matrix[0][1], m02 = matrix[0][2];
+		const float m10 = matrix[1][0], m11 = matrix[1][1], m12 = matrix[1][2];
+		const float m20 = matrix[2][0], m21 = matrix[2][1], m22 = matrix[2][2];
+		for (int i = 0; i < count; i++)
+		{
+			const float x = srcXs[i];
+			const float y = srcYs[i];
+			const float z = srcZs[i];
+			dstXs[i] = (m00 * x) + (m01 * y) + (m02 * z) + translationX;
+			dstYs[i] = (m10 * x) + (m11 * y) + (m12 * z) + translationY;
+			dstZs[i] = (m20 * x) + (m21 * y) + (m22 * z) + translationZ;
+		}
+	}
+
+	void TransformVertices(const VertexTransform &transform, BufferView<const float> vertices, BufferView<const float> normals,
+		int vertexCount)
+	{
+		g_vertexXs.resize(vertexCount);
+		g_vertexYs.resize(vertexCount);
+		g_vertexZs.resize(vertexCount);
+		g_normalXs.resize(vertexCount);
+		g_normalYs.resize(vertexCount);
+		g_normalZs.resize(vertexCount);
+
+		const float *srcVertexXs = vertices.begin();
+		TransformComponents(transform.linear, transform.translation[0], transform.translation[1], transform.translation[2],
+			srcVertexXs, srcVertexXs + vertexCount, srcVertexXs + (vertexCount * 2), vertexCount,
+			g_vertexXs.data(), g_vertexYs.data(), g_vertexZs.data());
+
+		const float *srcNormalXs = normals.begin();
+		TransformComponents(transform.normalLinear, 0.0f, 0.0f, 0.0f, srcNormalXs, srcNormalXs + vertexCount,
+			srcNormalXs + (vertexCount * 2), vertexCount, g_normalXs.data(), g_normalYs.data(), g_normalZs.data());
+	}
+
+	// Outcodes for every transformed vertex so most triangles are accepted or rejected without clipping.
+	void ClassifyVertices(const ClippingPlanes &clippingPlanes, const Double3 &eye, int vertexCount)
+	{
+		g_vertexOutsideMasks.assign(vertexCount, 0);
+		g_vertexStraddleMasks.assign(vertexCount, 0);
+
+		const float *xs = g_vertexXs.data();
+		const float *ys = g_vertexYs.data();
+		const float *zs = g_vertexZs.data();
+		uint8_t *outsideMasks = g_vertexOutsideMasks.data();
+		uint8_t *straddleMasks = g_vertexStraddleMasks.data();
+		for (int planeIndex = 0; planeIndex < static_cast<int>(clippingPlanes.size()); planeIndex++)
+		{
+			const ClippingPlane &plane = clippingPlanes[planeIndex];
+			const float normalX = static_cast<float>(plane.normal.x);
+			const float normalY = static_cast<float>(plane.normal.y);
+			const float normalZ = static_cast<float>(plane.normal.z);
+			const float planeDist = static_cast<float>((plane.point - eye).dot(plane.normal));
+			const uint8_t planeBit = static_cast<uint8_t>(1 << planeIndex);
+			for (int i = 0; i < vertexCount; i++)
+			{
+				const float dist = (normalX * xs[i]) + (normalY * ys[i]) + (normalZ * zs[i]) - planeDist;
+				outsideMasks[i] |= (dist < -CLIP_OUTCODE_MARGIN) ? planeBit : 0;
+				straddleMasks[i] |= (dist < CLIP_OUTCODE_MARGIN) ? planeBit : 0;
+			}
+		}
+	}
+
+	// Deinterleaves vertex components into the planar float layout read by the vertex stage.
+	template<typename T>
+	void WritePlanarComponents(BufferView<const T> src, int vertexCount, int componentsPerVertex, BufferView<float> dst)
+	{
+		DebugAssert(src.getCount() == dst.getCount());
+		const T *srcPtr = src.begin();
+		float *dstPtr = dst.begin();
+		for (int component = 0; component < componentsPerVertex; component++)
+		{
+			float *dstComponents = dstPtr + (component * vertexCount);
+			for (int i = 0; i < vertexCount; i++)
+			{
+				dstComponents[i] = static_cast<float>(srcPtr[(i * componentsPerVertex) + component]);
+			}
+		}
+	}
+
+	// Processes the given model space triangles in the following ways, and returns a view to a geometry cache
 	// that is invalidated the next time this function is called.
-	// 1) Back-face culling
-	// 2) Frustum culling
-	// 3) Clipping
+	// 1) Vertex shading in float batches
+	// 2) Back-face culling
+	// 3) Frustum culling by outcodes
+	// 4) Clipping, only for triangles crossing a frustum plane
 	swGeometry::TriangleDrawListIndices ProcessMeshForRasterization(const Double3 &modelPosition, const Double3 &preScaleTranslation,
-		const Matrix4d &rotation, const Matrix4d &scale, const SoftwareRenderer::VertexBuffer &vertexBuffer,
-		const SoftwareRenderer::AttributeBuffer &normalBuffer, const SoftwareRenderer::AttributeBuffer &texCoordBuffer,
-		const SoftwareRenderer::IndexBuffer &indexBuffer, ObjectTextureID textureID0, ObjectTextureID textureID1,
-		VertexShaderType vertexShaderType, const Double3 &eye, const ClippingPlanes &clippingPlanes)
+		const Matrix4d &rotation, const Matrix4d &scale, BufferView<const float> vertices, BufferView<const float> normals,
+		BufferView<const float> texCoords, int vertexCount, BufferView<const int32_t> indices, ObjectTextureID textureID0,
+		ObjectTextureID textureID1, VertexShaderType vertexShaderType, const Double3 &eye, const ClippingPlanes &clippingPlanes)
 	{
 		std::vector<Double3> &outVisibleTriangleV0s = g_visibleTriangleV0s;
 		std::vector<Double3> &outVisibleTriangleV1s = g_visibleTriangleV1s;
@@ -380,143 +614,88 @@ namespace swGeometry
 		outVisibleTriangleTextureID0s.clear();
 		outVisibleTriangleTextureID1s.clear();
 
-		const Double4 modelPositionXYZW(modelPosition, 0.0);
-		const Double4 preScaleTranslationXYZW(preScaleTranslation, 1.0);
+		const VertexTransform vertexTransform = MakeVertexTransform(vertexShaderType, modelPosition, preScaleTranslation,
+			rotation, scale, eye);
+		TransformVertices(vertexTransform, vertices, normals, vertexCount);
+		ClassifyVertices(clippingPlanes, eye, vertexCount);
+
+		const float *vertexXs = g_vertexXs.data();
+		const float *vertexYs = g_vertexYs.data();
+		const float *vertexZs = g_vertexZs.data();
+		const float *normalXs = g_normalXs.data();
+		const float *normalYs = g_normalYs.data();
+		const float *normalZs = g_normalZs.data();
+		const uint8_t *outsideMasks = g_vertexOutsideMasks.data();
+		const uint8_t *straddleMasks = g_vertexStraddleMasks.data();
+		const float *texCoordUs = texCoords.begin();
+		const float *texCoordVs = texCoordUs + vertexCount;
+
+		auto makeWorldPoint = [&eye, vertexXs, vertexYs, vertexZs](int32_t index)
+		{
+			return Double3(
+				eye.x + static_cast<double>(vertexXs[index]),
+				eye.y + static_cast<double>(vertexYs[index]),
+				eye.z + static_cast<double>(vertexZs[index]));
+		};
+
+		auto makeNormal = [normalXs, normalYs, normalZs](int32_t index)
+		{
+			return Double3(static_cast<double>(normalXs[index]), static_cast<double>(normalYs[index]), static_cast<double>(normalZs[index]));
+		};
+
+		auto makeUV = [texCoordUs, texCoordVs](int32_t index)
+		{
+			return Double2(static_cast<double>(texCoordUs[index]), static_cast<double>(texCoordVs[index]));
+		};
 
-		const double *verticesPtr = vertexBuffer.vertices.begin();
-		const double *normalsPtr = normalBuffer.attributes.begin();
-		const double *texCoordsPtr = texCoordBuffer.attributes.begin();
-		const int32_t *indicesPtr = indexBuffer.indices.begin();
-		const int triangleCount = indexBuffer.indices.getCount() / 3;
+		const int32_t *indicesPtr = indices.begin();
+		const int triangleCount = indices.getCount() / 3;
 		for (int i = 0; i < triangleCount; i++)
 		{
 			const int indexBufferBase = i * 3;
 			const int32_t index0 = indicesPtr[indexBufferBase];
 			const int32_t index1 = indicesPtr[indexBufferBase + 1];
 			const int32_t index2 = indicesPtr[indexBufferBase + 2];
-			const int32_t v0Index = index0 * 3;
-			const int32_t v1Index = index1 * 3;
-			const int32_t v2Index = index2 * 3;
-			const int32_t normal0Index = v0Index;
-			const int32_t normal1Index = v1Index;
-			const int32_t normal2Index = v2Index;
-
-			const Double4 unshadedV0(
-				*(verticesPtr + v0Index),
-				*(verticesPtr + v0Index + 1),
-				*(verticesPtr + v0Index + 2),
-				1.0);
-			const Double4 unshadedV1(
-				*(verticesPtr + v1Index),
-				*(verticesPtr + v1Index + 1),
-				*(verticesPtr + v1Index + 2),
-				1.0);
-			const Double4 unshadedV2(
-				*(verticesPtr + v2Index),
-				*(verticesPtr + v2Index + 1),
-				*(verticesPtr + v2Index + 2),
-				1.0);
-			const Double4 unshadedNormal0(
-				*(normalsPtr + normal0Index),
-				*(normalsPtr + normal0Index + 1),
-				*(normalsPtr + normal0Index + 2),
-				0.0);
-			const Double4 unshadedNormal1(
-				*(normalsPtr + normal1Index),
-				*(normalsPtr + normal1Index + 1),
-				*(normalsPtr + normal1Index + 2),
-				0.0);
-			const Double4 unshadedNormal2(
-				*(normalsPtr + normal2Index),
-				*(normalsPtr + normal2Index + 1),
-				*(normalsPtr + normal2Index + 2),
-				0.0);
-
-			Double4 shadedV0, shadedV1, shadedV2;
-			Double4 shadedNormal0, shadedNormal1, shadedNormal2;
-			switch (vertexShaderType)
-			{
-			case VertexShaderType::Voxel:
-				shadedV0 = unshadedV0 + modelPositionXYZW;
-				shadedV1 = unshadedV1 + modelPositionXYZW;
-				shadedV2 = unshadedV2 + modelPositionXYZW;
-				shadedNormal0 = unshadedNormal0;
-				shadedNormal1 = unshadedNormal1;
-				shadedNormal2 = unshadedNormal2;
-				break;
-			case VertexShaderType::SwingingDoor:
-				shadedV0 = (rotation * unshadedV0) + modelPositionXYZW;
-				shadedV1 = (rotation * unshadedV1) + modelPositionXYZW;
-				shadedV2 = (rotation * unshadedV2) + modelPositionXYZW;
-				shadedNormal0 = rotation * unshadedNormal0;
-				shadedNormal1 = rotation * unshadedNormal1;
-				shadedNormal2 = rotation * unshadedNormal2;
-				break;
-			case VertexShaderType::SlidingDoor:
-				shadedV0 = (rotation * (scale * unshadedV0)) + modelPositionXYZW;
-				shadedV1 = (rotation * (scale * unshadedV1)) + modelPositionXYZW;
-				shadedV2 = (rotation * (scale * unshadedV2)) + modelPositionXYZW;
-				shadedNormal0 = rotation * unshadedNormal0;
-				shadedNormal1 = rotation * unshadedNormal1;
-				shadedNormal2 = rotation * unshadedNormal2;
-				break;
-			case VertexShaderType::RaisingDoor:
-				// Need to push + pop a translation so it scales towards the ceiling.
-				shadedV0 = unshadedV0 + preScaleTranslationXYZW;
-				shadedV1 = unshadedV1 + preScaleTranslationXYZW;
-				shadedV2 = unshadedV2 + preScaleTranslationXYZW;
-				shadedV0 = scale * shadedV0;
-				shadedV1 = scale * shadedV1;
-				shadedV2 = scale * shadedV2;
-				shadedV0 = shadedV0 - preScaleTranslationXYZW;
-				shadedV1 = shadedV1 - preScaleTranslationXYZW;
-				shadedV2 = shadedV2 - preScaleTranslationXYZW;
-
-				shadedV0 = (rotation * shadedV0) + modelPositionXYZW;
-				shadedV1 = (rotation * shadedV1) + modelPositionXYZW;
-				shadedV2 = (rotation * shadedV2) + modelPositionXYZW;
-				shadedNormal0 = rotation * unshadedNormal0;
-				shadedNormal1 = rotation * unshadedNormal1;
-				shadedNormal2 = rotation * unshadedNormal2;
-				break;
-			case VertexShaderType::SplittingDoor:
+
+			// Discard back-facing. The eye is the origin of the batch.
+			const float v0ToEyeDotNormal0 = -((vertexXs[index0] * normalXs[index0]) + (vertexYs[index0] * normalYs[index0]) +
+				(vertexZs[index0] * normalZs[index0]));
+			if (v0ToEyeDotNormal0 < Constants::Epsilon)
 			{
-				DebugNotImplemented();
-				break;
+				continue;
 			}
-			case VertexShaderType::Entity:
-				shadedV0 = (rotation * (scale * unshadedV0)) + modelPositionXYZW;
-				shadedV1 = (rotation * (scale * unshadedV1)) + modelPositionXYZW;
-				shadedV2 = (rotation * (scale * unshadedV2)) + modelPositionXYZW;
-				shadedNormal0 = unshadedNormal0;
-				shadedNormal1 = unshadedNormal1;
-				shadedNormal2 = unshadedNormal2;
-				break;
-			default:
-				DebugNotImplementedMsg(std::to_string(static_cast<int>(vertexShaderType)));
-				break;
+
+			// Discard if every vertex is outside the same plane.
+			if ((outsideMasks[index0] & outsideMasks[index1] & outsideMasks[index2]) != 0)
+			{
+				continue;
 			}
 
-			const Double3 shadedV0XYZ(shadedV0.x, shadedV0.y, shadedV0.z);
-			const Double3 shadedV1XYZ(shadedV1.x, shadedV1.y, shadedV1.z);
-			const Double3 shadedV2XYZ(shadedV2.x, shadedV2.y, shadedV2.z);
-			const Double3 shadedNormal0XYZ(shadedNormal0.x, shadedNormal0.y, shadedNormal0.z);
-			const Double3 shadedNormal1XYZ(shadedNormal1.x, shadedNormal1.y, shadedNormal1.z);
-			const Double3 shadedNormal2XYZ(shadedNormal2.x, shadedNormal2.y, shadedNormal2.z);
-			const Double2 uv0(
-				*(texCoordsPtr + (index0 * 2)),
-				*(texCoordsPtr + (index0 * 2) + 1));
-			const Double2 uv1(
-				*(texCoordsPtr + (index1 * 2)),
-				*(texCoordsPtr + (index1 * 2) + 1));
-			const Double2 uv2(
-				*(texCoordsPtr + (index2 * 2)),
-				*(texCoordsPtr + (index2 * 2) + 1));
-
-			// Discard back-facing.
-			const Double3 v0ToEye = eye - shadedV0XYZ;
-			if (v0ToEye.dot(shadedNormal0XYZ) < Constants::Epsilon)
+			const Double3 shadedV0XYZ = makeWorldPoint(index0);
+			const Double3 shadedV1XYZ = makeWorldPoint(index1);
+			const Double3 shadedV2XYZ = makeWorldPoint(index2);
+			const Double3 shadedNormal0XYZ = makeNormal(index0);
+			const Double3 shadedNormal1XYZ = makeNormal(index1);
+			const Double3 shadedNormal2XYZ = makeNormal(index2);
+			const Double2 uv0 = makeUV(index0);
+			const Double2 uv1 = makeUV(index1);
+			const Double2 uv2 = makeUV(index2);
+
+			const uint8_t straddleMask = straddleMasks[index0] | straddleMasks[index1] | straddleMasks[index2];
+			if (straddleMask == 0)
 			{
+				// Entirely inside the frustum.
+				outVisibleTriangleV0s.emplace_back(shadedV0XYZ);
+				outVisibleTriangleV1s.emplace_back(shadedV1XYZ);
+				outVisibleTriangleV2s.emplace_back(shadedV2XYZ);
+				outVisibleTriangleNormal0s.emplace_back(shadedNormal0XYZ);
+				outVisibleTriangleNormal1s.emplace_back(shadedNormal1XYZ);
+				outVisibleTriangleNormal2s.emplace_back(shadedNormal2XYZ);
+				outVisibleTriangleUV0s.emplace_back(uv0);
+				outVisibleTriangleUV1s.emplace_back(uv1);
+				outVisibleTriangleUV2s.emplace_back(uv2);
+				outVisibleTriangleTextureID0s.emplace_back(textureID0);
+				outVisibleTriangleTextureID1s.emplace_back(textureID1);
 				continue;
 			}
 
@@ -537,8 +716,15 @@ namespace swGeometry
 			outClipListTextureID0s[clipListFrontIndex] = textureID0;
 			outClipListTextureID1s[clipListFrontIndex] = textureID1;
 
-			for (const ClippingPlane &plane : clippingPlanes)
+			for (int planeIndex = 0; planeIndex < static_cast<int>(clippingPlanes.size()); planeIndex++)
 			{
+				// Vertices clipped against other planes stay on the inside of this one.
+				if ((straddleMask & (1 << planeIndex)) == 0)
+				{
+					continue;
+				}
+
+				const ClippingPlane &plane = clippingPlanes[planeIndex];
 				const int trianglesToClipCount = clipListSize - clipListFrontIndex;
 				for (int j = trianglesToClipCount; j > 0; j--)
 				{
@@ -632,6 +818,40 @@ namespace swGeometry
 // Rendering functions, per-pixel work.
 namespace swRender
 {
+	// Trilinearly filters the baked intensities at the given point, clamped to the lightmap's box.
+	double SampleLightmap(const SoftwareRenderer::Lightmap &lightmap, const Double3 &worldPoint)
+	{
+		const Buffer3D<uint8_t> &intensities = lightmap.intensities;
+		const int maxX = intensities.getWidth() - 1;
+		const int maxY = intensities.getHeight() - 1;
+		const int maxZ = intensities.getDepth() - 1;
+		const double sampleX = std::clamp((worldPoint.x - lightmap.minPoint.x) * lightmap.sampleScale.x, 0.0, static_cast<double>(maxX));
+		const double sampleY = std::clamp((worldPoint.y - lightmap.minPoint.y) * lightmap.sampleScale.y, 0.0, static_cast<double>(maxY));
+		const double sampleZ = std::clamp((worldPoint.z - lightmap.minPoint.z) * lightmap.sampleScale.z, 0.0, static_cast<double>(maxZ));
+		const int x0 = std::min(static_cast<int>(sampleX), maxX - 1);
+		const int y0 = std::min(static_cast<int>(sampleY), maxY - 1);
+		const int z0 = std::min(static_cast<int>(sampleZ), maxZ - 1);
+		const double xPercent = sampleX - static_cast<double>(x0);
+		const double yPercent = sampleY - static_cast<double>(y0);
+		const double zPercent = sampleZ - static_cast<double>(z0);
+
+		auto lerpX = [&intensities, x0, xPercent](int y, int z)
+		{
+			const double a = static_cast<double>(intensities.get(x0, y, z));
+			const double b = static_cast<double>(intensities.get(x0 + 1, y, z));
+			return a + ((b - a) * xPercent);
+		};
+
+		const double y0z0 = lerpX(y0, z0);
+		const double y1z0 = lerpX(y0 + 1, z0);
+		const double y0z1 = lerpX(y0, z0 + 1);
+		const double y1z1 = lerpX(y0 + 1, z0 + 1);
+		const double z0Value = y0z0 + ((y1z0 - y0z0) * yPercent);
+		const double z1Value = y0z1 + ((y1z1 - y0z1) * yPercent);
+		const double value = z0Value + ((z1Value - z0Value) * zPercent);
+		return value / 255.0;
+	}
+
 	void DrawDebugRGB(const RenderCamera &camera, BufferView2D<uint32_t> &colorBuffer)
 	{
 		const int frameBufferWidth = colorBuffer.getWidth();
@@ -714,17 +934,24 @@ namespace swRender
 		const uint8_t *texels;
 		int width, height;
 		double widthReal, heightReal;
+		bool isTiled;
 		TextureSamplingType samplingType;
 
-		void init(const uint8_t *texels, int width, int height, TextureSamplingType samplingType)
+		void init(const SoftwareRenderer::ObjectTexture::MipLevel &mipLevel, TextureSamplingType samplingType)
 		{
-			this->texels = texels;
-			this->width = width;
-			this->height = height;
-			this->widthReal = static_cast<double>(width);
-			this->heightReal = static_cast<double>(height);
+			this->texels = mipLevel.texels;
+			this->width = mipLevel.width;
+			this->height = mipLevel.height;
+			this->widthReal = static_cast<double>(mipLevel.width);
+			this->heightReal = static_cast<double>(mipLevel.height);
+			this->isTiled = mipLevel.isTiled;
 			this->samplingType = samplingType;
 		}
+
+		int getTexelIndex(int x, int y) const
+		{
+			return swTexture::GetTexelIndex(x, y, this->width, this->isTiled);
+		}
 	};
 
 	struct PixelShaderPalette
@@ -771,7 +998,7 @@ namespace swRender
 			texelY = std::clamp(static_cast<int>(actualV * texture.height), 0, texture.height - 1);
 		}
 
-		const int texelIndex = texelX + (texelY * texture.width);
+		const int texelIndex = texture.getTexelIndex(texelX, texelY);
 		const uint8_t texel = texture.texels[texelIndex];
 
 		const int shadedTexelIndex = texel + (lighting.lightLevel * lighting.texelsPerLightLevel);
@@ -785,7 +1012,7 @@ namespace swRender
 	{
 		const int layerTexelX = std::clamp(static_cast<int>(perspective.texelPercent.x * alphaTestTexture.widthReal), 0, alphaTestTexture.width - 1);
 		const int layerTexelY = std::clamp(static_cast<int>(perspective.texelPercent.y * alphaTestTexture.heightReal), 0, alphaTestTexture.height - 1);
-		const int layerTexelIndex = layerTexelX + (layerTexelY * alphaTestTexture.width);
+		const int layerTexelIndex = alphaTestTexture.getTexelIndex(layerTexelX, layerTexelY);
 		uint8_t texel = alphaTestTexture.texels[layerTexelIndex];
 
 		const bool isTransparent = texel == 0;
@@ -797,7 +1024,7 @@ namespace swRender
 			const double actualV = v >= 1.0 ? (v - 1.0) : v;
 			const int texelY = std::clamp(static_cast<int>(actualV * opaqueTexture.heightReal), 0, opaqueTexture.height - 1);
 
-			const int texelIndex = texelX + (texelY * opaqueTexture.width);
+			const int texelIndex = opaqueTexture.getTexelIndex(texelX, texelY);
 			texel = opaqueTexture.texels[texelIndex];
 		}
 
@@ -812,7 +1039,7 @@ namespace swRender
 	{
 		const int texelX = std::clamp(static_cast<int>(perspective.texelPercent.x * texture.widthReal), 0, texture.width - 1);
 		const int texelY = std::clamp(static_cast<int>(perspective.texelPercent.y * texture.heightReal), 0, texture.height - 1);
-		const int texelIndex = texelX + (texelY * texture.width);
+		const int texelIndex = texture.getTexelIndex(texelX, texelY);
 		const uint8_t texel = texture.texels[texelIndex];
 
 		const bool isTransparent = texel == 0;
@@ -833,7 +1060,7 @@ namespace swRender
 		const double u = std::clamp(uMin + ((1.0 - uMin) * perspective.texelPercent.x), uMin, 1.0);
 		const int texelX = std::clamp(static_cast<int>(u * texture.widthReal), 0, texture.width - 1);
 		const int texelY = std::clamp(static_cast<int>(perspective.texelPercent.y * texture.height), 0, texture.height - 1);
-		const int texelIndex = texelX + (texelY * texture.width);
+		const int texelIndex = texture.getTexelIndex(texelX, texelY);
 		const uint8_t texel = texture.texels[texelIndex];
 
 		const bool isTransparent = texel == 0;
@@ -855,7 +1082,7 @@ namespace swRender
 		const double v = std::clamp(vMin + ((1.0 - vMin) * perspective.texelPercent.y), vMin, 1.0);
 		const int texelY = std::clamp(static_cast<int>(v * texture.heightReal), 0, texture.height - 1);
 
-		const int texelIndex = texelX + (texelY * texture.width);
+		const int texelIndex = texture.getTexelIndex(texelX, texelY);
 		const uint8_t texel = texture.texels[texelIndex];
 
 		const bool isTransparent = texel == 0;
@@ -875,7 +1102,7 @@ namespace swRender
 	{
 		const int texelX = std::clamp(static_cast<int>(perspective.texelPercent.x * texture.widthReal), 0, texture.width - 1);
 		const int texelY = std::clamp(static_cast<int>(perspective.texelPercent.y * texture.heightReal), 0, texture.height - 1);
-		const int texelIndex = texelX + (texelY * texture.width);
+		const int texelIndex = texture.getTexelIndex(texelX, texelY);
 		const uint8_t texel = texture.texels[texelIndex];
 
 		const bool isTransparent = texel == 0;
@@ -884,7 +1111,7 @@ namespace swRender
 			return;
 		}
 
-		const uint8_t replacementTexel = lookupTexture.texels[texel];
+		const uint8_t replacementTexel = lookupTexture.texels[lookupTexture.getTexelIndex(texel, 0)];
 
 		const int shadedTexelIndex = replacementTexel + (lighting.lightLevel * lighting.texelsPerLightLevel);
 		const uint8_t shadedTexel = lighting.lightTableTexels[shadedTexelIndex];
@@ -897,7 +1124,7 @@ namespace swRender
 	{
 		const int texelX = std::clamp(static_cast<int>(perspective.texelPercent.x * texture.widthReal), 0, texture.width - 1);
 		const int texelY = std::clamp(static_cast<int>(perspective.texelPercent.y * texture.heightReal), 0, texture.height - 1);
-		const int texelIndex = texelX + (texelY * texture.width);
+		const int texelIndex = texture.getTexelIndex(texelX, texelY);
 		const uint8_t texel = texture.texels[texelIndex];
 
 		const bool isTransparent = texel == 0;
@@ -918,7 +1145,7 @@ namespace swRender
 	{
 		const int texelX = std::clamp(static_cast<int>(perspective.texelPercent.x * texture.widthReal), 0, texture.width - 1);
 		const int texelY = std::clamp(static_cast<int>(perspective.texelPercent.y * texture.heightReal), 0, texture.height - 1);
-		const int texelIndex = texelX + (texelY * texture.width);
+		const int texelIndex = texture.getTexelIndex(texelX, texelY);
 		const uint8_t texel = texture.texels[texelIndex];
 
 		const bool isTransparent = texel == 0;
@@ -956,8 +1183,8 @@ namespace swRender
 		frameBuffer.depth[frameBuffer.pixelIndex] = perspective.cameraZDepth;
 	}
 
-	void PixelShader_AlphaTestedWithPreviousBrightnessLimit(const PixelShaderPerspectiveCorrection &perspective,
-		const PixelShaderTexture &texture, PixelShaderFrameBuffer &frameBuffer)
+	// Whether a star can be drawn over the given color (i.e. the sky behind it isn't too bright).
+	bool IsDarkEnoughForStar(uint32_t color)
 	{
 		constexpr int brightnessLimit = 0x3F; // Highest value each RGB component can be.
 		constexpr uint8_t brightnessMask = ~brightnessLimit;
@@ -965,18 +1192,22 @@ namespace swRender
 		constexpr uint32_t brightnessMaskG = brightnessMask << 8;
 		constexpr uint32_t brightnessMaskB = brightnessMask;
 		constexpr uint32_t brightnessMaskRGB = brightnessMaskR | brightnessMaskG | brightnessMaskB;
+		return (color & brightnessMaskRGB) == 0;
+	}
 
+	void PixelShader_AlphaTestedWithPreviousBrightnessLimit(const PixelShaderPerspectiveCorrection &perspective,
+		const PixelShaderTexture &texture, PixelShaderFrameBuffer &frameBuffer)
+	{
 		const uint8_t prevFrameBufferPixel = frameBuffer.colors[frameBuffer.pixelIndex];
 		const uint32_t prevFrameBufferColor = frameBuffer.palette.colors[prevFrameBufferPixel];
-		const bool isDarkEnough = (prevFrameBufferColor & brightnessMaskRGB) == 0;
-		if (!isDarkEnough)
+		if (!IsDarkEnoughForStar(prevFrameBufferColor))
 		{
 			return;
 		}
 
 		const int texelX = std::clamp(static_cast<int>(perspective.texelPercent.x * texture.widthReal), 0, texture.width - 1);
 		const int texelY = std::clamp(static_cast<int>(perspective.texelPercent.y * texture.heightReal), 0, texture.height - 1);
-		const int texelIndex = texelX + (texelY * texture.width);
+		const int texelIndex = texture.getTexelIndex(texelX, texelY);
 		const uint8_t texel = texture.texels[texelIndex];
 
 		const bool isTransparent = texel == 0;
@@ -992,8 +1223,8 @@ namespace swRender
 	// The provided triangles are assumed to be back-face culled and clipped.
 	void RasterizeTriangles(const swGeometry::TriangleDrawListIndices &drawListIndices, TextureSamplingType textureSamplingType0,
 		TextureSamplingType textureSamplingType1, RenderLightingType lightingType, double meshLightPercent, double ambientPercent,
-		BufferView<const SoftwareRenderer::Light*> lights, PixelShaderType pixelShaderType, double pixelShaderParam0,
-		const SoftwareRenderer::ObjectTexturePool &textures, const SoftwareRenderer::ObjectTexture &paletteTexture,
+		BufferView<const SoftwareRenderer::Light*> lights, const SoftwareRenderer::Lightmap *lightmap, PixelShaderType pixelShaderType, double pixelShaderParam0,
+		bool useMipmaps, const SoftwareRenderer::ObjectTexturePool &textures, const SoftwareRenderer::ObjectTexture &paletteTexture,
 		const SoftwareRenderer::ObjectTexture &lightTableTexture, const RenderCamera &camera,
 		BufferView2D<uint8_t> paletteIndexBuffer, BufferView2D<double> depthBuffer, BufferView2D<uint32_t> colorBuffer)
 	{
@@ -1094,14 +1325,32 @@ namespace swRender
 			const ObjectTextureID textureID1 = swGeometry::g_visibleTriangleTextureID1s[index];
 			const SoftwareRenderer::ObjectTexture &texture0 = textures.get(textureID0);
 
+			// Per-triangle level of detail from how many texels land on each covered pixel. Every mip level has a
+			// quarter of the texels of the one before it. Triangles are small (one per voxel face half), so this
+			// is close to per-pixel selection without the cost.
+			int mipLevel0 = 0;
+			if (useMipmaps && (textureSamplingType0 == TextureSamplingType::Default) && (texture0.mipLevelCount > 1))
+			{
+				const Double2 screenSpace02 = screenSpace2_2D - screenSpace0_2D;
+				const double screenArea = std::abs((screenSpace01.x * screenSpace02.y) - (screenSpace01.y * screenSpace02.x));
+				const Double2 uv01 = uv1 - uv0;
+				const Double2 uv02 = uv2 - uv0;
+				const double texelArea = std::abs((uv01.x * uv02.y) - (uv01.y * uv02.x)) * static_cast<double>(texture0.texelCount);
+				if ((screenArea > Constants::Epsilon) && (texelArea > screenArea))
+				{
+					const double lod = 0.5 * std::log2(texelArea / screenArea);
+					mipLevel0 = std::clamp(static_cast<int>(lod), 0, texture0.mipLevelCount - 1);
+				}
+			}
+
 			PixelShaderTexture shaderTexture0;
-			shaderTexture0.init(texture0.texels8Bit, texture0.width, texture0.height, textureSamplingType0);
+			shaderTexture0.init(texture0.mipLevels[mipLevel0], textureSamplingType0);
 
 			PixelShaderTexture shaderTexture1;
 			if (requiresTwoTextures)
 			{
 				const SoftwareRenderer::ObjectTexture &texture1 = textures.get(textureID1);
-				shaderTexture1.init(texture1.texels8Bit, texture1.width, texture1.height, textureSamplingType1);
+				shaderTexture1.init(texture1.mipLevels[0], textureSamplingType1);
 			}
 
 			for (int y = yStart; y < yEnd; y++)
@@ -1152,7 +1401,12 @@ namespace swRender
 							if (requiresPerPixelLightIntensity)
 							{
 								lightIntensitySum = ambientPercent;
-								for (int lightIndex = 0; lightIndex < lightCount; lightIndex++)
+								if (lightmap != nullptr)
+								{
+									lightIntensitySum = std::min(lightIntensitySum + SampleLightmap(*lightmap, shaderWorldPoint), 1.0);
+								}
+
+								for (int lightIndex = 0; (lightIndex < lightCount) && (lightIntensitySum < 1.0); lightIndex++)
 								{
 									const SoftwareRenderer::Light &light = *lightsPtr[lightIndex];
 									const Double3 lightPointDiff = light.worldPoint - shaderWorldPoint;
@@ -1275,6 +1529,87 @@ namespace swRender
 			}
 		}
 	}
+
+	// Draws small stars as projected point sprites directly into the frame buffer. This runs after all draw calls
+	// so a star is only written where nothing closer than it has been drawn and the sky behind it is dark enough.
+	void DrawSkyPoints(BufferView<const RenderSkyPoint> skyPoints, const SoftwareRenderer::ObjectTexture &paletteTexture,
+		const RenderCamera &camera, BufferView2D<uint8_t> paletteIndexBuffer, BufferView2D<double> depthBuffer,
+		BufferView2D<uint32_t> colorBuffer)
+	{
+		const int frameBufferWidth = paletteIndexBuffer.getWidth();
+		const int frameBufferHeight = paletteIndexBuffer.getHeight();
+		const double frameBufferWidthReal = static_cast<double>(frameBufferWidth);
+		const double frameBufferHeightReal = static_cast<double>(frameBufferHeight);
+		uint8_t *paletteIndexBufferPtr = paletteIndexBuffer.begin();
+		double *depthBufferPtr = depthBuffer.begin();
+		uint32_t *colorBufferPtr = colorBuffer.begin();
+		const uint32_t *paletteColors = paletteTexture.texels32Bit;
+
+		const Matrix4d &viewMatrix = camera.viewMatrix;
+		const Matrix4d &perspectiveMatrix = camera.perspectiveMatrix;
+		constexpr double yShear = 0.0;
+		constexpr double starDistance = RendererUtils::SKY_STAR_DISTANCE;
+
+		// Screen-space scale of something one unit wide/tall at one unit of camera depth.
+		const double pixelsPerUnitX = perspectiveMatrix.x.x * 0.50 * frameBufferWidthReal;
+		const double pixelsPerUnitY = perspectiveMatrix.y.y * 0.50 * frameBufferHeightReal;
+
+		const int skyPointCount = skyPoints.getCount();
+		for (int i = 0; i < skyPointCount; i++)
+		{
+			const RenderSkyPoint &skyPoint = skyPoints.get(i);
+			if (skyPoint.paletteIndex == 0)
+			{
+				continue; // Transparent.
+			}
+
+			// Only the view rotation applies since sky points are infinitely far from the camera.
+			const Double4 viewDir = RendererUtils::worldSpaceToCameraSpace(Double4(skyPoint.direction, 0.0), viewMatrix);
+			const double viewZ = viewDir.z * starDistance;
+			if (viewZ <= RendererUtils::NEAR_PLANE)
+			{
+				continue; // Behind the camera.
+			}
+
+			const Double4 viewPoint(viewDir.x * starDistance, viewDir.y * starDistance, viewZ, 1.0);
+			const Double4 clipPoint = RendererUtils::cameraSpaceToClipSpace(viewPoint, perspectiveMatrix);
+			const Double3 ndcPoint = RendererUtils::clipSpaceToNDC(clipPoint);
+			const Double3 screenSpacePoint = RendererUtils::ndcToScreenSpace(ndcPoint, yShear, frameBufferWidthReal, frameBufferHeightReal);
+
+			// Always cover at least one pixel center. Anchored at the bottom center like other sky objects.
+			const double depthScale = starDistance / viewZ;
+			const double pixelWidth = std::max(skyPoint.width * depthScale * pixelsPerUnitX, 1.0);
+			const double pixelHeight = std::max(skyPoint.height * depthScale * pixelsPerUnitY, 1.0);
+			const int xStart = RendererUtils::getLowerBoundedPixel(screenSpacePoint.x - (pixelWidth * 0.50), frameBufferWidth);
+			const int xEnd = RendererUtils::getLowerBoundedPixel(screenSpacePoint.x + (pixelWidth * 0.50), frameBufferWidth);
+			const int yStart = RendererUtils::getLowerBoundedPixel(screenSpacePoint.y - pixelHeight, frameBufferHeight);
+			const int yEnd = RendererUtils::getLowerBoundedPixel(screenSpacePoint.y, frameBufferHeight);
+
+			const uint8_t paletteIndex = skyPoint.paletteIndex;
+			const uint32_t color = paletteColors[paletteIndex];
+			for (int y = yStart; y < yEnd; y++)
+			{
+				for (int x = xStart; x < xEnd; x++)
+				{
+					const int pixelIndex = x + (y * frameBufferWidth);
+					if (viewZ >= depthBufferPtr[pixelIndex])
+					{
+						continue;
+					}
+
+					const uint8_t prevPaletteIndex = paletteIndexBufferPtr[pixelIndex];
+					if (!IsDarkEnoughForStar(paletteColors[prevPaletteIndex]))
+					{
+						continue;
+					}
+
+					paletteIndexBufferPtr[pixelIndex] = paletteIndex;
+					depthBufferPtr[pixelIndex] = viewZ;
+					colorBufferPtr[pixelIndex] = color;
+				}
+			}
+		}
+	}
 }
 
 SoftwareRenderer::ObjectTexture::ObjectTexture()
@@ -1287,6 +1622,7 @@ SoftwareRenderer::ObjectTexture::ObjectTexture()
 	this->heightReal = 0.0;
 	this->texelCount = 0;
 	this->bytesPerTexel = 0;
+	this->mipLevelCount = 0;
 }
 
 void SoftwareRenderer::ObjectTexture::init(int width, int height, int bytesPerTexel)
@@ -1317,28 +1653,141 @@ void SoftwareRenderer::ObjectTexture::init(int width, int height, int bytesPerTe
 	this->widthReal = static_cast<double>(width);
 	this->heightReal = static_cast<double>(height);
 	this->bytesPerTexel = bytesPerTexel;
+
+	// Only 8-bit textures are sampled by the rasterizer. Levels go down to 1 texel in the larger dimension.
+	this->mipLevelCount = 0;
+	this->mipTexels.clear();
+	if (bytesPerTexel == 1)
+	{
+		int mipTexelCount = 0;
+		int levelCount = 0;
+		while (levelCount < MAX_MIP_LEVELS)
+		{
+			const int levelWidth = swTexture::GetMipDimension(width, levelCount);
+			const int levelHeight = swTexture::GetMipDimension(height, levelCount);
+			const bool isTiled = swTexture::CanTile(levelWidth, levelHeight);
+			if ((levelCount > 0) || isTiled)
+			{
+				mipTexelCount += levelWidth * levelHeight;
+			}
+
+			levelCount++;
+			if ((levelWidth == 1) && (levelHeight == 1))
+			{
+				break;
+			}
+		}
+
+		if (mipTexelCount > 0)
+		{
+			this->mipTexels.init(mipTexelCount);
+			this->mipTexels.fill(0);
+		}
+
+		int mipTexelOffset = 0;
+		for (int i = 0; i < levelCount; i++)
+		{
+			MipLevel &level = this->mipLevels[i];
+			level.width = swTexture::GetMipDimension(width, i);
+			level.height = swTexture::GetMipDimension(height, i);
+			level.isTiled = swTexture::CanTile(level.width, level.height);
+			if ((i == 0) && !level.isTiled)
+			{
+				level.texels = this->texels8Bit;
+			}
+			else
+			{
+				level.texels = this->mipTexels.begin() + mipTexelOffset;
+				mipTexelOffset += level.width * level.height;
+			}
+		}
+
+		this->mipLevelCount = levelCount;
+	}
+}
+
+SoftwareRenderer::ObjectTexture::MipLevel::MipLevel()
+{
+	this->texels = nullptr;
+	this->width = 0;
+	this->height = 0;
+	this->isTiled = false;
+}
+
+void SoftwareRenderer::ObjectTexture::updateMipLevels()
+{
+	if (this->mipLevelCount == 0)
+	{
+		return;
+	}
+
+	// Level 0 only needs copying if it's tiled.
+	const MipLevel &firstLevel = this->mipLevels[0];
+	if (firstLevel.isTiled)
+	{
+		uint8_t *dstTexels = const_cast<uint8_t*>(firstLevel.texels);
+		for (int y = 0; y < this->height; y++)
+		{
+			for (int x = 0; x < this->width; x++)
+			{
+				const int dstIndex = swTexture::GetTexelIndex(x, y, this->width, true);
+				dstTexels[dstIndex] = this->texels8Bit[x + (y * this->width)];
+			}
+		}
+	}
+
+	for (int i = 1; i < this->mipLevelCount; i++)
+	{
+		const MipLevel &srcLevel = this->mipLevels[i - 1];
+		const MipLevel &dstLevel = this->mipLevels[i];
+		uint8_t *dstTexels = const_cast<uint8_t*>(dstLevel.texels);
+		for (int y = 0; y < dstLevel.height; y++)
+		{
+			const int srcY0 = std::min(y * 2, srcLevel.height - 1);
+			const int srcY1 = std::min(srcY0 + 1, srcLevel.height - 1);
+			for (int x = 0; x < dstLevel.width; x++)
+			{
+				const int srcX0 = std::min(x * 2, srcLevel.width - 1);
+				const int srcX1 = std::min(srcX0 + 1, srcLevel.width - 1);
+				const uint8_t srcTexels[4] =
+				{
+					srcLevel.texels[swTexture::GetTexelIndex(srcX0, srcY0, srcLevel.width, srcLevel.isTiled)],
+					srcLevel.texels[swTexture::GetTexelIndex(srcX1, srcY0, srcLevel.width, srcLevel.isTiled)],
+					srcLevel.texels[swTexture::GetTexelIndex(srcX0, srcY1, srcLevel.width, srcLevel.isTiled)],
+					srcLevel.texels[swTexture::GetTexelIndex(srcX1, srcY1, srcLevel.width, srcLevel.isTiled)]
+				};
+
+				const int dstIndex = swTexture::GetTexelIndex(x, y, dstLevel.width, dstLevel.isTiled);
+				dstTexels[dstIndex] = swTexture::DownsampleTexels(srcTexels);
+			}
+		}
+	}
 }
 
 void SoftwareRenderer::ObjectTexture::clear()
 {
 	this->texels.clear();
+	this->mipTexels.clear();
+	this->mipLevelCount = 0;
 }
 
-void SoftwareRenderer::VertexBuffer::init(int vertexCount, int componentsPerVertex)
+SoftwareRenderer::VertexBuffer::VertexBuffer()
 {
-	const int valueCount = vertexCount * componentsPerVertex;
-	this->vertices.init(valueCount);
+	this->verticesID = -1;
+	this->vertexCount = 0;
+	this->componentsPerVertex = 0;
 }
 
-void SoftwareRenderer::AttributeBuffer::init(int vertexCount, int componentsPerVertex)
+SoftwareRenderer::AttributeBuffer::AttributeBuffer()
 {
-	const int valueCount = vertexCount * componentsPerVertex;
-	this->attributes.init(valueCount);
+	this->attributesID = -1;
+	this->vertexCount = 0;
+	this->componentsPerVertex = 0;
 }
 
-void SoftwareRenderer::IndexBuffer::init(int indexCount)
+SoftwareRenderer::IndexBuffer::IndexBuffer()
 {
-	this->indices.init(indexCount);
+	this->indicesID = -1;
 }
 
 SoftwareRenderer::Light::Light()
@@ -1354,9 +1803,44 @@ void SoftwareRenderer::Light::init(const Double3 &worldPoint, double startRadius
 	this->endRadius = endRadius;
 }
 
-SoftwareRenderer::SoftwareRenderer()
+SoftwareRenderer::Lightmap::Lightmap()
 {
+	this->sampleScale = Double3::Zero;
+}
 
+void SoftwareRenderer::Lightmap::init(const Double3 &minPoint, const Double3 &maxPoint, BufferView3D<const uint8_t> intensities)
+{
+	// Need at least two samples per axis to filter between.
+	DebugAssert(intensities.getWidth() >= 2);
+	DebugAssert(intensities.getHeight() >= 2);
+	DebugAssert(intensities.getDepth() >= 2);
+	DebugAssert(maxPoint.x > minPoint.x);
+	DebugAssert(maxPoint.y > minPoint.y);
+	DebugAssert(maxPoint.z > minPoint.z);
+
+	this->intensities.init(intensities.getWidth(), intensities.getHeight(), intensities.getDepth());
+	for (int z = 0; z < intensities.getDepth(); z++)
+	{
+		for (int y = 0; y < intensities.getHeight(); y++)
+		{
+			for (int x = 0; x < intensities.getWidth(); x++)
+			{
+				this->intensities.set(x, y, z, intensities.get(x, y, z));
+			}
+		}
+	}
+
+	this->minPoint = minPoint;
+	this->sampleScale = Double3(
+		static_cast<double>(intensities.getWidth() - 1) / (maxPoint.x - minPoint.x),
+		static_cast<double>(intensities.getHeight() - 1) / (maxPoint.y - minPoint.y),
+		static_cast<double>(intensities.getDepth() - 1) / (maxPoint.z - minPoint.z));
+}
+
+SoftwareRenderer::SoftwareRenderer()
+{
+	this->frameWidth = 0;
+	this->frameHeight = 0;
 }
 
 SoftwareRenderer::~SoftwareRenderer()
@@ -1366,8 +1850,11 @@ SoftwareRenderer::~SoftwareRenderer()
 
 void SoftwareRenderer::init(const RenderInitSettings &settings)
 {
-	this->paletteIndexBuffer.init(settings.width, settings.height);
-	this->depthBuffer.init(settings.width, settings.height);
+	const int frameBufferCount = settings.width * settings.height;
+	this->paletteIndexBuffer.init(frameBufferCount);
+	this->depthBuffer.init(frameBufferCount);
+	this->frameWidth = settings.width;
+	this->frameHeight = settings.height;
 }
 
 void SoftwareRenderer::shutdown()
@@ -1377,8 +1864,10 @@ void SoftwareRenderer::shutdown()
 	this->vertexBuffers.clear();
 	this->attributeBuffers.clear();
 	this->indexBuffers.clear();
+	this->geometryHeap.clear();
 	this->objectTextures.clear();
 	this->lights.clear();
+	this->lightmaps.clear();
 }
 
 bool SoftwareRenderer::isInited() const
@@ -1388,11 +1877,17 @@ bool SoftwareRenderer::isInited() const
 
 void SoftwareRenderer::resize(int width, int height)
 {
-	this->paletteIndexBuffer.init(width, height);
-	this->paletteIndexBuffer.fill(0);
+	const int frameBufferCount = width * height;
+	if (frameBufferCount > this->paletteIndexBuffer.getCount())
+	{
+		this->paletteIndexBuffer.init(frameBufferCount);
+		this->depthBuffer.init(frameBufferCount);
+	}
 
-	this->depthBuffer.init(width, height);
+	this->paletteIndexBuffer.fill(0);
 	this->depthBuffer.fill(std::numeric_limits<double>::infinity());
+	this->frameWidth = width;
+	this->frameHeight = height;
 }
 
 bool SoftwareRenderer::tryCreateVertexBuffer(int vertexCount, int componentsPerVertex, VertexBufferID *outID)
@@ -1400,14 +1895,25 @@ bool SoftwareRenderer::tryCreateVertexBuffer(int vertexCount, int componentsPerV
 	DebugAssert(vertexCount > 0);
 	DebugAssert(componentsPerVertex >= 2);
 
+	RenderGeometryAllocationID allocID;
+	const int byteCount = vertexCount * componentsPerVertex * static_cast<int>(sizeof(float));
+	if (!this->geometryHeap.tryAlloc(byteCount, &allocID))
+	{
+		DebugLogError("Couldn't allocate vertex buffer geometry (" + std::to_string(byteCount) + " bytes).");
+		return false;
+	}
+
 	if (!this->vertexBuffers.tryAlloc(outID))
 	{
 		DebugLogError("Couldn't allocate vertex buffer ID.");
+		this->geometryHeap.free(allocID);
 		return false;
 	}
 
 	VertexBuffer &buffer = this->vertexBuffers.get(*outID);
-	buffer.init(vertexCount, componentsPerVertex);
+	buffer.verticesID = allocID;
+	buffer.vertexCount = vertexCount;
+	buffer.componentsPerVertex = componentsPerVertex;
 	return true;
 }
 
@@ -1416,14 +1922,25 @@ bool SoftwareRenderer::tryCreateAttributeBuffer(int vertexCount, int componentsP
 	DebugAssert(vertexCount > 0);
 	DebugAssert(componentsPerVertex >= 2);
 
+	RenderGeometryAllocationID allocID;
+	const int byteCount = vertexCount * componentsPerVertex * static_cast<int>(sizeof(float));
+	if (!this->geometryHeap.tryAlloc(byteCount, &allocID))
+	{
+		DebugLogError("Couldn't allocate attribute buffer geometry (" + std::to_string(byteCount) + " bytes).");
+		return false;
+	}
+
 	if (!this->attributeBuffers.tryAlloc(outID))
 	{
 		DebugLogError("Couldn't allocate attribute buffer ID.");
+		this->geometryHeap.free(allocID);
 		return false;
 	}
 
 	AttributeBuffer &buffer = this->attributeBuffers.get(*outID);
-	buffer.init(vertexCount, componentsPerVertex);
+	buffer.attributesID = allocID;
+	buffer.vertexCount = vertexCount;
+	buffer.componentsPerVertex = componentsPerVertex;
 	return true;
 }
 
@@ -1432,22 +1949,32 @@ bool SoftwareRenderer::tryCreateIndexBuffer(int indexCount, IndexBufferID *outID
 	DebugAssert(indexCount > 0);
 	DebugAssert((indexCount % 3) == 0);
 
+	RenderGeometryAllocationID allocID;
+	const int byteCount = indexCount * static_cast<int>(sizeof(int32_t));
+	if (!this->geometryHeap.tryAlloc(byteCount, &allocID))
+	{
+		DebugLogError("Couldn't allocate index buffer geometry (" + std::to_string(byteCount) + " bytes).");
+		return false;
+	}
+
 	if (!this->indexBuffers.tryAlloc(outID))
 	{
 		DebugLogError("Couldn't allocate index buffer ID.");
+		this->geometryHeap.free(allocID);
 		return false;
 	}
 
 	IndexBuffer &buffer = this->indexBuffers.get(*outID);
-	buffer.init(indexCount);
+	buffer.indicesID = allocID;
 	return true;
 }
 
 void SoftwareRenderer::populateVertexBuffer(VertexBufferID id, BufferView<const double> vertices)
 {
-	VertexBuffer &buffer = this->vertexBuffers.get(id);
+	const VertexBuffer &buffer = this->vertexBuffers.get(id);
+	BufferView<float> dstVertices = this->geometryHeap.get<float>(buffer.verticesID);
 	const int srcCount = vertices.getCount();
-	const int dstCount = buffer.vertices.getCount();
+	const int dstCount = dstVertices.getCount();
 	if (srcCount != dstCount)
 	{
 		DebugLogError("Mismatched vertex buffer sizes for ID " + std::to_string(id) + ": " +
@@ -1455,16 +1982,31 @@ void SoftwareRenderer::populateVertexBuffer(VertexBufferID id, BufferView<const
 		return;
 	}
 
-	const auto srcBegin = vertices.begin();
-	const auto srcEnd = srcBegin + srcCount;
-	std::copy(srcBegin, srcEnd, buffer.vertices.begin());
+	swGeometry::WritePlanarComponents(vertices, buffer.vertexCount, buffer.componentsPerVertex, dstVertices);
+}
+
+void SoftwareRenderer::populateVertexBufferFloat(VertexBufferID id, BufferView<const float> vertices)
+{
+	const VertexBuffer &buffer = this->vertexBuffers.get(id);
+	BufferView<float> dstVertices = this->geometryHeap.get<float>(buffer.verticesID);
+	const int srcCount = vertices.getCount();
+	const int dstCount = dstVertices.getCount();
+	if (srcCount != dstCount)
+	{
+		DebugLogError("Mismatched vertex buffer sizes for ID " + std::to_string(id) + ": " +
+			std::to_string(srcCount) + " != " + std::to_string(dstCount));
+		return;
+	}
+
+	swGeometry::WritePlanarComponents(vertices, buffer.vertexCount, buffer.componentsPerVertex, dstVertices);
 }
 
 void SoftwareRenderer::populateAttributeBuffer(AttributeBufferID id, BufferView<const double> attributes)
 {
-	AttributeBuffer &buffer = this->attributeBuffers.get(id);
+	const AttributeBuffer &buffer = this->attributeBuffers.get(id);
+	BufferView<float> dstAttributes = this->geometryHeap.get<float>(buffer.attributesID);
 	const int srcCount = attributes.getCount();
-	const int dstCount = buffer.attributes.getCount();
+	const int dstCount = dstAttributes.getCount();
 	if (srcCount != dstCount)
 	{
 		DebugLogError("Mismatched attribute buffer sizes for ID " + std::to_string(id) + ": " +
@@ -1472,16 +2014,31 @@ void SoftwareRenderer::populateAttributeBuffer(AttributeBufferID id, BufferView<
 		return;
 	}
 
-	const auto srcBegin = attributes.begin();
-	const auto srcEnd = srcBegin + srcCount;
-	std::copy(srcBegin, srcEnd, buffer.attributes.begin());
+	swGeometry::WritePlanarComponents(attributes, buffer.vertexCount, buffer.componentsPerVertex, dstAttributes);
+}
+
+void SoftwareRenderer::populateAttributeBufferFloat(AttributeBufferID id, BufferView<const float> attributes)
+{
+	const AttributeBuffer &buffer = this->attributeBuffers.get(id);
+	BufferView<float> dstAttributes = this->geometryHeap.get<float>(buffer.attributesID);
+	const int srcCount = attributes.getCount();
+	const int dstCount = dstAttributes.getCount();
+	if (srcCount != dstCount)
+	{
+		DebugLogError("Mismatched attribute buffer sizes for ID " + std::to_string(id) + ": " +
+			std::to_string(srcCount) + " != " + std::to_string(dstCount));
+		return;
+	}
+
+	swGeometry::WritePlanarComponents(attributes, buffer.vertexCount, buffer.componentsPerVertex, dstAttributes);
 }
 
 void SoftwareRenderer::populateIndexBuffer(IndexBufferID id, BufferView<const int32_t> indices)
 {
-	IndexBuffer &buffer = this->indexBuffers.get(id);
+	const IndexBuffer &buffer = this->indexBuffers.get(id);
+	BufferView<int32_t> dstIndices = this->geometryHeap.get<int32_t>(buffer.indicesID);
 	const int srcCount = indices.getCount();
-	const int dstCount = buffer.indices.getCount();
+	const int dstCount = dstIndices.getCount();
 	if (srcCount != dstCount)
 	{
 		DebugLogError("Mismatched index buffer sizes for ID " + std::to_string(id) + ": " +
@@ -1491,21 +2048,27 @@ void SoftwareRenderer::populateIndexBuffer(IndexBufferID id, BufferView<const in
 
 	const auto srcBegin = indices.begin();
 	const auto srcEnd = srcBegin + srcCount;
-	std::copy(srcBegin, srcEnd, buffer.indices.begin());
+	std::copy(srcBegin, srcEnd, dstIndices.begin());
 }
 
 void SoftwareRenderer::freeVertexBuffer(VertexBufferID id)
 {
+	const VertexBuffer &buffer = this->vertexBuffers.get(id);
+	this->geometryHeap.free(buffer.verticesID);
 	this->vertexBuffers.free(id);
 }
 
 void SoftwareRenderer::freeAttributeBuffer(AttributeBufferID id)
 {
+	const AttributeBuffer &buffer = this->attributeBuffers.get(id);
+	this->geometryHeap.free(buffer.attributesID);
 	this->attributeBuffers.free(id);
 }
 
 void SoftwareRenderer::freeIndexBuffer(IndexBufferID id)
 {
+	const IndexBuffer &buffer = this->indexBuffers.get(id);
+	this->geometryHeap.free(buffer.indicesID);
 	this->indexBuffers.free(id);
 }
 
@@ -1541,6 +2104,7 @@ bool SoftwareRenderer::tryCreateObjectTexture(const TextureBuilder &textureBuild
 		const Buffer2D<uint8_t> &srcTexels = palettedTexture.texels;
 		uint8_t *dstTexels = reinterpret_cast<uint8_t*>(texture.texels.begin());
 		std::copy(srcTexels.begin(), srcTexels.end(), dstTexels);
+		texture.updateMipLevels();
 	}
 	else if (textureBuilderType == TextureBuilderType::TrueColor)
 	{
@@ -1565,8 +2129,9 @@ LockedTexture SoftwareRenderer::lockObjectTexture(ObjectTextureID id)
 
 void SoftwareRenderer::unlockObjectTexture(ObjectTextureID id)
 {
-	// Do nothing; any writes are already in RAM.
-	static_cast<void>(id);
+	// Writes are already in RAM but the sampling copies are stale.
+	ObjectTexture &texture = this->objectTextures.get(id);
+	texture.updateMipLevels();
 }
 
 void SoftwareRenderer::freeObjectTexture(ObjectTextureID id)
@@ -1624,10 +2189,33 @@ void SoftwareRenderer::freeLight(RenderLightID id)
 	this->lights.free(id);
 }
 
+bool SoftwareRenderer::tryCreateLightmap(RenderLightmapID *outID)
+{
+	if (!this->lightmaps.tryAlloc(outID))
+	{
+		DebugLogError("Couldn't allocate render lightmap ID.");
+		return false;
+	}
+
+	return true;
+}
+
+void SoftwareRenderer::populateLightmap(RenderLightmapID id, const Double3 &minPoint, const Double3 &maxPoint,
+	BufferView3D<const uint8_t> intensities)
+{
+	Lightmap &lightmap = this->lightmaps.get(id);
+	lightmap.init(minPoint, maxPoint, intensities);
+}
+
+void SoftwareRenderer::freeLightmap(RenderLightmapID id)
+{
+	this->lightmaps.free(id);
+}
+
 RendererSystem3D::ProfilerData SoftwareRenderer::getProfilerData() const
 {
-	const int renderWidth = this->paletteIndexBuffer.getWidth();
-	const int renderHeight = this->paletteIndexBuffer.getHeight();
+	const int renderWidth = this->frameWidth;
+	const int renderHeight = this->frameHeight;
 
 	const int threadCount = 1;
 
@@ -1637,27 +2225,30 @@ RendererSystem3D::ProfilerData SoftwareRenderer::getProfilerData() const
 
 	const int textureCount = this->objectTextures.getUsedCount();
 	int textureByteCount = 0;
-	for (int i = 0; i < this->objectTextures.getTotalCount(); i++)
+	this->objectTextures.forEach([&textureByteCount](ObjectTextureID id, const ObjectTexture &texture)
 	{
-		const ObjectTextureID id = static_cast<ObjectTextureID>(i);
-		const ObjectTexture *texturePtr = this->objectTextures.tryGet(id);
-		if (texturePtr != nullptr)
-		{
-			textureByteCount += texturePtr->texels.getCount();
-		}
-	}
+		textureByteCount += texture.texels.getCount() + texture.mipTexels.getCount();
+	});
+
+	const RenderGeometryHeap::Stats geometryStats = this->geometryHeap.getStats();
 
 	const int totalLightCount = this->lights.getUsedCount();
 
 	return ProfilerData(renderWidth, renderHeight, threadCount, drawCallCount, sceneTriangleCount,
-		visTriangleCount, textureCount, textureByteCount, totalLightCount);
+		visTriangleCount, textureCount, textureByteCount, geometryStats.slabCount, geometryStats.usedByteCount,
+		geometryStats.reservedByteCount, totalLightCount);
 }
 
 void SoftwareRenderer::submitFrame(const RenderCamera &camera, BufferView<const RenderDrawCall> drawCalls,
-	const RenderFrameSettings &settings, uint32_t *outputBuffer)
+	BufferView<const RenderSkyPoint> skyPoints, const RenderFrameSettings &settings, uint32_t *outputBuffer)
 {
-	const int frameBufferWidth = this->paletteIndexBuffer.getWidth();
-	const int frameBufferHeight = this->paletteIndexBuffer.getHeight();
+	// Render dimensions can be smaller than the frame buffers when using dynamic resolution.
+	const int frameBufferWidth = settings.renderWidth;
+	const int frameBufferHeight = settings.renderHeight;
+	DebugAssert((frameBufferWidth * frameBufferHeight) <= this->paletteIndexBuffer.getCount());
+	this->frameWidth = frameBufferWidth;
+	this->frameHeight = frameBufferHeight;
+
 	BufferView2D<uint8_t> paletteIndexBufferView(this->paletteIndexBuffer.begin(), frameBufferWidth, frameBufferHeight);
 	BufferView2D<double> depthBufferView(this->depthBuffer.begin(), frameBufferWidth, frameBufferHeight);
 	BufferView2D<uint32_t> colorBufferView(outputBuffer, frameBufferWidth, frameBufferHeight);
@@ -1671,6 +2262,9 @@ void SoftwareRenderer::submitFrame(const RenderCamera &camera, BufferView<const
 	swRender::ClearFrameBuffers(paletteIndexBufferView, depthBufferView, colorBufferView);
 	swRender::ClearTriangleDrawList();
 
+	// Chunks unloaded since the last frame leave holes in the geometry heap.
+	this->geometryHeap.compact();
+
 	const swGeometry::ClippingPlanes clippingPlanes = swGeometry::MakeClippingPlanes(camera);
 
 	const int drawCallCount = drawCalls.getCount();
@@ -1687,12 +2281,17 @@ void SoftwareRenderer::submitFrame(const RenderCamera &camera, BufferView<const
 		const AttributeBuffer &normalBuffer = this->attributeBuffers.get(drawCall.normalBufferID);
 		const AttributeBuffer &texCoordBuffer = this->attributeBuffers.get(drawCall.texCoordBufferID);
 		const IndexBuffer &indexBuffer = this->indexBuffers.get(drawCall.indexBufferID);
+		const RenderGeometryHeap &geometryHeap = this->geometryHeap;
+		const BufferView<const float> vertices = geometryHeap.get<float>(vertexBuffer.verticesID);
+		const BufferView<const float> normals = geometryHeap.get<float>(normalBuffer.attributesID);
+		const BufferView<const float> texCoords = geometryHeap.get<float>(texCoordBuffer.attributesID);
+		const BufferView<const int32_t> indices = geometryHeap.get<int32_t>(indexBuffer.indicesID);
 		const ObjectTextureID textureID0 = drawCall.textureIDs[0].has_value() ? *drawCall.textureIDs[0] : -1;
 		const ObjectTextureID textureID1 = drawCall.textureIDs[1].has_value() ? *drawCall.textureIDs[1] : -1;
 		const VertexShaderType vertexShaderType = drawCall.vertexShaderType;
 		const swGeometry::TriangleDrawListIndices drawListIndices = swGeometry::ProcessMeshForRasterization(
-			meshPosition, preScaleTranslation, rotationMatrix, scaleMatrix, vertexBuffer, normalBuffer, texCoordBuffer,
-			indexBuffer, textureID0, textureID1, vertexShaderType, camera.worldPoint, clippingPlanes);
+			meshPosition, preScaleTranslation, rotationMatrix, scaleMatrix, vertices, normals, texCoords,
+			vertexBuffer.vertexCount, indices, textureID0, textureID1, vertexShaderType, camera.worldPoint, clippingPlanes);
 
 		const TextureSamplingType textureSamplingType0 = drawCall.textureSamplingType0;
 		const TextureSamplingType textureSamplingType1 = drawCall.textureSamplingType1;
@@ -1701,6 +2300,7 @@ void SoftwareRenderer::submitFrame(const RenderCamera &camera, BufferView<const
 		double meshLightPercent = 0.0;
 		const Light *lightPtrs[RenderDrawCall::MAX_LIGHTS];
 		BufferView<const Light*> lightsView;
+		const Lightmap *lightmapPtr = nullptr;
 		if (lightingType == RenderLightingType::PerMesh)
 		{
 			meshLightPercent = drawCall.lightPercent;
@@ -1715,15 +2315,22 @@ void SoftwareRenderer::submitFrame(const RenderCamera &camera, BufferView<const
 			}
 
 			lightsView.init(lightPtrs, drawCall.lightIdCount);
+
+			if (drawCall.lightmapID >= 0)
+			{
+				lightmapPtr = &this->lightmaps.get(drawCall.lightmapID);
+			}
 		}
 
 		const double ambientPercent = settings.ambientPercent;
 		const PixelShaderType pixelShaderType = drawCall.pixelShaderType;
 		const double pixelShaderParam0 = drawCall.pixelShaderParam0;
 		swRender::RasterizeTriangles(drawListIndices, textureSamplingType0, textureSamplingType1, lightingType, meshLightPercent,
-			ambientPercent, lightsView, pixelShaderType, pixelShaderParam0, this->objectTextures, paletteTexture, lightTableTexture,
-			camera, paletteIndexBufferView, depthBufferView, colorBufferView);
+			ambientPercent, lightsView, lightmapPtr, pixelShaderType, pixelShaderParam0, settings.useMipmaps, this->objectTextures, paletteTexture,
+			lightTableTexture, camera, paletteIndexBufferView, depthBufferView, colorBufferView);
 	}
+
+	swRender::DrawSkyPoints(skyPoints, paletteTexture, camera, paletteIndexBufferView, depthBufferView, colorBufferView);
 }
 
 void SoftwareRenderer::present()
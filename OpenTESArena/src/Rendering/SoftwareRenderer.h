@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "RendererSystem3D.h"
+#include "RenderGeometryHeap.h"
 #include "../Math/MathUtils.h"
 #include "../Math/Matrix4.h"
 #include "../Math/Vector2.h"
@@ -28,40 +29,64 @@ class SoftwareRenderer : public RendererSystem3D
 public:
 	struct ObjectTexture
 	{
-		Buffer<std::byte> texels;
+		static constexpr int MAX_MIP_LEVELS = 13; // Enough for 4096x4096.
+
+		// One level of an 8-bit texture as sampled by the rasterizer.
+		struct MipLevel
+		{
+			const uint8_t *texels;
+			int width, height;
+			bool isTiled; // Stored as 8x8 blocks so nearby texels in both directions share cache lines.
+
+			MipLevel();
+		};
+
+		Buffer<std::byte> texels; // Row-major, as written through lockObjectTexture().
 		const uint8_t *texels8Bit;
 		const uint32_t *texels32Bit;
 		int width, height, texelCount;
 		double widthReal, heightReal;
 		int bytesPerTexel;
 
+		Buffer<uint8_t> mipTexels; // Sampling copies of 8-bit levels that can't point at the row-major texels.
+		MipLevel mipLevels[MAX_MIP_LEVELS];
+		int mipLevelCount;
+
 		ObjectTexture();
 
 		void init(int width, int height, int bytesPerTexel);
+		void updateMipLevels(); // Must be called after writing to texels.
 		void clear();
 	};
 
 	using ObjectTexturePool = RecyclablePool<ObjectTexture, ObjectTextureID>;
 
+	// Mesh buffers live in the geometry heap and are looked up by allocation ID when drawn. Vertices and
+	// attributes are stored as floats one component at a time (all X's, then all Y's...) so the vertex stage
+	// can transform them in batches.
 	struct VertexBuffer
 	{
-		Buffer<double> vertices;
+		RenderGeometryAllocationID verticesID;
+		int vertexCount;
+		int componentsPerVertex;
 
-		void init(int vertexCount, int componentsPerVertex);
+		VertexBuffer();
 	};
 
 	struct AttributeBuffer
 	{
-		Buffer<double> attributes;
+		RenderGeometryAllocationID attributesID;
+		int vertexCount;
+		int componentsPerVertex;
 
-		void init(int vertexCount, int componentsPerVertex);
+		AttributeBuffer();
 	};
 
 	struct IndexBuffer
 	{
-		Buffer<int32_t> indices;
+		RenderGeometryAllocationID indicesID;
 
-		void init(int indexCount);
+		IndexBuffer();
 	};
 
 	struct Light
@@ -73,19 +98,36 @@ public:
 
 		void init(const Double3 &worldPoint, double startRadius, double endRadius);
 	};
+
+	// Light intensities at evenly spaced samples over a box, from 0 (unlit) to 255 (fully lit).
+	struct Lightmap
+	{
+		Buffer3D<uint8_t> intensities;
+		Double3 minPoint;
+		Double3 sampleScale; // World units to sample units.
+
+		Lightmap();
+
+		void init(const Double3 &minPoint, const Double3 &maxPoint, BufferView3D<const uint8_t> intensities);
+	};
 private:
 	using VertexBufferPool = RecyclablePool<VertexBuffer, VertexBufferID>;
 	using AttributeBufferPool = RecyclablePool<AttributeBuffer, AttributeBufferID>;
 	using IndexBufferPool = RecyclablePool<IndexBuffer, IndexBufferID>;
 	using LightPool = RecyclablePool<Light, RenderLightID>;
+	using LightmapPool = RecyclablePool<Lightmap, RenderLightmapID>;
 
-	Buffer2D<uint8_t> paletteIndexBuffer; // Intermediate buffer to support back-to-front transparencies.
-	Buffer2D<double> depthBuffer;
+	// Frame buffers are only reallocated when growing. Each frame uses the first width * height elements.
+	Buffer<uint8_t> paletteIndexBuffer; // Intermediate buffer to support back-to-front transparencies.
+	Buffer<double> depthBuffer;
+	int frameWidth, frameHeight; // Dimensions of the most recent frame.
 	VertexBufferPool vertexBuffers;
 	AttributeBufferPool attributeBuffers;
 	IndexBufferPool indexBuffers;
+	RenderGeometryHeap geometryHeap; // Contents of all vertex, attribute, and index buffers.
 	ObjectTexturePool objectTextures;
 	LightPool lights;
+	LightmapPool lightmaps;
 public:
 	SoftwareRenderer();
 	~SoftwareRenderer() override;
@@ -100,7 +142,9 @@ public:
 	bool tryCreateAttributeBuffer(int vertexCount, int componentsPerVertex, AttributeBufferID *outID) override;
 	bool tryCreateIndexBuffer(int indexCount, IndexBufferID *outID) override;
 	void populateVertexBuffer(VertexBufferID id, BufferView<const double> vertices) override;
+	void populateVertexBufferFloat(VertexBufferID id, BufferView<const float> vertices) override;
 	void populateAttributeBuffer(AttributeBufferID id, BufferView<const double> attributes) override;
+	void populateAttributeBufferFloat(AttributeBufferID id, BufferView<const float> attributes) override;
 	void populateIndexBuffer(IndexBufferID id, BufferView<const int32_t> indices) override;
 	void freeVertexBuffer(VertexBufferID id) override;
 	void freeAttributeBuffer(AttributeBufferID id) override;
@@ -119,11 +163,15 @@ public:
 	void setLightPosition(RenderLightID id, const Double3 &worldPoint) override;
 	void setLightRadius(RenderLightID id, double startRadius, double endRadius) override;
 	void freeLight(RenderLightID id) override;
+	bool tryCreateLightmap(RenderLightmapID *outID) override;
+	void populateLightmap(RenderLightmapID id, const Double3 &minPoint, const Double3 &maxPoint,
+		BufferView3D<const uint8_t> intensities) override;
+	void freeLightmap(RenderLightmapID id) override;
 
 	ProfilerData getProfilerData() const override;
 
 	void submitFrame(const RenderCamera &camera, BufferView<const RenderDrawCall> drawCalls,
-		const RenderFrameSettings &settings, uint32_t *outputBuffer) override;
+		BufferView<const RenderSkyPoint> skyPoints, const RenderFrameSettings &settings, uint32_t *outputBuffer) override;
 	void present() override;
 };
 
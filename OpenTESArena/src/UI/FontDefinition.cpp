@@ -64,6 +64,11 @@ int FontDefinition::getCharacterHeight() const
 	return this->characterHeight;
 }
 
+int FontDefinition::getCharacterCount() const
+{
+	return this->characters.getCount();
+}
+
 bool FontDefinition::tryMakeCharLookupString(const char *c, std::string *outString)
 {
 	if (String::isNullOrEmpty(c))
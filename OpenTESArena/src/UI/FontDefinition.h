@@ -36,6 +36,8 @@ public:
 	// This can be used to determine the height of a row of text.
 	int getCharacterHeight() const;
 
+	int getCharacterCount() const;
+
 	// Attempts to get the character ID associated with the given UTF-8 character.
 	bool tryGetCharacterID(const char *c, CharID *outID) const;
 
@@ -6,9 +6,11 @@
 #include "FontLibrary.h"
 #include "TextAlignment.h"
 #include "TextBox.h"
+#include "TextRenderCache.h"
 #include "../Rendering/Renderer.h"
 
 #include "components/debug/Debug.h"
+#include "components/utilities/FrameArena.h"
 #include "components/utilities/StringView.h"
 
 TextBox::Properties::Properties(int fontDefIndex, const FontLibrary *fontLibrary,
@@ -95,6 +97,10 @@ TextBox::InitInfo TextBox::InitInfo::makeWithXY(const std::string_view &text, in
 
 TextBox::TextBox()
 {
+	this->renderer = nullptr;
+	this->isTextureRenderTarget = false;
+	this->useCpuTexture = false;
+	this->renderTargetsResetCount = 0;
 	this->dirty = false;
 }
 
@@ -106,7 +112,8 @@ bool TextBox::init(const Rect &rect, const Properties &properties, Renderer &ren
 	const int textureWidth = properties.textureGenInfo.width;
 	const int textureHeight = properties.textureGenInfo.height;
 	UiTextureID textureID;
-	if (!renderer.tryCreateUiTexture(textureWidth, textureHeight, &textureID))
+	this->isTextureRenderTarget = renderer.tryCreateUiRenderTarget(textureWidth, textureHeight, &textureID);
+	if (!this->isTextureRenderTarget && !renderer.tryCreateUiTexture(textureWidth, textureHeight, &textureID))
 	{
 		DebugLogError("Couldn't create UI texture for text box (dims: " + std::to_string(textureWidth) + "x" +
 			std::to_string(textureHeight) + ").");
@@ -114,6 +121,7 @@ bool TextBox::init(const Rect &rect, const Properties &properties, Renderer &ren
 	}
 	
 	this->textureRef.init(textureID, renderer);
+	this->renderer = &renderer;
 	this->dirty = true;
 	return true;
 }
@@ -141,13 +149,20 @@ const Rect &TextBox::getRect() const
 
 UiTextureID TextBox::getTextureID()
 {
+	// The render target's contents are gone after a reset even though the text didn't change.
+	if (this->isTextureRenderTarget && !this->useCpuTexture &&
+		(this->renderTargetsResetCount != this->renderer->getRenderTargetsResetCount()))
+	{
+		this->dirty = true;
+	}
+
 	if (this->dirty)
 	{
 		this->updateTexture();
 		DebugAssert(!this->dirty);
 	}
 
-	return this->textureRef.get();
+	return this->useCpuTexture ? this->cpuTextureRef.get() : this->textureRef.get();
 }
 
 void TextBox::setText(const std::string_view &text)
@@ -168,29 +183,44 @@ void TextBox::clearOverrideColors()
 	this->dirty = true;
 }
 
-void TextBox::updateTexture()
+bool TextBox::tryUpdateTextureQuads(const FontDefinition &fontDef)
 {
-	if (!this->dirty)
+	const TextRenderCache::GlyphAtlas *glyphAtlas = TextRenderCache::tryGetGlyphAtlas(fontDef, *this->renderer);
+	if (glyphAtlas == nullptr)
 	{
-		return;
+		return false;
+	}
+
+	const TextRenderUtils::TextShadowInfo *shadowInfoPtr = this->properties.shadowInfo.has_value() ? &(*this->properties.shadowInfo) : nullptr;
+	const BufferView<const TextRenderCache::GlyphQuad> glyphQuads = TextRenderCache::getLayout(this->text, fontDef,
+		this->textureRef.getWidth(), this->textureRef.getHeight(), this->properties.alignment, shadowInfoPtr,
+		this->properties.lineSpacing);
+
+	BufferView<RendererSystem2D::TextureQuad> textureQuads = FrameArena::allocView<RendererSystem2D::TextureQuad>(glyphQuads.getCount());
+	for (int i = 0; i < glyphQuads.getCount(); i++)
+	{
+		const TextRenderCache::GlyphQuad &glyphQuad = glyphQuads.get(i);
+		const Rect &glyphRect = glyphAtlas->glyphRects[glyphQuad.charID];
+		const Color &color = glyphQuad.isShadow ? this->properties.shadowInfo->color : this->properties.defaultColor;
+		textureQuads.set(i, RendererSystem2D::TextureQuad(glyphRect.getLeft(), glyphRect.getTop(), glyphRect.getWidth(),
+			glyphRect.getHeight(), glyphQuad.x, glyphQuad.y, color));
 	}
 
-	uint32_t *texels = this->textureRef.lockTexels();
+	this->renderer->drawUiTextureQuads(glyphAtlas->textureID, textureQuads.begin(), textureQuads.getCount(), this->textureRef.get());
+	return true;
+}
+
+void TextBox::updateTextureTexels(const FontDefinition &fontDef, ScopedUiTextureRef &dstTextureRef)
+{
+	uint32_t *texels = dstTextureRef.lockTexels();
 	if (texels == nullptr)
 	{
 		DebugLogError("Couldn't lock text box UI texture for updating.");
 		return;
 	}
 
-	// Stored for convenience of redrawing the texture. Couldn't immediately find a better way to do this.
-	// - Maybe try a FontDefinitionRef in the future.
-	const FontLibrary *fontLibrary = this->properties.fontLibrary;
-	DebugAssert(fontLibrary != nullptr);
-
-	const FontDefinition &fontDef = fontLibrary->getDefinition(this->properties.fontDefIndex);
-
-	const int width = this->textureRef.getWidth();
-	const int height = this->textureRef.getHeight();
+	const int width = dstTextureRef.getWidth();
+	const int height = dstTextureRef.getHeight();
 	BufferView2D<uint32_t> textureView(texels, width, height);
 
 	// Clear texture.
@@ -198,13 +228,66 @@ void TextBox::updateTexture()
 
 	if (!this->text.empty())
 	{
-		const Buffer<std::string_view> textLines = TextRenderUtils::getTextLines(this->text);
+		const BufferView<const std::string_view> textLines = TextRenderUtils::getTextLines(this->text);
 		const TextRenderUtils::ColorOverrideInfo *colorOverrideInfoPtr = (this->colorOverrideInfo.getEntryCount() > 0) ? &this->colorOverrideInfo : nullptr;
 		const TextRenderUtils::TextShadowInfo *shadowInfoPtr = this->properties.shadowInfo.has_value() ? &(*this->properties.shadowInfo) : nullptr;
 		TextRenderUtils::drawTextLines(textLines, fontDef, 0, 0, this->properties.defaultColor, this->properties.alignment,
 			this->properties.lineSpacing, colorOverrideInfoPtr, shadowInfoPtr, textureView);
 	}
 
-	this->textureRef.unlockTexels();
+	dstTextureRef.unlockTexels();
+}
+
+void TextBox::updateTexture()
+{
+	if (!this->dirty)
+	{
+		return;
+	}
+
+	// Stored for convenience of redrawing the texture. Couldn't immediately find a better way to do this.
+	// - Maybe try a FontDefinitionRef in the future.
+	const FontLibrary *fontLibrary = this->properties.fontLibrary;
+	DebugAssert(fontLibrary != nullptr);
+
+	const FontDefinition &fontDef = fontLibrary->getDefinition(this->properties.fontDefIndex);
+
+	// Glyph quads are tinted with one color per run, so per-character color overrides stay on the CPU path.
+	const bool hasColorOverrides = this->colorOverrideInfo.getEntryCount() > 0;
+	if (this->isTextureRenderTarget && !hasColorOverrides && this->tryUpdateTextureQuads(fontDef))
+	{
+		this->renderTargetsResetCount = this->renderer->getRenderTargetsResetCount();
+		this->useCpuTexture = false;
+		this->dirty = false;
+		return;
+	}
+
+	if (this->isTextureRenderTarget)
+	{
+		// Render targets can't be locked.
+		if (this->cpuTextureRef.get() < 0)
+		{
+			const int textureWidth = this->textureRef.getWidth();
+			const int textureHeight = this->textureRef.getHeight();
+			UiTextureID textureID;
+			if (!this->renderer->tryCreateUiTexture(textureWidth, textureHeight, &textureID))
+			{
+				DebugLogError("Couldn't create lockable UI texture for text box (dims: " + std::to_string(textureWidth) +
+					"x" + std::to_string(textureHeight) + ").");
+				return;
+			}
+
+			this->cpuTextureRef.init(textureID, *this->renderer);
+		}
+
+		this->updateTextureTexels(fontDef, this->cpuTextureRef);
+		this->useCpuTexture = true;
+	}
+	else
+	{
+		this->updateTextureTexels(fontDef, this->textureRef);
+		this->useCpuTexture = false;
+	}
+
 	this->dirty = false;
 }
@@ -62,9 +62,20 @@ private:
 	Properties properties;
 	std::string text;
 	TextRenderUtils::ColorOverrideInfo colorOverrideInfo;
-	ScopedUiTextureRef textureRef; // Output texture for rendering.
+	ScopedUiTextureRef textureRef; // Output texture for rendering. A render target when the renderer supports it.
+	ScopedUiTextureRef cpuTextureRef; // Lockable texture for text the glyph quad path can't draw, created on demand.
+	Renderer *renderer;
+	bool isTextureRenderTarget;
+	bool useCpuTexture; // Whether the latest text went to the lockable texture.
+	int renderTargetsResetCount; // The renderer's count when the render target was last drawn.
 	bool dirty;
 
+	// Draws cached glyph quads from the font's atlas into the render target. Returns false if the atlas is unavailable.
+	bool tryUpdateTextureQuads(const FontDefinition &fontDef);
+
+	// Rasterizes the text on the CPU into a lockable texture.
+	void updateTextureTexels(const FontDefinition &fontDef, ScopedUiTextureRef &dstTextureRef);
+
 	// Redraws the underlying texture for display.
 	void updateTexture();
 public:
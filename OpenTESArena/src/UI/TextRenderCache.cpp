@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "TextAlignment.h"
+#include "TextRenderCache.h"
+#include "../Rendering/Renderer.h"
+
+#include "components/debug/Debug.h"
+#include "components/utilities/Buffer2D.h"
+
+namespace
+{
+	constexpr int GlyphAtlasWidth = 256;
+	constexpr int GlyphAtlasPadding = 1; // Empty texels between glyphs.
+	constexpr int MaxLayoutCount = 128;
+
+	struct LayoutKey
+	{
+		std::string text;
+		const FontDefinition *fontDef;
+		int textureWidth, textureHeight;
+		TextAlignment alignment;
+		bool hasShadow;
+		int shadowOffsetX, shadowOffsetY;
+		int lineSpacing;
+
+		bool operator==(const LayoutKey &other) const
+		{
+			return (this->text == other.text) && (this->fontDef == other.fontDef) &&
+				(this->textureWidth == other.textureWidth) && (this->textureHeight == other.textureHeight) &&
+				(this->alignment == other.alignment) && (this->hasShadow == other.hasShadow) &&
+				(this->shadowOffsetX == other.shadowOffsetX) && (this->shadowOffsetY == other.shadowOffsetY) &&
+				(this->lineSpacing == other.lineSpacing);
+		}
+	};
+
+	struct LayoutKeyHasher
+	{
+		size_t operator()(const LayoutKey &key) const
+		{
+			size_t hash = std::hash<std::string>()(key.text);
+			auto combine = [&hash](size_t value)
+			{
+				hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+			};
+
+			combine(std::hash<const FontDefinition*>()(key.fontDef));
+			combine(static_cast<size_t>(key.textureWidth));
+			combine(static_cast<size_t>(key.textureHeight));
+			combine(static_cast<size_t>(key.alignment));
+			combine(static_cast<size_t>(key.shadowOffsetX) + (static_cast<size_t>(key.shadowOffsetY) << 16));
+			combine(static_cast<size_t>(key.lineSpacing));
+			return hash;
+		}
+	};
+
+	struct LayoutEntry
+	{
+		LayoutKey key;
+		std::vector<TextRenderCache::GlyphQuad> quads;
+	};
+
+	// Failed atlases are kept with an invalid texture ID so they aren't retried every frame.
+	std::unordered_map<const FontDefinition*, TextRenderCache::GlyphAtlas> g_glyphAtlases;
+	int g_glyphAtlasDeviceResetCount = 0; // The renderer's device reset count when the atlases were made.
+
+	std::list<LayoutEntry> g_layoutEntries; // Most recently used first.
+	std::unordered_map<LayoutKey, std::list<LayoutEntry>::iterator, LayoutKeyHasher> g_layoutEntryIters;
+
+	void FreeGlyphAtlases(Renderer &renderer)
+	{
+		for (const auto &pair : g_glyphAtlases)
+		{
+			const TextRenderCache::GlyphAtlas &atlas = pair.second;
+			if (atlas.textureID >= 0)
+			{
+				renderer.freeUiTexture(atlas.textureID);
+			}
+		}
+
+		g_glyphAtlases.clear();
+	}
+
+	bool TryMakeGlyphAtlas(const FontDefinition &fontDef, Renderer &renderer, TextRenderCache::GlyphAtlas *outAtlas)
+	{
+		const int charCount = fontDef.getCharacterCount();
+		const int charHeight = fontDef.getCharacterHeight();
+		outAtlas->glyphRects.init(charCount);
+
+		// Shelf packing; every glyph in a font is the same height.
+		int x = 0;
+		int y = 0;
+		for (int i = 0; i < charCount; i++)
+		{
+			const FontDefinition::Character &fontChar = fontDef.getCharacter(i);
+			const int charWidth = fontChar.getWidth();
+			if ((x + charWidth) > GlyphAtlasWidth)
+			{
+				x = 0;
+				y += charHeight + GlyphAtlasPadding;
+			}
+
+			outAtlas->glyphRects[i] = Rect(x, y, charWidth, charHeight);
+			x += charWidth + GlyphAtlasPadding;
+		}
+
+		const int atlasHeight = std::max(y + charHeight, 1);
+		Buffer2D<uint32_t> texels(GlyphAtlasWidth, atlasHeight);
+		texels.fill(0);
+
+		const uint32_t glyphColor = Color::White.toARGB();
+		for (int i = 0; i < charCount; i++)
+		{
+			const FontDefinition::Character &fontChar = fontDef.getCharacter(i);
+			const Rect &glyphRect = outAtlas->glyphRects[i];
+			for (int charY = 0; charY < fontChar.getHeight(); charY++)
+			{
+				for (int charX = 0; charX < fontChar.getWidth(); charX++)
+				{
+					if (fontChar.get(charX, charY))
+					{
+						texels.set(glyphRect.getLeft() + charX, glyphRect.getTop() + charY, glyphColor);
+					}
+				}
+			}
+		}
+
+		return renderer.tryCreateUiTexture(BufferView2D<const uint32_t>(texels), &outAtlas->textureID);
+	}
+
+	void MakeLayout(const std::string &text, const FontDefinition &fontDef, int textureWidth, int textureHeight,
+		TextAlignment alignment, const TextRenderUtils::TextShadowInfo *shadow, int lineSpacing,
+		std::vector<TextRenderCache::GlyphQuad> &outQuads)
+	{
+		std::optional<TextRenderUtils::TextShadowInfo> shadowInfo;
+		if (shadow != nullptr)
+		{
+			shadowInfo = *shadow;
+		}
+
+		const BufferView<const std::string_view> textLines = TextRenderUtils::getTextLines(text);
+		const Buffer<Int2> offsets = TextRenderUtils::makeAlignmentOffsets(
+			textLines, textureWidth, textureHeight, alignment, fontDef, shadowInfo, lineSpacing);
+
+		auto addLine = [&fontDef, &outQuads](BufferView<const FontDefinition::CharID> charIDs, int x, int y, bool isShadow)
+		{
+			int currentX = x;
+			for (const FontDefinition::CharID charID : charIDs)
+			{
+				outQuads.push_back({ charID, currentX, y, isShadow });
+				currentX += fontDef.getCharacter(charID).getWidth();
+			}
+		};
+
+		// Same order as the CPU path: each line's shadow is drawn right before the line itself.
+		for (int i = 0; i < textLines.getCount(); i++)
+		{
+			const BufferView<const FontDefinition::CharID> charIDs = TextRenderUtils::getLineFontCharIDs(textLines.get(i), fontDef);
+			const Int2 &offset = offsets[i];
+			int foregroundX = offset.x;
+			int foregroundY = offset.y;
+			if (shadow != nullptr)
+			{
+				foregroundX += std::max(-shadow->offsetX, 0);
+				foregroundY += std::max(-shadow->offsetY, 0);
+				addLine(charIDs, offset.x + std::max(shadow->offsetX, 0), offset.y + std::max(shadow->offsetY, 0), true);
+			}
+
+			addLine(charIDs, foregroundX, foregroundY, false);
+		}
+	}
+}
+
+TextRenderCache::GlyphAtlas::GlyphAtlas()
+{
+	this->textureID = -1;
+}
+
+const TextRenderCache::GlyphAtlas *TextRenderCache::tryGetGlyphAtlas(const FontDefinition &fontDef, Renderer &renderer)
+{
+	// A device reset loses every texture, so the atlases are uploaded again.
+	const int deviceResetCount = renderer.getRenderDeviceResetCount();
+	if (deviceResetCount != g_glyphAtlasDeviceResetCount)
+	{
+		FreeGlyphAtlases(renderer);
+		g_glyphAtlasDeviceResetCount = deviceResetCount;
+	}
+
+	auto iter = g_glyphAtlases.find(&fontDef);
+	if (iter == g_glyphAtlases.end())
+	{
+		GlyphAtlas atlas;
+		if (!TryMakeGlyphAtlas(fontDef, renderer, &atlas))
+		{
+			DebugLogError("Couldn't create glyph atlas for font \"" + fontDef.getName() + "\".");
+			atlas.textureID = -1;
+		}
+
+		iter = g_glyphAtlases.emplace(&fontDef, std::move(atlas)).first;
+	}
+
+	const GlyphAtlas &atlas = iter->second;
+	return (atlas.textureID >= 0) ? &atlas : nullptr;
+}
+
+BufferView<const TextRenderCache::GlyphQuad> TextRenderCache::getLayout(const std::string &text, const FontDefinition &fontDef,
+	int textureWidth, int textureHeight, TextAlignment alignment, const TextRenderUtils::TextShadowInfo *shadow, int lineSpacing)
+{
+	LayoutKey key;
+	key.text = text;
+	key.fontDef = &fontDef;
+	key.textureWidth = textureWidth;
+	key.textureHeight = textureHeight;
+	key.alignment = alignment;
+	key.hasShadow = shadow != nullptr;
+	key.shadowOffsetX = (shadow != nullptr) ? shadow->offsetX : 0;
+	key.shadowOffsetY = (shadow != nullptr) ? shadow->offsetY : 0;
+	key.lineSpacing = lineSpacing;
+
+	const auto iter = g_layoutEntryIters.find(key);
+	if (iter != g_layoutEntryIters.end())
+	{
+		g_layoutEntries.splice(g_layoutEntries.begin(), g_layoutEntries, iter->second);
+	}
+	else
+	{
+		if (static_cast<int>(g_layoutEntries.size()) >= MaxLayoutCount)
+		{
+			g_layoutEntryIters.erase(g_layoutEntries.back().key);
+			g_layoutEntries.pop_back();
+		}
+
+		LayoutEntry entry;
+		MakeLayout(text, fontDef, textureWidth, textureHeight, alignment, shadow, lineSpacing, entry.quads);
+		entry.key = std::move(key);
+		g_layoutEntries.emplace_front(std::move(entry));
+		g_layoutEntryIters.emplace(g_layoutEntries.front().key, g_layoutEntries.begin());
+	}
+
+	const std::vector<GlyphQuad> &quads = g_layoutEntries.front().quads;
+	return BufferView<const GlyphQuad>(quads.data(), static_cast<int>(quads.size()));
+}
+
+void TextRenderCache::shutdown(Renderer &renderer)
+{
+	FreeGlyphAtlases(renderer);
+	g_layoutEntryIters.clear();
+	g_layoutEntries.clear();
+}
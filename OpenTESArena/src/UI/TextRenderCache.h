@@ -0,0 +1,51 @@
+#ifndef TEXT_RENDER_CACHE_H
+#define TEXT_RENDER_CACHE_H
+
+#include <string>
+
+#include "FontDefinition.h"
+#include "TextRenderUtils.h"
+#include "../Math/Rect.h"
+#include "../Rendering/RenderTextureUtils.h"
+
+#include "components/utilities/Buffer.h"
+#include "components/utilities/BufferView.h"
+
+class Renderer;
+
+enum class TextAlignment;
+
+// Shared state for drawing text boxes as glyph quads instead of rasterizing every pixel on the CPU.
+namespace TextRenderCache
+{
+	// Every glyph of a font packed into one white UI texture, so text of any color is a tinted copy.
+	struct GlyphAtlas
+	{
+		UiTextureID textureID;
+		Buffer<Rect> glyphRects; // Indexed by font character ID.
+
+		GlyphAtlas();
+	};
+
+	// Where one glyph goes in a text box texture.
+	struct GlyphQuad
+	{
+		FontDefinition::CharID charID;
+		int x, y;
+		bool isShadow;
+	};
+
+	// Gets the font's atlas, uploading it on first use.
+	const GlyphAtlas *tryGetGlyphAtlas(const FontDefinition &fontDef, Renderer &renderer);
+
+	// Gets the glyph positions for a block of text in a texture of the given size, in drawing order. Recently
+	// used layouts are kept by text, font, and formatting. The view is valid until the next call.
+	BufferView<const GlyphQuad> getLayout(const std::string &text, const FontDefinition &fontDef, int textureWidth,
+		int textureHeight, TextAlignment alignment, const TextRenderUtils::TextShadowInfo *shadow, int lineSpacing);
+
+	// Frees the glyph atlas textures and cached layouts. Must be called before the renderer that owns the atlases
+	// is destroyed.
+	void shutdown(Renderer &renderer);
+}
+
+#endif
@@ -5,7 +5,7 @@
 #include "TextRenderUtils.h"
 
 #include "components/debug/Debug.h"
-#include "components/utilities/StringView.h"
+#include "components/utilities/FrameArena.h"
 
 TextRenderUtils::TextureGenInfo::TextureGenInfo()
 {
@@ -111,13 +111,25 @@ void TextRenderUtils::TextShadowInfo::init(int offsetX, int offsetY, const Color
 	this->color = color;
 }
 
-Buffer<std::string_view> TextRenderUtils::getTextLines(const std::string_view &text)
+BufferView<const std::string_view> TextRenderUtils::getTextLines(const std::string_view &text)
 {
 	// @todo: might eventually handle "\r\n".
-	return StringView::split(text, '\n');
+	// Same as StringView::split() but without a heap allocation since text boxes split their text every redraw.
+	const int lineCount = 1 + static_cast<int>(std::count(text.begin(), text.end(), '\n'));
+	BufferView<std::string_view> lines = FrameArena::allocView<std::string_view>(lineCount);
+
+	size_t lineStart = 0;
+	for (int i = 0; i < lineCount; i++)
+	{
+		const size_t lineEnd = std::min(text.find('\n', lineStart), text.size());
+		lines[i] = text.substr(lineStart, lineEnd - lineStart);
+		lineStart = lineEnd + 1;
+	}
+
+	return BufferView<const std::string_view>(lines.begin(), lines.getCount());
 }
 
-Buffer<FontDefinition::CharID> TextRenderUtils::getLineFontCharIDs(const std::string_view &line, const FontDefinition &fontDef)
+BufferView<const FontDefinition::CharID> TextRenderUtils::getLineFontCharIDs(const std::string_view &line, const FontDefinition &fontDef)
 {
 	FontDefinition::CharID fallbackCharID;
 	if (!fontDef.tryGetCharacterID("?", &fallbackCharID))
@@ -128,7 +140,7 @@ Buffer<FontDefinition::CharID> TextRenderUtils::getLineFontCharIDs(const std::st
 	const int lineLength = static_cast<int>(line.size());
 
 	// @todo: support more than ASCII
-	Buffer<FontDefinition::CharID> charIDs(lineLength);
+	BufferView<FontDefinition::CharID> charIDs = FrameArena::allocView<FontDefinition::CharID>(lineLength);
 	for (int i = 0; i < lineLength; i++)
 	{
 		const char c = line[i];
@@ -143,7 +155,7 @@ Buffer<FontDefinition::CharID> TextRenderUtils::getLineFontCharIDs(const std::st
 		charIDs[i] = charID;
 	}
 
-	return charIDs;
+	return BufferView<const FontDefinition::CharID>(charIDs.begin(), charIDs.getCount());
 }
 
 int TextRenderUtils::getLinePixelWidth(BufferView<const FontDefinition::CharID> charIDs,
@@ -167,7 +179,7 @@ int TextRenderUtils::getLinePixelWidth(BufferView<const FontDefinition::CharID>
 int TextRenderUtils::getLinePixelWidth(const std::string_view &line, const FontDefinition &fontDef,
 	const std::optional<TextShadowInfo> &shadow)
 {
-	const Buffer<FontDefinition::CharID> charIDs = TextRenderUtils::getLineFontCharIDs(line, fontDef);
+	const BufferView<const FontDefinition::CharID> charIDs = TextRenderUtils::getLineFontCharIDs(line, fontDef);
 	return TextRenderUtils::getLinePixelWidth(charIDs, fontDef, shadow);
 }
 
@@ -206,7 +218,7 @@ TextRenderUtils::TextureGenInfo TextRenderUtils::makeTextureGenInfo(BufferView<c
 TextRenderUtils::TextureGenInfo TextRenderUtils::makeTextureGenInfo(const std::string_view &text,
 	const FontDefinition &fontDef, const std::optional<TextShadowInfo> &shadow, int lineSpacing)
 {
-	const Buffer<std::string_view> textLines = TextRenderUtils::getTextLines(text);
+	const BufferView<const std::string_view> textLines = TextRenderUtils::getTextLines(text);
 	return TextRenderUtils::makeTextureGenInfo(textLines, fontDef, shadow, lineSpacing);
 }
 
@@ -303,21 +315,21 @@ Buffer<Int2> TextRenderUtils::makeAlignmentOffsets(BufferView<const std::string_
 void TextRenderUtils::drawChar(const FontDefinition::Character &fontChar, int dstX, int dstY, const Color &textColor,
 	BufferView2D<uint32_t> &outBuffer)
 {
-	// @todo: clip loop ranges instead of checking in loop.
-	for (int y = dstY; y < (dstY + fontChar.getHeight()); y++)
+	const int startX = std::max(dstX, 0);
+	const int endX = std::min(dstX + fontChar.getWidth(), outBuffer.getWidth());
+	const int startY = std::max(dstY, 0);
+	const int endY = std::min(dstY + fontChar.getHeight(), outBuffer.getHeight());
+	const uint32_t dstPixel = textColor.toARGB();
+	for (int y = startY; y < endY; y++)
 	{
-		for (int x = dstX; x < (dstX + fontChar.getWidth()); x++)
+		const int srcY = y - dstY;
+		for (int x = startX; x < endX; x++)
 		{
-			if ((x >= 0) && (x < outBuffer.getWidth()) && (y >= 0) && (y < outBuffer.getHeight()))
+			const int srcX = x - dstX;
+			const bool srcPixelIsColored = fontChar.get(srcX, srcY);
+			if (srcPixelIsColored)
 			{
-				const int srcX = x - dstX;
-				const int srcY = y - dstY;
-				const bool srcPixelIsColored = fontChar.get(srcX, srcY);
-				if (srcPixelIsColored)
-				{
-					const uint32_t dstPixel = textColor.toARGB();
-					outBuffer.set(x, y, dstPixel);
-				}
+				outBuffer.set(x, y, dstPixel);
 			}
 		}
 	}
@@ -375,9 +387,8 @@ void TextRenderUtils::drawTextLine(const std::string_view &line, const FontDefin
 	const Color &textColor, const ColorOverrideInfo *colorOverrideInfo, const TextShadowInfo *shadow,
 	BufferView2D<uint32_t> &outBuffer)
 {
-	const Buffer<FontDefinition::CharID> charIDs = TextRenderUtils::getLineFontCharIDs(line, fontDef);
-	const BufferView<const FontDefinition::CharID> charIdsView(charIDs);
-	TextRenderUtils::drawTextLine(charIdsView, fontDef, dstX, dstY, textColor, colorOverrideInfo, shadow, outBuffer);
+	const BufferView<const FontDefinition::CharID> charIDs = TextRenderUtils::getLineFontCharIDs(line, fontDef);
+	TextRenderUtils::drawTextLine(charIDs, fontDef, dstX, dstY, textColor, colorOverrideInfo, shadow, outBuffer);
 }
 
 void TextRenderUtils::drawTextLines(BufferView<const std::string_view> textLines, const FontDefinition &fontDef,
@@ -72,11 +72,12 @@ namespace TextRenderUtils
 		void init(int offsetX, int offsetY, const Color &color);
 	};
 
-	// Splits a string of text into lines based on newline characters.
-	Buffer<std::string_view> getTextLines(const std::string_view &text);
+	// Splits a string of text into lines based on newline characters. The list is in the frame arena.
+	BufferView<const std::string_view> getTextLines(const std::string_view &text);
 
-	// Gets the font characters needed to render each character in the given line of text.
-	Buffer<FontDefinition::CharID> getLineFontCharIDs(const std::string_view &line, const FontDefinition &fontDef);
+	// Gets the font characters needed to render each character in the given line of text. The list is in the
+	// frame arena.
+	BufferView<const FontDefinition::CharID> getLineFontCharIDs(const std::string_view &line, const FontDefinition &fontDef);
 
 	// Gets the number of pixels long a rendered line of characters would be.
 	int getLinePixelWidth(BufferView<const FontDefinition::CharID> charIDs, const FontDefinition &fontDef,
@@ -120,6 +120,24 @@ std::string Platform::getScreenshotPath()
 	return String::replace(screenshotPathString, '\\', '/');
 }
 
+std::string Platform::getAssetCachePath()
+{
+	// SDL_GetPrefPath() creates the desired folder if it doesn't exist.
+	char *cachePathPtr = SDL_GetPrefPath("OpenTESArena", "cache");
+
+	if (cachePathPtr == nullptr)
+	{
+		DebugLogWarning("SDL_GetPrefPath() not available on this platform.");
+		cachePathPtr = SDL_strdup("cache/");
+	}
+
+	const std::string cachePathString(cachePathPtr);
+	SDL_free(cachePathPtr);
+
+	// Convert Windows backslashes to forward slashes.
+	return String::replace(cachePathString, '\\', '/');
+}
+
 std::string Platform::getLogPath()
 {
 	// Unfortunately there's no SDL_GetLogPath(), so we need to make our own.
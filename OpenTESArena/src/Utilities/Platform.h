@@ -19,6 +19,9 @@ namespace Platform
 	// Gets the screenshot folder path via SDL_GetPrefPath().
 	std::string getScreenshotPath();
 
+	// Gets the folder path for cached decoded assets via SDL_GetPrefPath().
+	std::string getAssetCachePath();
+
 	// Gets the log folder path for logging program messages.
 	std::string getLogPath();
 
@@ -45,19 +45,23 @@ MapDefinitionWild::MapDefinitionWild()
 }
 
 void MapDefinitionWild::init(Buffer2D<int> &&levelDefIndices, uint32_t fallbackSeed,
-	std::vector<MapGeneration::WildChunkBuildingNameInfo> &&buildingNameInfos)
+	Buffer<ArenaWildUtils::WildBlockID> &&levelDefBlockIDs, const LocationCityDefinition &cityDef,
+	const INFFile &inf)
 {
 	this->levelDefIndices = std::move(levelDefIndices);
 	this->fallbackSeed = fallbackSeed;
-	this->buildingNameInfos = std::move(buildingNameInfos);
+	this->levelDefBlockIDs = std::move(levelDefBlockIDs);
+	this->generatedLevelDefs.init(this->levelDefBlockIDs.getCount());
+	this->generatedLevelDefs.fill(false);
+	this->buildingNameInfos.clear();
+	this->cityDef = cityDef;
+	this->inf = inf;
+	this->mappingCaches = MapGeneration::makeWildMappingCaches();
 }
 
 int MapDefinitionWild::getLevelDefIndex(const ChunkInt2 &chunk) const
 {
-	const bool isValid = (chunk.x >= 0) && (chunk.x < this->levelDefIndices.getWidth()) &&
-		(chunk.y >= 0) && (chunk.y < this->levelDefIndices.getHeight());
-
-	if (isValid)
+	if (this->isInsideLevelDefIndices(chunk))
 	{
 		return this->levelDefIndices.get(chunk.x, chunk.y);
 	}
@@ -70,22 +74,33 @@ int MapDefinitionWild::getLevelDefIndex(const ChunkInt2 &chunk) const
 	}
 }
 
+bool MapDefinitionWild::isInsideLevelDefIndices(const ChunkInt2 &chunk) const
+{
+	return (chunk.x >= 0) && (chunk.x < this->levelDefIndices.getWidth()) &&
+		(chunk.y >= 0) && (chunk.y < this->levelDefIndices.getHeight());
+}
+
 const MapGeneration::WildChunkBuildingNameInfo *MapDefinitionWild::getBuildingNameInfo(const ChunkInt2 &chunk) const
 {
-	const auto iter = std::find_if(this->buildingNameInfos.begin(), this->buildingNameInfos.end(),
-		[&chunk](const MapGeneration::WildChunkBuildingNameInfo &buildingNameInfo)
+	const auto iter = this->buildingNameInfos.find(chunk);
+	if ((iter == this->buildingNameInfos.end()) || !iter->second.hasBuildingNames())
 	{
-		return buildingNameInfo.getChunk() == chunk;
-	});
+		return nullptr;
+	}
 
-	return (iter != this->buildingNameInfos.end()) ? &(*iter) : nullptr;
+	return &iter->second;
 }
 
 void MapDefinitionWild::clear()
 {
 	this->levelDefIndices.clear();
 	this->fallbackSeed = 0;
+	this->levelDefBlockIDs.clear();
+	this->generatedLevelDefs.clear();
 	this->buildingNameInfos.clear();
+	this->cityDef = LocationCityDefinition();
+	this->inf = INFFile();
+	this->mappingCaches = nullptr;
 }
 
 MapSubDefinition::MapSubDefinition()
@@ -330,7 +345,6 @@ bool MapDefinition::initCityLevel(const MIFFile &mif, uint32_t citySeed, uint32_
 bool MapDefinition::initWildLevels(BufferView2D<const ArenaWildUtils::WildBlockID> wildBlockIDs,
 	uint32_t fallbackSeed, const LocationCityDefinition &cityDef,
 	const SkyGeneration::ExteriorSkyGenInfo &skyGenInfo, const INFFile &inf,
-	const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
 	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager)
 {
 	// Create a list of unique block IDs and a 2D table of level definition index mappings. The index
@@ -381,14 +395,6 @@ bool MapDefinition::initWildLevels(BufferView2D<const ArenaWildUtils::WildBlockI
 	const double ceilingScale = ArenaLevelUtils::convertCeilingHeightToScale(ceiling.height);
 	levelInfoDef.init(ceilingScale);
 
-	const BufferView<const ArenaWildUtils::WildBlockID> uniqueWildBlockIdsConstView(uniqueWildBlockIDs);
-	const BufferView2D<const int> levelDefIndicesConstView(levelDefIndices);
-	BufferView<LevelDefinition> levelDefsView(this->levels);
-	std::vector<MapGeneration::WildChunkBuildingNameInfo> buildingNameInfos;
-	MapGeneration::generateRmdWilderness(uniqueWildBlockIdsConstView, levelDefIndicesConstView, cityDef, inf,
-		charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, levelDefsView, &levelInfoDef,
-		&buildingNameInfos);
-
 	SkyDefinition &skyDef = this->skies.get(0);
 	SkyInfoDefinition &skyInfoDef = this->skyInfos.get(0);
 	SkyGeneration::generateExteriorSky(skyGenInfo, binaryAssetLibrary, textureManager, &skyDef, &skyInfoDef);
@@ -406,8 +412,10 @@ bool MapDefinition::initWildLevels(BufferView2D<const ArenaWildUtils::WildBlockI
 
 	this->skyInfoMappings.set(0, 0);
 
-	// Populate wild chunk look-up values.
-	this->subDefinition.wild.init(std::move(levelDefIndices), fallbackSeed, std::move(buildingNameInfos));
+	// Populate wild chunk look-up values. Wild blocks are converted later as their chunks become active.
+	Buffer<ArenaWildUtils::WildBlockID> levelDefBlockIDs(static_cast<int>(uniqueWildBlockIDs.size()));
+	std::copy(uniqueWildBlockIDs.begin(), uniqueWildBlockIDs.end(), levelDefBlockIDs.begin());
+	this->subDefinition.wild.init(std::move(levelDefIndices), fallbackSeed, std::move(levelDefBlockIDs), cityDef, inf);
 
 	return true;
 }
@@ -527,8 +535,6 @@ bool MapDefinition::initCity(const MapGeneration::CityGenInfo &generationInfo,
 bool MapDefinition::initWild(const MapGeneration::WildGenInfo &generationInfo,
 	const SkyGeneration::ExteriorSkyGenInfo &skyGenInfo, TextureManager &textureManager)
 {
-	const CharacterClassLibrary &charClassLibrary = CharacterClassLibrary::getInstance();
-	const EntityDefinitionLibrary &entityDefLibrary = EntityDefinitionLibrary::getInstance();
 	const BinaryAssetLibrary &binaryAssetLibrary = BinaryAssetLibrary::getInstance();
 
 	this->init(MapType::Wilderness);
@@ -545,7 +551,7 @@ bool MapDefinition::initWild(const MapGeneration::WildGenInfo &generationInfo,
 	const LocationCityDefinition &cityDef = *generationInfo.cityDef;
 
 	this->initWildLevels(wildBlockIDs, generationInfo.fallbackSeed, cityDef, skyGenInfo, inf,
-		charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager);
+		binaryAssetLibrary, textureManager);
 
 	// No start level index and no start points in the wilderness due to the nature of chunks.
 	this->startLevelIndex = std::nullopt;
@@ -613,6 +619,43 @@ const MapSubDefinition &MapDefinition::getSubDefinition() const
 	return this->subDefinition;
 }
 
+void MapDefinition::generateWildChunks(BufferView<const ChunkInt2> chunkPositions, TextureManager &textureManager)
+{
+	DebugAssert(this->subDefinition.type == MapType::Wilderness);
+
+	const CharacterClassLibrary &charClassLibrary = CharacterClassLibrary::getInstance();
+	const EntityDefinitionLibrary &entityDefLibrary = EntityDefinitionLibrary::getInstance();
+	const BinaryAssetLibrary &binaryAssetLibrary = BinaryAssetLibrary::getInstance();
+
+	MapDefinitionWild &mapDefWild = this->subDefinition.wild;
+	MapGeneration::WildMappingCaches *mappingCaches = mapDefWild.mappingCaches.get();
+	DebugAssert(mappingCaches != nullptr);
+
+	for (const ChunkInt2 &chunk : chunkPositions)
+	{
+		const int levelDefIndex = mapDefWild.getLevelDefIndex(chunk);
+		LevelDefinition &levelDef = this->levels.get(levelDefIndex);
+		LevelInfoDefinition &levelInfoDef = this->levelInfos.get(this->levelInfoMappings.get(levelDefIndex));
+		if (!mapDefWild.generatedLevelDefs.get(levelDefIndex))
+		{
+			const ArenaWildUtils::WildBlockID wildBlockID = mapDefWild.levelDefBlockIDs.get(levelDefIndex);
+			MapGeneration::generateRmdWildBlock(wildBlockID, mapDefWild.cityDef, mapDefWild.inf, charClassLibrary,
+				entityDefLibrary, binaryAssetLibrary, textureManager, &levelDef, &levelInfoDef, mappingCaches);
+			mapDefWild.generatedLevelDefs.set(levelDefIndex, true);
+		}
+
+		// Building names only exist for chunks in the defined wilderness.
+		if (mapDefWild.isInsideLevelDefIndices(chunk) &&
+			(mapDefWild.buildingNameInfos.find(chunk) == mapDefWild.buildingNameInfos.end()))
+		{
+			MapGeneration::WildChunkBuildingNameInfo buildingNameInfo;
+			MapGeneration::generateRmdWildChunkBuildingNames(chunk, levelDef, binaryAssetLibrary, &levelInfoDef,
+				mappingCaches, &buildingNameInfo);
+			mapDefWild.buildingNameInfos.emplace(chunk, std::move(buildingNameInfo));
+		}
+	}
+}
+
 void MapDefinition::clear()
 {
 	this->levels.clear();
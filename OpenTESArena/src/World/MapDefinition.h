@@ -1,15 +1,18 @@
 #ifndef MAP_DEFINITION_H
 #define MAP_DEFINITION_H
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "LevelDefinition.h"
 #include "LevelInfoDefinition.h"
 #include "MapGeneration.h"
 #include "../Assets/ArenaTypes.h"
+#include "../Assets/INFFile.h"
 #include "../Sky/SkyDefinition.h"
 #include "../Sky/SkyGeneration.h"
 #include "../Sky/SkyInfoDefinition.h"
@@ -50,15 +53,27 @@ struct MapDefinitionWild
 	Buffer2D<int> levelDefIndices;
 	uint32_t fallbackSeed; // I.e. the world map location seed.
 
-	// Building name infos for each chunk.
-	std::vector<MapGeneration::WildChunkBuildingNameInfo> buildingNameInfos;
+	// Wild block of each level definition. A level definition is only converted from its .RMD block the
+	// first time a chunk using it is needed.
+	Buffer<ArenaWildUtils::WildBlockID> levelDefBlockIDs;
+	Buffer<bool> generatedLevelDefs;
+
+	// Building name infos for each chunk generated so far (empty if the chunk has no named buildings).
+	std::unordered_map<ChunkInt2, MapGeneration::WildChunkBuildingNameInfo> buildingNameInfos;
+
+	// Inputs kept for generating wild blocks on demand.
+	LocationCityDefinition cityDef;
+	INFFile inf;
+	std::shared_ptr<MapGeneration::WildMappingCaches> mappingCaches;
 
 	MapDefinitionWild();
 
 	void init(Buffer2D<int> &&levelDefIndices, uint32_t fallbackSeed,
-		std::vector<MapGeneration::WildChunkBuildingNameInfo> &&buildingNameInfos);
+		Buffer<ArenaWildUtils::WildBlockID> &&levelDefBlockIDs, const LocationCityDefinition &cityDef,
+		const INFFile &inf);
 
 	int getLevelDefIndex(const ChunkInt2 &chunk) const;
+	bool isInsideLevelDefIndices(const ChunkInt2 &chunk) const;
 	const MapGeneration::WildChunkBuildingNameInfo *getBuildingNameInfo(const ChunkInt2 &chunk) const;
 
 	void clear();
@@ -111,7 +126,6 @@ private:
 	bool initWildLevels(BufferView2D<const ArenaWildUtils::WildBlockID> wildBlockIDs,
 		uint32_t fallbackSeed, const LocationCityDefinition &cityDef,
 		const SkyGeneration::ExteriorSkyGenInfo &skyGenInfo, const INFFile &inf,
-		const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
 		const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager);
 	void initStartPoints(const MIFFile &mif);
 public:
@@ -148,6 +162,10 @@ public:
 
 	const MapSubDefinition &getSubDefinition() const;
 
+	// Converts any wild blocks and chunk building names not yet generated for the given chunks. Must be called
+	// before the chunks are populated.
+	void generateWildChunks(BufferView<const ChunkInt2> chunkPositions, TextureManager &textureManager);
+
 	void clear();
 };
 
@@ -1,4 +1,7 @@
 #include <algorithm>
+#include <array>
+#include <bitset>
+#include <memory>
 #include <unordered_map>
 
 #include "ArenaCityUtils.h"
@@ -57,15 +60,84 @@ namespace MapGeneration
 		}
 	};
 
+	// Direct-indexed table over the 16-bit Arena voxel ID space. Split into pages allocated on first write since
+	// a level only uses a handful of distinct voxel IDs, most of them sharing a high byte.
+	template<typename T>
+	class ArenaVoxelMappingTable
+	{
+	private:
+		static constexpr int PAGE_SIZE = 256;
+		static constexpr int PAGE_COUNT = 65536 / PAGE_SIZE;
+
+		struct Page
+		{
+			std::array<T, PAGE_SIZE> values;
+			std::bitset<PAGE_SIZE> occupied;
+		};
+
+		std::array<std::unique_ptr<Page>, PAGE_COUNT> pages;
+	public:
+		// Returns null if the voxel hasn't been mapped yet.
+		const T *tryGet(ArenaTypes::VoxelID voxel) const
+		{
+			const Page *page = this->pages[voxel >> 8].get();
+			const int index = voxel & 0xFF;
+			if ((page == nullptr) || !page->occupied.test(index))
+			{
+				return nullptr;
+			}
+
+			return &page->values[index];
+		}
+
+		void set(ArenaTypes::VoxelID voxel, const T &value)
+		{
+			std::unique_ptr<Page> &page = this->pages[voxel >> 8];
+			if (page == nullptr)
+			{
+				page = std::make_unique<Page>();
+			}
+
+			const int index = voxel & 0xFF;
+			page->values[index] = value;
+			page->occupied.set(index);
+		}
+	};
+
 	// Mapping caches of .MIF/.RMD voxels, etc. to modern level info entries.
-	using ArenaVoxelMappingCache = std::unordered_map<ArenaTypes::VoxelID, ArenaVoxelMappingEntry>;
-	using ArenaEntityMappingCache = std::unordered_map<ArenaTypes::VoxelID, LevelDefinition::EntityDefID>;
-	using ArenaLockMappingCache = std::vector<std::pair<ArenaTypes::MIFLock, LevelDefinition::LockDefID>>;
-	using ArenaTriggerMappingCache = std::vector<std::pair<ArenaTypes::MIFTrigger, LevelDefinition::TriggerDefID>>;
-	using ArenaTransitionMappingCache = std::unordered_map<ArenaTypes::VoxelID, LevelDefinition::TransitionDefID>;
+	using ArenaVoxelMappingCache = ArenaVoxelMappingTable<ArenaVoxelMappingEntry>;
+	using ArenaEntityMappingCache = ArenaVoxelMappingTable<LevelDefinition::EntityDefID>;
+	using ArenaLockMappingCache = std::unordered_map<uint32_t, LevelDefinition::LockDefID>; // Key from makeLockMappingKey().
+	using ArenaTriggerMappingCache = std::unordered_map<uint32_t, LevelDefinition::TriggerDefID>; // Key from makeTriggerMappingKey().
+	using ArenaTransitionMappingCache = ArenaVoxelMappingTable<LevelDefinition::TransitionDefID>;
 	using ArenaBuildingNameMappingCache = std::unordered_map<std::string, LevelDefinition::BuildingNameID>;
-	using ArenaDoorMappingCache = std::unordered_map<ArenaTypes::VoxelID, LevelDefinition::DoorDefID>;
-	using ArenaChasmMappingCache = std::unordered_map<ArenaTypes::VoxelID, LevelDefinition::ChasmDefID>;
+	using ArenaDoorMappingCache = ArenaVoxelMappingTable<LevelDefinition::DoorDefID>;
+	using ArenaChasmMappingCache = ArenaVoxelMappingTable<LevelDefinition::ChasmDefID>;
+
+	struct WildMappingCaches
+	{
+		ArenaVoxelMappingCache florMappings, map1Mappings, map2Mappings;
+		ArenaEntityMappingCache entityMappings;
+		ArenaTransitionMappingCache transitionMappings;
+		ArenaBuildingNameMappingCache buildingNameMappings;
+		ArenaDoorMappingCache doorMappings;
+		ArenaChasmMappingCache chasmMappings;
+	};
+
+	// Packs every field of a .MIF lock into one key.
+	uint32_t makeLockMappingKey(const ArenaTypes::MIFLock &lock)
+	{
+		return static_cast<uint32_t>(lock.x) | (static_cast<uint32_t>(lock.y) << 8) |
+			(static_cast<uint32_t>(lock.lockLevel) << 16);
+	}
+
+	// Packs every field of a .MIF trigger into one key.
+	uint32_t makeTriggerMappingKey(const ArenaTypes::MIFTrigger &trigger)
+	{
+		return static_cast<uint32_t>(trigger.x) | (static_cast<uint32_t>(trigger.y) << 8) |
+			(static_cast<uint32_t>(static_cast<uint8_t>(trigger.textIndex)) << 16) |
+			(static_cast<uint32_t>(static_cast<uint8_t>(trigger.soundIndex)) << 24);
+	}
 
 	// Converts the given Arena *MENU ID to a modern interior type, if any.
 	std::optional<ArenaTypes::InteriorType> tryGetInteriorTypeFromMenuIndex(int menuIndex, MapType mapType)
@@ -207,7 +279,7 @@ namespace MapGeneration
 
 			// The entity can only be instantiated if there is at least an idle animation.
 			const std::optional<int> idleStateIndex = entityAnimDef.tryGetStateIndex(
-				EntityAnimationUtils::STATE_IDLE.c_str());
+				EntityAnimationUtils::getStateIdleID());
 			if (!idleStateIndex.has_value())
 			{
 				DebugLogWarning("Missing static entity idle anim state for flat \"" +
@@ -230,7 +302,7 @@ namespace MapGeneration
 
 			// Must have at least an idle animation.
 			const std::optional<int> idleStateIndex = entityAnimDef.tryGetStateIndex(
-				EntityAnimationUtils::STATE_IDLE.c_str());
+				EntityAnimationUtils::getStateIdleID());
 			if (!idleStateIndex.has_value())
 			{
 				DebugLogWarning("Missing dynamic entity idle anim state for flat \"" +
@@ -1216,10 +1288,10 @@ namespace MapGeneration
 				LevelDefinition::VoxelMeshDefID voxelMeshDefID;
 				LevelDefinition::VoxelTextureDefID voxelTextureDefID;
 				LevelDefinition::VoxelTraitsDefID voxelTraitsDefID;
-				const auto defIter = voxelCache->find(florVoxel);
-				if (defIter != voxelCache->end())
+				const ArenaVoxelMappingEntry *entryPtr = voxelCache->tryGet(florVoxel);
+				if (entryPtr != nullptr)
 				{
-					const ArenaVoxelMappingEntry &entry = defIter->second;
+					const ArenaVoxelMappingEntry &entry = *entryPtr;
 					voxelMeshDefID = entry.meshDefID;
 					voxelTextureDefID = entry.textureDefID;
 					voxelTraitsDefID = entry.traitsDefID;
@@ -1236,7 +1308,7 @@ namespace MapGeneration
 
 					ArenaVoxelMappingEntry newEntry;
 					newEntry.init(voxelMeshDefID, voxelTextureDefID, voxelTraitsDefID);
-					voxelCache->emplace(florVoxel, newEntry);
+					voxelCache->set(florVoxel, newEntry);
 				}
 
 				const SNInt levelX = florZ;
@@ -1252,10 +1324,10 @@ namespace MapGeneration
 				{
 					// Get entity def ID from cache or create a new one.
 					LevelDefinition::EntityDefID entityDefID;
-					const auto iter = entityCache->find(florVoxel);
-					if (iter != entityCache->end())
+					const LevelDefinition::EntityDefID *entityDefIDPtr = entityCache->tryGet(florVoxel);
+					if (entityDefIDPtr != nullptr)
 					{
-						entityDefID = iter->second;
+						entityDefID = *entityDefIDPtr;
 					}
 					else
 					{
@@ -1271,7 +1343,7 @@ namespace MapGeneration
 						}
 
 						entityDefID = outLevelInfoDef->addEntityDef(std::move(entityDef));
-						entityCache->emplace(florVoxel, entityDefID);
+						entityCache->set(florVoxel, entityDefID);
 					}
 
 					const WorldDouble3 entityPos(
@@ -1290,10 +1362,10 @@ namespace MapGeneration
 					const VoxelTraitsDefinition::Chasm &chasm = traitsDef.chasm;
 
 					LevelDefinition::ChasmDefID chasmDefID;
-					const auto chasmIter = chasmCache->find(florVoxel);
-					if (chasmIter != chasmCache->end())
+					const LevelDefinition::ChasmDefID *chasmDefIDPtr = chasmCache->tryGet(florVoxel);
+					if (chasmDefIDPtr != nullptr)
 					{
-						chasmDefID = chasmIter->second;
+						chasmDefID = *chasmDefIDPtr;
 					}
 					else
 					{
@@ -1304,7 +1376,7 @@ namespace MapGeneration
 						chasmDef.initClassic(chasm.type, chasmWallTextureAsset, textureManager);
 
 						chasmDefID = outLevelInfoDef->addChasmDef(std::move(chasmDef));
-						chasmCache->emplace(florVoxel, chasmDefID);
+						chasmCache->set(florVoxel, chasmDefID);
 					}
 
 					outLevelDef->addChasm(chasmDefID, VoxelInt3(levelX, levelY, levelZ));
@@ -1369,10 +1441,10 @@ namespace MapGeneration
 					LevelDefinition::VoxelMeshDefID voxelMeshDefID;
 					LevelDefinition::VoxelTextureDefID voxelTextureDefID;
 					LevelDefinition::VoxelTraitsDefID voxelTraitsDefID;
-					const auto defIter = voxelCache->find(map1Voxel);
-					if (defIter != voxelCache->end())
+					const ArenaVoxelMappingEntry *entryPtr = voxelCache->tryGet(map1Voxel);
+					if (entryPtr != nullptr)
 					{
-						const ArenaVoxelMappingEntry &entry = defIter->second;
+						const ArenaVoxelMappingEntry &entry = *entryPtr;
 						voxelMeshDefID = entry.meshDefID;
 						voxelTextureDefID = entry.textureDefID;
 						voxelTraitsDefID = entry.traitsDefID;
@@ -1392,7 +1464,7 @@ namespace MapGeneration
 
 						ArenaVoxelMappingEntry newEntry;
 						newEntry.init(voxelMeshDefID, voxelTextureDefID, voxelTraitsDefID);
-						voxelCache->emplace(map1Voxel, newEntry);
+						voxelCache->set(map1Voxel, newEntry);
 					}
 
 					outLevelDef->setVoxelMeshID(levelX, levelY, levelZ, voxelMeshDefID);
@@ -1409,10 +1481,10 @@ namespace MapGeneration
 					{
 						// Get transition def ID from cache or create a new one.
 						LevelDefinition::TransitionDefID transitionDefID;
-						const auto iter = transitionCache->find(map1Voxel);
-						if (iter != transitionCache->end())
+						const LevelDefinition::TransitionDefID *transitionDefIDPtr = transitionCache->tryGet(map1Voxel);
+						if (transitionDefIDPtr != nullptr)
 						{
-							transitionDefID = iter->second;
+							transitionDefID = *transitionDefIDPtr;
 						}
 						else
 						{
@@ -1421,7 +1493,7 @@ namespace MapGeneration
 								rulerIsMale, palaceIsMainQuestDungeon, cityType, dungeonDef, isArtifactDungeon,
 								mapType, binaryAssetLibrary.getExeData());
 							transitionDefID = outLevelInfoDef->addTransitionDef(std::move(transitionDef));
-							transitionCache->emplace(map1Voxel, transitionDefID);
+							transitionCache->set(map1Voxel, transitionDefID);
 						}
 
 						outLevelDef->addTransition(transitionDefID, levelPosition);
@@ -1435,16 +1507,16 @@ namespace MapGeneration
 					{
 						// Get door def ID from cache or create a new one.
 						LevelDefinition::DoorDefID doorDefID;
-						const auto iter = doorCache->find(map1Voxel);
-						if (iter != doorCache->end())
+						const LevelDefinition::DoorDefID *doorDefIDPtr = doorCache->tryGet(map1Voxel);
+						if (doorDefIDPtr != nullptr)
 						{
-							doorDefID = iter->second;
+							doorDefID = *doorDefIDPtr;
 						}
 						else
 						{
 							DoorDefinition doorDef = MapGeneration::makeDoorDef(*doorDefGenInfo, inf);
 							doorDefID = outLevelInfoDef->addDoorDef(std::move(doorDef));
-							doorCache->emplace(map1Voxel, doorDefID);
+							doorCache->set(map1Voxel, doorDefID);
 						}
 
 						outLevelDef->addDoor(doorDefID, levelPosition);
@@ -1454,10 +1526,10 @@ namespace MapGeneration
 				{
 					// Get entity def ID from cache or create a new one.
 					LevelDefinition::EntityDefID entityDefID;
-					const auto iter = entityCache->find(map1Voxel);
-					if (iter != entityCache->end())
+					const LevelDefinition::EntityDefID *entityDefIDPtr = entityCache->tryGet(map1Voxel);
+					if (entityDefIDPtr != nullptr)
 					{
-						entityDefID = iter->second;
+						entityDefID = *entityDefIDPtr;
 					}
 					else
 					{
@@ -1473,7 +1545,7 @@ namespace MapGeneration
 						}
 
 						entityDefID = outLevelInfoDef->addEntityDef(std::move(entityDef));
-						entityCache->emplace(map1Voxel, entityDefID);
+						entityCache->set(map1Voxel, entityDefID);
 					}
 
 					const WorldDouble3 entityPos(
@@ -1506,10 +1578,10 @@ namespace MapGeneration
 				LevelDefinition::VoxelMeshDefID voxelMeshDefID;
 				LevelDefinition::VoxelTextureDefID voxelTextureDefID;
 				LevelDefinition::VoxelTraitsDefID voxelTraitsDefID;
-				const auto defIter = voxelCache->find(map2Voxel);
-				if (defIter != voxelCache->end())
+				const ArenaVoxelMappingEntry *entryPtr = voxelCache->tryGet(map2Voxel);
+				if (entryPtr != nullptr)
 				{
-					const ArenaVoxelMappingEntry &entry = defIter->second;
+					const ArenaVoxelMappingEntry &entry = *entryPtr;
 					voxelMeshDefID = entry.meshDefID;
 					voxelTextureDefID = entry.textureDefID;
 					voxelTraitsDefID = entry.traitsDefID;
@@ -1526,7 +1598,7 @@ namespace MapGeneration
 
 					ArenaVoxelMappingEntry newEntry;
 					newEntry.init(voxelMeshDefID, voxelTextureDefID, voxelTraitsDefID);
-					voxelCache->emplace(map2Voxel, newEntry);
+					voxelCache->set(map2Voxel, newEntry);
 				}
 
 				// Duplicate voxels upward based on calculated height.
@@ -1575,13 +1647,8 @@ namespace MapGeneration
 
 		// Get lock def ID from cache or create a new one.
 		LevelDefinition::LockDefID lockDefID;
-		const auto iter = std::find_if(lockMappings->begin(), lockMappings->end(),
-			[&lock](const std::pair<ArenaTypes::MIFLock, LevelDefinition::LockDefID> &pair)
-		{
-			const ArenaTypes::MIFLock &mifLock = pair.first;
-			return (mifLock.x == lock.x) && (mifLock.y == lock.y) && (mifLock.lockLevel == lock.lockLevel);
-		});
-
+		const uint32_t lockKey = MapGeneration::makeLockMappingKey(lock);
+		const auto iter = lockMappings->find(lockKey);
 		if (iter != lockMappings->end())
 		{
 			lockDefID = iter->second;
@@ -1590,7 +1657,7 @@ namespace MapGeneration
 		{
 			LockDefinition lockDef = MapGeneration::makeLockDefFromArenaLock(lock);
 			lockDefID = outLevelInfoDef->addLockDef(std::move(lockDef));
-			lockMappings->emplace_back(std::make_pair(lock, lockDefID));
+			lockMappings->emplace(lockKey, lockDefID);
 		}
 
 		const LockDefinition &lockDef = outLevelInfoDef->getLockDef(lockDefID);
@@ -1606,19 +1673,12 @@ namespace MapGeneration
 	{
 		// See if the trigger has already been added. Prevent duplicate triggers since they exist in at least
 		// one of the original game's main quest dungeons.
-		const auto iter = std::find_if(triggerMappings->begin(), triggerMappings->end(),
-			[&trigger](const std::pair<ArenaTypes::MIFTrigger, LevelDefinition::TriggerDefID> &pair)
-		{
-			const ArenaTypes::MIFTrigger &mifTrigger = pair.first;
-			return (mifTrigger.x == trigger.x) && (mifTrigger.y == trigger.y) &&
-				(mifTrigger.textIndex == trigger.textIndex) && (mifTrigger.soundIndex == trigger.soundIndex);
-		});
-
-		if (iter == triggerMappings->end())
+		const uint32_t triggerKey = MapGeneration::makeTriggerMappingKey(trigger);
+		if (triggerMappings->find(triggerKey) == triggerMappings->end())
 		{
 			const LevelDefinition::TriggerDefID triggerDefID = outLevelInfoDef->addTriggerDef(
 				MapGeneration::makeTriggerDefFromArenaTrigger(trigger, inf));
-			triggerMappings->emplace_back(std::make_pair(trigger, triggerDefID));
+			triggerMappings->emplace(triggerKey, triggerDefID);
 
 			const VoxelTriggerDefinition &triggerDef = outLevelInfoDef->getTriggerDef(triggerDefID);
 			const SNInt x = triggerDef.getX();
@@ -2522,109 +2582,86 @@ void MapGeneration::generateMifCity(const MIFFile &mif, uint32_t citySeed, uint3
 		outLevelInfoDef);
 }
 
-void MapGeneration::generateRmdWilderness(BufferView<const ArenaWildUtils::WildBlockID> uniqueWildBlockIDs,
-	BufferView2D<const int> levelDefIndices, const LocationCityDefinition &cityDef,
+std::shared_ptr<MapGeneration::WildMappingCaches> MapGeneration::makeWildMappingCaches()
+{
+	return std::make_shared<WildMappingCaches>();
+}
+
+void MapGeneration::generateRmdWildBlock(ArenaWildUtils::WildBlockID wildBlockID, const LocationCityDefinition &cityDef,
 	const INFFile &inf, const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
-	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager,
-	BufferView<LevelDefinition> &outLevelDefs, LevelInfoDefinition *outLevelInfoDef,
-	std::vector<MapGeneration::WildChunkBuildingNameInfo> *outBuildingNameInfos)
+	const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager, LevelDefinition *outLevelDef,
+	LevelInfoDefinition *outLevelInfoDef, WildMappingCaches *caches)
 {
-	DebugAssert(uniqueWildBlockIDs.getCount() == outLevelDefs.getCount());
+	DebugAssert(caches != nullptr);
 
-	ArenaVoxelMappingCache florMappings, map1Mappings, map2Mappings;
-	ArenaEntityMappingCache entityMappings;
-	ArenaTransitionMappingCache transitionMappings;
-	ArenaBuildingNameMappingCache buildingNameMappings;
-	ArenaDoorMappingCache doorMappings;
-	ArenaChasmMappingCache chasmMappings;
+	const auto &rmdFiles = ArenaLevelLibrary::getInstance().getWildernessChunks();
+	const int rmdIndex = DebugMakeIndex(rmdFiles, wildBlockID - 1);
+	const RMDFile &rmd = rmdFiles[rmdIndex];
+	const BufferView2D<const ArenaTypes::VoxelID> rmdFLOR = rmd.getFLOR();
+	const BufferView2D<const ArenaTypes::VoxelID> rmdMAP1 = rmd.getMAP1();
+	const BufferView2D<const ArenaTypes::VoxelID> rmdMAP2 = rmd.getMAP2();
 
-	// Create temp voxel data buffers to be used by each wilderness chunk.
+	// Copy .RMD voxels into temp buffers.
 	constexpr int chunkDim = ChunkUtils::CHUNK_DIM;
 	Buffer2D<ArenaTypes::VoxelID> tempFlor(chunkDim, chunkDim);
 	Buffer2D<ArenaTypes::VoxelID> tempMap1(chunkDim, chunkDim);
 	Buffer2D<ArenaTypes::VoxelID> tempMap2(chunkDim, chunkDim);
-
-	for (int i = 0; i < uniqueWildBlockIDs.getCount(); i++)
+	for (int y = 0; y < tempFlor.getHeight(); y++)
 	{
-		const ArenaWildUtils::WildBlockID wildBlockID = uniqueWildBlockIDs.get(i);
-		const auto &rmdFiles = ArenaLevelLibrary::getInstance().getWildernessChunks();
-		const int rmdIndex = DebugMakeIndex(rmdFiles, wildBlockID - 1);
-		const RMDFile &rmd = rmdFiles[rmdIndex];
-		const BufferView2D<const ArenaTypes::VoxelID> rmdFLOR = rmd.getFLOR();
-		const BufferView2D<const ArenaTypes::VoxelID> rmdMAP1 = rmd.getMAP1();
-		const BufferView2D<const ArenaTypes::VoxelID> rmdMAP2 = rmd.getMAP2();
-
-		// Copy .RMD voxels into temp buffers.
-		for (int y = 0; y < tempFlor.getHeight(); y++)
-		{
-			for (int x = 0; x < tempFlor.getWidth(); x++)
-			{
-				const ArenaTypes::VoxelID rmdFlorID = rmdFLOR.get(x, y);
-				const ArenaTypes::VoxelID rmdMap1ID = rmdMAP1.get(x, y);
-				const ArenaTypes::VoxelID rmdMap2ID = rmdMAP2.get(x, y);
-				tempFlor.set(x, y, rmdFlorID);
-				tempMap1.set(x, y, rmdMap1ID);
-				tempMap2.set(x, y, rmdMap2ID);
-			}
+		for (int x = 0; x < tempFlor.getWidth(); x++)
+		{
+			const ArenaTypes::VoxelID rmdFlorID = rmdFLOR.get(x, y);
+			const ArenaTypes::VoxelID rmdMap1ID = rmdMAP1.get(x, y);
+			const ArenaTypes::VoxelID rmdMap2ID = rmdMAP2.get(x, y);
+			tempFlor.set(x, y, rmdFlorID);
+			tempMap1.set(x, y, rmdMap1ID);
+			tempMap2.set(x, y, rmdMap2ID);
 		}
+	}
 
-		if (ArenaWildUtils::isWildCityBlock(wildBlockID))
-		{
-			// Change the placeholder WILD00{1..4}.RMD block to the one for the given city.
-			BufferView2D<ArenaTypes::VoxelID> tempFlorView(tempFlor);
-			BufferView2D<ArenaTypes::VoxelID> tempMap1View(tempMap1);
-			BufferView2D<ArenaTypes::VoxelID> tempMap2View(tempMap2);
-			ArenaWildUtils::reviseWildCityBlock(wildBlockID, tempFlorView, tempMap1View, tempMap2View, cityDef, binaryAssetLibrary);
-		}
-
-		LevelDefinition &levelDef = outLevelDefs.get(i);
-
-		const BufferView2D<const ArenaTypes::VoxelID> tempFlorConstView(tempFlor);
-		const BufferView2D<const ArenaTypes::VoxelID> tempMap1ConstView(tempMap1);
-		const BufferView2D<const ArenaTypes::VoxelID> tempMap2ConstView(tempMap2);
+	if (ArenaWildUtils::isWildCityBlock(wildBlockID))
+	{
+		// Change the placeholder WILD00{1..4}.RMD block to the one for the given city.
+		BufferView2D<ArenaTypes::VoxelID> tempFlorView(tempFlor);
+		BufferView2D<ArenaTypes::VoxelID> tempMap1View(tempMap1);
+		BufferView2D<ArenaTypes::VoxelID> tempMap2View(tempMap2);
+		ArenaWildUtils::reviseWildCityBlock(wildBlockID, tempFlorView, tempMap1View, tempMap2View, cityDef, binaryAssetLibrary);
+	}
 
-		constexpr MapType mapType = MapType::Wilderness;
-		constexpr std::optional<ArenaTypes::InteriorType> interiorType; // Wilderness is not an interior.
+	const BufferView2D<const ArenaTypes::VoxelID> tempFlorConstView(tempFlor);
+	const BufferView2D<const ArenaTypes::VoxelID> tempMap1ConstView(tempMap1);
+	const BufferView2D<const ArenaTypes::VoxelID> tempMap2ConstView(tempMap2);
 
-		// Dungeon definition if this chunk has any dungeons.
-		const uint32_t dungeonSeed = cityDef.provinceSeed;
-		LocationDungeonDefinition dungeonDef;
-		dungeonDef.init(dungeonSeed, ArenaWildUtils::WILD_DUNGEON_WIDTH_CHUNKS, ArenaWildUtils::WILD_DUNGEON_HEIGHT_CHUNKS);
+	constexpr MapType mapType = MapType::Wilderness;
+	constexpr std::optional<ArenaTypes::InteriorType> interiorType; // Wilderness is not an interior.
 
-		constexpr std::optional<bool> isArtifactDungeon = false; // No artifacts in wild dungeons.
+	// Dungeon definition if this chunk has any dungeons.
+	const uint32_t dungeonSeed = cityDef.provinceSeed;
+	LocationDungeonDefinition dungeonDef;
+	dungeonDef.init(dungeonSeed, ArenaWildUtils::WILD_DUNGEON_WIDTH_CHUNKS, ArenaWildUtils::WILD_DUNGEON_HEIGHT_CHUNKS);
 
-		MapGeneration::readArenaFLOR(tempFlorConstView, mapType, interiorType, cityDef.rulerIsMale, inf,
-			charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, &levelDef,
-			outLevelInfoDef, &florMappings, &entityMappings, &chasmMappings);
-		MapGeneration::readArenaMAP1(tempMap1ConstView, mapType, interiorType, cityDef.rulerSeed, cityDef.rulerIsMale,
-			cityDef.palaceIsMainQuestDungeon, cityDef.type, &dungeonDef, isArtifactDungeon, inf, charClassLibrary,
-			entityDefLibrary, binaryAssetLibrary, textureManager, &levelDef, outLevelInfoDef, &map1Mappings,
-			&entityMappings, &transitionMappings, &doorMappings);
-		MapGeneration::readArenaMAP2(tempMap2ConstView, inf, &levelDef, outLevelInfoDef, &map2Mappings);
-	}
+	constexpr std::optional<bool> isArtifactDungeon = false; // No artifacts in wild dungeons.
 
-	// Generate chunk-wise building names for the wilderness.
-	for (WEInt z = 0; z < levelDefIndices.getHeight(); z++)
-	{
-		for (SNInt x = 0; x < levelDefIndices.getWidth(); x++)
-		{
-			const int levelDefIndex = levelDefIndices.get(x, z);
-			const LevelDefinition &levelDef = outLevelDefs.get(levelDefIndex);
-			const ChunkInt2 chunk(x, z);
-			const uint32_t chunkSeed = ArenaWildUtils::makeWildChunkSeed(chunk.x, chunk.y);
-			MapGeneration::WildChunkBuildingNameInfo buildingNameInfo;
-			buildingNameInfo.init(chunk);
+	MapGeneration::readArenaFLOR(tempFlorConstView, mapType, interiorType, cityDef.rulerIsMale, inf,
+		charClassLibrary, entityDefLibrary, binaryAssetLibrary, textureManager, outLevelDef,
+		outLevelInfoDef, &caches->florMappings, &caches->entityMappings, &caches->chasmMappings);
+	MapGeneration::readArenaMAP1(tempMap1ConstView, mapType, interiorType, cityDef.rulerSeed, cityDef.rulerIsMale,
+		cityDef.palaceIsMainQuestDungeon, cityDef.type, &dungeonDef, isArtifactDungeon, inf, charClassLibrary,
+		entityDefLibrary, binaryAssetLibrary, textureManager, outLevelDef, outLevelInfoDef, &caches->map1Mappings,
+		&caches->entityMappings, &caches->transitionMappings, &caches->doorMappings);
+	MapGeneration::readArenaMAP2(tempMap2ConstView, inf, outLevelDef, outLevelInfoDef, &caches->map2Mappings);
+}
 
-			MapGeneration::generateArenaWildChunkBuildingNames(chunkSeed, levelDef, binaryAssetLibrary,
-				&buildingNameInfo, outLevelInfoDef, &buildingNameMappings);
+void MapGeneration::generateRmdWildChunkBuildingNames(const ChunkInt2 &chunk, const LevelDefinition &levelDef,
+	const BinaryAssetLibrary &binaryAssetLibrary, LevelInfoDefinition *outLevelInfoDef, WildMappingCaches *caches,
+	MapGeneration::WildChunkBuildingNameInfo *outBuildingNameInfo)
+{
+	DebugAssert(caches != nullptr);
 
-			// Register the chunk if it has any buildings with names.
-			if (buildingNameInfo.hasBuildingNames())
-			{
-				outBuildingNameInfos->emplace_back(std::move(buildingNameInfo));
-			}
-		}
-	}
+	const uint32_t chunkSeed = ArenaWildUtils::makeWildChunkSeed(chunk.x, chunk.y);
+	outBuildingNameInfo->init(chunk);
+	MapGeneration::generateArenaWildChunkBuildingNames(chunkSeed, levelDef, binaryAssetLibrary, outBuildingNameInfo,
+		outLevelInfoDef, &caches->buildingNameMappings);
 }
 
 void MapGeneration::readMifLocks(BufferView<const MIFLevel> levels, const INFFile &inf,
@@ -2,6 +2,7 @@
 #define MAP_GENERATION_H
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -200,15 +201,22 @@ namespace MapGeneration
 		const TextAssetLibrary &textAssetLibrary, TextureManager &textureManager,
 		LevelDefinition *outLevelDef, LevelInfoDefinition *outLevelInfoDef);
 
-	// Generates wilderness chunks from a list of unique wild block IDs. Each block ID maps to the
-	// level definition at the same index.
-	void generateRmdWilderness(BufferView<const ArenaWildUtils::WildBlockID> uniqueWildBlockIDs,
-		BufferView2D<const int> levelDefIndices, const LocationCityDefinition &cityDef,
-		const INFFile &inf, const CharacterClassLibrary &charClassLibrary,
-		const EntityDefinitionLibrary &entityDefLibrary,const BinaryAssetLibrary &binaryAssetLibrary,
-		TextureManager &textureManager, BufferView<LevelDefinition> &outLevelDefs,
-		LevelInfoDefinition *outLevelInfoDef,
-		std::vector<MapGeneration::WildChunkBuildingNameInfo> *outBuildingNameInfos);
+	// Mapping caches kept between on-demand wilderness generation calls so every wild block and chunk shares
+	// the same level info definitions.
+	struct WildMappingCaches;
+	std::shared_ptr<WildMappingCaches> makeWildMappingCaches();
+
+	// Converts one .RMD wild block to the modern format.
+	void generateRmdWildBlock(ArenaWildUtils::WildBlockID wildBlockID, const LocationCityDefinition &cityDef,
+		const INFFile &inf, const CharacterClassLibrary &charClassLibrary, const EntityDefinitionLibrary &entityDefLibrary,
+		const BinaryAssetLibrary &binaryAssetLibrary, TextureManager &textureManager, LevelDefinition *outLevelDef,
+		LevelInfoDefinition *outLevelInfoDef, WildMappingCaches *caches);
+
+	// Generates building names for a wild chunk from its seed. The chunk's level definition must already be
+	// generated.
+	void generateRmdWildChunkBuildingNames(const ChunkInt2 &chunk, const LevelDefinition &levelDef,
+		const BinaryAssetLibrary &binaryAssetLibrary, LevelInfoDefinition *outLevelInfoDef, WildMappingCaches *caches,
+		MapGeneration::WildChunkBuildingNameInfo *outBuildingNameInfo);
 
 	void readMifLocks(BufferView<const MIFLevel> levels, const INFFile &inf,
 		BufferView<LevelDefinition> &outLevelDefs, LevelInfoDefinition *outLevelInfoDef);
@@ -1,9 +1,18 @@
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <cstring>
 #include <ctime>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 #include "Debug.h"
 #include "../utilities/Directory.h"
@@ -50,12 +59,261 @@ namespace
 	}
 }
 
+
 namespace Log
 {
 	constexpr int MAX_FILES = 10;
+	constexpr int RING_CAPACITY = 1024; // Messages queued per thread before the thread writes them itself.
+	constexpr auto WRITER_INTERVAL = std::chrono::milliseconds(20);
+
+	// Repeats from one call site beyond this many per window are dropped and counted instead.
+	constexpr auto RATE_LIMIT_WINDOW = std::chrono::seconds(1);
+	constexpr int RATE_LIMIT_COUNT = 8;
 
 	char pathBuffer[1024];
 	std::ofstream stream;
+
+	struct Record
+	{
+		uint64_t sequence; // Restores cross-thread order when draining.
+		DebugMessageType type;
+		const char *filePath;
+		int lineNumber;
+		int suppressedCount; // Non-zero for a summary of dropped repeats instead of a message.
+		std::string message;
+	};
+
+	// Repeats dropped from one call site since its last summary.
+	struct SuppressedCallSite
+	{
+		uint64_t sequence; // Of the latest dropped repeat, so the summary sorts where it would have been.
+		DebugMessageType type;
+		const char *filePath;
+		int lineNumber;
+		int count;
+	};
+
+	// Single-producer single-consumer queue owned by one logging thread. The consumer is whoever holds writeMutex.
+	class Ring
+	{
+	private:
+		std::vector<Record> records;
+		std::atomic<uint32_t> head, tail;
+
+		std::mutex suppressedMutex; // Only taken when a repeat is dropped or when draining.
+		std::unordered_map<uint64_t, SuppressedCallSite> suppressedCallSites;
+	public:
+		std::atomic<bool> orphaned; // Set when the owning thread exits.
+
+		Ring()
+			: records(RING_CAPACITY), head(0), tail(0), orphaned(false) { }
+
+		uint32_t getCount() const
+		{
+			return this->head.load(std::memory_order_relaxed) - this->tail.load(std::memory_order_relaxed);
+		}
+
+		bool tryPush(Record &&record)
+		{
+			const uint32_t headIndex = this->head.load(std::memory_order_relaxed);
+			if ((headIndex - this->tail.load(std::memory_order_acquire)) == RING_CAPACITY)
+			{
+				return false;
+			}
+
+			this->records[headIndex % RING_CAPACITY] = std::move(record);
+			this->head.store(headIndex + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool tryPop(Record *outRecord)
+		{
+			const uint32_t tailIndex = this->tail.load(std::memory_order_relaxed);
+			if (tailIndex == this->head.load(std::memory_order_acquire))
+			{
+				return false;
+			}
+
+			*outRecord = std::move(this->records[tailIndex % RING_CAPACITY]);
+			this->tail.store(tailIndex + 1, std::memory_order_release);
+			return true;
+		}
+
+		void addSuppressed(uint64_t callSiteKey, const Record &record)
+		{
+			std::lock_guard<std::mutex> lock(this->suppressedMutex);
+			SuppressedCallSite &callSite = this->suppressedCallSites[callSiteKey];
+			callSite.sequence = record.sequence;
+			callSite.type = record.type;
+			callSite.filePath = record.filePath;
+			callSite.lineNumber = record.lineNumber;
+			callSite.count++;
+		}
+
+		// Moves a summary record for each call site with dropped repeats into the given list.
+		void takeSuppressed(std::vector<Record> &outRecords)
+		{
+			std::lock_guard<std::mutex> lock(this->suppressedMutex);
+			for (const auto &pair : this->suppressedCallSites)
+			{
+				const SuppressedCallSite &callSite = pair.second;
+
+				Record record;
+				record.sequence = callSite.sequence;
+				record.type = callSite.type;
+				record.filePath = callSite.filePath;
+				record.lineNumber = callSite.lineNumber;
+				record.suppressedCount = callSite.count;
+				outRecords.emplace_back(std::move(record));
+			}
+
+			this->suppressedCallSites.clear();
+		}
+	};
+
+	struct CallSiteLimit
+	{
+		std::chrono::steady_clock::time_point windowStart;
+		int count;
+
+		CallSiteLimit()
+		{
+			this->count = 0;
+		}
+	};
+
+	struct ThreadState
+	{
+		std::shared_ptr<Ring> ring; // Created on the thread's first message.
+		std::unordered_map<uint64_t, CallSiteLimit> callSiteLimits;
+
+		~ThreadState()
+		{
+			if (this->ring != nullptr)
+			{
+				this->ring->orphaned.store(true, std::memory_order_release);
+			}
+		}
+	};
+
+	std::mutex writeMutex; // Guards the ring list, draining, and the output streams.
+	std::vector<std::shared_ptr<Ring>> rings;
+	std::vector<Record> pendingRecords;
+	std::atomic<uint64_t> nextSequence(0);
+
+	std::thread writerThread;
+	std::mutex writerMutex;
+	std::condition_variable writerCondition;
+	bool writerStopRequested = false; // Guarded by writerMutex.
+	std::atomic<bool> writerRunning(false);
+
+	std::atomic<int> minimumType(static_cast<int>(DebugMessageType::Status));
+	std::atomic<bool> anyCategoryDisabled(false);
+	std::mutex categoryMutex;
+	std::vector<std::string> disabledCategories;
+
+	thread_local ThreadState threadState;
+
+	void appendRecord(const Record &record, std::string &output)
+	{
+		output += '[';
+		output += record.filePath;
+		output += '(' + std::to_string(record.lineNumber) + ")] ";
+		output += GetDebugMessageTypeString(record.type);
+		if (record.suppressedCount > 0)
+		{
+			output += "(" + std::to_string(record.suppressedCount) + " similar message" +
+				((record.suppressedCount > 1) ? "s" : "") + " suppressed)";
+		}
+		else
+		{
+			output += record.message;
+		}
+
+		output += '\n';
+	}
+
+	void writeOutputLocked(const std::string &output)
+	{
+		std::cerr << output;
+		if (Log::stream.is_open())
+		{
+			Log::stream << output;
+		}
+	}
+
+	// Writes everything queued by all threads. Must hold writeMutex.
+	void drainLocked()
+	{
+		for (auto iter = Log::rings.begin(); iter != Log::rings.end(); )
+		{
+			Ring &ring = **iter;
+			const bool orphaned = ring.orphaned.load(std::memory_order_acquire);
+
+			Record record;
+			while (ring.tryPop(&record))
+			{
+				Log::pendingRecords.emplace_back(std::move(record));
+			}
+
+			ring.takeSuppressed(Log::pendingRecords);
+			iter = orphaned ? Log::rings.erase(iter) : std::next(iter);
+		}
+
+		if (Log::pendingRecords.empty())
+		{
+			return;
+		}
+
+		std::sort(Log::pendingRecords.begin(), Log::pendingRecords.end(),
+			[](const Record &a, const Record &b) { return a.sequence < b.sequence; });
+
+		std::string output;
+		for (const Record &record : Log::pendingRecords)
+		{
+			Log::appendRecord(record, output);
+		}
+
+		Log::pendingRecords.clear();
+		Log::writeOutputLocked(output);
+		Log::stream.flush();
+	}
+
+	void runWriterThread()
+	{
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(Log::writerMutex);
+				if (!Log::writerStopRequested)
+				{
+					Log::writerCondition.wait_for(lock, Log::WRITER_INTERVAL);
+				}
+
+				if (Log::writerStopRequested)
+				{
+					break;
+				}
+			}
+
+			std::lock_guard<std::mutex> lock(Log::writeMutex);
+			Log::drainLocked();
+		}
+	}
+
+	// Makes sure the writer thread is joined even if the program exits without calling Debug::shutdown().
+	struct ShutdownGuard
+	{
+		~ShutdownGuard()
+		{
+			if (Log::writerThread.joinable())
+			{
+				Debug::shutdown();
+			}
+		}
+	};
+
+	ShutdownGuard shutdownGuard;
 }
 
 bool Debug::init(const char *logDirectory)
@@ -89,62 +347,210 @@ bool Debug::init(const char *logDirectory)
 		return false;
 	}
 
+	if (!Log::writerThread.joinable())
+	{
+		Log::writerStopRequested = false;
+		Log::writerRunning.store(true, std::memory_order_release);
+		Log::writerThread = std::thread(Log::runWriterThread);
+	}
+
 	return true;
 }
 
 void Debug::shutdown()
 {
+	// Later messages are written synchronously.
+	Log::writerRunning.store(false, std::memory_order_release);
+
+	if (Log::writerThread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock(Log::writerMutex);
+			Log::writerStopRequested = true;
+		}
+
+		Log::writerCondition.notify_all();
+		Log::writerThread.join();
+	}
+
+	Debug::flush();
+
+	std::lock_guard<std::mutex> lock(Log::writeMutex);
 	Log::stream.close();
 	std::fill(std::begin(Log::pathBuffer), std::end(Log::pathBuffer), '\0');
 }
 
-std::string Debug::getShorterPath(const char *__file__)
+void Debug::flush()
+{
+	std::lock_guard<std::mutex> lock(Log::writeMutex);
+	Log::drainLocked();
+	std::cerr.flush();
+	Log::stream.flush();
+}
+
+void Debug::setMinimumType(DebugMessageType type)
+{
+	Log::minimumType.store(static_cast<int>(type), std::memory_order_relaxed);
+}
+
+void Debug::setCategoryEnabled(const std::string &category, bool enabled)
+{
+	std::lock_guard<std::mutex> lock(Log::categoryMutex);
+	std::vector<std::string> &categories = Log::disabledCategories;
+	const auto iter = std::find(categories.begin(), categories.end(), category);
+	if (!enabled && (iter == categories.end()))
+	{
+		categories.emplace_back(category);
+	}
+	else if (enabled && (iter != categories.end()))
+	{
+		categories.erase(iter);
+	}
+
+	Log::anyCategoryDisabled.store(!categories.empty(), std::memory_order_relaxed);
+}
+
+bool Debug::isEnabled(DebugMessageType type, const char *filePath)
 {
-	// Replace back-slashes with forward slashes, then split.
-	const std::string path = String::replace(std::string(__file__), '\\', '/');
-	const Buffer<std::string> tokens = String::split(path, '/');
+	if (static_cast<int>(type) < Log::minimumType.load(std::memory_order_relaxed))
+	{
+		return false;
+	}
 
-	std::string shortPath;
+	// Errors are never muted by category.
+	if ((type == DebugMessageType::Error) || !Log::anyCategoryDisabled.load(std::memory_order_relaxed))
+	{
+		return true;
+	}
 
-	if (tokens.getCount() >= 2)
+	const char *separator = std::strpbrk(filePath, "/\\");
+	if (separator == nullptr)
 	{
-		shortPath = tokens[tokens.getCount() - 2] + '/' + tokens[tokens.getCount() - 1];
+		return true;
 	}
-	else if (tokens.getCount() == 1)
+
+	const size_t categoryLength = static_cast<size_t>(separator - filePath);
+	std::lock_guard<std::mutex> lock(Log::categoryMutex);
+	for (const std::string &category : Log::disabledCategories)
 	{
-		shortPath = tokens[0];
+		if ((category.size() == categoryLength) && (std::strncmp(category.c_str(), filePath, categoryLength) == 0))
+		{
+			return false;
+		}
 	}
 
-	return shortPath;
+	return true;
 }
 
-void Debug::write(DebugMessageType type, const std::string &filePath, int lineNumber, const std::string &message)
+void Debug::write(DebugMessageType type, const char *filePath, int lineNumber, std::string &&message)
 {
-	const std::string &messageTypeStr = GetDebugMessageTypeString(type);
-	const std::string lineNumberStr = std::to_string(lineNumber);
-	const std::string outputStr = "[" + filePath + "(" + lineNumberStr + ")] " + messageTypeStr + message + '\n';
-	std::cerr << outputStr;
-	Log::stream << outputStr;
+	Log::Record record;
+	record.sequence = Log::nextSequence.fetch_add(1, std::memory_order_relaxed);
+	record.type = type;
+	record.filePath = filePath;
+	record.lineNumber = lineNumber;
+	record.suppressedCount = 0;
+	record.message = std::move(message);
+
+	if (!Log::writerRunning.load(std::memory_order_acquire))
+	{
+		// Before init or after shutdown; write immediately.
+		std::lock_guard<std::mutex> lock(Log::writeMutex);
+		Log::drainLocked();
+
+		std::string output;
+		Log::appendRecord(record, output);
+		Log::writeOutputLocked(output);
+		return;
+	}
+
+	Log::ThreadState &threadState = Log::threadState;
+	if (threadState.ring == nullptr)
+	{
+		threadState.ring = std::make_shared<Log::Ring>();
+
+		std::lock_guard<std::mutex> lock(Log::writeMutex);
+		Log::rings.emplace_back(threadState.ring);
+	}
+
+	Log::Ring &ring = *threadState.ring;
+
+	// Errors are never rate limited.
+	if (type != DebugMessageType::Error)
+	{
+		const uint64_t callSiteKey = (static_cast<uint64_t>(reinterpret_cast<uintptr_t>(filePath)) << 16) ^
+			static_cast<uint64_t>(lineNumber);
+		Log::CallSiteLimit &callSiteLimit = threadState.callSiteLimits[callSiteKey];
+		const auto now = std::chrono::steady_clock::now();
+		if ((now - callSiteLimit.windowStart) >= Log::RATE_LIMIT_WINDOW)
+		{
+			callSiteLimit.windowStart = now;
+			callSiteLimit.count = 0;
+		}
+
+		if (callSiteLimit.count >= Log::RATE_LIMIT_COUNT)
+		{
+			// Reported as one summary line the next time the rings are drained.
+			ring.addSuppressed(callSiteKey, record);
+			return;
+		}
+
+		callSiteLimit.count++;
+	}
+
+	if (!ring.tryPush(std::move(record)))
+	{
+		// The writer fell behind; write everything from here instead of dropping messages. Draining empties
+		// this thread's ring, so the retry always succeeds.
+		{
+			std::lock_guard<std::mutex> lock(Log::writeMutex);
+			Log::drainLocked();
+		}
+
+		ring.tryPush(std::move(record));
+	}
+
+	if ((type == DebugMessageType::Error) || (ring.getCount() >= (Log::RING_CAPACITY / 2)))
+	{
+		Log::writerCondition.notify_one();
+	}
 }
 
-void Debug::log(const char *__file__, int lineNumber, const std::string &message)
+void Debug::log(const char *filePath, int lineNumber, std::string message)
 {
-	Debug::write(DebugMessageType::Status, Debug::getShorterPath(__file__), lineNumber, message);
+	Debug::write(DebugMessageType::Status, filePath, lineNumber, std::move(message));
 }
 
-void Debug::logWarning(const char *__file__, int lineNumber, const std::string &message)
+void Debug::logWarning(const char *filePath, int lineNumber, std::string message)
 {
-	Debug::write(DebugMessageType::Warning, Debug::getShorterPath(__file__), lineNumber, message);
+	Debug::write(DebugMessageType::Warning, filePath, lineNumber, std::move(message));
 }
 
-void Debug::logError(const char *__file__, int lineNumber, const std::string &message)
+void Debug::logError(const char *filePath, int lineNumber, std::string message)
 {
-	Debug::write(DebugMessageType::Error, Debug::getShorterPath(__file__), lineNumber, message);
+	Debug::write(DebugMessageType::Error, filePath, lineNumber, std::move(message));
 }
 
-void Debug::crash(const char *__file__, int lineNumber, const std::string &message)
+void Debug::crash(const char *filePath, int lineNumber, const std::string &message)
 {
-	Debug::logError(__file__, lineNumber, message);
+	// Everything queued goes out first so the crash reason is the last line, and it skips rate limiting.
+	Debug::flush();
+	{
+		Log::Record record;
+		record.sequence = 0;
+		record.type = DebugMessageType::Error;
+		record.filePath = filePath;
+		record.lineNumber = lineNumber;
+		record.suppressedCount = 0;
+		record.message = message;
+
+		std::string output;
+		Log::appendRecord(record, output);
+
+		std::lock_guard<std::mutex> lock(Log::writeMutex);
+		Log::writeOutputLocked(output);
+		Log::stream.flush();
+	}
 
 #if defined(__APPLE__) && defined(__MACH__)
 	// @todo: implement proper logging alternative to SDL message box.
@@ -7,7 +7,11 @@
 
 // Below are various debug methods and macros for replacing asserts or program exits 
 // that might be accompanied with messages and logging.
+//
+// Messages are queued per thread and written by a background thread, so logging doesn't stall the caller on
+// console or file I/O. Crashes flush everything queued before exiting.
 
+// Ordered by severity.
 enum class DebugMessageType
 {
 	Status,
@@ -21,34 +25,63 @@ private:
 	Debug() = delete;
 	~Debug() = delete;
 
-	// Writes a debug message to the console with the file path and line number.
-	static void write(DebugMessageType type, const std::string &filePath, int lineNumber, const std::string &message);
+	// Queues a debug message for the console and log file with the file path and line number.
+	static void write(DebugMessageType type, const char *filePath, int lineNumber, std::string &&message);
 public:
 	static bool init(const char *logDirectory);
 	static void shutdown();
 
-	// Shortens the __FILE__ macro so it only includes a couple parent folders.
-	static std::string getShorterPath(const char *__file__);
+	// Waits until every queued message has been written.
+	static void flush();
+
+	// Messages below this severity are dropped. Default is Status.
+	static void setMinimumType(DebugMessageType type);
+
+	// A message's category is the folder of the source file that logged it, i.e. "Audio" or "Rendering".
+	static void setCategoryEnabled(const std::string &category, bool enabled);
+
+	// Whether a message from the given trimmed source path would be written. Checked before building the message.
+	static bool isEnabled(DebugMessageType type, const char *filePath);
+
+	// Points __FILE__ past all but its last parent folder at compile time.
+	static consteval const char *trimPath(const char *path)
+	{
+		const char *lastSeparator = nullptr;
+		const char *secondLastSeparator = nullptr;
+		for (const char *c = path; *c != '\0'; c++)
+		{
+			if ((*c == '/') || (*c == '\\'))
+			{
+				secondLastSeparator = lastSeparator;
+				lastSeparator = c;
+			}
+		}
+
+		return (secondLastSeparator != nullptr) ? (secondLastSeparator + 1) : path;
+	}
 
 	// Use DebugLog() instead. Helper method for mentioning something about program state.
-	static void log(const char *__file__, int lineNumber, const std::string &message);
+	static void log(const char *filePath, int lineNumber, std::string message);
 
 	// Use DebugLogWarning() instead. Helper method for warning the user about something.
-	static void logWarning(const char *__file__, int lineNumber, const std::string &message);
+	static void logWarning(const char *filePath, int lineNumber, std::string message);
 
 	// Use DebugLogError() instead. Helper method for reporting an error while still continuing.
-	static void logError(const char *__file__, int lineNumber, const std::string &message);
+	static void logError(const char *filePath, int lineNumber, std::string message);
 
 	// Use DebugCrash() instead. Helper method for crashing the program with a reason.
-	[[noreturn]] static void crash(const char *__file__, int lineNumber, const std::string &message);
+	[[noreturn]] static void crash(const char *filePath, int lineNumber, const std::string &message);
 
-	// General logging defines.
-#define DebugLog(message) Debug::log(__FILE__, __LINE__, message)
-#define DebugLogWarning(message) Debug::logWarning(__FILE__, __LINE__, message)
-#define DebugLogError(message) Debug::logError(__FILE__, __LINE__, message)
+	// General logging defines. The message isn't built if it would be filtered out.
+#define DebugLogWithType(type, func, message) \
+	do { constexpr const char *debugFilePath = Debug::trimPath(__FILE__); \
+		if (Debug::isEnabled(type, debugFilePath)) Debug::func(debugFilePath, __LINE__, message); } while (false)
+#define DebugLog(message) DebugLogWithType(DebugMessageType::Status, log, message)
+#define DebugLogWarning(message) DebugLogWithType(DebugMessageType::Warning, logWarning, message)
+#define DebugLogError(message) DebugLogWithType(DebugMessageType::Error, logError, message)
 
 	// Crash define, when the program simply cannot continue.
-#define DebugCrash(message) Debug::crash(__FILE__, __LINE__, message)
+#define DebugCrash(message) Debug::crash(Debug::trimPath(__FILE__), __LINE__, message)
 
 	// Assertions.
 #define DebugAssertMsg(condition, message) \
@@ -58,7 +91,7 @@ public:
 
 	// Exception generator with file and line.
 #define DebugException(message) \
-	std::runtime_error(std::string(message) + " (" + Debug::getShorterPath(__FILE__) + "(" + std::to_string(__LINE__) + "))")
+	std::runtime_error(std::string(message) + " (" + std::string(Debug::trimPath(__FILE__)) + "(" + std::to_string(__LINE__) + "))")
 
 	// Various error handlers:
 	// Unhandled return.
@@ -2,6 +2,7 @@
 #define ALLOCATOR_H
 
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 #include "Buffer.h"
@@ -28,7 +29,7 @@ private:
 	{
 		DebugAssert(this->data.isValid());
 		constexpr size_t alignment = alignof(T);
-		const size_t curAddress = reinterpret_cast<uintptr_t>(this->data.get()) + this->index;
+		const size_t curAddress = reinterpret_cast<uintptr_t>(this->data.begin()) + this->index;
 		const size_t modulo = curAddress % alignment;
 		return (modulo != 0) ? static_cast<int>(alignment - modulo) : 0;
 	}
@@ -87,7 +88,7 @@ public:
 		DebugAssert(this->canAlloc<T>(count));
 
 		this->index += this->getAlignmentByteCount<T>();
-		T *ptr = reinterpret_cast<T*>(this->data.get() + this->index);
+		T *ptr = reinterpret_cast<T*>(this->data.begin() + this->index);
 		for (int i = 0; i < count; i++)
 		{
 			*(ptr + i) = defaultValue;
@@ -110,6 +111,33 @@ public:
 		return bufferView.get();
 	}
 
+	// Untyped allocation for allocator-aware containers. Returns null if it doesn't fit.
+	std::byte *tryAllocBytes(int byteCount, int alignment)
+	{
+		DebugAssert(byteCount >= 0);
+		DebugAssert((alignment > 0) && ((alignment & (alignment - 1)) == 0));
+		if (!this->isInited())
+		{
+			return nullptr;
+		}
+
+		const uintptr_t curAddress = reinterpret_cast<uintptr_t>(this->data.begin()) + this->index;
+		const int alignmentBytes = static_cast<int>((alignment - (curAddress % alignment)) % alignment);
+		if ((this->index + alignmentBytes + byteCount) > this->data.getCount())
+		{
+			return nullptr;
+		}
+
+		std::byte *ptr = this->data.begin() + this->index + alignmentBytes;
+		this->index += alignmentBytes + byteCount;
+		return ptr;
+	}
+
+	int getUsedByteCount() const
+	{
+		return this->index;
+	}
+
 	void clear()
 	{
 		this->index = 0;
@@ -9,6 +9,10 @@
 FPSCounter::FPSCounter()
 {
 	this->frameTimes.fill(0.0);
+	this->historyFrameTimes.fill(0.0);
+	this->historyIndex = 0;
+	this->historyCount = 0;
+	this->sortedHistoryFrameTimes.reserve(this->historyFrameTimes.size());
 }
 
 int FPSCounter::getFrameCount() const
@@ -59,6 +63,43 @@ double FPSCounter::getLowestFPS() const
 	return 1.0 / *iter;
 }
 
+double FPSCounter::getPercentileFrameTime(double percentile) const
+{
+	DebugAssert(percentile >= 0.0);
+	DebugAssert(percentile <= 100.0);
+	if (this->historyCount == 0)
+	{
+		return 0.0;
+	}
+
+	const std::vector<double> &sortedFrameTimes = this->sortedHistoryFrameTimes;
+	const double indexReal = (percentile / 100.0) * static_cast<double>(this->historyCount - 1);
+	const int index = static_cast<int>(std::round(indexReal));
+	DebugAssertIndex(sortedFrameTimes, index);
+	return sortedFrameTimes[index];
+}
+
+double FPSCounter::getLowFPS(double percent) const
+{
+	DebugAssert(percent > 0.0);
+	DebugAssert(percent <= 100.0);
+	if (this->historyCount == 0)
+	{
+		return 0.0;
+	}
+
+	// Average the slowest frames, always including at least one.
+	const std::vector<double> &sortedFrameTimes = this->sortedHistoryFrameTimes;
+	const int slowCount = std::max(static_cast<int>((percent / 100.0) * static_cast<double>(this->historyCount)), 1);
+	const double sum = std::accumulate(sortedFrameTimes.end() - slowCount, sortedFrameTimes.end(), 0.0);
+	if (sum <= 0.0)
+	{
+		return 0.0;
+	}
+
+	return static_cast<double>(slowCount) / sum;
+}
+
 void FPSCounter::updateFrameTime(double dt)
 {
 	// Rotate the array right by one index (this puts the last value at the front).
@@ -66,4 +107,20 @@ void FPSCounter::updateFrameTime(double dt)
 		this->frameTimes.rbegin() + 1, this->frameTimes.rend());
 
 	this->frameTimes.front() = dt;
+
+	// Replace the oldest frame in the sorted history once it's full.
+	std::vector<double> &sortedFrameTimes = this->sortedHistoryFrameTimes;
+	if (this->historyCount == static_cast<int>(this->historyFrameTimes.size()))
+	{
+		const double oldestFrameTime = this->historyFrameTimes[this->historyIndex];
+		const auto oldestIter = std::lower_bound(sortedFrameTimes.begin(), sortedFrameTimes.end(), oldestFrameTime);
+		DebugAssert(oldestIter != sortedFrameTimes.end());
+		sortedFrameTimes.erase(oldestIter);
+	}
+
+	sortedFrameTimes.insert(std::upper_bound(sortedFrameTimes.begin(), sortedFrameTimes.end(), dt), dt);
+
+	this->historyFrameTimes[this->historyIndex] = dt;
+	this->historyIndex = (this->historyIndex + 1) % static_cast<int>(this->historyFrameTimes.size());
+	this->historyCount = std::min(this->historyCount + 1, static_cast<int>(this->historyFrameTimes.size()));
 }
@@ -2,12 +2,21 @@
 #define FPS_COUNTER_H
 
 #include <array>
+#include <vector>
 
 class FPSCounter
 {
 private:
 	std::array<double, 60> frameTimes;
 
+	// Longer history for low and percentile statistics that only show up over many frames.
+	std::array<double, 2000> historyFrameTimes;
+	int historyIndex, historyCount;
+
+	// The same history sorted from fastest to slowest frame, kept sorted as frames are added so statistics
+	// queries don't have to sort.
+	std::vector<double> sortedHistoryFrameTimes;
+
 	// Gets the average frame time in seconds based on recent data.
 	double getAverageFrameTime() const;
 public:
@@ -23,6 +32,13 @@ public:
 	double getHighestFPS() const;
 	double getLowestFPS() const;
 
+	// Gets the frame time in seconds that the given percent of recent frames are at or below, i.e. 99.0 for
+	// the 99th percentile.
+	double getPercentileFrameTime(double percentile) const;
+
+	// Gets the average FPS of the slowest given percent of recent frames, i.e. 1.0 for the 1% low.
+	double getLowFPS(double percent) const;
+
 	// Sets the frame time of the most recent frame. This should be called once
 	// per frame.
 	void updateFrameTime(double dt);
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <bit>
+
+#include "Allocator.h"
+#include "FrameArena.h"
+
+#include "../debug/Debug.h"
+
+namespace
+{
+	constexpr int DefaultArenaByteCount = 1 << 20;
+	constexpr int MaxArenaByteCount = 1 << 28;
+
+	// A grown arena shrinks once this many frames in a row use at most 1/ShrinkUsageDivisor of it.
+	constexpr int ShrinkFrameCount = 600;
+	constexpr int64_t ShrinkUsageDivisor = 4;
+
+	struct HeapBlock
+	{
+		std::byte *ptr;
+		size_t alignment;
+	};
+
+	struct ThreadArena
+	{
+		ScratchAllocator allocator;
+		std::vector<HeapBlock> heapBlocks; // Fallback allocations once the arena is full.
+		int64_t heapByteCount;
+		int64_t lastFrameArenaByteCount, lastFrameHeapByteCount;
+		int underusedFrameCount; // Consecutive frames under the shrink threshold.
+		int64_t underusedPeakByteCount; // Largest frame total during those frames.
+
+		ThreadArena()
+			: allocator(DefaultArenaByteCount)
+		{
+			this->heapByteCount = 0;
+			this->lastFrameArenaByteCount = 0;
+			this->lastFrameHeapByteCount = 0;
+			this->underusedFrameCount = 0;
+			this->underusedPeakByteCount = 0;
+		}
+
+		~ThreadArena()
+		{
+			this->freeHeapBlocks();
+		}
+
+		void freeHeapBlocks()
+		{
+			for (const HeapBlock &block : this->heapBlocks)
+			{
+				::operator delete(block.ptr, std::align_val_t(block.alignment));
+			}
+
+			this->heapBlocks.clear();
+		}
+	};
+
+	thread_local ThreadArena CurrentThreadArena;
+}
+
+std::byte *FrameArena::allocBytes(size_t byteCount, size_t alignment)
+{
+	ThreadArena &arena = CurrentThreadArena;
+	if (byteCount <= static_cast<size_t>(arena.allocator.getByteSize()))
+	{
+		std::byte *ptr = arena.allocator.tryAllocBytes(static_cast<int>(byteCount), static_cast<int>(alignment));
+		if (ptr != nullptr)
+		{
+			return ptr;
+		}
+	}
+
+	HeapBlock block;
+	block.ptr = static_cast<std::byte*>(::operator new(std::max<size_t>(byteCount, 1), std::align_val_t(alignment)));
+	block.alignment = alignment;
+	arena.heapBlocks.emplace_back(block);
+	arena.heapByteCount += static_cast<int64_t>(byteCount);
+	return block.ptr;
+}
+
+void FrameArena::reset()
+{
+	ThreadArena &arena = CurrentThreadArena;
+	arena.lastFrameArenaByteCount = arena.allocator.getUsedByteCount();
+	arena.lastFrameHeapByteCount = arena.heapByteCount;
+
+	arena.freeHeapBlocks();
+	arena.heapByteCount = 0;
+
+	const int64_t frameByteCount = arena.lastFrameArenaByteCount + arena.lastFrameHeapByteCount;
+	const int64_t arenaByteCount = arena.allocator.getByteSize();
+	if (arena.lastFrameHeapByteCount > 0)
+	{
+		arena.underusedFrameCount = 0;
+		arena.underusedPeakByteCount = 0;
+
+		// Grow so a frame like this one fits entirely in the arena next time.
+		const int64_t newByteCount = std::min<int64_t>(std::bit_ceil(static_cast<uint64_t>(frameByteCount)), MaxArenaByteCount);
+		if (newByteCount > arenaByteCount)
+		{
+			DebugLog("Growing frame arena to " + std::to_string(newByteCount / 1024) + "KB.");
+			arena.allocator.init(static_cast<int>(newByteCount));
+			return;
+		}
+	}
+	else if ((arenaByteCount > DefaultArenaByteCount) && (frameByteCount <= (arenaByteCount / ShrinkUsageDivisor)))
+	{
+		arena.underusedFrameCount++;
+		arena.underusedPeakByteCount = std::max(arena.underusedPeakByteCount, frameByteCount);
+		if (arena.underusedFrameCount >= ShrinkFrameCount)
+		{
+			// Shrink to twice the recent peak so ordinary frame-to-frame variation doesn't spill.
+			const int64_t newByteCount = std::max<int64_t>(
+				std::bit_ceil(static_cast<uint64_t>(arena.underusedPeakByteCount * 2)), DefaultArenaByteCount);
+			arena.underusedFrameCount = 0;
+			arena.underusedPeakByteCount = 0;
+			if (newByteCount < arenaByteCount)
+			{
+				DebugLog("Shrinking frame arena to " + std::to_string(newByteCount / 1024) + "KB.");
+				arena.allocator.init(static_cast<int>(newByteCount));
+				return;
+			}
+		}
+	}
+	else
+	{
+		arena.underusedFrameCount = 0;
+		arena.underusedPeakByteCount = 0;
+	}
+
+	arena.allocator.clear();
+}
+
+int64_t FrameArena::getLastFrameArenaByteCount()
+{
+	return CurrentThreadArena.lastFrameArenaByteCount;
+}
+
+int64_t FrameArena::getLastFrameHeapByteCount()
+{
+	return CurrentThreadArena.lastFrameHeapByteCount;
+}
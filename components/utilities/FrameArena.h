@@ -0,0 +1,84 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "BufferView.h"
+
+// Per-thread linear arena for lists that only live during one frame (ray cast scratch data, text line splits,
+// etc.). Allocations are a pointer bump and are all released at once by reset() at the end of the frame.
+// Anything allocated from it must not be kept past that point.
+//
+// When the arena runs out, allocations fall back to the heap until the next reset(), which then grows the arena
+// to fit the frame's total so later frames don't spill again. If a spike (i.e. a scene load) grew it and frames
+// stay well under its size for a while afterwards, it shrinks back toward what those frames use.
+
+namespace FrameArena
+{
+	// Never returns null.
+	std::byte *allocBytes(size_t byteCount, size_t alignment);
+
+	// Gets a value-initialized list that's valid until the end of the frame.
+	template<typename T>
+	BufferView<T> allocView(int count)
+	{
+		static_assert(std::is_trivially_destructible_v<T>);
+		std::byte *bytes = FrameArena::allocBytes(sizeof(T) * count, alignof(T));
+		T *ptr = reinterpret_cast<T*>(bytes);
+		for (int i = 0; i < count; i++)
+		{
+			new (ptr + i) T();
+		}
+
+		return BufferView<T>(ptr, count);
+	}
+
+	// Releases everything the calling thread allocated this frame.
+	void reset();
+
+	// Bytes the calling thread allocated from its arena and from the heap fallback in the last finished frame.
+	int64_t getLastFrameArenaByteCount();
+	int64_t getLastFrameHeapByteCount();
+}
+
+// Standard allocator over the calling thread's frame arena. Freeing is a no-op since the arena is released
+// in bulk, so containers using it should reserve up front when they can.
+template<typename T>
+class FrameAllocator
+{
+public:
+	using value_type = T;
+
+	FrameAllocator() = default;
+
+	template<typename U>
+	FrameAllocator(const FrameAllocator<U>&) { }
+
+	T *allocate(size_t count)
+	{
+		return reinterpret_cast<T*>(FrameArena::allocBytes(sizeof(T) * count, alignof(T)));
+	}
+
+	void deallocate(T*, size_t) { }
+
+	template<typename U>
+	bool operator==(const FrameAllocator<U>&) const
+	{
+		return true;
+	}
+
+	template<typename U>
+	bool operator!=(const FrameAllocator<U>&) const
+	{
+		return false;
+	}
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+#endif
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "FramePacer.h"
+
+namespace
+{
+	// Remaining wait that is yielded instead of slept. Covers typical scheduler wakeup latency.
+	constexpr FramePacer::Clock::duration SpinDuration = std::chrono::microseconds(1500);
+
+	double GetSeconds(FramePacer::Clock::duration duration)
+	{
+		return std::chrono::duration<double>(duration).count();
+	}
+}
+
+FramePacer::FramePacer()
+{
+	this->hasStarted = false;
+}
+
+double FramePacer::waitForNextFrame(Clock::duration framePeriod)
+{
+	Clock::time_point now = Clock::now();
+	if (!this->hasStarted)
+	{
+		this->deadline = now;
+	}
+	else
+	{
+		this->deadline += framePeriod;
+
+		// If more than a frame behind (i.e. a load or hitch), start over from now instead of running a burst of
+		// unpaced frames to catch up.
+		if ((now - this->deadline) > framePeriod)
+		{
+			this->deadline = now;
+		}
+
+		const Clock::time_point sleepEndTime = this->deadline - SpinDuration;
+		if (now < sleepEndTime)
+		{
+			std::this_thread::sleep_until(sleepEndTime);
+		}
+
+		now = Clock::now();
+		while (now < this->deadline)
+		{
+			std::this_thread::yield();
+			now = Clock::now();
+		}
+	}
+
+	const Clock::time_point prevFrameStartTime = this->hasStarted ? this->frameStartTime : now;
+	this->frameStartTime = now;
+	this->hasStarted = true;
+	return GetSeconds(this->frameStartTime - prevFrameStartTime);
+}
+
+double FramePacer::startFrameNow()
+{
+	const Clock::time_point now = Clock::now();
+	const Clock::time_point prevFrameStartTime = this->hasStarted ? this->frameStartTime : now;
+	this->frameStartTime = now;
+	this->deadline = now;
+	this->hasStarted = true;
+	return GetSeconds(this->frameStartTime - prevFrameStartTime);
+}
+
+FramePacer::Clock::duration FramePacer::makeRefreshAlignedPeriod(Clock::duration framePeriod, int refreshRate)
+{
+	if (refreshRate <= 0)
+	{
+		return framePeriod;
+	}
+
+	const std::chrono::duration<double> refreshPeriod(1.0 / static_cast<double>(refreshRate));
+	const double refreshesPerFrame = std::max(std::round(GetSeconds(framePeriod) / refreshPeriod.count()), 1.0);
+	return std::chrono::duration_cast<Clock::duration>(refreshPeriod * refreshesPerFrame);
+}
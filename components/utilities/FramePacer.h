@@ -0,0 +1,32 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <chrono>
+
+// Limits the frame rate with absolute deadlines on the monotonic clock. Each frame's deadline is the previous
+// one plus the frame period, so oversleeping one frame doesn't shift every later frame. Most of the wait is a
+// regular thread sleep and the last stretch is spent yielding since sleeps can overshoot by a millisecond or more.
+
+class FramePacer
+{
+public:
+	using Clock = std::chrono::steady_clock;
+private:
+	Clock::time_point deadline; // Earliest start of the next frame.
+	Clock::time_point frameStartTime;
+	bool hasStarted;
+public:
+	FramePacer();
+
+	// Waits until the next frame may start and returns the time in seconds since the previous frame started.
+	double waitForNextFrame(Clock::duration framePeriod);
+
+	// Starts the next frame without waiting and returns the time in seconds since the previous frame started.
+	double startFrameNow();
+
+	// Rounds the frame period to a whole number of display refreshes so every frame is shown for the same
+	// number of refreshes. Returns the unmodified period if the refresh rate is unknown.
+	static Clock::duration makeRefreshAlignedPeriod(Clock::duration framePeriod, int refreshRate);
+};
+
+#endif
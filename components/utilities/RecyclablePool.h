@@ -1,15 +1,19 @@
 #ifndef RECYCLABLE_POOL_H
 #define RECYCLABLE_POOL_H
 
-#include <algorithm>
+#include <bit>
+#include <cstdint>
 #include <type_traits>
-#include <unordered_set>
 #include <vector>
 
 #include "../debug/Debug.h"
 
 // Contiguous pool that allows elements to be freed and their position reused by future elements
 // without affecting other elements.
+//
+// IDs are generational handles: the low bits are the element's slot and the high bits count how many times
+// that slot has been freed, so an ID kept after its element was freed is rejected instead of silently
+// referring to whatever reused the slot. The sign bit is never set, so negative IDs stay usable as "no ID".
 
 template<typename ElementT, typename IdT>
 class RecyclablePool
@@ -19,34 +23,70 @@ private:
 	static_assert(std::is_move_assignable_v<ElementT>);
 	static_assert(!std::is_polymorphic_v<ElementT>);
 	static_assert(std::is_integral_v<IdT>);
-	
+	static_assert(sizeof(IdT) == sizeof(uint32_t));
+
+	static constexpr int SLOT_BITS = 20;
+	static constexpr uint32_t SLOT_MASK = (1u << SLOT_BITS) - 1;
+	static constexpr uint32_t GENERATION_MASK = (1u << (31 - SLOT_BITS)) - 1;
+	static constexpr int USED_BITS_PER_WORD = 64;
+
+	struct Slot
+	{
+		uint32_t generation;
+		int nextFreeIndex; // Next slot in the free list if this slot is free, otherwise -1.
+	};
+
 	std::vector<ElementT> elements;
-	std::unordered_set<IdT> freedIDs;
-	IdT nextID;
+	std::vector<Slot> slots;
+	std::vector<uint64_t> usedBits; // One bit per slot for cheap validity checks and iteration.
+	int freeListHead; // Most recently freed slot, or -1.
+	int freeCount;
+
+	static IdT makeID(int slotIndex, uint32_t generation)
+	{
+		return static_cast<IdT>((generation << SLOT_BITS) | static_cast<uint32_t>(slotIndex));
+	}
 
-	bool isFreedID(IdT id) const
+	bool isSlotUsed(int slotIndex) const
 	{
-		return this->freedIDs.find(id) != this->freedIDs.end();
+		const uint64_t word = this->usedBits[slotIndex / USED_BITS_PER_WORD];
+		return (word & (1ull << (slotIndex % USED_BITS_PER_WORD))) != 0;
+	}
+
+	void setSlotUsed(int slotIndex, bool used)
+	{
+		uint64_t &word = this->usedBits[slotIndex / USED_BITS_PER_WORD];
+		const uint64_t bit = 1ull << (slotIndex % USED_BITS_PER_WORD);
+		word = used ? (word | bit) : (word & ~bit);
 	}
 
 	bool isValidID(IdT id) const
 	{
-		if ((id < 0) || (id >= this->nextID))
+		if (id < 0)
 		{
 			return false;
 		}
 
-		if (this->isFreedID(id))
+		const int slotIndex = RecyclablePool::getSlotIndex(id);
+		if ((slotIndex >= this->getTotalCount()) || !this->isSlotUsed(slotIndex))
 		{
 			return false;
 		}
 
-		return true;
+		const uint32_t generation = static_cast<uint32_t>(id) >> SLOT_BITS;
+		return this->slots[slotIndex].generation == generation;
 	}
 public:
 	RecyclablePool()
 	{
-		this->nextID = 0;
+		this->freeListHead = -1;
+		this->freeCount = 0;
+	}
+
+	// Gets the element position an ID refers to, for callers that keep their own per-element arrays.
+	static int getSlotIndex(IdT id)
+	{
+		return static_cast<int>(static_cast<uint32_t>(id) & SLOT_MASK);
 	}
 
 	// Gets total number of slots; not all are always in use.
@@ -57,7 +97,7 @@ public:
 
 	int getFreeCount() const
 	{
-		return static_cast<int>(this->freedIDs.size());
+		return this->freeCount;
 	}
 
 	int getUsedCount() const
@@ -68,15 +108,13 @@ public:
 	ElementT &get(IdT id)
 	{
 		DebugAssert(this->isValidID(id));
-		DebugAssertIndex(this->elements, id);
-		return this->elements[id];
+		return this->elements[RecyclablePool::getSlotIndex(id)];
 	}
 
 	const ElementT &get(IdT id) const
 	{
 		DebugAssert(this->isValidID(id));
-		DebugAssertIndex(this->elements, id);
-		return this->elements[id];
+		return this->elements[RecyclablePool::getSlotIndex(id)];
 	}
 
 	ElementT *tryGet(IdT id)
@@ -86,8 +124,7 @@ public:
 			return nullptr;
 		}
 
-		DebugAssertIndex(this->elements, id);
-		return &this->elements[id];
+		return &this->elements[RecyclablePool::getSlotIndex(id)];
 	}
 
 	const ElementT *tryGet(IdT id) const
@@ -97,24 +134,43 @@ public:
 			return nullptr;
 		}
 
-		DebugAssertIndex(this->elements, id);
-		return &this->elements[id];
+		return &this->elements[RecyclablePool::getSlotIndex(id)];
 	}
 
 	bool tryAlloc(IdT *outID)
 	{
-		if (!this->freedIDs.empty())
+		int slotIndex;
+		if (this->freeListHead >= 0)
 		{
-			*outID = *this->freedIDs.begin();
-			this->freedIDs.erase(this->freedIDs.begin());
+			slotIndex = this->freeListHead;
+			Slot &slot = this->slots[slotIndex];
+			this->freeListHead = slot.nextFreeIndex;
+			slot.nextFreeIndex = -1;
+			this->freeCount--;
 		}
 		else
 		{
-			*outID = this->nextID;
-			this->nextID++;
+			slotIndex = this->getTotalCount();
+			if (static_cast<uint32_t>(slotIndex) > SLOT_MASK)
+			{
+				return false;
+			}
+
 			this->elements.emplace_back(ElementT());
+
+			Slot slot;
+			slot.generation = 0;
+			slot.nextFreeIndex = -1;
+			this->slots.emplace_back(slot);
+
+			if ((slotIndex % USED_BITS_PER_WORD) == 0)
+			{
+				this->usedBits.emplace_back(0);
+			}
 		}
 
+		this->setSlotUsed(slotIndex, true);
+		*outID = RecyclablePool::makeID(slotIndex, this->slots[slotIndex].generation);
 		return true;
 	}
 
@@ -125,17 +181,55 @@ public:
 			DebugCrash("Invalid ID to free: \"" + std::to_string(id) + "\"");
 		}
 
-		this->freedIDs.emplace(id);
-		
-		DebugAssertIndex(this->elements, id);
-		this->elements[id] = ElementT();
+		const int slotIndex = RecyclablePool::getSlotIndex(id);
+		Slot &slot = this->slots[slotIndex];
+		slot.generation = (slot.generation + 1) & GENERATION_MASK;
+		slot.nextFreeIndex = this->freeListHead;
+		this->freeListHead = slotIndex;
+		this->freeCount++;
+		this->setSlotUsed(slotIndex, false);
+
+		this->elements[slotIndex] = ElementT();
+	}
+
+	// Calls the function with the ID and element of every allocated element in slot order.
+	template<typename FuncT>
+	void forEach(FuncT &&func)
+	{
+		for (int wordIndex = 0; wordIndex < static_cast<int>(this->usedBits.size()); wordIndex++)
+		{
+			uint64_t word = this->usedBits[wordIndex];
+			while (word != 0)
+			{
+				const int slotIndex = (wordIndex * USED_BITS_PER_WORD) + std::countr_zero(word);
+				func(RecyclablePool::makeID(slotIndex, this->slots[slotIndex].generation), this->elements[slotIndex]);
+				word &= word - 1;
+			}
+		}
+	}
+
+	template<typename FuncT>
+	void forEach(FuncT &&func) const
+	{
+		for (int wordIndex = 0; wordIndex < static_cast<int>(this->usedBits.size()); wordIndex++)
+		{
+			uint64_t word = this->usedBits[wordIndex];
+			while (word != 0)
+			{
+				const int slotIndex = (wordIndex * USED_BITS_PER_WORD) + std::countr_zero(word);
+				func(RecyclablePool::makeID(slotIndex, this->slots[slotIndex].generation), this->elements[slotIndex]);
+				word &= word - 1;
+			}
+		}
 	}
 
 	void clear()
 	{
 		this->elements.clear();
-		this->freedIDs.clear();
-		this->nextID = 0;
+		this->slots.clear();
+		this->usedBits.clear();
+		this->freeListHead = -1;
+		this->freeCount = 0;
 	}
 };
 
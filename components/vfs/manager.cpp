@@ -9,12 +9,21 @@
 #include <fnmatch.h>
 #endif
 
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
 #include <cassert> // @todo: replace with DebugAssert
 #include <cctype>
+#include <cerrno>
 #include <cstring>
 #include <fstream>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "../archives/bsaarchive.hpp"
@@ -24,6 +33,219 @@ namespace
 {
 	std::vector<std::string> gRootPaths;
 	Archives::BsaArchive gGlobalBsa;
+
+	// Where a filename resolves to, so lookups don't need to probe the filesystem.
+	struct IndexEntry
+	{
+		std::string path; // Full path of a loose file, or the entry name in GLOBAL.BSA.
+		bool inGlobalBSA;
+		int sourceIndex; // -1 for GLOBAL.BSA, otherwise the root path index.
+	};
+
+	// Every loose file and GLOBAL.BSA entry by exact name and by uppercase name. Misses are remembered
+	// too since asset loaders often check for optional files that never exist.
+	std::unordered_map<std::string, IndexEntry> gExactIndex, gFoldedIndex;
+	std::unordered_set<std::string> gExactMisses, gFoldedMisses;
+	std::vector<std::string> gIndexedFolders;
+	std::mutex gIndexMutex;
+
+#ifdef __linux__
+	int gWatchFD = -1; // inotify instance watching every indexed folder, or -1 if disabled.
+#endif
+
+	std::string MakeFoldedName(const char *name)
+	{
+		std::string foldedName(name);
+		for (char &c : foldedName)
+		{
+			c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+		}
+
+		return foldedName;
+	}
+
+	bool IsDirectoryEntry(const std::string &path, const dirent *ent)
+	{
+#ifdef _WIN32
+		return S_ISDIR(ent->d_type);
+#else
+		if (ent->d_type != DT_UNKNOWN)
+		{
+			return ent->d_type == DT_DIR;
+		}
+
+		struct stat st;
+		return (stat(path.c_str(), &st) == 0) && S_ISDIR(st.st_mode);
+#endif
+	}
+
+	void AddIndexEntry(const std::string &name, const IndexEntry &entry)
+	{
+		// Later sources take precedence, matching the root path search order. Within one source the first
+		// casing seen wins for folded names.
+		gExactIndex[name] = entry;
+
+		std::string foldedName = MakeFoldedName(name.c_str());
+		auto foldedIter = gFoldedIndex.find(foldedName);
+		if (foldedIter == gFoldedIndex.end())
+		{
+			gFoldedIndex.emplace(std::move(foldedName), entry);
+		}
+		else if (entry.sourceIndex > foldedIter->second.sourceIndex)
+		{
+			foldedIter->second = entry;
+		}
+	}
+
+	void IndexFolder(const std::string &folderPath, const std::string &prefix, int sourceIndex)
+	{
+		DIR *dir = opendir(folderPath.c_str());
+		if (dir == nullptr)
+		{
+			return;
+		}
+
+		gIndexedFolders.emplace_back(folderPath);
+
+		dirent *ent;
+		while ((ent = readdir(dir)) != nullptr)
+		{
+			if ((std::strcmp(ent->d_name, ".") == 0) || (std::strcmp(ent->d_name, "..") == 0))
+			{
+				continue;
+			}
+
+			const std::string path = folderPath + ent->d_name;
+			const std::string name = prefix + ent->d_name;
+			if (IsDirectoryEntry(path, ent))
+			{
+				IndexFolder(path + '/', name + '/', sourceIndex);
+			}
+			else
+			{
+				IndexEntry entry;
+				entry.path = path;
+				entry.inGlobalBSA = false;
+				entry.sourceIndex = sourceIndex;
+				AddIndexEntry(name, entry);
+			}
+		}
+
+		closedir(dir);
+	}
+
+	void UpdateWatches()
+	{
+#ifdef __linux__
+		if (gWatchFD < 0)
+		{
+			return;
+		}
+
+		// Recreating the instance is the simplest way to drop watches on folders that no longer exist.
+		close(gWatchFD);
+		gWatchFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (gWatchFD < 0)
+		{
+			DebugLogWarning("Couldn't recreate data folder watch (" + std::string(std::strerror(errno)) + ").");
+			return;
+		}
+
+		constexpr uint32_t watchMask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+		for (const std::string &folderPath : gIndexedFolders)
+		{
+			if (inotify_add_watch(gWatchFD, folderPath.c_str(), watchMask) < 0)
+			{
+				DebugLogWarning("Couldn't watch \"" + folderPath + "\" (" + std::string(std::strerror(errno)) + ").");
+			}
+		}
+#endif
+	}
+
+	void RebuildIndex()
+	{
+		gExactIndex.clear();
+		gFoldedIndex.clear();
+		gExactMisses.clear();
+		gFoldedMisses.clear();
+		gIndexedFolders.clear();
+
+		for (const std::string &name : gGlobalBsa.list())
+		{
+			IndexEntry entry;
+			entry.path = name;
+			entry.inGlobalBSA = true;
+			entry.sourceIndex = -1;
+			AddIndexEntry(name, entry);
+		}
+
+		for (int i = 0; i < static_cast<int>(gRootPaths.size()); i++)
+		{
+			IndexFolder(gRootPaths[i], std::string(), i);
+		}
+
+		UpdateWatches();
+	}
+
+	// Resolves a name the index doesn't know about (paths with "..", backslashes, etc.) the same way
+	// the VFS always has, then remembers the result either way.
+	const IndexEntry *FindExactEntry(const char *name)
+	{
+		const auto iter = gExactIndex.find(name);
+		if (iter != gExactIndex.end())
+		{
+			return &iter->second;
+		}
+
+		if (gExactMisses.find(name) != gExactMisses.end())
+		{
+			return nullptr;
+		}
+
+		IndexEntry entry;
+		const auto rootIter = std::find_if(gRootPaths.rbegin(), gRootPaths.rend(),
+			[name](const std::string &rootPath)
+		{
+			std::ifstream stream(rootPath + name, std::ios::binary);
+			return stream.good();
+		});
+
+		if (rootIter != gRootPaths.rend())
+		{
+			entry.path = *rootIter + name;
+			entry.inGlobalBSA = false;
+			entry.sourceIndex = static_cast<int>(std::distance(rootIter, gRootPaths.rend())) - 1;
+		}
+		else if (gGlobalBsa.exists(name))
+		{
+			entry.path = name;
+			entry.inGlobalBSA = true;
+			entry.sourceIndex = -1;
+		}
+		else
+		{
+			gExactMisses.emplace(name);
+			return nullptr;
+		}
+
+		return &gExactIndex.emplace(name, std::move(entry)).first->second;
+	}
+
+	VFS::IStreamPtr OpenEntry(const IndexEntry &entry)
+	{
+		if (entry.inGlobalBSA)
+		{
+			return gGlobalBsa.open(entry.path.c_str());
+		}
+
+		auto stream = std::make_shared<std::ifstream>(entry.path, std::ios::binary);
+		if (!stream->good())
+		{
+			return nullptr;
+		}
+
+		return stream;
+	}
 }
 
 namespace VFS
@@ -40,8 +262,10 @@ void Manager::initialize(std::string&& rootPath)
 	else if ((rootPath.back() != '/') && (rootPath.back() != '\\'))
 		rootPath += '/';
 
+	std::lock_guard<std::mutex> lock(gIndexMutex);
 	gGlobalBsa.load(rootPath + "GLOBAL.BSA");
 	gRootPaths.push_back(std::move(rootPath));
+	RebuildIndex();
 }
 
 void Manager::addDataPath(std::string&& path)
@@ -51,34 +275,90 @@ void Manager::addDataPath(std::string&& path)
 	else if ((path.back() != '/') && (path.back() != '\\'))
 		path += '/';
 
+	std::lock_guard<std::mutex> lock(gIndexMutex);
 	gRootPaths.push_back(std::move(path));
+	RebuildIndex();
 }
 
-IStreamPtr Manager::open(const char *name, bool *inGlobalBSA)
+void Manager::refresh()
 {
-	assert(name != nullptr);
-	assert(inGlobalBSA != nullptr);
-
-	std::unique_ptr<std::ifstream> stream(new std::ifstream());
+	std::lock_guard<std::mutex> lock(gIndexMutex);
+	RebuildIndex();
+}
 
-	// Search in reverse, so newer paths take precedence.
-	const auto iter = std::find_if(gRootPaths.rbegin(), gRootPaths.rend(),
-		[name, &stream](const std::string &rootPath)
+void Manager::setWatchForChanges(bool enabled)
+{
+#ifdef __linux__
+	std::lock_guard<std::mutex> lock(gIndexMutex);
+	if (enabled == (gWatchFD >= 0))
 	{
-		stream->open(rootPath + name, std::ios::binary);
-		return stream->good();
-	});
+		return;
+	}
 
-	if (iter != gRootPaths.rend())
+	if (enabled)
 	{
-		*inGlobalBSA = false;
-		return IStreamPtr(std::move(stream));
+		gWatchFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (gWatchFD < 0)
+		{
+			DebugLogWarning("Couldn't watch data folders for changes (" + std::string(std::strerror(errno)) + ").");
+			return;
+		}
+
+		UpdateWatches();
 	}
 	else
+	{
+		close(gWatchFD);
+		gWatchFD = -1;
+	}
+#else
+	if (enabled)
+	{
+		DebugLogWarning("Watching data folders for changes isn't supported on this platform.");
+	}
+#endif
+}
+
+void Manager::pollChanges()
+{
+#ifdef __linux__
+	std::lock_guard<std::mutex> lock(gIndexMutex);
+	if (gWatchFD < 0)
+	{
+		return;
+	}
+
+	// Only whether anything changed matters, so drain the queue and rebuild once.
+	bool changed = false;
+	alignas(inotify_event) char buffer[4096];
+	while (::read(gWatchFD, buffer, sizeof(buffer)) > 0)
+	{
+		changed = true;
+	}
+
+	if (changed)
+	{
+		DebugLog("Data folders changed, rebuilding file index.");
+		RebuildIndex();
+	}
+#endif
+}
+
+IStreamPtr Manager::open(const char *name, bool *inGlobalBSA)
+{
+	assert(name != nullptr);
+	assert(inGlobalBSA != nullptr);
+
+	std::lock_guard<std::mutex> lock(gIndexMutex);
+	const IndexEntry *entry = FindExactEntry(name);
+	if (entry == nullptr)
 	{
 		*inGlobalBSA = true;
-		return gGlobalBsa.open(name);
+		return nullptr;
 	}
+
+	*inGlobalBSA = entry->inGlobalBSA;
+	return OpenEntry(*entry);
 }
 
 IStreamPtr Manager::open(const char *name)
@@ -89,34 +369,52 @@ IStreamPtr Manager::open(const char *name)
 
 IStreamPtr Manager::openCaseInsensitive(const char *name, bool *inGlobalBSA)
 {
-	// Since the given filename is assumed to be unique in its directory, we only need to
-	// worry about filenames just like it but with different casing.
-	std::string newName = name;
-
-	// Case 1: upper first character, lower rest.
-	newName.front() = std::toupper(newName.front());
-	std::for_each(newName.begin() + 1, newName.end(),
-		[](char &c) { c = std::tolower(c); });
+	assert(name != nullptr);
+	assert(inGlobalBSA != nullptr);
 
-	IStreamPtr stream = this->open(newName.c_str(), inGlobalBSA);
+	std::lock_guard<std::mutex> lock(gIndexMutex);
+	std::string foldedName = MakeFoldedName(name);
+	const IndexEntry *entry = nullptr;
 
-	if (stream != nullptr)
+	const auto iter = gFoldedIndex.find(foldedName);
+	if (iter != gFoldedIndex.end())
 	{
-		return stream;
+		entry = &iter->second;
 	}
-	else
+	else if (gFoldedMisses.find(foldedName) == gFoldedMisses.end())
 	{
-		// Case 2: all uppercase.
-		for (char &c : newName)
+		// Not indexed, so fall back to the casings Arena's floppy and CD versions use: upper first
+		// character and lower rest, then all uppercase.
+		std::string newName = foldedName;
+		std::for_each(newName.begin() + 1, newName.end(),
+			[](char &c) { c = static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+
+		entry = FindExactEntry(newName.c_str());
+		if (entry == nullptr)
+		{
+			entry = FindExactEntry(foldedName.c_str());
+		}
+
+		if (entry != nullptr)
+		{
+			entry = &gFoldedIndex.emplace(std::move(foldedName), *entry).first->second;
+		}
+		else
 		{
-			c = std::toupper(c);
+			gFoldedMisses.emplace(std::move(foldedName));
 		}
+	}
 
-		stream = this->open(newName.c_str(), inGlobalBSA);
+	if (entry == nullptr)
+	{
+		*inGlobalBSA = true;
 
 		// The caller does error checking to see if this is null.
-		return stream;
+		return nullptr;
 	}
+
+	*inGlobalBSA = entry->inGlobalBSA;
+	return OpenEntry(*entry);
 }
 
 IStreamPtr Manager::openCaseInsensitive(const char *name)
@@ -177,16 +475,10 @@ bool Manager::readCaseInsensitive(const char *name, Buffer<std::byte> *dst)
 
 bool Manager::exists(const char *name)
 {
-	std::ifstream file;
-	const auto iter = std::find_if(gRootPaths.begin(), gRootPaths.end(),
-		[name, &file](const std::string &rootPath)
-	{
-		file.open(rootPath + name, std::ios::binary);
-		return file.is_open();
-	});
+	assert(name != nullptr);
 
-	// If not in the root paths, then check inside GLOBAL.BSA.
-	return (iter != gRootPaths.end()) || gGlobalBsa.exists(name);
+	std::lock_guard<std::mutex> lock(gIndexMutex);
+	return FindExactEntry(name) != nullptr;
 }
 
 void Manager::addDir(const std::string &path, const std::string &pre, const char *pattern,
@@ -28,13 +28,20 @@ public:
 	void initialize(std::string&& rootPath = std::string());
 	void addDataPath(std::string&& path);
 
+	// Rescans every data path and GLOBAL.BSA, forgetting any cached misses.
+	void refresh();
+
+	// Watches the data paths for added, removed, or renamed files (Linux only). Changes are applied
+	// by pollChanges() so lookups never see a half-updated index.
+	void setWatchForChanges(bool enabled);
+	void pollChanges();
+
 	IStreamPtr open(const char *name, bool *inGlobalBSA);
 	IStreamPtr open(const char *name);
 
 	// Special open method intended for Unix systems since the Arena floppy and CD versions don't
-	// have consistent casing for some files (like SPELLSG.65). This method is specific to Arena's
-	// files and is not a general solution for case-insensitive file loading.
-	// - To do: replace with something using std::filesystem::equivalent() (C++17)?
+	// have consistent casing for some files (like SPELLSG.65). Looks up the uppercase name in the
+	// file index built from the data paths and GLOBAL.BSA.
 	IStreamPtr openCaseInsensitive(const char *name, bool *inGlobalBSA);
 	IStreamPtr openCaseInsensitive(const char *name);
 